@@ -244,6 +244,14 @@ typedef struct CassNode_ CassNode;
  */
 typedef struct CassIterator_ CassIterator;
 
+/**
+ * An object used to iterate over the rows of every page of a statement's
+ * result, or of a table scan, fetching the following pages in the background.
+ *
+ * @struct CassPagedIterator
+ */
+typedef struct CassPagedIterator_ CassPagedIterator;
+
 /**
  * A collection of column values.
  *
@@ -453,6 +461,24 @@ typedef struct CassSpeculativeExecutionMetrics_ {
   cass_double_t percentage; /**< Fraction of requests that are aborted speculative retries */
 } CassSpeculativeExecutionMetrics;
 
+typedef struct CassResultMetadataCacheMetrics_ {
+  cass_uint64_t hits; /**< Rows results that re-used cached metadata */
+  cass_uint64_t misses; /**< Rows results whose metadata was decoded and added to the cache */
+} CassResultMetadataCacheMetrics;
+
+typedef struct CassPreparedStatementCacheMetrics_ {
+  cass_uint64_t entries; /**< The number of cached prepared statements */
+  cass_uint64_t size_bytes; /**< The approximate memory used by the cached statements */
+  cass_uint64_t evictions; /**< Statements evicted because the cache was full */
+  cass_uint64_t reprepares; /**< Statements re-prepared after an "unprepared" error */
+  cass_uint64_t coalesced_reprepares; /**< Re-prepares that were shared */
+} CassPreparedStatementCacheMetrics;
+
+typedef struct CassControlConnectionEventMetrics_ {
+  cass_uint64_t coalesced_schema_events; /**< Schema events merged into another event's refresh */
+  cass_uint64_t coalesced_topology_events; /**< Topology and status events merged into another event's update */
+} CassControlConnectionEventMetrics;
+
 typedef enum CassConsistency_ {
   CASS_CONSISTENCY_UNKNOWN      = 0xFFFF,
   CASS_CONSISTENCY_ANY          = 0x0000,
@@ -693,6 +719,7 @@ typedef enum  CassErrorSource_ {
   XX(CASS_ERROR_SOURCE_LIB, CASS_ERROR_LIB_NO_CUSTOM_PAYLOAD, 33, "No custom payload") \
   XX(CASS_ERROR_SOURCE_LIB, CASS_ERROR_LIB_EXECUTION_PROFILE_INVALID, 34, "Invalid execution profile specified") \
   XX(CASS_ERROR_SOURCE_LIB, CASS_ERROR_LIB_NO_TRACING_ID, 35, "No tracing ID") \
+  XX(CASS_ERROR_SOURCE_LIB, CASS_ERROR_LIB_RESULT_INTERRUPTED, 36, "Result interrupted") \
   XX(CASS_ERROR_SOURCE_SERVER, CASS_ERROR_SERVER_SERVER_ERROR, 0x0000, "Server error") \
   XX(CASS_ERROR_SOURCE_SERVER, CASS_ERROR_SERVER_PROTOCOL_ERROR, 0x000A, "Protocol error") \
   XX(CASS_ERROR_SOURCE_SERVER, CASS_ERROR_SERVER_BAD_CREDENTIALS, 0x0100, "Bad credentials") \
@@ -747,6 +774,19 @@ typedef enum CassError_ {
 typedef void (*CassFutureCallback)(CassFuture* future,
                                    void* data);
 
+/**
+ * A callback that's notified with the rows of a result as they're received.
+ *
+ * @param[in] chunk A result containing the rows decoded since the last
+ * notification. It's only valid for the duration of the callback.
+ * @param[in] data user defined data provided when the callback
+ * was registered.
+ *
+ * @see cass_statement_set_result_chunk_callback()
+ */
+typedef void (*CassResultChunkCallback)(const CassResult* chunk,
+                                        void* data);
+
 /**
  * Maximum size of a log message
  */
@@ -1212,6 +1252,29 @@ cass_execution_profile_set_latency_aware_routing_settings(CassExecProfile* profi
                                                           cass_uint64_t update_rate_ms,
                                                           cass_uint64_t min_measured);
 
+/**
+ * Configures the execution profile to use load-aware request routing or not.
+ *
+ * <b>Note:</b> Execution profiles use the cluster-level load balancing policy
+ * unless enabled. This setting is not applicable unless a load balancing policy
+ * is enabled on the execution profile.
+ *
+ * <b>Default:</b> cass_false (disabled).
+ *
+ * @public @memberof CassExecProfile
+ *
+ * @param[in] profile
+ * @param[in] enabled
+ * @param[in] use_latency
+ * @return CASS_OK if successful, otherwise an error occurred.
+ *
+ * @see cass_cluster_set_load_aware_routing()
+ */
+CASS_EXPORT CassError
+cass_execution_profile_set_load_aware_routing(CassExecProfile* profile,
+                                              cass_bool_t enabled,
+                                              cass_bool_t use_latency);
+
 /**
  * Sets/Appends whitelist hosts for the execution profile. The first call sets
  * the whitelist hosts and any subsequent calls appends additional hosts.
@@ -1434,6 +1497,29 @@ cass_execution_profile_set_constant_speculative_execution_policy(CassExecProfile
                                                                  cass_int64_t constant_delay_ms,
                                                                  int max_speculative_executions);
 
+/**
+ * Enable percentile speculative executions with the supplied settings for the
+ * execution profile.
+ *
+ * <b>Note:</b> Profile-based speculative execution policy is disabled by
+ * default; cluster speculative execution policy is used when profile does not
+ * contain a policy.
+ *
+ * @public @memberof CassExecProfile
+ *
+ * @param[in] profile
+ * @param[in] percentile
+ * @param[in] max_speculative_executions
+ * @param[in] max_speculative_ratio
+ * @return CASS_OK if successful, otherwise an error occurred
+ *
+ * @see cass_cluster_set_percentile_speculative_execution_policy()
+ */
+CASS_EXPORT CassError
+cass_execution_profile_set_percentile_speculative_execution_policy(
+    CassExecProfile* profile, cass_double_t percentile, int max_speculative_executions,
+    cass_double_t max_speculative_ratio);
+
 /**
  * Disable speculative executions for the execution profile.
  *
@@ -1679,6 +1765,99 @@ CASS_EXPORT CassError
 cass_cluster_set_num_threads_io(CassCluster* cluster,
                                 unsigned num_threads);
 
+/**
+ * Binds the IO threads to CPUs. The list uses the same format as taskset,
+ * e.g. "0-3,8,10-11", and IO threads are assigned the listed CPUs
+ * round-robin: the first IO thread is bound to the first CPU, the second IO
+ * thread to the second CPU, and so on.
+ *
+ * Each IO thread is bound before it allocates its connections and buffers,
+ * so (with the operating system's default first-touch memory policy) the
+ * memory the thread uses is allocated on its CPU's NUMA node. Binding is only
+ * supported on Linux and Windows; a warning is logged if a thread can't be
+ * bound.
+ *
+ * <b>Default:</b> NULL (IO threads aren't bound to CPUs)
+ *
+ * @public @memberof CassCluster
+ *
+ * @param[in] cluster
+ * @param[in] cpu_list A list of CPUs or an empty string (or NULL) to not bind
+ * the IO threads.
+ * @return CASS_OK if successful, otherwise an error occurred.
+ *
+ * @see cass_cluster_set_num_threads_io()
+ */
+CASS_EXPORT CassError
+cass_cluster_set_io_thread_affinity(CassCluster* cluster,
+                                    const char* cpu_list);
+
+/**
+ * Same as cass_cluster_set_io_thread_affinity(), but with lengths for string
+ * parameters.
+ *
+ * @public @memberof CassCluster
+ *
+ * @param[in] cluster
+ * @param[in] cpu_list
+ * @param[in] cpu_list_length
+ * @return same as cass_cluster_set_io_thread_affinity()
+ *
+ * @see cass_cluster_set_io_thread_affinity()
+ */
+CASS_EXPORT CassError
+cass_cluster_set_io_thread_affinity_n(CassCluster* cluster,
+                                      const char* cpu_list,
+                                      size_t cpu_list_length);
+
+/**
+ * Sets the amount of time an IO thread keeps polling its connections and
+ * request queue, without blocking, after it last handled a request or a
+ * response. Responses and requests that arrive while the thread is spinning
+ * are handled without the latency of waking up the thread, at the cost of
+ * the CPU time used while spinning (each IO thread uses a full core while
+ * requests are arriving faster than the spin time).
+ *
+ * <b>Note:</b> This is intended for latency-sensitive applications with
+ * dedicated CPUs for the IO threads; see
+ * cass_cluster_set_io_thread_affinity().
+ *
+ * <b>Default:</b> 0 (IO threads block as soon as there are no events)
+ *
+ * @public @memberof CassCluster
+ *
+ * @param[in] cluster
+ * @param[in] spin_time_us The spin time in microseconds or 0 to disable
+ * spinning.
+ */
+CASS_EXPORT void
+cass_cluster_set_io_spin_time(CassCluster* cluster,
+                              unsigned spin_time_us);
+
+/**
+ * Enable/Disable using io_uring (Linux 5.4+) for the IO threads' socket
+ * writes and reads. The writes that the IO threads flush during an event
+ * loop iteration are submitted together with a single system call instead of
+ * a system call per socket. On Linux 6.0+ each connection also keeps a
+ * multishot receive queued that reads into buffers shared by the IO thread's
+ * connections, instead of a read system call per socket. SSL connections
+ * still use the regular event loop. If the ring can't be created at
+ * runtime (e.g. the kernel doesn't support io_uring or it's disabled) then a
+ * warning is logged and the regular event loop is used.
+ *
+ * <b>Default:</b> cass_false (disabled).
+ *
+ * @public @memberof CassCluster
+ *
+ * @param[in] cluster
+ * @param[in] enabled
+ * @return CASS_OK if successful, CASS_ERROR_LIB_NOT_IMPLEMENTED if the driver
+ * was built without io_uring support.
+ */
+CASS_EXPORT CassError
+cass_cluster_set_use_io_uring(CassCluster* cluster,
+                              cass_bool_t enabled);
+
 /**
  * Sets the size of the fixed size queue that stores
  * pending requests.
@@ -2293,6 +2472,29 @@ cass_cluster_set_latency_aware_routing_settings(CassCluster* cluster,
                                                 cass_uint64_t update_rate_ms,
                                                 cass_uint64_t min_measured);
 
+/**
+ * Configures the cluster to use load-aware request routing or not.
+ *
+ * <b>Default:</b> cass_false (disabled).
+ *
+ * For each request the first two hosts of the base routing policy's query
+ * plan (e.g. two of the replicas when token-aware routing is enabled) are
+ * compared and the host with the fewest in-flight requests is tried first.
+ * This steers requests away from a host that is temporarily slow, for example
+ * because of garbage collection or compaction.
+ *
+ * @public @memberof CassCluster
+ *
+ * @param[in] cluster
+ * @param[in] enabled
+ * @param[in] use_latency If enabled, the in-flight requests are weighted by
+ * the hosts' average latencies.
+ */
+CASS_EXPORT void
+cass_cluster_set_load_aware_routing(CassCluster* cluster,
+                                    cass_bool_t enabled,
+                                    cass_bool_t use_latency);
+
 /**
  * Sets/Appends whitelist hosts. The first call sets the whitelist hosts and
  * any subsequent calls appends additional hosts. Passing an empty string will
@@ -2570,6 +2772,86 @@ CASS_EXPORT void
 cass_cluster_set_use_schema(CassCluster* cluster,
                             cass_bool_t enabled);
 
+/**
+ * Sets the amount of time, in milliseconds, that schema change events are
+ * debounced by the control connection. Events received within the window are
+ * merged: duplicate events are dropped and multiple table (or user type)
+ * changes in the same keyspace are handled by a single refresh of the
+ * keyspace's tables (or user types). This reduces the number of schema
+ * queries run during large migrations.
+ *
+ * <b>Default:</b> 0 ms (disabled; every event is handled immediately)
+ *
+ * @public @memberof CassCluster
+ *
+ * @param[in] cluster
+ * @param[in] window_ms
+ *
+ * @see cass_cluster_set_topology_event_debounce_window()
+ */
+CASS_EXPORT void
+cass_cluster_set_schema_event_debounce_window(CassCluster* cluster,
+                                              unsigned window_ms);
+
+/**
+ * Sets the amount of time, in milliseconds, that topology and status change
+ * events are debounced by the control connection. Events received within the
+ * window are merged: only the last status of a node is applied and multiple
+ * new or moved nodes are handled by a single query of the peers table. This
+ * reduces the number of queries run during rolling restarts and large
+ * topology changes.
+ *
+ * <b>Default:</b> 0 ms (disabled; every event is handled immediately)
+ *
+ * @public @memberof CassCluster
+ *
+ * @param[in] cluster
+ * @param[in] window_ms
+ *
+ * @see cass_cluster_set_schema_event_debounce_window()
+ */
+CASS_EXPORT void
+cass_cluster_set_topology_event_debounce_window(CassCluster* cluster,
+                                                unsigned window_ms);
+
+/**
+ * Sets the path of a file used to cache the cluster's schema metadata between
+ * runs of an application. When the control connection is established the
+ * schema in the cache file is used, instead of querying the system schema
+ * tables, if its schema version matches the connected host's schema version.
+ * Otherwise, the schema is queried and the cache file is replaced. This
+ * reduces the time it takes to connect to clusters with large schemas.
+ *
+ * <b>Note:</b> The cache file is read and written by the session's control
+ * connection so it should not be shared by sessions that are connected at
+ * the same time.
+ *
+ * <b>Default:</b> Empty (disabled)
+ *
+ * @public @memberof CassCluster
+ *
+ * @param[in] cluster
+ * @param[in] path An empty path disables the cache file.
+ */
+CASS_EXPORT void
+cass_cluster_set_metadata_cache_file(CassCluster* cluster,
+                                     const char* path);
+
+/**
+ * Same as cass_cluster_set_metadata_cache_file(), but with lengths for string
+ * parameters.
+ *
+ * @public @memberof CassCluster
+ *
+ * @param[in] cluster
+ * @param[in] path
+ * @param[in] path_length
+ */
+CASS_EXPORT void
+cass_cluster_set_metadata_cache_file_n(CassCluster* cluster,
+                                       const char* path,
+                                       size_t path_length);
+
 /**
  * Enable/Disable retrieving hostnames for IP addresses using reverse IP lookup.
  *
@@ -2623,6 +2905,32 @@ cass_cluster_set_constant_speculative_execution_policy(CassCluster* cluster,
                                                        cass_int64_t constant_delay_ms,
                                                        int max_speculative_executions);
 
+/**
+ * Enable speculative executions that are started after a percentile of the
+ * recent request latencies. The latencies are tracked separately by each
+ * I/O thread for each profile (the default profile or an execution profile)
+ * and the delay is recomputed every second. No speculative executions are
+ * started until enough latencies have been recorded.
+ *
+ * @public @memberof CassCluster
+ *
+ * @param[in] cluster
+ * @param[in] percentile The latency percentile to wait for before starting
+ * the next execution, e.g. 99.0. Must be greater than 0 and less than 100.
+ * @param[in] max_speculative_executions
+ * @param[in] max_speculative_ratio The maximum number of speculative
+ * executions as a share of the requests, e.g. 0.1 for 10%. Only speculative
+ * executions that start count towards the limit, not the ones that are
+ * scheduled and then canceled because the request finished first. Use 0 for
+ * no limit.
+ * @return CASS_OK if successful, otherwise an error occurred
+ */
+CASS_EXPORT CassError
+cass_cluster_set_percentile_speculative_execution_policy(CassCluster* cluster,
+                                                         cass_double_t percentile,
+                                                         int max_speculative_executions,
+                                                         cass_double_t max_speculative_ratio);
+
 /**
  * Disable speculative executions
  *
@@ -2736,6 +3044,52 @@ CASS_EXPORT CassError
 cass_cluster_set_prepare_on_up_or_add_host(CassCluster* cluster,
                                            cass_bool_t enabled);
 
+/**
+ * Sets the maximum number of outstanding requests used to pre-prepare cached
+ * prepared statements on a host that becomes available or is added. The
+ * requests are spread over the same number of connections as a host's
+ * connection pool (see cass_cluster_set_core_connections_per_host()) and the
+ * most recently used statements are prepared first.
+ *
+ * A lower value reduces the burst of prepare requests a host receives when
+ * it becomes available, but it takes longer to prepare all the statements.
+ *
+ * <b>Default:</b> 128
+ *
+ * @public @memberof CassCluster
+ *
+ * @param[in] cluster
+ * @param[in] concurrency Must be greater than zero.
+ * @return CASS_OK if successful, otherwise an error occurred
+ *
+ * @see cass_cluster_set_prepare_on_up_or_add_host()
+ */
+CASS_EXPORT CassError
+cass_cluster_set_prepare_on_up_or_add_host_concurrency(CassCluster* cluster,
+                                                       unsigned concurrency);
+
+/**
+ * Sets the maximum number of prepared statements whose metadata is cached by
+ * the session. The cached metadata is used to pre-prepare statements on hosts
+ * that become available and to track result metadata changes. When the
+ * maximum is exceeded the least recently used statement is evicted; an evicted
+ * statement continues to work and is re-prepared on demand if a host returns
+ * an "unprepared" error.
+ *
+ * <b>Default:</b> 10000
+ *
+ * @public @memberof CassCluster
+ *
+ * @param[in] cluster
+ * @param[in] max_entries The maximum number of entries. A value of zero
+ * disables the limit.
+ *
+ * @see cass_session_get_prepared_statement_cache_metrics()
+ */
+CASS_EXPORT void
+cass_cluster_set_prepared_statement_cache_size(CassCluster* cluster,
+                                               unsigned max_entries);
+
 /**
  * Enable the <b>NO_COMPACT</b> startup option.
  *
@@ -3125,6 +3479,28 @@ CASS_EXPORT CassFuture*
 cass_session_execute(CassSession* session,
                      const CassStatement* statement);
 
+/**
+ * Execute several independent statements. This is the same as calling
+ * cass_session_execute() for each of the statements, but the statements are
+ * submitted to the session's I/O threads in groups, so that each I/O thread
+ * is woken once, instead of once per statement.
+ *
+ * @public @memberof CassSession
+ *
+ * @param[in] session
+ * @param[in] statements
+ * @param[in] count The number of statements.
+ * @param[out] futures A future for each of the statements, in the same
+ * order. Each of the futures must be freed.
+ *
+ * @see cass_session_execute()
+ */
+CASS_EXPORT void
+cass_session_execute_many(CassSession* session,
+                          const CassStatement* const* statements,
+                          size_t count,
+                          CassFuture** futures);
+
 /**
  * Execute a batch statement.
  *
@@ -3142,6 +3518,137 @@ CASS_EXPORT CassFuture*
 cass_session_execute_batch(CassSession* session,
                            const CassBatch* batch);
 
+/**
+ * Execute a batch statement, splitting an unlogged batch into a batch per
+ * replica set. The batch's statements are grouped by their replicas using
+ * the session's token map (statements must have a routing key, e.g. bound
+ * prepared statements) and the resulting batches are executed in parallel,
+ * each with the batch's settings, so that each batch is sent to a
+ * coordinator that's a replica for all of its statements.
+ *
+ * The returned future is set once all the batches finish. If any of them
+ * fail then it's set to the first error; otherwise its result is the first
+ * batch's result. Statements of batches that failed may or may not have been
+ * applied, so this should only be used with idempotent statements if the
+ * batch is retried.
+ *
+ * Logged and counter batches, and batches whose statements all have the same
+ * replicas, are executed the same as cass_session_execute_batch().
+ *
+ * @cassandra{2.0+}
+ *
+ * @public @memberof CassSession
+ *
+ * @param[in] session
+ * @param[in] batch
+ * @return A future that must be freed.
+ *
+ * @see cass_session_execute_batch()
+ */
+CASS_EXPORT CassFuture*
+cass_session_execute_batch_split(CassSession* session,
+                                 const CassBatch* batch);
+
+/**
+ * Execute a query or bound statement and iterate over the rows of all of its
+ * result's pages. The request for the next page is sent as soon as the
+ * previous page is received, instead of when the application has finished
+ * with the previous page, so that fetching pages overlaps with processing
+ * rows. Pages are fetched ahead of the application until either
+ * prefetch_pages pages or max_prefetch_bytes bytes of results are buffered.
+ *
+ * The statement's paging state is updated as pages are received and the
+ * statement is frozen (see cass_statement_freeze()) so that only its values,
+ * paging state and timestamp are encoded for each page. The statement must not
+ * be modified or executed until the iterator is freed, and the session must
+ * not be closed or freed until the iterator is freed.
+ *
+ * <b>Note:</b> This doesn't support statements with a result chunk callback;
+ * the iterator's error is CASS_ERROR_LIB_BAD_PARAMS for those statements.
+ *
+ * @public @memberof CassSession
+ *
+ * @param[in] session
+ * @param[in] statement
+ * @param[in] prefetch_pages The maximum number of pages received ahead of the
+ * page being iterated over. A value of 0 disables prefetching; each page is
+ * then requested when the previous page has been iterated over.
+ * @param[in] max_prefetch_bytes The maximum size of the pages received ahead
+ * of the page being iterated over. A value of 0 disables the limit.
+ * @return A new paged iterator that must be freed.
+ *
+ * @see cass_paged_iterator_free()
+ * @see cass_statement_set_paging_size()
+ */
+CASS_EXPORT CassPagedIterator*
+cass_session_execute_paged(CassSession* session,
+                           CassStatement* statement,
+                           unsigned prefetch_pages,
+                           size_t max_prefetch_bytes);
+
+/**
+ * Scans all the rows of a table by splitting the ring into the token ranges
+ * of the session's token map and querying each range
+ * ("token(...) > ? AND token(...) <= ?") on one of its replicas, preferring
+ * replicas in the local datacenter. Up to parallelism ranges are queried at
+ * the same time and a range's query is retried on the range's other replicas
+ * if it fails. The rows of all the ranges are returned by the iterator, in no
+ * particular order.
+ *
+ * <b>Note:</b> This requires token-aware routing and schema metadata to be
+ * enabled. Errors, including an unknown table, are returned by
+ * cass_paged_iterator_error_code().
+ *
+ * @public @memberof CassSession
+ *
+ * @param[in] session
+ * @param[in] keyspace
+ * @param[in] table
+ * @param[in] columns The columns to select (e.g. "a, b") or NULL to select
+ * all the columns.
+ * @param[in] parallelism The maximum number of ranges queried at the same
+ * time. This is also the maximum number of pages buffered ahead of the
+ * application.
+ * @return A new paged iterator that must be freed.
+ *
+ * @see cass_paged_iterator_free()
+ * @see cass_cluster_set_token_aware_routing()
+ */
+CASS_EXPORT CassPagedIterator*
+cass_session_scan_table(CassSession* session,
+                        const char* keyspace,
+                        const char* table,
+                        const char* columns,
+                        unsigned parallelism);
+
+/**
+ * Same as cass_session_scan_table(), but with lengths for string
+ * parameters.
+ *
+ * @public @memberof CassSession
+ *
+ * @param[in] session
+ * @param[in] keyspace
+ * @param[in] keyspace_length
+ * @param[in] table
+ * @param[in] table_length
+ * @param[in] columns
+ * @param[in] columns_length
+ * @param[in] parallelism
+ * @return same as cass_session_scan_table()
+ *
+ * @see cass_session_scan_table()
+ */
+CASS_EXPORT CassPagedIterator*
+cass_session_scan_table_n(CassSession* session,
+                          const char* keyspace,
+                          size_t keyspace_length,
+                          const char* table,
+                          size_t table_length,
+                          const char* columns,
+                          size_t columns_length,
+                          unsigned parallelism);
+
 /**
  * Gets a snapshot of this session's schema metadata. The returned
  * snapshot of the schema metadata is not updated. This function
@@ -3182,6 +3689,56 @@ CASS_EXPORT void
 cass_session_get_speculative_execution_metrics(const CassSession* session,
                                                CassSpeculativeExecutionMetrics* output);
 
+/**
+ * Gets a copy of this session's result metadata cache metrics. The metadata
+ * of rows results that don't use a prepared statement's metadata (simple
+ * queries and each page of a paged query) is cached by the driver's I/O
+ * threads and shared by results with identical column specifications.
+ *
+ * @public @memberof CassSession
+ *
+ * @param[in] session
+ * @param[out] output
+ */
+CASS_EXPORT void
+cass_session_get_result_metadata_cache_metrics(const CassSession* session,
+                                               CassResultMetadataCacheMetrics* output);
+
+/**
+ * Gets a copy of this session's prepared statement cache metrics. Requests
+ * that fail with an "unprepared" error re-prepare the statement once per host
+ * and I/O thread; concurrent requests for the same statement wait for that
+ * re-prepare instead of sending their own.
+ *
+ * @public @memberof CassSession
+ *
+ * @param[in] session
+ * @param[out] output
+ *
+ * @see cass_cluster_set_prepared_statement_cache_size()
+ */
+CASS_EXPORT void
+cass_session_get_prepared_statement_cache_metrics(const CassSession* session,
+                                                  CassPreparedStatementCacheMetrics* output);
+
+/**
+ * Gets a copy of this session's control connection event metrics. Schema,
+ * topology and status events received within a debounce window are handled
+ * together; the counts are the events that didn't need their own refresh.
+ * They include the events of previous control connections.
+ *
+ * @public @memberof CassSession
+ *
+ * @param[in] session
+ * @param[out] output
+ *
+ * @see cass_cluster_set_schema_event_debounce_window()
+ * @see cass_cluster_set_topology_event_debounce_window()
+ */
+CASS_EXPORT void
+cass_session_get_control_connection_event_metrics(const CassSession* session,
+                                                  CassControlConnectionEventMetrics* output);
+
 /**
  * Get the client id.
  *
@@ -5313,6 +5870,25 @@ CASS_EXPORT CassError
 cass_statement_set_request_timeout(CassStatement* statement,
                                    cass_uint64_t timeout_ms);
 
+/**
+ * Freezes the statement so that the invariant parts of its request (the
+ * query string or prepared ID, consistency, flags, paging size, paging state
+ * and serial consistency) are encoded once and re-used by subsequent
+ * executions. Only the bound values and timestamp are encoded per execution.
+ * This is useful for a statement that's re-bound and executed repeatedly.
+ *
+ * The statement's settings can still be changed after it's frozen; the
+ * invariant parts are re-encoded when they change. Statements that use named
+ * values or a statement keyspace (protocol v5) are always fully encoded.
+ *
+ * @public @memberof CassStatement
+ *
+ * @param[in] statement
+ * @return CASS_OK if successful, otherwise an error occurred.
+ */
+CASS_EXPORT CassError
+cass_statement_freeze(CassStatement* statement);
+
 /**
  * Sets whether the statement is idempotent. Idempotent statements are able to be
  * automatically retried after timeouts/errors and can be speculatively executed.
@@ -5408,6 +5984,37 @@ CASS_EXPORT CassError
 cass_statement_set_tracing(CassStatement* statement,
                            cass_bool_t enabled);
 
+/**
+ * Sets a callback that receives the rows of the statement's result as they're
+ * received, instead of after the whole page has been received. This caps the
+ * memory used by a large page to roughly the size of its largest row and
+ * overlaps decoding the rows with receiving them.
+ *
+ * The callback is called on one of the driver's I/O threads, one or more
+ * times, with a result containing the rows that have been received since the
+ * previous call. The result returned by the statement's future has the
+ * result's metadata and paging state (it can be used to get the next page),
+ * but it doesn't contain any rows. Only rows results are streamed.
+ *
+ * <b>Note:</b> Speculative executions aren't used for the statement because
+ * each execution would pass its rows to the callback. For the same reason, if
+ * the request fails after rows have been passed to the callback (e.g. the
+ * connection is closed) it's not retried, even if the statement is idempotent,
+ * and the future's error is CASS_ERROR_LIB_RESULT_INTERRUPTED. Rows received
+ * after the request times out aren't passed to the callback.
+ *
+ * @public @memberof CassStatement
+ *
+ * @param[in] statement
+ * @param[in] callback The callback, NULL disables streaming.
+ * @param[in] data User defined data passed to the callback.
+ * @return CASS_OK if successful, otherwise an error occurred.
+ */
+CASS_EXPORT CassError
+cass_statement_set_result_chunk_callback(CassStatement* statement,
+                                         CassResultChunkCallback callback,
+                                         void* data);
+
 /**
  * Sets a specific host that should run the query.
  *
@@ -9791,6 +10398,26 @@ cass_iterator_type(CassIterator* iterator);
 CASS_EXPORT CassIterator*
 cass_iterator_from_result(const CassResult* result);
 
+/**
+ * Creates a new iterator for the specified result that decodes rows lazily.
+ * Advancing the iterator only records the position of each column in the
+ * row; a column's value is decoded when it's first retrieved. This reduces
+ * the cost of iterating over wide rows when only a few columns are read.
+ *
+ * <b>Note:</b> Values retrieved from the iterator's rows are only valid
+ * until the iterator is advanced (the same as cass_iterator_from_result()).
+ *
+ * @public @memberof CassResult
+ *
+ * @param[in] result
+ * @return A new iterator that must be freed.
+ *
+ * @see cass_iterator_from_result()
+ * @see cass_iterator_free()
+ */
+CASS_EXPORT CassIterator*
+cass_iterator_from_result_lazy(const CassResult* result);
+
 /**
  * Creates a new iterator for the specified row. This can be
  * used to iterate over columns in a row.
@@ -10431,6 +11058,80 @@ cass_iterator_get_meta_field_name(const CassIterator* iterator,
 CASS_EXPORT const CassValue*
 cass_iterator_get_meta_field_value(const CassIterator* iterator);
 
+/***********************************************************************************
+ *
+ * Paged Iterator
+ *
+ ***********************************************************************************/
+
+/**
+ * Frees a paged iterator instance. Pages that are still being fetched are
+ * discarded when they're received.
+ *
+ * @public @memberof CassPagedIterator
+ *
+ * @param[in] iterator
+ */
+CASS_EXPORT void
+cass_paged_iterator_free(CassPagedIterator* iterator);
+
+/**
+ * Advances the iterator to the next row, waiting for the next page to be
+ * received if necessary. If a request fails, the rows of the pages received
+ * before the failure are still returned before this returns false.
+ *
+ * @public @memberof CassPagedIterator
+ *
+ * @param[in] iterator
+ * @return false if there are no more rows or an error occurred, otherwise
+ * true.
+ *
+ * @see cass_paged_iterator_error_code()
+ */
+CASS_EXPORT cass_bool_t
+cass_paged_iterator_next(CassPagedIterator* iterator);
+
+/**
+ * Gets the row at the iterator's current position.
+ *
+ * Calling cass_paged_iterator_next() will invalidate the previous
+ * row returned by this method.
+ *
+ * @public @memberof CassPagedIterator
+ *
+ * @param[in] iterator
+ * @return A row
+ */
+CASS_EXPORT const CassRow*
+cass_paged_iterator_get_row(const CassPagedIterator* iterator);
+
+/**
+ * Gets the error code of the request that failed to fetch a page. This
+ * should be checked after cass_paged_iterator_next() returns false.
+ *
+ * @public @memberof CassPagedIterator
+ *
+ * @param[in] iterator
+ * @return CASS_OK if all the pages were received successfully, otherwise
+ * the error that stopped the iteration.
+ */
+CASS_EXPORT CassError
+cass_paged_iterator_error_code(const CassPagedIterator* iterator);
+
+/**
+ * Gets the error message of the request that failed to fetch a page.
+ *
+ * @public @memberof CassPagedIterator
+ *
+ * @param[in] iterator
+ * @param[out] message Empty string returned if no error
+ * @param[out] message_length
+ */
+CASS_EXPORT void
+cass_paged_iterator_error_message(const CassPagedIterator* iterator,
+                                  const char** message,
+                                  size_t* message_length);
+
 /***********************************************************************************
  *
  * Row
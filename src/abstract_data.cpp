@@ -24,11 +24,18 @@
 #include "tuple.hpp"
 #include "user_type_value.hpp"
 
+#include <algorithm>
+
 using namespace datastax::internal::core;
 
+// Avoid guessing a huge bind buffer from a single large value
+#define MAX_INITIAL_BIND_BUFFER_SIZE (64 * 1024)
+#define MIN_BIND_BUFFER_SIZE 64
+
 CassError AbstractData::set(size_t index, CassNull value) {
   CASS_CHECK_INDEX_AND_TYPE(index, value);
-  elements_[index] = Element(value);
+  Buffer buf(core::encode_with_length(value));
+  set_element(index, Element::NUL, buf.data(), buf.size());
   return CASS_OK;
 }
 
@@ -37,84 +44,153 @@ CassError AbstractData::set(size_t index, const Collection* value) {
   if (value->type() == CASS_COLLECTION_TYPE_MAP && value->items().size() % 2 != 0) {
     return CASS_ERROR_LIB_INVALID_ITEM_COUNT;
   }
-  elements_[index] = value;
+  size_t size = value->get_size_with_length();
+  value->encode_with_length(allocate_element(index, Element::BUFFER, size));
   return CASS_OK;
 }
 
 CassError AbstractData::set(size_t index, const Tuple* value) {
   CASS_CHECK_INDEX_AND_TYPE(index, value);
-  elements_[index] = value->encode_with_length();
+  Buffer buf(value->encode_with_length());
+  set_element(index, Element::BUFFER, buf.data(), buf.size());
   return CASS_OK;
 }
 
 CassError AbstractData::set(size_t index, const UserTypeValue* value) {
   CASS_CHECK_INDEX_AND_TYPE(index, value);
-  elements_[index] = value->encode_with_length();
+  Buffer buf(value->encode_with_length());
+  set_element(index, Element::BUFFER, buf.data(), buf.size());
   return CASS_OK;
 }
 
 Buffer AbstractData::encode() const {
-  Buffer buf(get_buffers_size());
-  encode_buffers(0, &buf);
-  return buf;
+  return encode_elements(-1); // Unset values are null
 }
 
 Buffer AbstractData::encode_with_length() const {
-  size_t buffers_size = get_buffers_size();
-  Buffer buf(sizeof(int32_t) + buffers_size);
-
-  size_t pos = buf.encode_int32(0, buffers_size);
-  encode_buffers(pos, &buf);
+  size_t size = 0;
+  for (ElementVec::const_iterator i = elements_.begin(), end = elements_.end(); i != end; ++i) {
+    size += i->is_unset() ? sizeof(int32_t) : i->get_size();
+  }
 
+  Buffer buf(sizeof(int32_t) + size);
+  size_t pos = buf.encode_int32(0, size);
+  for (size_t i = 0; i < elements_.size(); ++i) {
+    pos = copy_element(i, -1, pos, &buf); // Unset values are null
+  }
   return buf;
 }
 
-size_t AbstractData::get_buffers_size() const {
+Buffer AbstractData::encode_elements(int32_t unset_length) const {
   size_t size = 0;
+  bool is_contiguous = true;
   for (ElementVec::const_iterator i = elements_.begin(), end = elements_.end(); i != end; ++i) {
-    if (!i->is_unset()) {
-      size += i->get_size();
+    if (i->is_unset()) {
+      is_contiguous = false;
+      size += sizeof(int32_t);
     } else {
-      size += sizeof(int32_t); // null
+      if (i->offset() != size) is_contiguous = false;
+      size += i->get_size();
     }
   }
-  return size;
-}
 
-void AbstractData::encode_buffers(size_t pos, Buffer* buf) const {
-  for (ElementVec::const_iterator i = elements_.begin(), end = elements_.end(); i != end; ++i) {
-    if (!i->is_unset()) {
-      pos = i->copy_buffer(pos, buf);
-    } else {
-      pos = buf->encode_int32(pos, -1); // null
-    }
+  if (is_contiguous && size > 0) {
+    return Buffer(buffer_.get(), size);
+  }
+
+  Buffer buf(size);
+  size_t pos = 0;
+  for (size_t i = 0; i < elements_.size(); ++i) {
+    pos = copy_element(i, unset_length, pos, &buf);
   }
+  return buf;
 }
 
-size_t AbstractData::Element::get_size() const {
-  if (type_ == COLLECTION) {
-    return collection_->get_size_with_length();
-  } else {
-    assert(type_ == BUFFER || type_ == NUL);
-    return buf_.size();
+size_t AbstractData::copy_element(size_t index, int32_t unset_length, size_t pos,
+                                  Buffer* buf) const {
+  const Element& element = elements_[index];
+  if (element.is_unset()) {
+    return buf->encode_int32(pos, unset_length);
   }
+  return buf->copy(pos, buffer_->data() + element.offset(), element.get_size());
 }
 
-size_t AbstractData::Element::copy_buffer(size_t pos, Buffer* buf) const {
-  if (type_ == COLLECTION) {
-    Buffer encoded(collection_->encode_with_length());
-    return buf->copy(pos, encoded.data(), encoded.size());
-  } else {
-    assert(type_ == BUFFER || type_ == NUL);
-    return buf->copy(pos, buf_.data(), buf_.size());
+void AbstractData::encode_element(size_t index, CassString value) {
+  char* data = allocate_element(index, Element::BUFFER, sizeof(int32_t) + value.length);
+  encode_int32(data, value.length);
+  memcpy(data + sizeof(int32_t), value.data, value.length);
+}
+
+void AbstractData::encode_element(size_t index, CassBytes value) {
+  char* data = allocate_element(index, Element::BUFFER, sizeof(int32_t) + value.size);
+  encode_int32(data, value.size);
+  memcpy(data + sizeof(int32_t), value.data, value.size);
+}
+
+void AbstractData::encode_element(size_t index, CassCustom value) {
+  char* data = allocate_element(index, Element::BUFFER, sizeof(int32_t) + value.size);
+  encode_int32(data, value.size);
+  memcpy(data + sizeof(int32_t), value.data, value.size);
+}
+
+void AbstractData::set_element(size_t index, Element::Type type, const char* data, size_t size) {
+  memcpy(allocate_element(index, type, size), data, size);
+}
+
+char* AbstractData::allocate_element(size_t index, Element::Type type, size_t size) {
+  Element& element = elements_[index];
+
+  // The bind buffer is shared with requests that are still being written so
+  // it can only be modified if it's not referenced elsewhere.
+  bool is_shared = buffer_ && buffer_->ref_count() > 1;
+
+  if (!element.is_unset()) {
+    if (element.size_ == size && !is_shared) { // Overwrite the previous value
+      element.type_ = type;
+      return buffer_->data() + element.offset_;
+    }
+    unused_size_ += element.size_;
+    element.type_ = Element::UNSET;
   }
+
+  if (is_shared || buffer_size_ + size > buffer_capacity_) {
+    reallocate(size);
+  }
+
+  element.type_ = type;
+  element.offset_ = buffer_size_;
+  element.size_ = size;
+  buffer_size_ += size;
+  return buffer_->data() + element.offset_;
 }
 
-Buffer AbstractData::Element::get_buffer() const {
-  if (type_ == COLLECTION) {
-    return collection_->encode_with_length();
-  } else {
-    assert(type_ == BUFFER || type_ == NUL);
-    return buf_;
+void AbstractData::reallocate(size_t size) {
+  size_t needed = buffer_size_ - unused_size_ + size;
+  size_t capacity = buffer_capacity_;
+  if (capacity == 0) {
+    // Assume the rest of the values are a similar size
+    capacity = std::min(size * elements_.size(),
+                        std::max(size, static_cast<size_t>(MAX_INITIAL_BIND_BUFFER_SIZE)));
+    capacity = std::max(capacity, static_cast<size_t>(MIN_BIND_BUFFER_SIZE));
   }
+  if (capacity < needed) {
+    capacity = std::max(2 * capacity, needed);
+  }
+
+  // Compact the values in index order so that the bind buffer holds exactly
+  // the encoded values when they're all bound.
+  RefBuffer::Ptr buffer(RefBuffer::create(capacity));
+  size_t pos = 0;
+  for (ElementVec::iterator i = elements_.begin(), end = elements_.end(); i != end; ++i) {
+    if (!i->is_unset()) {
+      memcpy(buffer->data() + pos, buffer_->data() + i->offset_, i->size_);
+      i->offset_ = pos;
+      pos += i->size_;
+    }
+  }
+
+  buffer_ = buffer;
+  buffer_size_ = pos;
+  buffer_capacity_ = capacity;
+  unused_size_ = 0;
 }
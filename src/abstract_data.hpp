@@ -43,59 +43,71 @@ class UserTypeValue;
 
 class AbstractData : public Allocated {
 public:
+  /**
+   * A bound value. The encoded value ([bytes]) is stored in the bind buffer
+   * at an offset.
+   */
   class Element {
   public:
-    enum Type { UNSET, NUL, BUFFER, COLLECTION };
+    enum Type { UNSET, NUL, BUFFER };
 
     Element()
-        : type_(UNSET) {}
+        : type_(UNSET)
+        , offset_(0)
+        , size_(0) {}
 
-    Element(CassNull value)
-        : type_(NUL)
-        , buf_(core::encode_with_length(value)) {}
-
-    Element(const Buffer& buf)
-        : type_(BUFFER)
-        , buf_(buf) {}
-
-    Element(const Collection* collection)
-        : type_(COLLECTION)
-        , collection_(collection) {}
-
-    bool is_unset() const { return type_ == UNSET || (type_ == BUFFER && buf_.size() == 0); }
+    bool is_unset() const { return type_ == UNSET; }
 
     bool is_null() const { return type_ == NUL; }
 
-    size_t get_size() const;
-    size_t copy_buffer(size_t pos, Buffer* buf) const;
-    Buffer get_buffer() const;
+    size_t offset() const { return offset_; }
+
+    size_t get_size() const { return size_; }
 
   private:
+    friend class AbstractData;
+
     Type type_;
-    Buffer buf_;
-    SharedRefPtr<const Collection> collection_;
+    size_t offset_;
+    size_t size_;
   };
 
   typedef Vector<Element> ElementVec;
 
 public:
   AbstractData(size_t count)
-      : elements_(count) {}
+      : elements_(count)
+      , buffer_size_(0)
+      , buffer_capacity_(0)
+      , unused_size_(0) {}
 
   virtual ~AbstractData() {}
 
   const ElementVec& elements() const { return elements_; }
 
+  /**
+   * Get the encoded value ([bytes]) of a set element.
+   *
+   * @param index The index of the element.
+   * @return A pointer into the bind buffer.
+   */
+  const char* element_data(size_t index) const {
+    assert(!elements_[index].is_unset());
+    return buffer_->data() + elements_[index].offset();
+  }
+
   void reset(size_t count) {
     elements_.clear();
     elements_.resize(count);
+    buffer_size_ = 0;
+    unused_size_ = 0;
   }
 
-#define SET_TYPE(Type)                                  \
-  CassError set(size_t index, const Type value) {       \
-    CASS_CHECK_INDEX_AND_TYPE(index, value);            \
-    elements_[index] = core::encode_with_length(value); \
-    return CASS_OK;                                     \
+#define SET_TYPE(Type)                            \
+  CassError set(size_t index, const Type value) { \
+    CASS_CHECK_INDEX_AND_TYPE(index, value);      \
+    encode_element(index, value);                 \
+    return CASS_OK;                               \
   }
 
   SET_TYPE(cass_int8_t)
@@ -145,6 +157,26 @@ protected:
   virtual size_t get_indices(StringRef name, IndexVec* indices) = 0;
   virtual const DataType::ConstPtr& get_type(size_t index) const = 0;
 
+  /**
+   * Encode all the elements as a sequence of [bytes] values. When the bind
+   * buffer already holds exactly that sequence it's shared instead of copied.
+   *
+   * @param unset_length The [bytes] length used for unset elements.
+   * @return A buffer containing the encoded elements.
+   */
+  Buffer encode_elements(int32_t unset_length) const;
+
+  /**
+   * Copy the encoded value of an element into a buffer.
+   *
+   * @param index The index of the element.
+   * @param unset_length The [bytes] length used if the element is unset.
+   * @param pos The position in the buffer.
+   * @param buf The destination buffer.
+   * @return The position after the value.
+   */
+  size_t copy_element(size_t index, int32_t unset_length, size_t pos, Buffer* buf) const;
+
 private:
   template <class T>
   CassError check(size_t index, const T value) {
@@ -159,12 +191,33 @@ private:
     return CASS_OK;
   }
 
-  size_t get_buffers_size() const;
-  void encode_buffers(size_t pos, Buffer* buf) const;
+  template <class T>
+  void encode_element(size_t index, const T value) {
+    // Small values are encoded using the buffer's fixed storage so this
+    // doesn't allocate.
+    Buffer buf(core::encode_with_length(value));
+    set_element(index, Element::BUFFER, buf.data(), buf.size());
+  }
+
+  void encode_element(size_t index, CassString value);
+  void encode_element(size_t index, CassBytes value);
+  void encode_element(size_t index, CassCustom value);
+
+  void set_element(size_t index, Element::Type type, const char* data, size_t size);
+  char* allocate_element(size_t index, Element::Type type, size_t size);
+  void reallocate(size_t size);
 
 private:
   ElementVec elements_;
 
+  // Bound values are encoded into a single buffer (in index order when bound
+  // in order). Replaced values leave unused space that's reclaimed when the
+  // buffer is reallocated.
+  RefBuffer::Ptr buffer_;
+  size_t buffer_size_;
+  size_t buffer_capacity_;
+  size_t unused_size_;
+
 private:
   DISALLOW_COPY_AND_ASSIGN(AbstractData);
 };
@@ -21,10 +21,14 @@
 #include "constants.hpp"
 #include "execute_request.hpp"
 #include "external.hpp"
+#include "map.hpp"
 #include "protocol.hpp"
 #include "request_callback.hpp"
 #include "serialization.hpp"
 #include "statement.hpp"
+#include "utils.hpp"
+
+#include <algorithm>
 
 using namespace datastax;
 using namespace datastax::internal::core;
@@ -240,3 +244,46 @@ bool BatchRequest::get_routing_key(String* routing_key) const {
   }
   return false;
 }
+
+void BatchRequest::split(const TokenMap* token_map, const String& keyspace, Vec* batches) const {
+  const String& batch_keyspace(!this->keyspace().empty() ? this->keyspace() : keyspace);
+
+  // The key for a replica set is its sorted addresses. An empty key is used
+  // for statements that can't be routed.
+  typedef Map<String, BatchRequest::Ptr> BatchMap;
+  BatchMap grouped;
+  for (StatementVec::const_iterator it = statements_.begin(), end = statements_.end(); it != end;
+       ++it) {
+    const Statement::Ptr& statement(*it);
+    const String& statement_keyspace(!statement->keyspace().empty() ? statement->keyspace()
+                                                                    : batch_keyspace);
+
+    String key;
+    String routing_key;
+    if (token_map != NULL && !statement_keyspace.empty() &&
+        statement->get_routing_key(&routing_key)) {
+      const CopyOnWriteHostVec& replicas = token_map->get_replicas(statement_keyspace, routing_key);
+      if (replicas && !replicas->empty()) {
+        Vector<String> addresses;
+        for (HostVec::const_iterator host_it = replicas->begin(), host_end = replicas->end();
+             host_it != host_end; ++host_it) {
+          addresses.push_back((*host_it)->address().to_string(true));
+        }
+        std::sort(addresses.begin(), addresses.end());
+        key = implode(addresses);
+      }
+    }
+
+    BatchRequest::Ptr& batch = grouped[key];
+    if (!batch) {
+      batch.reset(new BatchRequest(type_));
+      batch->copy_settings(*this);
+    }
+    batch->statements_.push_back(statement);
+  }
+
+  batches->reserve(batches->size() + grouped.size());
+  for (BatchMap::const_iterator it = grouped.begin(), end = grouped.end(); it != end; ++it) {
+    batches->push_back(it->second);
+  }
+}
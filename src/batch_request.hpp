@@ -27,6 +27,7 @@
 #include "request.hpp"
 #include "statement.hpp"
 #include "string.hpp"
+#include "token_map.hpp"
 #include "vector.hpp"
 
 namespace datastax { namespace internal { namespace core {
@@ -36,6 +37,7 @@ class ExecuteRequest;
 class BatchRequest : public RoutableRequest {
 public:
   typedef SharedRefPtr<BatchRequest> Ptr;
+  typedef SharedRefPtr<const BatchRequest> ConstPtr;
   typedef Vector<Statement::Ptr> StatementVec;
 
   BatchRequest(uint8_t type)
@@ -52,6 +54,20 @@ public:
 
   virtual bool get_routing_key(String* routing_key) const;
 
+  typedef Vector<SharedRefPtr<BatchRequest> > Vec;
+
+  /**
+   * Split the batch into a batch per replica set. Statements that share the
+   * same replicas are grouped, in their original order, into a batch with the
+   * same settings as this batch. Statements without a routing key are grouped
+   * into a single batch.
+   *
+   * @param token_map The token map used to determine the replicas.
+   * @param keyspace The keyspace used if the batch doesn't have a keyspace.
+   * @param batches The resulting batches.
+   */
+  void split(const TokenMap* token_map, const String& keyspace, Vec* batches) const;
+
 private:
   int encode(ProtocolVersion version, RequestCallback* callback, BufferVec* bufs) const;
 
@@ -53,6 +53,17 @@ public:
     }
   }
 
+  // Shares the first `size` bytes of an existing reference counted buffer
+  Buffer(RefBuffer* buffer, size_t size)
+      : size_(size) {
+    if (size > FIXED_BUFFER_SIZE) {
+      buffer->inc_ref();
+      data_.buffer = buffer;
+    } else if (size > 0) {
+      memcpy(data_.fixed, buffer->data(), size);
+    }
+  }
+
   Buffer(const Buffer& buf)
       : size_(0) {
     copy(buf);
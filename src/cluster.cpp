@@ -212,7 +212,9 @@ ClusterSettings::ClusterSettings()
     , port(CASS_DEFAULT_PORT)
     , reconnection_policy(new ExponentialReconnectionPolicy())
     , prepare_on_up_or_add_host(CASS_DEFAULT_PREPARE_ON_UP_OR_ADD_HOST)
-    , max_prepares_per_flush(CASS_DEFAULT_MAX_PREPARES_PER_FLUSH)
+    , prepare_on_up_or_add_host_concurrency(CASS_DEFAULT_PREPARE_ON_UP_OR_ADD_HOST_CONCURRENCY)
+    , prepare_on_up_or_add_host_connections(CASS_DEFAULT_NUM_CONNECTIONS_PER_HOST)
+    , max_prepared_statements(CASS_DEFAULT_MAX_PREPARED_STATEMENTS)
     , disable_events_on_startup(false)
     , cluster_metadata_resolver_factory(new DefaultClusterMetadataResolverFactory()) {
   load_balancing_policies.push_back(load_balancing_policy);
@@ -225,7 +227,9 @@ ClusterSettings::ClusterSettings(const Config& config)
     , port(config.port())
     , reconnection_policy(config.reconnection_policy())
     , prepare_on_up_or_add_host(config.prepare_on_up_or_add_host())
-    , max_prepares_per_flush(CASS_DEFAULT_MAX_PREPARES_PER_FLUSH)
+    , prepare_on_up_or_add_host_concurrency(config.prepare_on_up_or_add_host_concurrency())
+    , prepare_on_up_or_add_host_connections(config.core_connections_per_host())
+    , max_prepared_statements(config.max_prepared_statements())
     , disable_events_on_startup(false)
     , cluster_metadata_resolver_factory(config.cluster_metadata_resolver_factory()) {}
 
@@ -244,6 +248,7 @@ Cluster::Cluster(const ControlConnection::Ptr& connection, ClusterListener* list
     , is_closing_(false)
     , connected_host_(connected_host)
     , hosts_(hosts)
+    , prepared_metadata_(settings.max_prepared_statements)
     , local_dc_(local_dc)
     , supported_options_(supported_options)
     , is_recording_events_(settings.disable_events_on_startup) {
@@ -322,8 +327,42 @@ void Cluster::update_hosts(const HostMap& hosts) {
 }
 
 void Cluster::update_schema(const ControlConnectionSchema& schema) {
-  metadata_.clear_and_update_back(connection_->server_version());
+  schema_version_ = schema.schema_version;
+
+  // Only the keyspaces and tables that changed since the schema metadata was
+  // last built are replaced. The rest of the metadata is shared with the
+  // current snapshot.
+  SchemaDelta delta;
+  if (schema_digest_.update(connection_->server_version(), schema, &delta)) {
+    LOG_DEBUG("Incrementally updating schema metadata (%u keyspace(s) and %u table(s) replaced "
+              "or dropped)",
+              static_cast<unsigned int>(delta.dropped_keyspaces.size()),
+              static_cast<unsigned int>(delta.dropped_tables.size()));
+
+    metadata_.copy_front_and_update_back(connection_->server_version());
+
+    for (StringVec::const_iterator it = delta.dropped_keyspaces.begin(),
+                                   end = delta.dropped_keyspaces.end();
+         it != end; ++it) {
+      metadata_.drop_keyspace(*it);
+    }
+
+    for (SchemaDelta::KeyspaceTableVec::const_iterator it = delta.dropped_tables.begin(),
+                                                       end = delta.dropped_tables.end();
+         it != end; ++it) {
+      metadata_.drop_table_or_view(it->first, it->second);
+    }
+
+    update_schema_results(delta.changed);
+  } else {
+    metadata_.clear_and_update_back(connection_->server_version());
+    update_schema_results(schema);
+  }
 
+  metadata_.swap_to_back_and_update_front();
+}
+
+void Cluster::update_schema_results(const ControlConnectionSchema& schema) {
   if (schema.keyspaces) {
     metadata_.update_keyspaces(schema.keyspaces.get(), false);
   }
@@ -367,8 +406,6 @@ void Cluster::update_schema(const ControlConnectionSchema& schema) {
   if (schema.virtual_columns) {
     metadata_.update_columns(schema.virtual_columns.get());
   }
-
-  metadata_.swap_to_back_and_update_front();
 }
 
 void Cluster::update_token_map(const HostMap& hosts, const String& partitioner,
@@ -416,6 +453,8 @@ void Cluster::handle_schedule_reconnect() {
     reconnector_.reset(new ControlConnector(host, connection_->protocol_version(),
                                             bind_callback(&Cluster::on_reconnect, this)));
     reconnector_->with_settings(settings_.control_connection_settings)
+        ->with_metrics(connection_->metrics())
+        ->with_known_schema_version(schema_version_)
         ->connect(connection_->loop());
   } else {
     // No more hosts, refresh the query plan and schedule a re-connection
@@ -444,7 +483,11 @@ void Cluster::on_reconnect(ControlConnector* connector) {
     connected_host_ = hosts_[connection_->address()];
     assert(connected_host_ && "Connected host not found in hosts map");
 
-    update_schema(connector->schema());
+    // The existing schema metadata is kept if the schema hasn't changed since
+    // it was retrieved.
+    if (!connector->is_schema_unchanged()) {
+      update_schema(connector->schema());
+    }
     update_token_map(connector->hosts(), connected_host_->partitioner(), connector->schema());
 
     // Notify the listener that we've built a new token map
@@ -667,7 +710,9 @@ bool Cluster::prepare_host(const Host::Ptr& host, const PrepareHostHandler::Call
   if (connection_ && settings_.prepare_on_up_or_add_host) {
     PrepareHostHandler::Ptr prepare_host_handler(
         new PrepareHostHandler(host, prepared_metadata_.copy(), callback,
-                               connection_->protocol_version(), settings_.max_prepares_per_flush));
+                               connection_->protocol_version(),
+                               settings_.prepare_on_up_or_add_host_concurrency,
+                               settings_.prepare_on_up_or_add_host_connections));
 
     prepare_host_handler->prepare(connection_->loop(),
                                   settings_.control_connection_settings.connection_settings);
@@ -686,6 +731,9 @@ void Cluster::on_prepare_host_up(const PrepareHostHandler* handler) {
 
 void Cluster::on_update_schema(SchemaType type, const ResultResponse::Ptr& result,
                                const String& keyspace_name, const String& target_name) {
+  schema_version_.clear();
+  schema_digest_.invalidate_keyspace(keyspace_name);
+
   switch (type) {
     case KEYSPACE:
       // Virtual keyspaces are not updated (always false)
@@ -722,6 +770,9 @@ void Cluster::on_update_schema(SchemaType type, const ResultResponse::Ptr& resul
 
 void Cluster::on_drop_schema(SchemaType type, const String& keyspace_name,
                              const String& target_name) {
+  schema_version_.clear();
+  schema_digest_.invalidate_keyspace(keyspace_name);
+
   switch (type) {
     case KEYSPACE:
       metadata_.drop_keyspace(keyspace_name);
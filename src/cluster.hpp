@@ -27,6 +27,7 @@
 #include "monitor_reporting.hpp"
 #include "prepare_host_handler.hpp"
 #include "prepared.hpp"
+#include "schema_digest.hpp"
 
 #include <uv.h>
 
@@ -206,9 +207,21 @@ struct ClusterSettings {
   bool prepare_on_up_or_add_host;
 
   /**
-   * Max number of requests to be written out to the socket per write system call.
+   * The maximum number of outstanding requests used to prepare cached
+   * prepared statements on a host.
    */
-  unsigned max_prepares_per_flush;
+  unsigned prepare_on_up_or_add_host_concurrency;
+
+  /**
+   * The number of connections used to prepare cached prepared statements on
+   * a host.
+   */
+  unsigned prepare_on_up_or_add_host_connections;
+
+  /**
+   * The maximum number of cached prepared statements (zero is unbounded).
+   */
+  unsigned max_prepared_statements;
 
   /**
    * If true then events are disabled on startup. Events can be explicitly
@@ -342,6 +355,13 @@ public:
    */
   void prepared(const String& id, const PreparedMetadata::Entry::Ptr& entry);
 
+  /**
+   * Get the prepared metadata cache (thread-safe).
+   *
+   * @return The prepared metadata cache.
+   */
+  const PreparedMetadata& prepared_metadata() const { return prepared_metadata_; }
+
   /**
    * Get available hosts (determined by host distance). This filters out ignored
    * hosts (*NOT* thread-safe).
@@ -368,6 +388,7 @@ private:
 private:
   void update_hosts(const HostMap& hosts);
   void update_schema(const ControlConnectionSchema& schema);
+  void update_schema_results(const ControlConnectionSchema& schema);
   void update_token_map(const HostMap& hosts, const String& partitioner,
                         const ControlConnectionSchema& schema);
 
@@ -439,6 +460,14 @@ private:
   Host::Ptr connected_host_;
   LockedHostMap hosts_;
   Metadata metadata_;
+  // The schema version of the host that the schema metadata was fully
+  // retrieved from. This is cleared when the metadata is changed by schema
+  // events.
+  String schema_version_;
+  // Digests of the schema rows that the schema metadata was built from. These
+  // are used to only rebuild the keyspaces and tables that changed when the
+  // schema is retrieved again.
+  SchemaDigest schema_digest_;
   PreparedMetadata prepared_metadata_;
   TokenMap::Ptr token_map_;
   String local_dc_;
@@ -103,6 +103,34 @@ CassError cass_cluster_set_num_threads_io(CassCluster* cluster, unsigned num_thr
   return CASS_OK;
 }
 
+CassError cass_cluster_set_io_thread_affinity(CassCluster* cluster, const char* cpu_list) {
+  return cass_cluster_set_io_thread_affinity_n(cluster, cpu_list, SAFE_STRLEN(cpu_list));
+}
+
+CassError cass_cluster_set_io_thread_affinity_n(CassCluster* cluster, const char* cpu_list,
+                                                size_t cpu_list_length) {
+  CpuList cpus;
+  if (cpu_list_length > 0 && !parse_cpu_list(String(cpu_list, cpu_list_length), &cpus)) {
+    return CASS_ERROR_LIB_BAD_PARAMS;
+  }
+  cluster->config().set_io_thread_affinity(cpus);
+  return CASS_OK;
+}
+
+void cass_cluster_set_io_spin_time(CassCluster* cluster, unsigned spin_time_us) {
+  cluster->config().set_io_spin_time_us(spin_time_us);
+}
+
+CassError cass_cluster_set_use_io_uring(CassCluster* cluster, cass_bool_t enabled) {
+#ifdef HAVE_IO_URING
+  cluster->config().set_use_io_uring(enabled == cass_true);
+  return CASS_OK;
+#else
+  if (enabled == cass_false) return CASS_OK;
+  return CASS_ERROR_LIB_NOT_IMPLEMENTED;
+#endif
+}
+
 CassError cass_cluster_set_queue_size_io(CassCluster* cluster, unsigned queue_size) {
   if (queue_size == 0) {
     return CASS_ERROR_LIB_BAD_PARAMS;
@@ -328,6 +356,11 @@ void cass_cluster_set_latency_aware_routing_settings(
   cluster->config().set_latency_aware_routing_settings(settings);
 }
 
+void cass_cluster_set_load_aware_routing(CassCluster* cluster, cass_bool_t enabled,
+                                         cass_bool_t use_latency) {
+  cluster->config().set_load_aware_routing(enabled == cass_true, use_latency == cass_true);
+}
+
 void cass_cluster_set_whitelist_filtering(CassCluster* cluster, const char* hosts) {
   cass_cluster_set_whitelist_filtering_n(cluster, hosts, SAFE_STRLEN(hosts));
 }
@@ -417,6 +450,23 @@ void cass_cluster_set_use_schema(CassCluster* cluster, cass_bool_t enabled) {
   cluster->config().set_use_schema(enabled == cass_true);
 }
 
+void cass_cluster_set_schema_event_debounce_window(CassCluster* cluster, unsigned window_ms) {
+  cluster->config().set_schema_event_debounce_window_ms(window_ms);
+}
+
+void cass_cluster_set_topology_event_debounce_window(CassCluster* cluster, unsigned window_ms) {
+  cluster->config().set_topology_event_debounce_window_ms(window_ms);
+}
+
+void cass_cluster_set_metadata_cache_file(CassCluster* cluster, const char* path) {
+  cass_cluster_set_metadata_cache_file_n(cluster, path, SAFE_STRLEN(path));
+}
+
+void cass_cluster_set_metadata_cache_file_n(CassCluster* cluster, const char* path,
+                                            size_t path_length) {
+  cluster->config().set_metadata_cache_file(String(path, path_length));
+}
+
 CassError cass_cluster_set_use_hostname_resolution(CassCluster* cluster, cass_bool_t enabled) {
   cluster->config().set_use_hostname_resolution(enabled == cass_true);
   return CASS_OK;
@@ -439,6 +489,18 @@ CassError cass_cluster_set_constant_speculative_execution_policy(CassCluster* cl
   return CASS_OK;
 }
 
+CassError cass_cluster_set_percentile_speculative_execution_policy(
+    CassCluster* cluster, cass_double_t percentile, int max_speculative_executions,
+    cass_double_t max_speculative_ratio) {
+  if (percentile <= 0.0 || percentile >= 100.0 || max_speculative_executions < 0 ||
+      max_speculative_ratio < 0.0 || max_speculative_ratio > 1.0) {
+    return CASS_ERROR_LIB_BAD_PARAMS;
+  }
+  cluster->config().set_speculative_execution_policy(new PercentileSpeculativeExecutionPolicy(
+      percentile, max_speculative_executions, max_speculative_ratio));
+  return CASS_OK;
+}
+
 CassError cass_cluster_set_no_speculative_execution_policy(CassCluster* cluster) {
   cluster->config().set_speculative_execution_policy(new NoSpeculativeExecutionPolicy());
   return CASS_OK;
@@ -473,6 +535,19 @@ CassError cass_cluster_set_prepare_on_up_or_add_host(CassCluster* cluster, cass_
   return CASS_OK;
 }
 
+CassError cass_cluster_set_prepare_on_up_or_add_host_concurrency(CassCluster* cluster,
+                                                                 unsigned concurrency) {
+  if (concurrency == 0) {
+    return CASS_ERROR_LIB_BAD_PARAMS;
+  }
+  cluster->config().set_prepare_on_up_or_add_host_concurrency(concurrency);
+  return CASS_OK;
+}
+
+void cass_cluster_set_prepared_statement_cache_size(CassCluster* cluster, unsigned max_entries) {
+  cluster->config().set_max_prepared_statements(max_entries);
+}
+
 CassError cass_cluster_set_local_address(CassCluster* cluster, const char* name) {
   return cass_cluster_set_local_address_n(cluster, name, SAFE_STRLEN(name));
 }
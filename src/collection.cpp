@@ -160,10 +160,13 @@ Buffer Collection::encode() const {
 }
 
 Buffer Collection::encode_with_length() const {
-  size_t internal_size = get_size();
-  Buffer buf(sizeof(int32_t) + internal_size);
-  size_t pos = buf.encode_int32(0, internal_size);
-  pos = buf.encode_int32(pos, get_count());
-  encode_items(buf.data() + pos);
+  Buffer buf(get_size_with_length());
+  encode_with_length(buf.data());
   return buf;
 }
+
+void Collection::encode_with_length(char* output) const {
+  output = encode_int32(output, get_size());
+  output = encode_int32(output, get_count());
+  encode_items(output);
+}
@@ -95,6 +95,9 @@ public:
   Buffer encode() const;
   Buffer encode_with_length() const;
 
+  // Encodes into `output` which must have room for `get_size_with_length()` bytes
+  void encode_with_length(char* output) const;
+
   void clear() { items_.clear(); }
 
 private:
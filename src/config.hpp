@@ -30,6 +30,7 @@
 #include "speculative_execution.hpp"
 #include "ssl.hpp"
 #include "string.hpp"
+#include "utils.hpp"
 #include "timestamp_generator.hpp"
 
 #include <climits>
@@ -45,6 +46,8 @@ public:
       , protocol_version_(ProtocolVersion::highest_supported())
       , use_beta_protocol_version_(CASS_DEFAULT_USE_BETA_PROTOCOL_VERSION)
       , thread_count_io_(CASS_DEFAULT_THREAD_COUNT_IO)
+      , io_spin_time_us_(CASS_DEFAULT_IO_SPIN_TIME_US)
+      , use_io_uring_(CASS_DEFAULT_USE_IO_URING)
       , queue_size_io_(CASS_DEFAULT_QUEUE_SIZE_IO)
       , core_connections_per_host_(CASS_DEFAULT_NUM_CONNECTIONS_PER_HOST)
       , reconnection_policy_(new ExponentialReconnectionPolicy())
@@ -67,11 +70,15 @@ public:
       , connection_heartbeat_interval_secs_(CASS_DEFAULT_HEARTBEAT_INTERVAL_SECS)
       , timestamp_gen_(new MonotonicTimestampGenerator())
       , use_schema_(CASS_DEFAULT_USE_SCHEMA)
+      , schema_event_debounce_window_ms_(CASS_DEFAULT_SCHEMA_EVENT_DEBOUNCE_WINDOW_MS)
+      , topology_event_debounce_window_ms_(CASS_DEFAULT_TOPOLOGY_EVENT_DEBOUNCE_WINDOW_MS)
       , use_hostname_resolution_(CASS_DEFAULT_HOSTNAME_RESOLUTION_ENABLED)
       , use_randomized_contact_points_(CASS_DEFAULT_USE_RANDOMIZED_CONTACT_POINTS)
       , max_reusable_write_objects_(CASS_DEFAULT_MAX_REUSABLE_WRITE_OBJECTS)
       , prepare_on_all_hosts_(CASS_DEFAULT_PREPARE_ON_ALL_HOSTS)
       , prepare_on_up_or_add_host_(CASS_DEFAULT_PREPARE_ON_UP_OR_ADD_HOST)
+      , prepare_on_up_or_add_host_concurrency_(CASS_DEFAULT_PREPARE_ON_UP_OR_ADD_HOST_CONCURRENCY)
+      , max_prepared_statements_(CASS_DEFAULT_MAX_PREPARED_STATEMENTS)
       , no_compact_(CASS_DEFAULT_NO_COMPACT)
       , is_client_id_set_(false)
       , host_listener_(new DefaultHostListener())
@@ -112,6 +119,18 @@ public:
 
   void set_thread_count_io(unsigned num_threads) { thread_count_io_ = num_threads; }
 
+  const CpuList& io_thread_affinity() const { return io_thread_affinity_; }
+
+  void set_io_thread_affinity(const CpuList& cpus) { io_thread_affinity_ = cpus; }
+
+  unsigned io_spin_time_us() const { return io_spin_time_us_; }
+
+  void set_io_spin_time_us(unsigned spin_time_us) { io_spin_time_us_ = spin_time_us; }
+
+  bool use_io_uring() const { return use_io_uring_; }
+
+  void set_use_io_uring(bool use_io_uring) { use_io_uring_ = use_io_uring; }
+
   unsigned queue_size_io() const { return queue_size_io_; }
 
   void set_queue_size_io(unsigned queue_size) { queue_size_io_ = queue_size; }
@@ -254,6 +273,10 @@ public:
     default_profile_.set_latency_aware_routing_settings(settings);
   }
 
+  void set_load_aware_routing(bool is_load_aware, bool use_latency) {
+    default_profile_.set_load_aware_routing(is_load_aware, use_latency);
+  }
+
   bool tcp_nodelay_enable() const { return tcp_nodelay_enable_; }
 
   void set_tcp_nodelay(bool enable) { tcp_nodelay_enable_ = enable; }
@@ -294,6 +317,19 @@ public:
   bool use_schema() const { return use_schema_; }
   void set_use_schema(bool enable) { use_schema_ = enable; }
 
+  unsigned schema_event_debounce_window_ms() const { return schema_event_debounce_window_ms_; }
+  void set_schema_event_debounce_window_ms(unsigned window_ms) {
+    schema_event_debounce_window_ms_ = window_ms;
+  }
+
+  unsigned topology_event_debounce_window_ms() const { return topology_event_debounce_window_ms_; }
+  void set_topology_event_debounce_window_ms(unsigned window_ms) {
+    topology_event_debounce_window_ms_ = window_ms;
+  }
+
+  const String& metadata_cache_file() const { return metadata_cache_file_; }
+  void set_metadata_cache_file(const String& path) { metadata_cache_file_ = path; }
+
   bool use_hostname_resolution() const { return use_hostname_resolution_; }
   void set_use_hostname_resolution(bool enable) { use_hostname_resolution_ = enable; }
 
@@ -325,6 +361,18 @@ public:
 
   void set_prepare_on_up_or_add_host(bool enabled) { prepare_on_up_or_add_host_ = enabled; }
 
+  unsigned prepare_on_up_or_add_host_concurrency() const {
+    return prepare_on_up_or_add_host_concurrency_;
+  }
+
+  void set_prepare_on_up_or_add_host_concurrency(unsigned concurrency) {
+    prepare_on_up_or_add_host_concurrency_ = concurrency;
+  }
+
+  unsigned max_prepared_statements() const { return max_prepared_statements_; }
+
+  void set_max_prepared_statements(unsigned max_entries) { max_prepared_statements_ = max_entries; }
+
   const Address& local_address() const { return local_address_; }
 
   void set_local_address(const Address& address) { local_address_ = address; }
@@ -410,6 +458,9 @@ private:
   bool use_beta_protocol_version_;
   AddressVec contact_points_;
   unsigned thread_count_io_;
+  CpuList io_thread_affinity_;
+  unsigned io_spin_time_us_;
+  bool use_io_uring_;
   unsigned queue_size_io_;
   unsigned core_connections_per_host_;
   SharedRefPtr<ReconnectionPolicy> reconnection_policy_;
@@ -433,6 +484,9 @@ private:
   unsigned connection_heartbeat_interval_secs_;
   SharedRefPtr<TimestampGenerator> timestamp_gen_;
   bool use_schema_;
+  unsigned schema_event_debounce_window_ms_;
+  unsigned topology_event_debounce_window_ms_;
+  String metadata_cache_file_;
   bool use_hostname_resolution_;
   bool use_randomized_contact_points_;
   unsigned max_reusable_write_objects_;
@@ -440,6 +494,8 @@ private:
   ExecutionProfile::Map profiles_;
   bool prepare_on_all_hosts_;
   bool prepare_on_up_or_add_host_;
+  unsigned prepare_on_up_or_add_host_concurrency_;
+  unsigned max_prepared_statements_;
   Address local_address_;
   bool no_compact_;
   String application_name_;
@@ -75,7 +75,7 @@ static NopConnectionListener nop_listener__;
 
 void ConnectionHandler::on_read(Socket* socket, ssize_t nread, const uv_buf_t* buf) {
   connection_->on_read(buf->base, nread);
-  free_buffer(buf);
+  free_buffer(nread, buf);
 }
 
 void ConnectionHandler::on_write(Socket* socket, int status, SocketRequest* request) {
@@ -110,6 +110,7 @@ Connection::Connection(const Socket::Ptr& socket, const Host::Ptr& host,
     : socket_(socket)
     , host_(host)
     , inflight_request_count_(0)
+    , result_chunk_request_count_(0)
     , response_(new ResponseMessage())
     , listener_(&nop_listener__)
     , protocol_version_(protocol_version)
@@ -143,6 +144,9 @@ int32_t Connection::write(const RequestCallback::Ptr& callback) {
 
   // Add to the inflight count after we've cleared all posssible errors.
   inflight_request_count_.fetch_add(1);
+  if (callback->request()->result_chunk_callback()) {
+    result_chunk_request_count_++;
+  }
 
   LOG_TRACE("Sending message type %s with stream %d on host %s",
             opcode_to_string(callback->request()->opcode()).c_str(), stream,
@@ -185,6 +189,15 @@ void Connection::maybe_set_keyspace(ResponseMessage* response) {
   }
 }
 
+// Release the stream of a request that's no longer in-flight
+void Connection::release(RequestCallback* callback) {
+  stream_manager_.release(callback->stream());
+  inflight_request_count_.fetch_sub(1);
+  if (callback->request()->result_chunk_callback()) {
+    result_chunk_request_count_--;
+  }
+}
+
 void Connection::on_write(int status, RequestCallback* request) {
   listener_->on_write();
 
@@ -203,16 +216,14 @@ void Connection::on_write(int status, RequestCallback* request) {
         callback->set_state(RequestCallback::REQUEST_STATE_READING);
         pending_reads_.add_to_back(request);
       } else {
-        stream_manager_.release(callback->stream());
-        inflight_request_count_.fetch_sub(1);
+        release(callback.get());
         callback->set_state(RequestCallback::REQUEST_STATE_FINISHED);
         callback->on_error(CASS_ERROR_LIB_WRITE_ERROR, "Unable to write to socket");
       }
       break;
 
     case RequestCallback::REQUEST_STATE_READ_BEFORE_WRITE:
-      stream_manager_.release(callback->stream());
-      inflight_request_count_.fetch_sub(1);
+      release(callback.get());
       // The read callback happened before the write callback
       // returned. This is now responsible for finishing the request.
       callback->set_state(RequestCallback::REQUEST_STATE_FINISHED);
@@ -239,6 +250,8 @@ void Connection::on_read(const char* buf, size_t size) {
   restart_terminate_timer();
 
   while (remaining != 0 && !socket_->is_closing()) {
+    // Only stop after the header of a result if it could be streamed
+    response_->set_stream_results(result_chunk_request_count_ > 0);
     ssize_t consumed = response_->decode(pos, remaining);
     if (consumed <= 0) {
       LOG_ERROR("Error decoding/consuming message");
@@ -246,6 +259,16 @@ void Connection::on_read(const char* buf, size_t size) {
       continue;
     }
 
+    if (result_chunk_request_count_ > 0 && response_->is_result_body_pending()) {
+      // Decode the rows of the result as they're received if the request
+      // has a result chunk callback.
+      RequestCallback::Ptr callback;
+      if (stream_manager_.get(response_->stream(), callback) &&
+          callback->request()->result_chunk_callback()) {
+        response_->stream_result(callback);
+      }
+    }
+
     if (response_->is_body_ready()) {
       ScopedPtr<ResponseMessage> response(response_.release());
       response_.reset(new ResponseMessage());
@@ -271,8 +294,7 @@ void Connection::on_read(const char* buf, size_t size) {
           switch (callback->state()) {
             case RequestCallback::REQUEST_STATE_READING:
               pending_reads_.remove(callback.get());
-              stream_manager_.release(callback->stream());
-              inflight_request_count_.fetch_sub(1);
+              release(callback.get());
               callback->set_state(RequestCallback::REQUEST_STATE_FINISHED);
               maybe_set_keyspace(response.get());
               callback->on_set(response.get());
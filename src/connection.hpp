@@ -217,6 +217,7 @@ public:
 
 private:
   void maybe_set_keyspace(ResponseMessage* response);
+  void release(RequestCallback* callback);
 
   void on_write(int status, RequestCallback* request);
   void on_read(const char* buf, size_t size);
@@ -234,6 +235,7 @@ private:
   const Host::Ptr host_;
   StreamManager<RequestCallback::Ptr> stream_manager_;
   Atomic<int> inflight_request_count_;
+  int result_chunk_request_count_; // In-flight requests with a result chunk callback
 
   List<SocketRequest> pending_reads_;
   ScopedPtr<ResponseMessage> response_;
@@ -77,6 +77,24 @@ bool ConnectionPoolManager::has_connections(const Address& address) const {
   return it != pools_.end() && it->second->has_connections();
 }
 
+RequestCallback::Ptr
+ConnectionPoolManager::find_pending_prepare(const PendingPrepareKey& key) const {
+  Map<PendingPrepareKey, RequestCallback::Ptr>::const_iterator it = pending_prepares_.find(key);
+  if (it != pending_prepares_.end()) {
+    return it->second;
+  }
+  return RequestCallback::Ptr();
+}
+
+void ConnectionPoolManager::add_pending_prepare(const PendingPrepareKey& key,
+                                                const RequestCallback::Ptr& callback) {
+  pending_prepares_[key] = callback;
+}
+
+void ConnectionPoolManager::remove_pending_prepare(const PendingPrepareKey& key) {
+  pending_prepares_.erase(key);
+}
+
 void ConnectionPoolManager::flush() {
   for (DenseHashSet<ConnectionPool*>::const_iterator it = to_flush_.begin(), end = to_flush_.end();
        it != end; ++it) {
@@ -24,8 +24,11 @@
 #include "connection_pool.hpp"
 #include "connection_pool_connector.hpp"
 #include "histogram_wrapper.hpp"
+#include "map.hpp"
 #include "ref_counted.hpp"
+#include "request_callback.hpp"
 #include "string.hpp"
+#include "string_ref.hpp"
 
 #include <uv.h>
 
@@ -54,6 +57,23 @@ public:
   virtual void on_close(ConnectionPoolManager* manager) = 0;
 };
 
+/**
+ * Identifies a statement being re-prepared on a host.
+ */
+struct PendingPrepareKey {
+  PendingPrepareKey(const Address& address, const StringRef& id)
+      : address(address)
+      , id(id.data(), id.size()) {}
+
+  bool operator<(const PendingPrepareKey& other) const {
+    if (address == other.address) return id < other.id;
+    return address < other.address;
+  }
+
+  Address address;
+  String id;
+};
+
 /**
  * A manager for one or more connection pools to different hosts.
  */
@@ -141,6 +161,32 @@ public:
    */
   void set_listener(ConnectionPoolManagerListener* listener = NULL);
 
+  /**
+   * Find the request that's re-preparing a statement on a host. This is used
+   * so that only a single request re-prepares a statement (per host) when many
+   * requests receive "unprepared" errors at the same time.
+   *
+   * @param key The address of the host and the prepared statement's ID.
+   * @return The in-flight PREPARE request's callback or null if the statement
+   * isn't being re-prepared.
+   */
+  RequestCallback::Ptr find_pending_prepare(const PendingPrepareKey& key) const;
+
+  /**
+   * Add an in-flight PREPARE request for a statement on a host.
+   *
+   * @param key The address of the host and the prepared statement's ID.
+   * @param callback The PREPARE request's callback.
+   */
+  void add_pending_prepare(const PendingPrepareKey& key, const RequestCallback::Ptr& callback);
+
+  /**
+   * Remove a completed PREPARE request for a statement on a host.
+   *
+   * @param key The address of the host and the prepared statement's ID.
+   */
+  void remove_pending_prepare(const PendingPrepareKey& key);
+
 public:
   uv_loop_t* loop() const { return loop_; }
   ProtocolVersion protocol_version() const { return protocol_version_; }
@@ -196,6 +242,7 @@ private:
   ConnectionPool::Map pools_;
   ConnectionPoolConnector::Vec pending_pools_;
   DenseHashSet<ConnectionPool*> to_flush_;
+  Map<PendingPrepareKey, RequestCallback::Ptr> pending_prepares_;
 
   String keyspace_;
 
@@ -115,14 +115,17 @@
 #define CASS_DEFAULT_HOSTNAME_RESOLUTION_ENABLED false
 #define CASS_DEFAULT_IDLE_TIMEOUT_SECS 60
 #define CASS_DEFAULT_LOG_LEVEL CASS_LOG_WARN
-#define CASS_DEFAULT_MAX_PREPARES_PER_FLUSH 128
+#define CASS_DEFAULT_MAX_PREPARED_STATEMENTS 10000
 #define CASS_DEFAULT_MAX_REUSABLE_WRITE_OBJECTS UINT_MAX
 #define CASS_DEFAULT_MAX_SCHEMA_WAIT_TIME_MS 10000
 #define CASS_DEFAULT_NUM_CONNECTIONS_PER_HOST 1
 #define CASS_DEFAULT_PREPARE_ON_ALL_HOSTS true
 #define CASS_DEFAULT_PREPARE_ON_UP_OR_ADD_HOST true
+#define CASS_DEFAULT_PREPARE_ON_UP_OR_ADD_HOST_CONCURRENCY 128
 #define CASS_DEFAULT_PORT 9042
 #define CASS_DEFAULT_QUEUE_SIZE_IO 8192
+#define CASS_DEFAULT_IO_SPIN_TIME_US 0 // Disabled
+#define CASS_DEFAULT_USE_IO_URING false
 #define CASS_DEFAULT_CONSTANT_RECONNECT_WAIT_TIME_MS 2000u
 #define CASS_DEFAULT_EXPONENTIAL_RECONNECT_BASE_DELAY_MS \
   CASS_DEFAULT_CONSTANT_RECONNECT_WAIT_TIME_MS
@@ -137,6 +140,8 @@
 #define CASS_DEFAULT_USE_BETA_PROTOCOL_VERSION false
 #define CASS_DEFAULT_USE_RANDOMIZED_CONTACT_POINTS true
 #define CASS_DEFAULT_USE_SCHEMA true
+#define CASS_DEFAULT_SCHEMA_EVENT_DEBOUNCE_WINDOW_MS 0
+#define CASS_DEFAULT_TOPOLOGY_EVENT_DEBOUNCE_WINDOW_MS 0
 #define CASS_DEFAULT_COALESCE_DELAY 200
 #define CASS_DEFAULT_NEW_REQUEST_RATIO 50
 #define CASS_DEFAULT_NO_COMPACT false
@@ -150,6 +155,9 @@
 #define CASS_DEFAULT_CONSISTENCY CASS_CONSISTENCY_LOCAL_ONE
 #define CASS_DEFAULT_REQUEST_TIMEOUT_MS 12000u
 #define CASS_DEFAULT_SERIAL_CONSISTENCY CASS_CONSISTENCY_ANY
+#define CASS_DEFAULT_SCAN_PAGE_SIZE 5000
+#define CASS_DEFAULT_SPECULATIVE_EXECUTION_WINDOW_MS 1000
+#define CASS_DEFAULT_SPECULATIVE_EXECUTION_MIN_SAMPLES 100
 
 // Client monitoring defaults
 #define CASS_DEFAULT_CLIENT_MONITOR_EVENTS_INTERVAL_SECS 300
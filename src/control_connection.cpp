@@ -25,6 +25,7 @@
 #include "load_balancing.hpp"
 #include "logger.hpp"
 #include "metadata.hpp"
+#include "metrics.hpp"
 #include "query_request.hpp"
 #include "result_iterator.hpp"
 #include "result_response.hpp"
@@ -174,6 +175,29 @@ public:
   const bool is_all_peers;
 };
 
+/**
+ * A specialized request callback for handling multiple node changes using a
+ * single query of the "system.peers" table. This is used when topology events
+ * are debounced.
+ */
+class RefreshNodesCallback : public ControlRequestCallback {
+public:
+  /**
+   * Constructor.
+   *
+   * @param nodes The addresses of the hosts that changed and their type of
+   * change.
+   * @param query The query to run for the node changes.
+   * @param control_connection The control connection the query is run on.
+   */
+  RefreshNodesCallback(const ControlConnection::PendingNodeMap& nodes, const String& query,
+                       ControlConnection* control_connection)
+      : ControlRequestCallback(query, control_connection, ControlConnection::on_refresh_nodes)
+      , nodes(nodes) {}
+
+  const ControlConnection::PendingNodeMap nodes;
+};
+
 /**
  * A specialized request callback for keyspace queries. This is needed for
  * keyspace change events.
@@ -309,18 +333,25 @@ static NopControlConnectionListener nop_listener__;
 ControlConnectionSettings::ControlConnectionSettings()
     : use_schema(CASS_DEFAULT_USE_SCHEMA)
     , use_token_aware_routing(CASS_DEFAULT_USE_TOKEN_AWARE_ROUTING)
+    , schema_event_debounce_window_ms(CASS_DEFAULT_SCHEMA_EVENT_DEBOUNCE_WINDOW_MS)
+    , topology_event_debounce_window_ms(CASS_DEFAULT_TOPOLOGY_EVENT_DEBOUNCE_WINDOW_MS)
     , address_factory(new AddressFactory()) {}
 
 ControlConnectionSettings::ControlConnectionSettings(const Config& config)
     : connection_settings(config)
     , use_schema(config.use_schema())
     , use_token_aware_routing(config.token_aware_routing())
+    , schema_event_debounce_window_ms(config.schema_event_debounce_window_ms())
+    , topology_event_debounce_window_ms(config.topology_event_debounce_window_ms())
+    , metadata_cache_file(config.metadata_cache_file())
     , address_factory(create_address_factory_from_config(config)) {}
 
 ControlConnector::ControlConnector(const Host::Ptr& host, ProtocolVersion protocol_version,
                                    const Callback& callback)
     : connector_(
           new Connector(host, protocol_version, bind_callback(&ControlConnector::on_connect, this)))
+    , is_schema_from_cache_(false)
+    , is_schema_unchanged_(false)
     , callback_(callback)
     , error_code_(CONTROL_CONNECTION_OK)
     , listener_(NULL)
@@ -331,13 +362,16 @@ ControlConnection::ControlConnection(const Connection::Ptr& connection,
                                      const ControlConnectionSettings& settings,
                                      const VersionNumber& server_version,
                                      const VersionNumber& dse_server_version,
-                                     ListenAddressMap listen_addresses)
+                                     ListenAddressMap listen_addresses, Metrics* metrics)
     : connection_(connection)
     , settings_(settings)
     , server_version_(server_version)
     , dse_server_version_(dse_server_version)
     , listen_addresses_(listen_addresses)
-    , listener_(listener ? listener : &nop_listener__) {
+    , listener_(listener ? listener : &nop_listener__)
+    , metrics_(metrics)
+    , pending_topology_event_count_(0)
+    , pending_schema_event_count_(0) {
   connection_->set_listener(this);
   inc_ref();
 }
@@ -414,16 +448,65 @@ void ControlConnection::handle_refresh_node(RefreshNodeCallback* callback) {
     LOG_ERROR("No row found for host %s in %s's peers system table. "
               "%s will be ignored.",
               address_str.c_str(), address_string().c_str(), address_str.c_str());
-    return;
+  } else {
+    update_node(callback->type, row);
   }
 
+  finish_refreshing_node(callback->address);
+}
+
+void ControlConnection::refresh_nodes(const PendingNodeMap& nodes) {
+  LOG_DEBUG("Refresh %u nodes: %s", static_cast<unsigned>(nodes.size()), SELECT_PEERS);
+
+  RequestCallback::Ptr callback(new RefreshNodesCallback(nodes, SELECT_PEERS, this));
+  if (write_and_flush(callback) < 0) {
+    LOG_ERROR("No more stream available while attempting to refresh nodes info");
+    defunct();
+  }
+}
+
+void ControlConnection::on_refresh_nodes(ControlRequestCallback* callback) {
+  RefreshNodesCallback* refresh_callback = static_cast<RefreshNodesCallback*>(callback);
+  refresh_callback->control_connection()->handle_refresh_nodes(refresh_callback);
+}
+
+void ControlConnection::handle_refresh_nodes(RefreshNodesCallback* callback) {
+  PendingNodeMap remaining(callback->nodes);
+  ResultIterator rows(callback->result().get());
+
+  while (!remaining.empty() && rows.next()) {
+    const Row* row = rows.row();
+    for (PendingNodeMap::iterator it = remaining.begin(), end = remaining.end(); it != end; ++it) {
+      if (settings_.address_factory->is_peer(row, connection_->host(), it->first)) {
+        update_node(it->second, row);
+        remaining.erase(it);
+        break;
+      }
+    }
+  }
+
+  for (PendingNodeMap::const_iterator it = remaining.begin(), end = remaining.end(); it != end;
+       ++it) {
+    String address_str = it->first.to_string();
+    LOG_ERROR("No row found for host %s in %s's peers system table. "
+              "%s will be ignored.",
+              address_str.c_str(), address_string().c_str(), address_str.c_str());
+  }
+
+  for (PendingNodeMap::const_iterator it = callback->nodes.begin(), end = callback->nodes.end();
+       it != end; ++it) {
+    finish_refreshing_node(it->first);
+  }
+}
+
+void ControlConnection::update_node(RefreshNodeType type, const Row* row) {
   Address address;
   if (settings_.address_factory->create(row, connection_->host(), &address)) {
     Host::Ptr host(new Host(address));
     host->set(row, settings_.use_token_aware_routing);
     listen_addresses_[host->rpc_address()] = determine_listen_address(address, row);
 
-    switch (callback->type) {
+    switch (type) {
       case NEW_NODE:
         listener_->on_add(host);
         break;
@@ -435,6 +518,24 @@ void ControlConnection::handle_refresh_node(RefreshNodeCallback* callback) {
   }
 }
 
+void ControlConnection::update_status(const Address& address, bool is_up) {
+  if (is_up) {
+    listener_->on_up(address);
+  } else {
+    listener_->on_down(address);
+  }
+}
+
+void ControlConnection::finish_refreshing_node(const Address& address) {
+  RefreshingNodeMap::iterator it = refreshing_nodes_.find(address);
+  if (it == refreshing_nodes_.end() || --it->second.refresh_count > 0) return;
+  RefreshingNode node(it->second);
+  refreshing_nodes_.erase(it);
+  if (node.has_status) {
+    update_status(address, node.is_up);
+  }
+}
+
 void ControlConnection::refresh_keyspace(const StringRef& keyspace_name) {
   String query;
 
@@ -472,6 +573,8 @@ void ControlConnection::handle_refresh_keyspace(RefreshKeyspaceCallback* callbac
   listener_->on_update_schema(ControlConnectionListener::KEYSPACE, result, callback->keyspace_name);
 }
 
+// Refreshes a single table or view. If the name is empty then all the tables
+// and views in the keyspace are refreshed.
 void ControlConnection::refresh_table_or_view(const StringRef& keyspace_name,
                                               const StringRef& table_or_view_name) {
   String table_query;
@@ -479,51 +582,38 @@ void ControlConnection::refresh_table_or_view(const StringRef& keyspace_name,
   String column_query;
   String index_query;
 
+  String keyspace_predicate(" WHERE keyspace_name='");
+  keyspace_predicate.append(keyspace_name.data(), keyspace_name.size()).append("'");
+
+  String name_predicate;
+  if (!table_or_view_name.empty()) {
+    name_predicate.append("='").append(table_or_view_name.data(), table_or_view_name.size());
+    name_predicate.append("'");
+  }
+
   if (server_version_ >= VersionNumber(3, 0, 0)) {
-    table_query.assign(SELECT_TABLES_30);
-    table_query.append(" WHERE keyspace_name='")
-        .append(keyspace_name.data(), keyspace_name.size())
-        .append("' AND table_name='")
-        .append(table_or_view_name.data(), table_or_view_name.size())
-        .append("'");
-
-    view_query.assign(SELECT_VIEWS_30);
-    view_query.append(" WHERE keyspace_name='")
-        .append(keyspace_name.data(), keyspace_name.size())
-        .append("' AND view_name='")
-        .append(table_or_view_name.data(), table_or_view_name.size())
-        .append("'");
-
-    column_query.assign(SELECT_COLUMNS_30);
-    column_query.append(" WHERE keyspace_name='")
-        .append(keyspace_name.data(), keyspace_name.size())
-        .append("' AND table_name='")
-        .append(table_or_view_name.data(), table_or_view_name.size())
-        .append("'");
-
-    index_query.assign(SELECT_INDEXES_30);
-    index_query.append(" WHERE keyspace_name='")
-        .append(keyspace_name.data(), keyspace_name.size())
-        .append("' AND table_name='")
-        .append(table_or_view_name.data(), table_or_view_name.size())
-        .append("'");
+    table_query.assign(SELECT_TABLES_30).append(keyspace_predicate);
+    view_query.assign(SELECT_VIEWS_30).append(keyspace_predicate);
+    column_query.assign(SELECT_COLUMNS_30).append(keyspace_predicate);
+    index_query.assign(SELECT_INDEXES_30).append(keyspace_predicate);
+
+    if (!name_predicate.empty()) {
+      table_query.append(" AND table_name").append(name_predicate);
+      view_query.append(" AND view_name").append(name_predicate);
+      column_query.append(" AND table_name").append(name_predicate);
+      index_query.append(" AND table_name").append(name_predicate);
+    }
 
     LOG_DEBUG("Refreshing table/view %s; %s; %s; %s", table_query.c_str(), view_query.c_str(),
               column_query.c_str(), index_query.c_str());
   } else {
-    table_query.assign(SELECT_COLUMN_FAMILIES_20);
-    table_query.append(" WHERE keyspace_name='")
-        .append(keyspace_name.data(), keyspace_name.size())
-        .append("' AND columnfamily_name='")
-        .append(table_or_view_name.data(), table_or_view_name.size())
-        .append("'");
-
-    column_query.assign(SELECT_COLUMNS_20);
-    column_query.append(" WHERE keyspace_name='")
-        .append(keyspace_name.data(), keyspace_name.size())
-        .append("' AND columnfamily_name='")
-        .append(table_or_view_name.data(), table_or_view_name.size())
-        .append("'");
+    table_query.assign(SELECT_COLUMN_FAMILIES_20).append(keyspace_predicate);
+    column_query.assign(SELECT_COLUMNS_20).append(keyspace_predicate);
+
+    if (!name_predicate.empty()) {
+      table_query.append(" AND columnfamily_name").append(name_predicate);
+      column_query.append(" AND columnfamily_name").append(name_predicate);
+    }
 
     LOG_DEBUG("Refreshing table %s; %s", table_query.c_str(), column_query.c_str());
   }
@@ -553,7 +643,17 @@ void ControlConnection::on_refresh_table_or_view(ChainedControlRequestCallback*
 
 void ControlConnection::handle_refresh_table_or_view(RefreshTableCallback* callback) {
   ResultResponse::Ptr tables_result(callback->result("tables"));
-  if (!tables_result || tables_result->row_count() == 0) {
+  if (callback->table_or_view_name.empty()) { // All the keyspace's tables and views
+    ResultResponse::Ptr views_result(callback->result("views"));
+    if (tables_result && tables_result->row_count() > 0) {
+      listener_->on_update_schema(ControlConnectionListener::TABLE, tables_result,
+                                  callback->keyspace_name, callback->table_or_view_name);
+    }
+    if (views_result && views_result->row_count() > 0) {
+      listener_->on_update_schema(ControlConnectionListener::VIEW, views_result,
+                                  callback->keyspace_name, callback->table_or_view_name);
+    }
+  } else if (!tables_result || tables_result->row_count() == 0) {
     ResultResponse::Ptr views_result(callback->result("views"));
     if (!views_result || views_result->row_count() == 0) {
       LOG_ERROR("No row found for table (or view) %s.%s in system schema tables.",
@@ -590,9 +690,10 @@ void ControlConnection::refresh_type(const StringRef& keyspace_name, const Strin
 
   query.append(" WHERE keyspace_name='")
       .append(keyspace_name.data(), keyspace_name.size())
-      .append("' AND type_name='")
-      .append(type_name.data(), type_name.size())
       .append("'");
+  if (!type_name.empty()) { // Otherwise, refresh all the keyspace's types
+    query.append(" AND type_name='").append(type_name.data(), type_name.size()).append("'");
+  }
 
   LOG_DEBUG("Refreshing type %s", query.c_str());
 
@@ -612,6 +713,7 @@ void ControlConnection::on_refresh_type(ControlRequestCallback* callback) {
 void ControlConnection::handle_refresh_type(RefreshTypeCallback* callback) {
   const ResultResponse::Ptr result = callback->result();
   if (result->row_count() == 0) {
+    if (callback->type_name.empty()) return;
     LOG_ERROR("No row found for keyspace %s and type %s in system schema.",
               callback->keyspace_name.c_str(), callback->type_name.c_str());
     return;
@@ -687,49 +789,205 @@ void ControlConnection::handle_refresh_function(RefreshFunctionCallback* callbac
       Metadata::full_function_name(callback->function_name, callback->arg_types));
 }
 
+void ControlConnection::debounce_topology_event() {
+  ++pending_topology_event_count_;
+  if (!topology_event_timer_.is_running()) {
+    topology_event_timer_.start(
+        loop(), settings_.topology_event_debounce_window_ms,
+        bind_callback(&ControlConnection::on_topology_event_timeout, this));
+  }
+}
+
+void ControlConnection::on_topology_event_timeout(Timer* timer) {
+  PendingNodeMap nodes;
+  PendingStatusMap statuses;
+  nodes.swap(pending_nodes_);
+  statuses.swap(pending_statuses_);
+
+  uint64_t refresh_count = 0;
+
+  // The connected host isn't in the peers table so it's always refreshed
+  // separately.
+  PendingNodeMap peers;
+  for (PendingNodeMap::const_iterator it = nodes.begin(), end = nodes.end(); it != end; ++it) {
+    refreshing_nodes_[it->first].refresh_count++;
+    if (connection_->host()->rpc_address().equals(it->first, false)) {
+      refresh_node(it->second, it->first);
+      ++refresh_count;
+    } else {
+      peers.insert(*it);
+    }
+  }
+
+  if (peers.size() == 1) {
+    refresh_node(peers.begin()->second, peers.begin()->first);
+    ++refresh_count;
+  } else if (peers.size() > 1) {
+    refresh_nodes(peers);
+    ++refresh_count;
+  }
+
+  // A node's status is applied after its refresh completes, including a
+  // refresh started in a previous debounce window, otherwise the listener
+  // would ignore the status of a node it doesn't know about yet.
+  for (PendingStatusMap::const_iterator it = statuses.begin(), end = statuses.end(); it != end;
+       ++it) {
+    RefreshingNodeMap::iterator refreshing = refreshing_nodes_.find(it->first);
+    if (refreshing != refreshing_nodes_.end()) {
+      refreshing->second.has_status = true;
+      refreshing->second.is_up = it->second;
+    } else {
+      update_status(it->first, it->second);
+    }
+    ++refresh_count;
+  }
+
+  LOG_DEBUG("Handled %u debounced topology and status events using %u updates",
+            static_cast<unsigned>(pending_topology_event_count_),
+            static_cast<unsigned>(refresh_count));
+  if (metrics_ && pending_topology_event_count_ > refresh_count) {
+    metrics_->coalesced_topology_events.inc(pending_topology_event_count_ - refresh_count);
+  }
+  pending_topology_event_count_ = 0;
+}
+
+void ControlConnection::debounce_schema_event() {
+  ++pending_schema_event_count_;
+  if (!schema_event_timer_.is_running()) {
+    schema_event_timer_.start(loop(), settings_.schema_event_debounce_window_ms,
+                              bind_callback(&ControlConnection::on_schema_event_timeout, this));
+  }
+}
+
+void ControlConnection::on_schema_event_timeout(Timer* timer) {
+  PendingSchemaMap schemas;
+  schemas.swap(pending_schemas_);
+
+  uint64_t refresh_count = 0;
+
+  for (PendingSchemaMap::const_iterator it = schemas.begin(), end = schemas.end(); it != end;
+       ++it) {
+    const String& keyspace_name = it->first;
+    const PendingSchema& pending = it->second;
+
+    if (pending.is_keyspace_changed) {
+      refresh_keyspace(keyspace_name);
+      ++refresh_count;
+    }
+
+    // Multiple changes are handled by refreshing all the keyspace's tables (or
+    // types) using a single set of queries.
+    if (pending.tables_or_views.size() == 1) {
+      refresh_table_or_view(keyspace_name, *pending.tables_or_views.begin());
+      ++refresh_count;
+    } else if (pending.tables_or_views.size() > 1) {
+      refresh_table_or_view(keyspace_name, StringRef());
+      ++refresh_count;
+    }
+
+    if (pending.types.size() == 1) {
+      refresh_type(keyspace_name, *pending.types.begin());
+      ++refresh_count;
+    } else if (pending.types.size() > 1) {
+      refresh_type(keyspace_name, StringRef());
+      ++refresh_count;
+    }
+
+    for (Map<String, PendingFunction>::const_iterator i = pending.functions.begin(),
+                                                      end = pending.functions.end();
+         i != end; ++i) {
+      const PendingFunction& function = i->second;
+      StringRefVec arg_types(function.arg_types.begin(), function.arg_types.end());
+      refresh_function(keyspace_name, function.function_name, arg_types, function.is_aggregate);
+      ++refresh_count;
+    }
+  }
+
+  LOG_DEBUG("Handled %u debounced schema events using %u refreshes",
+            static_cast<unsigned>(pending_schema_event_count_),
+            static_cast<unsigned>(refresh_count));
+  if (metrics_ && pending_schema_event_count_ > refresh_count) {
+    metrics_->coalesced_schema_events.inc(pending_schema_event_count_ - refresh_count);
+  }
+  pending_schema_event_count_ = 0;
+}
+
 void ControlConnection::on_close(Connection* connection) {
+  // Pending events are dropped; the metadata is fully refreshed when the
+  // control connection is re-established.
+  topology_event_timer_.stop();
+  schema_event_timer_.stop();
   listener_->on_close(this);
   dec_ref();
 }
 
 void ControlConnection::on_event(const EventResponse::Ptr& response) {
+  bool is_topology_debounced = settings_.topology_event_debounce_window_ms > 0;
+  bool is_schema_debounced = settings_.schema_event_debounce_window_ms > 0;
+
   switch (response->event_type()) {
     case CASS_EVENT_TOPOLOGY_CHANGE: {
-      String address_str = response->affected_node().to_string();
+      const Address& address = response->affected_node();
+      String address_str = address.to_string();
       switch (response->topology_change()) {
         case EventResponse::NEW_NODE: {
           LOG_INFO("New node %s added event", address_str.c_str());
-          refresh_node(NEW_NODE, response->affected_node());
+          if (is_topology_debounced) {
+            pending_nodes_[address] = NEW_NODE;
+            debounce_topology_event();
+          } else {
+            refresh_node(NEW_NODE, address);
+          }
           break;
         }
 
         case EventResponse::REMOVED_NODE: {
           LOG_INFO("Node %s removed event", address_str.c_str());
-          listen_addresses_.erase(response->affected_node());
-          listener_->on_remove(response->affected_node());
+          pending_nodes_.erase(address);
+          pending_statuses_.erase(address);
+          refreshing_nodes_.erase(address);
+          listen_addresses_.erase(address);
+          listener_->on_remove(address);
           break;
         }
 
         case EventResponse::MOVED_NODE:
           LOG_INFO("Node %s moved event", address_str.c_str());
-          refresh_node(MOVED_NODE, response->affected_node());
+          if (is_topology_debounced) {
+            // A pending new node is added with its moved location
+            pending_nodes_.insert(PendingNodeMap::value_type(address, MOVED_NODE));
+            debounce_topology_event();
+          } else {
+            refresh_node(MOVED_NODE, address);
+          }
           break;
       }
       break;
     }
 
     case CASS_EVENT_STATUS_CHANGE: {
-      String address_str = response->affected_node().to_string();
+      const Address& address = response->affected_node();
+      String address_str = address.to_string();
       switch (response->status_change()) {
         case EventResponse::UP: {
           LOG_DEBUG("Node %s is up event", address_str.c_str());
-          listener_->on_up(response->affected_node());
+          if (is_topology_debounced) {
+            pending_statuses_[address] = true;
+            debounce_topology_event();
+          } else {
+            listener_->on_up(address);
+          }
           break;
         }
 
         case EventResponse::DOWN: {
           LOG_DEBUG("Node %s is down event", address_str.c_str());
-          listener_->on_down(response->affected_node());
+          if (is_topology_debounced) {
+            pending_statuses_[address] = false;
+            debounce_topology_event();
+          } else {
+            listener_->on_down(address);
+          }
           break;
         }
       }
@@ -749,6 +1007,34 @@ void ControlConnection::on_event(const EventResponse::Ptr& response) {
       switch (response->schema_change()) {
         case EventResponse::CREATED:
         case EventResponse::UPDATED:
+          if (is_schema_debounced) {
+            PendingSchema& pending = pending_schemas_[response->keyspace().to_string()];
+            switch (response->schema_change_target()) {
+              case EventResponse::KEYSPACE:
+                pending.is_keyspace_changed = true;
+                break;
+              case EventResponse::TABLE:
+                pending.tables_or_views.insert(response->target().to_string());
+                break;
+              case EventResponse::TYPE:
+                pending.types.insert(response->target().to_string());
+                break;
+              case EventResponse::FUNCTION:
+              case EventResponse::AGGREGATE: {
+                PendingFunction& function =
+                    pending.functions[Metadata::full_function_name(
+                        response->target().to_string(), to_strings(response->arg_types()))];
+                function.function_name = response->target().to_string();
+                function.arg_types = to_strings(response->arg_types());
+                function.is_aggregate =
+                    response->schema_change_target() == EventResponse::AGGREGATE;
+                break;
+              }
+            }
+            debounce_schema_event();
+            break;
+          }
+
           switch (response->schema_change_target()) {
             case EventResponse::KEYSPACE:
               refresh_keyspace(response->keyspace());
@@ -767,37 +1053,50 @@ void ControlConnection::on_event(const EventResponse::Ptr& response) {
           }
           break;
 
-        case EventResponse::DROPPED:
+        case EventResponse::DROPPED: {
+          // Pending refreshes of dropped objects are no longer needed
+          PendingSchemaMap::iterator pending =
+              pending_schemas_.find(response->keyspace().to_string());
+
           switch (response->schema_change_target()) {
             case EventResponse::KEYSPACE:
+              if (pending != pending_schemas_.end()) pending_schemas_.erase(pending);
               listener_->on_drop_schema(ControlConnectionListener::KEYSPACE,
                                         response->keyspace().to_string(),
                                         response->target().to_string());
               break;
             case EventResponse::TABLE:
+              if (pending != pending_schemas_.end()) {
+                pending->second.tables_or_views.erase(response->target().to_string());
+              }
               listener_->on_drop_schema(ControlConnectionListener::TABLE,
                                         response->keyspace().to_string(),
                                         response->target().to_string());
               break;
             case EventResponse::TYPE:
+              if (pending != pending_schemas_.end()) {
+                pending->second.types.erase(response->target().to_string());
+              }
               listener_->on_drop_schema(ControlConnectionListener::USER_TYPE,
                                         response->keyspace().to_string(),
                                         response->target().to_string());
               break;
             case EventResponse::FUNCTION:
-              listener_->on_drop_schema(
-                  ControlConnectionListener::FUNCTION, response->keyspace().to_string(),
-                  Metadata::full_function_name(response->target().to_string(),
-                                               to_strings(response->arg_types())));
-              break;
-            case EventResponse::AGGREGATE:
-              listener_->on_drop_schema(
-                  ControlConnectionListener::AGGREGATE, response->keyspace().to_string(),
-                  Metadata::full_function_name(response->target().to_string(),
-                                               to_strings(response->arg_types())));
+            case EventResponse::AGGREGATE: {
+              String full_function_name(Metadata::full_function_name(
+                  response->target().to_string(), to_strings(response->arg_types())));
+              if (pending != pending_schemas_.end()) {
+                pending->second.functions.erase(full_function_name);
+              }
+              listener_->on_drop_schema(response->schema_change_target() == EventResponse::FUNCTION
+                                            ? ControlConnectionListener::FUNCTION
+                                            : ControlConnectionListener::AGGREGATE,
+                                        response->keyspace().to_string(), full_function_name);
               break;
+            }
           }
           break;
+        }
       }
       break;
 
@@ -28,9 +28,12 @@
 #include "host.hpp"
 #include "load_balancing.hpp"
 #include "macros.hpp"
+#include "map.hpp"
 #include "request_callback.hpp"
 #include "response.hpp"
 #include "scoped_ptr.hpp"
+#include "set.hpp"
+#include "timer.hpp"
 #include "token_map.hpp"
 
 #include <stdint.h>
@@ -61,10 +64,12 @@
 namespace datastax { namespace internal { namespace core {
 
 class ChainedControlRequestCallback;
+class Metrics;
 class ControlRequestCallback;
 class ControlConnection;
 class EventResponse;
 class RefreshNodeCallback;
+class RefreshNodesCallback;
 class RefreshKeyspaceCallback;
 class RefreshTableCallback;
 class RefreshTypeCallback;
@@ -184,6 +189,25 @@ struct ControlConnectionSettings {
    */
   bool use_token_aware_routing;
 
+  /**
+   * The amount of time (in milliseconds) to debounce schema events. Schema
+   * events received during the window are merged into the fewest number of
+   * refreshes. If zero then schema events are handled immediately.
+   */
+  unsigned schema_event_debounce_window_ms;
+
+  /**
+   * The amount of time (in milliseconds) to debounce topology and status
+   * events. If zero then topology and status events are handled immediately.
+   */
+  unsigned topology_event_debounce_window_ms;
+
+  /**
+   * The path of the file used to cache the schema metadata between connections
+   * (and runs of the application). If empty then the schema is always queried.
+   */
+  String metadata_cache_file;
+
   /**
    * A factory for creating addresses (for the connection process).
    */
@@ -213,10 +237,12 @@ public:
    * @param server_version The version number of the server implementation.
    * @param dse_server_version The version number of the DSE server implementation.
    * @param listen_addresses The current state of the listen addresses map.
+   * @param metrics The metrics object used to record coalesced events (can be NULL).
    */
   ControlConnection(const Connection::Ptr& connection, ControlConnectionListener* listener,
                     const ControlConnectionSettings& settings, const VersionNumber& server_version,
-                    const VersionNumber& dse_server_version, ListenAddressMap listen_addresses);
+                    const VersionNumber& dse_server_version, ListenAddressMap listen_addresses,
+                    Metrics* metrics);
 
   /**
    * Write a request and flush immediately.
@@ -259,20 +285,70 @@ public:
 
   uv_loop_t* loop() { return connection_->loop(); }
   const Connection::Ptr& connection() const { return connection_; }
+  Metrics* metrics() const { return metrics_; }
 
 private:
   friend class ControlConnector;
   friend class RefreshNodeCallback;
+  friend class RefreshNodesCallback;
   friend class RefreshKeyspaceCallback;
   friend class RefreshTableCallback;
   friend class RefreshTypeCallback;
   friend class RefreshFunctionCallback;
 
+private:
+  typedef Map<Address, RefreshNodeType> PendingNodeMap;
+  typedef Map<Address, bool> PendingStatusMap; // True if the node is up
+
+  // A node that's being refreshed because of debounced topology events. A
+  // status received for the node is only applied once its refreshes complete
+  // so the node is known by the listener when it's marked up or down.
+  struct RefreshingNode {
+    RefreshingNode()
+        : refresh_count(0)
+        , has_status(false)
+        , is_up(false) {}
+
+    unsigned refresh_count;
+    bool has_status;
+    bool is_up; // The most recent status
+  };
+
+  typedef Map<Address, RefreshingNode> RefreshingNodeMap;
+
+  struct PendingFunction {
+    String function_name;
+    Vector<String> arg_types;
+    bool is_aggregate;
+  };
+
+  // The schema refreshes for a keyspace that are waiting for the end of the
+  // debounce window.
+  struct PendingSchema {
+    PendingSchema()
+        : is_keyspace_changed(false) {}
+
+    bool is_keyspace_changed;
+    Set<String> tables_or_views;
+    Set<String> types;
+    Map<String, PendingFunction> functions; // Keyed by the full function name
+  };
+
+  typedef Map<String, PendingSchema> PendingSchemaMap;
+
 private:
   void refresh_node(RefreshNodeType type, const Address& address);
   static void on_refresh_node(ControlRequestCallback* callback);
   void handle_refresh_node(RefreshNodeCallback* callback);
 
+  void refresh_nodes(const PendingNodeMap& nodes);
+  static void on_refresh_nodes(ControlRequestCallback* callback);
+  void handle_refresh_nodes(RefreshNodesCallback* callback);
+
+  void update_node(RefreshNodeType type, const Row* row);
+  void update_status(const Address& address, bool is_up);
+  void finish_refreshing_node(const Address& address);
+
   void refresh_keyspace(const StringRef& keyspace_name);
   static void on_refresh_keyspace(ControlRequestCallback* callback);
   void handle_refresh_keyspace(RefreshKeyspaceCallback* callback);
@@ -290,6 +366,12 @@ private:
   static void on_refresh_function(ControlRequestCallback* callback);
   void handle_refresh_function(RefreshFunctionCallback* callback);
 
+  void debounce_topology_event();
+  void on_topology_event_timeout(Timer* timer);
+
+  void debounce_schema_event();
+  void on_schema_event_timeout(Timer* timer);
+
   // Connection listener methods
   virtual void on_close(Connection* connection);
   virtual void on_event(const EventResponse::Ptr& response);
@@ -301,6 +383,17 @@ private:
   VersionNumber dse_server_version_;
   ListenAddressMap listen_addresses_;
   ControlConnectionListener* listener_;
+  Metrics* const metrics_;
+
+  Timer topology_event_timer_;
+  PendingNodeMap pending_nodes_;
+  PendingStatusMap pending_statuses_;
+  RefreshingNodeMap refreshing_nodes_;
+  uint64_t pending_topology_event_count_;
+
+  Timer schema_event_timer_;
+  PendingSchemaMap pending_schemas_;
+  uint64_t pending_schema_event_count_;
 };
 
 }}} // namespace datastax::internal::core
@@ -17,6 +17,7 @@
 */
 
 #include "control_connector.hpp"
+#include "metadata_cache_file.hpp"
 #include "result_iterator.hpp"
 
 using namespace datastax;
@@ -97,6 +98,11 @@ ControlConnector* ControlConnector::with_settings(const ControlConnectionSetting
   return this;
 }
 
+ControlConnector* ControlConnector::with_known_schema_version(const String& schema_version) {
+  known_schema_version_ = schema_version;
+  return this;
+}
+
 void ControlConnector::connect(uv_loop_t* loop) {
   inc_ref();
   int event_types = 0;
@@ -144,9 +150,12 @@ void ControlConnector::on_success() {
     return;
   }
 
+  schema_.schema_version = schema_version_;
+
   // Transfer ownership of the connection to the control connection.
   control_connection_.reset(new ControlConnection(
-      connection_, listener_, settings_, server_version_, dse_server_version_, listen_addresses_));
+      connection_, listener_, settings_, server_version_, dse_server_version_, listen_addresses_,
+      metrics_));
 
   control_connection_->set_listener(listener_);
 
@@ -212,6 +221,11 @@ void ControlConnector::handle_query_hosts(HostsConnectorRequestCallback* callbac
     hosts_[connected_host->address()] = connected_host;
     server_version_ = connected_host->server_version();
     dse_server_version_ = connected_host->dse_server_version();
+
+    const Value* schema_version = local_result->first_row().get_by_name("schema_version");
+    if (schema_version && !schema_version->is_null()) {
+      schema_version_ = schema_version->to_string_ref().to_string();
+    }
   } else {
     on_error(CONTROL_CONNECTION_ERROR_HOSTS,
              "No row found in " + connection_->address_string() + "'s local system table");
@@ -234,20 +248,63 @@ void ControlConnector::handle_query_hosts(HostsConnectorRequestCallback* callbac
   }
 
   if (settings_.use_token_aware_routing || settings_.use_schema) {
-    query_schema();
+    is_schema_unchanged_ = settings_.use_schema && !schema_version_.empty() &&
+                           schema_version_ == known_schema_version_;
+    if (is_schema_unchanged_) {
+      LOG_DEBUG("Schema version is unchanged; only refreshing keyspaces");
+      query_schema();
+    } else if (!read_schema_cache_file()) {
+      query_schema();
+    }
   } else {
     // If we're not using token aware routing or schema we can just finish.
     on_success();
   }
 }
 
+bool ControlConnector::read_schema_cache_file() {
+  if (settings_.metadata_cache_file.empty() || schema_version_.empty()) return false;
+
+  inc_ref(); // For the cache file read
+  MetadataCacheFile::Ptr file(new MetadataCacheFile(settings_.metadata_cache_file));
+  file->read(connection_->loop(),
+             bind_callback(&ControlConnector::on_read_schema_cache_file, this));
+  return true;
+}
+
+void ControlConnector::on_read_schema_cache_file(MetadataCacheFile* file) {
+  // The connector has already finished if it was canceled or its connection
+  // failed while the file was being read.
+  if (error_code_ == CONTROL_CONNECTION_OK) {
+    MetadataCacheFile::Key key(protocol_version(), server_version_, settings_.use_schema,
+                               schema_version_);
+    if (file->load(key, &schema_)) {
+      LOG_DEBUG("Loaded schema metadata from cache file %s", file->path().c_str());
+      is_schema_from_cache_ = true;
+      on_success();
+    } else {
+      query_schema();
+    }
+  }
+  dec_ref();
+}
+
+void ControlConnector::save_schema_to_cache() {
+  if (settings_.metadata_cache_file.empty() || schema_version_.empty()) return;
+
+  MetadataCacheFile::Ptr file(new MetadataCacheFile(settings_.metadata_cache_file));
+  MetadataCacheFile::Key key(protocol_version(), server_version_, settings_.use_schema,
+                             schema_version_);
+  file->save(connection_->loop(), key, schema_);
+}
+
 void ControlConnector::query_schema() {
   ChainedRequestCallback::Ptr callback;
 
   if (server_version_ >= VersionNumber(3, 0, 0)) {
     callback = ChainedRequestCallback::Ptr(
         new SchemaConnectorRequestCallback("keyspaces", SELECT_KEYSPACES_30, this));
-    if (settings_.use_schema) {
+    if (settings_.use_schema && !is_schema_unchanged_) {
       callback = callback->chain("tables", SELECT_TABLES_30)
                      ->chain("views", SELECT_VIEWS_30)
                      ->chain("columns", SELECT_COLUMNS_30)
@@ -265,7 +322,7 @@ void ControlConnector::query_schema() {
   } else {
     callback = ChainedRequestCallback::Ptr(
         new SchemaConnectorRequestCallback("keyspaces", SELECT_KEYSPACES_20, this));
-    if (settings_.use_schema) {
+    if (settings_.use_schema && !is_schema_unchanged_) {
       callback =
           callback->chain("tables", SELECT_COLUMN_FAMILIES_20)->chain("columns", SELECT_COLUMNS_20);
 
@@ -285,6 +342,20 @@ void ControlConnector::query_schema() {
 }
 
 void ControlConnector::handle_query_schema(SchemaConnectorRequestCallback* callback) {
+  if (is_schema_unchanged_) {
+    // Schema events received while connecting aren't applied to the existing
+    // schema so it needs to be fully refreshed.
+    for (EventResponse::Vec::const_iterator it = events().begin(), end = events().end();
+         it != end; ++it) {
+      if ((*it)->event_type() == CASS_EVENT_SCHEMA_CHANGE) {
+        LOG_DEBUG("Schema changed while connecting; refreshing the full schema");
+        is_schema_unchanged_ = false;
+        query_schema();
+        return;
+      }
+    }
+  }
+
   schema_.keyspaces = callback->result("keyspaces");
   schema_.tables = callback->result("tables");
   schema_.views = callback->result("views");
@@ -297,6 +368,10 @@ void ControlConnector::handle_query_schema(SchemaConnectorRequestCallback* callb
   schema_.virtual_tables = callback->result("virtual_tables");
   schema_.virtual_columns = callback->result("virtual_columns");
 
+  if (!is_schema_unchanged_) {
+    save_schema_to_cache();
+  }
+
   on_success();
 }
 
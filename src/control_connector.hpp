@@ -27,6 +27,7 @@
 namespace datastax { namespace internal { namespace core {
 
 class HostsConnectorRequestCallback;
+class MetadataCacheFile;
 class Metrics;
 class SchemaConnectorRequestCallback;
 
@@ -46,6 +47,12 @@ struct ControlConnectionSchema {
   ResultResponse::Ptr virtual_keyspaces;
   ResultResponse::Ptr virtual_tables;
   ResultResponse::Ptr virtual_columns;
+
+  /**
+   * The schema version of the host the schema was retrieved from. Empty if
+   * it's unknown.
+   */
+  String schema_version;
 };
 
 /**
@@ -107,6 +114,17 @@ public:
    */
   ControlConnector* with_settings(const ControlConnectionSettings& settings);
 
+  /**
+   * Sets the schema version of the schema metadata that's already known (e.g.
+   * from a previous control connection). If the connected host's schema
+   * version matches then only the keyspaces are queried (for the token map)
+   * and the rest of the schema queries are skipped.
+   *
+   * @param schema_version The known schema version.
+   * @return The connector to chain calls.
+   */
+  ControlConnector* with_known_schema_version(const String& schema_version);
+
   /**
    * Start the connection process.
    *
@@ -150,6 +168,22 @@ public:
    */
   const ControlConnectionSchema& schema() const { return schema_; }
 
+  /**
+   * Determines if the initial schema metadata was loaded from the metadata
+   * cache file instead of being queried.
+   *
+   * @return true if loaded from the cache file.
+   */
+  bool is_schema_from_cache() const { return is_schema_from_cache_; }
+
+  /**
+   * Determines if the connected host's schema version matches the known schema
+   * version. If true then the schema only contains the keyspaces.
+   *
+   * @return true if the schema hasn't changed.
+   */
+  bool is_schema_unchanged() const { return is_schema_unchanged_; }
+
 public:
   const Address& address() const { return connector_->address(); }
 
@@ -192,6 +226,10 @@ private:
   void query_hosts();
   void handle_query_hosts(HostsConnectorRequestCallback* callback);
 
+  bool read_schema_cache_file();
+  void on_read_schema_cache_file(MetadataCacheFile* file);
+  void save_schema_to_cache();
+
   void query_schema();
   void handle_query_schema(SchemaConnectorRequestCallback* callback);
 
@@ -214,6 +252,10 @@ private:
    */
   ListenAddressMap listen_addresses_;
   ControlConnectionSchema schema_;
+  String schema_version_;
+  String known_schema_version_;
+  bool is_schema_from_cache_;
+  bool is_schema_unchanged_;
 
   Callback callback_;
 
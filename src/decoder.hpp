@@ -183,6 +183,20 @@ public:
     return true;
   }
 
+  // Skips over a [bytes] value, returning the position of its length.
+  inline bool skip_value(const char** output) {
+    const char* position = input_;
+    int32_t size = 0;
+    if (!decode_int32(size)) return false;
+    if (size > 0) {
+      CHECK_REMAINING(size, "value");
+      input_ += size;
+      remaining_ -= size;
+    }
+    *output = position;
+    return true;
+  }
+
   inline bool decode_int64(int64_t& output) {
     CHECK_REMAINING(sizeof(int64_t), "long");
 
@@ -565,6 +579,15 @@ public:
 
   bool is_null() const { return input_ == NULL; }
 
+  // Gets the bytes between this decoder's position and the position of
+  // `other` (a copy of this decoder that has been advanced).
+  StringRef bytes_until(const Decoder& other) const {
+    return StringRef(input_, other.input_ - input_);
+  }
+
+  // Gets the bytes that haven't been decoded yet.
+  StringRef remaining_bytes() const { return StringRef(input_, remaining_); }
+
 protected:
   // Testing only
   inline const char* buffer() const { return input_; }
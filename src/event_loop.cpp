@@ -17,8 +17,13 @@
 */
 
 #include "event_loop.hpp"
+#include "read_buffer_pool.hpp"
+#include "result_metadata_cache.hpp"
 #include "ssl.hpp"
 
+// The size of an event loop's io_uring submission queue
+#define IO_URING_ENTRIES 256
+
 #if !defined(_WIN32)
 #include <signal.h>
 #endif
@@ -49,9 +54,18 @@ static void consume_blocked_sigpipe() {
 EventLoop::EventLoop()
     : is_loop_initialized_(false)
     , is_joinable_(false)
+    , has_cpu_affinity_(false)
+    , cpu_(0)
+    , is_task_wakeup_pending_(false)
     , is_closing_(false)
     , io_time_start_(0)
-    , io_time_elapsed_(0) {
+    , io_time_elapsed_(0)
+    , spin_time_ns_(0)
+    , has_activity_(false)
+    , use_io_uring_(false)
+    , allocator_(new SlabAllocator())
+    , metadata_cache_(new ResultMetadataCache())
+    , read_buffer_pool_(new ReadBufferPool()) {
   // Set user data for PooledConnection to start the I/O elapsed time.
   loop_.data = this;
 }
@@ -68,6 +82,11 @@ EventLoop::~EventLoop() {
       }
     }
   }
+  metadata_cache_.reset();
+  read_buffer_pool_.reset();
+  // Objects allocated on the loop thread may outlive it, so the allocator is
+  // freed once the last of them is returned.
+  allocator_->release();
 }
 
 int EventLoop::init(const String& thread_name /*= ""*/) {
@@ -113,7 +132,12 @@ void EventLoop::join() {
 
 void EventLoop::add(Task* task) {
   tasks_.enqueue(task);
-  async_.send();
+  // Tasks added before the loop starts running tasks don't need to wake it up
+  // again. The exchange synchronizes with the exchange in `on_task()` so the
+  // task is visible to the loop if it doesn't wake it up.
+  if (!is_task_wakeup_pending_.exchange(true)) {
+    async_.send();
+  }
 }
 
 void EventLoop::maybe_start_io_time() {
@@ -135,41 +159,68 @@ void EventLoop::on_run() {
   set_thread_name(name_);
 }
 
-EventLoop::TaskQueue::TaskQueue() { uv_mutex_init(&lock_); }
-
-EventLoop::TaskQueue::~TaskQueue() { uv_mutex_destroy(&lock_); }
-
-bool EventLoop::TaskQueue::enqueue(Task* task) {
-  ScopedMutex l(&lock_);
-  queue_.push_back(task);
-  return true;
-}
-
-bool EventLoop::TaskQueue::dequeue(Task*& task) {
-  ScopedMutex l(&lock_);
-  if (queue_.empty()) {
-    return false;
-  }
-  task = queue_.front();
-  queue_.pop_front();
-  return true;
-}
-
-bool EventLoop::TaskQueue::is_empty() {
-  ScopedMutex l(&lock_);
-  return queue_.empty();
-}
-
 void EventLoop::internal_on_run(void* arg) {
   EventLoop* thread = static_cast<EventLoop*>(arg);
   thread->handle_run();
 }
 
 void EventLoop::handle_run() {
+  if (has_cpu_affinity_) {
+    int rc = set_thread_affinity(cpu_);
+    if (rc != 0) {
+      LOG_WARN("Unable to bind event loop thread to CPU %u (error %d)", cpu_, rc);
+    }
+  }
+  context_.allocator = allocator_;
+  context_.metadata_cache = metadata_cache_.get();
+  context_.read_buffer_pool = read_buffer_pool_.get();
+  LoopContext::set_current(&context_);
+#ifdef HAVE_IO_URING
+  if (use_io_uring_) {
+    io_uring_.reset(new IoUring());
+    int rc = io_uring_->init(loop(), IO_URING_ENTRIES);
+    if (rc != 0) {
+      LOG_WARN("Unable to initialize io_uring, sockets will use libuv: %s", uv_strerror(rc));
+      io_uring_->close_handles();
+      io_uring_.reset();
+    }
+    context_.io_uring = io_uring_.get();
+  }
+#else
+  if (use_io_uring_) {
+    LOG_WARN("Driver was built without io_uring support, sockets will use libuv");
+  }
+#endif
   on_run();
-  uv_run(loop(), UV_RUN_DEFAULT);
+  run_loop();
   on_after_run();
+#ifdef HAVE_IO_URING
+  // Wait for the outstanding operations of the (closed) sockets
+  context_.io_uring = NULL;
+  io_uring_.reset();
+#endif
   SslContextFactory::thread_cleanup();
+  LoopContext::set_current(NULL);
+}
+
+void EventLoop::run_loop() {
+  if (spin_time_ns_ == 0) {
+    uv_run(loop(), UV_RUN_DEFAULT);
+    return;
+  }
+
+  // Poll without blocking until there's been no activity for the spin time,
+  // then block until the next event. The loop exits once there are no more
+  // active handles, the same as `UV_RUN_DEFAULT`.
+  uint64_t spin_until = 0;
+  for (;;) {
+    has_activity_ = false;
+    uv_run_mode mode = uv_hrtime() < spin_until ? UV_RUN_NOWAIT : UV_RUN_ONCE;
+    if (uv_run(loop(), mode) == 0) break;
+    if (has_activity_) {
+      spin_until = uv_hrtime() + spin_time_ns_;
+    }
+  }
 }
 
 void EventLoop::on_check(Check* check) {
@@ -177,12 +228,19 @@ void EventLoop::on_check(Check* check) {
   if (io_time_start_ > 0) {
     io_time_elapsed_ = now - io_time_start_;
     io_time_start_ = 0;
+    has_activity_ = true;
   } else {
     io_time_elapsed_ = 0;
   }
 }
 
 void EventLoop::on_task(Async* async) {
+  // Tasks added after this point wake up the loop again. This includes a task
+  // that's being linked into the queue and can't be dequeued yet.
+  is_task_wakeup_pending_.exchange(false);
+
+  has_activity_ = true;
+
   Task* task = NULL;
   while (tasks_.dequeue(task)) {
     if (task) {
@@ -194,6 +252,9 @@ void EventLoop::on_task(Async* async) {
   if (is_closing_.load() && tasks_.is_empty()) {
     async_.close_handle();
     check_.close_handle();
+#ifdef HAVE_IO_URING
+    if (io_uring_) io_uring_->close_handles();
+#endif
 #if defined(HAVE_SIGTIMEDWAIT) && !defined(HAVE_NOSIGPIPE)
     uv_prepare_stop(&prepare_);
     uv_close(reinterpret_cast<uv_handle_t*>(&prepare_), NULL);
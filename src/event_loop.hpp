@@ -22,13 +22,16 @@
 #include "allocated.hpp"
 #include "async.hpp"
 #include "atomic.hpp"
-#include "deque.hpp"
 #include "driver_config.hpp"
+#include "io_uring.hpp"
 #include "logger.hpp"
+#include "loop_context.hpp"
 #include "loop_watcher.hpp"
 #include "macros.hpp"
+#include "mpsc_queue.hpp"
 #include "scoped_lock.hpp"
 #include "scoped_ptr.hpp"
+#include "slab_allocator.hpp"
 #include "utils.hpp"
 
 #include <assert.h>
@@ -37,11 +40,15 @@
 namespace datastax { namespace internal { namespace core {
 
 class EventLoop;
+class ReadBufferPool;
+class ResultMetadataCache;
 
 /**
  * A task executed on an event loop thread.
  */
-class Task : public Allocated {
+class Task
+    : public Allocated
+    , public MPSCQueue<Task>::Node {
 public:
   virtual ~Task() {}
   virtual void run(EventLoop* event_loop) = 0;
@@ -67,6 +74,42 @@ public:
    */
   int init(const String& thread_name = "");
 
+  /**
+   * Bind the event loop thread to a CPU. This must be called before the
+   * event loop thread is started. The thread is bound before it allocates
+   * anything, so memory first touched by the thread (e.g. its slab allocator
+   * and connection buffers) is allocated on the CPU's NUMA node.
+   *
+   * @param cpu
+   */
+  void set_cpu_affinity(unsigned cpu) {
+    has_cpu_affinity_ = true;
+    cpu_ = cpu;
+  }
+
+  /**
+   * Poll for events without blocking for a period after the loop has handled
+   * a task or I/O, before blocking again. This avoids the latency of waking
+   * up the thread when requests and responses arrive close together, at the
+   * cost of the CPU used while spinning. This must be called before the event
+   * loop thread is started.
+   *
+   * @param spin_time_ns The time to spin after the last activity. Spinning is
+   * disabled if 0.
+   */
+  void set_spin_time(uint64_t spin_time_ns) { spin_time_ns_ = spin_time_ns; }
+
+  /**
+   * Use io_uring for socket writes and reads on the event loop thread (Linux
+   * only). Sockets fall back to libuv if the driver was built without io_uring
+   * support or the ring can't be created, and reads also fall back if the
+   * kernel doesn't support multishot receives. This must be called before the
+   * event loop thread is started.
+   *
+   * @param use_io_uring
+   */
+  void set_use_io_uring(bool use_io_uring) { use_io_uring_ = use_io_uring; }
+
   /**
    * Start the event loop thread.
    *
@@ -128,24 +171,10 @@ protected:
    */
   virtual void on_after_run() {}
 
-private:
-  class TaskQueue {
-  public:
-    TaskQueue();
-    ~TaskQueue();
-
-    bool enqueue(Task* task);
-    bool dequeue(Task*& task);
-    bool is_empty();
-
-  private:
-    uv_mutex_t lock_;
-    Deque<Task*> queue_;
-  };
-
 private:
   static void internal_on_run(void* arg);
   void handle_run();
+  void run_loop();
 
   void on_check(Check* check);
   void on_task(Async* async);
@@ -161,8 +190,13 @@ private:
 
   uv_thread_t thread_;
   bool is_joinable_;
+  bool has_cpu_affinity_;
+  unsigned cpu_;
   Async async_;
-  TaskQueue tasks_;
+  MPSCQueue<Task> tasks_;
+  // Set while the loop has been woken up, but hasn't started running tasks,
+  // so that tasks added in the meantime don't wake it up again.
+  Atomic<bool> is_task_wakeup_pending_;
 
   Atomic<bool> is_closing_;
 
@@ -170,6 +204,20 @@ private:
   uint64_t io_time_start_;
   uint64_t io_time_elapsed_;
 
+  uint64_t spin_time_ns_;
+  // Set when a loop iteration runs tasks or does I/O (only used when spinning)
+  bool has_activity_;
+
+  bool use_io_uring_;
+#ifdef HAVE_IO_URING
+  ScopedPtr<IoUring> io_uring_;
+#endif
+
+  SlabAllocator* allocator_;
+  ScopedPtr<ResultMetadataCache> metadata_cache_;
+  ScopedPtr<ReadBufferPool> read_buffer_pool_;
+  LoopContext context_; // Bound to the loop's thread while it runs
+
   String name_;
 };
 
@@ -30,18 +30,25 @@ ExecuteRequest::ExecuteRequest(const Prepared* prepared)
 
 int ExecuteRequest::encode(ProtocolVersion version, RequestCallback* callback,
                            BufferVec* bufs) const {
-  int32_t length = encode_query_or_id(bufs);
+  Buffer result_metadata_id;
   if (version.supports_result_metadata_id()) {
     if (callback->prepared_metadata_entry()) {
-      const Buffer& result_metadata_id(callback->prepared_metadata_entry()->result_metadata_id());
-      bufs->push_back(result_metadata_id);
-      length += result_metadata_id.size();
+      result_metadata_id = callback->prepared_metadata_entry()->result_metadata_id();
     } else {
-      bufs->push_back(Buffer(sizeof(uint16_t)));
-      bufs->back().encode_uint16(0, 0);
-      length += bufs->back().size();
+      result_metadata_id = Buffer(sizeof(uint16_t));
+      result_metadata_id.encode_uint16(0, 0);
     }
   }
+
+  if (can_encode_frozen(version)) {
+    return encode_frozen(version, result_metadata_id, callback, bufs);
+  }
+
+  int32_t length = encode_query_or_id(bufs);
+  if (result_metadata_id.size() > 0) {
+    bufs->push_back(result_metadata_id);
+    length += result_metadata_id.size();
+  }
   length += encode_begin(version, static_cast<uint16_t>(elements().size()), callback, bufs);
   int32_t result = encode_values(version, callback, bufs);
   if (result < 0) return result;
@@ -107,6 +107,13 @@ CassError cass_execution_profile_set_latency_aware_routing_settings(
   return CASS_OK;
 }
 
+CassError cass_execution_profile_set_load_aware_routing(CassExecProfile* profile,
+                                                        cass_bool_t enabled,
+                                                        cass_bool_t use_latency) {
+  profile->set_load_aware_routing(enabled == cass_true, use_latency == cass_true);
+  return CASS_OK;
+}
+
 CassError cass_execution_profile_set_whitelist_filtering(CassExecProfile* profile,
                                                          const char* hosts) {
   return cass_execution_profile_set_whitelist_filtering_n(profile, hosts, SAFE_STRLEN(hosts));
@@ -183,6 +190,18 @@ CassError cass_execution_profile_set_constant_speculative_execution_policy(
   return CASS_OK;
 }
 
+CassError cass_execution_profile_set_percentile_speculative_execution_policy(
+    CassExecProfile* profile, cass_double_t percentile, int max_speculative_executions,
+    cass_double_t max_speculative_ratio) {
+  if (percentile <= 0.0 || percentile >= 100.0 || max_speculative_executions < 0 ||
+      max_speculative_ratio < 0.0 || max_speculative_ratio > 1.0) {
+    return CASS_ERROR_LIB_BAD_PARAMS;
+  }
+  profile->set_speculative_execution_policy(new PercentileSpeculativeExecutionPolicy(
+      percentile, max_speculative_executions, max_speculative_ratio));
+  return CASS_OK;
+}
+
 CassError cass_execution_profile_set_no_speculative_execution_policy(CassExecProfile* profile) {
   profile->set_speculative_execution_policy(new NoSpeculativeExecutionPolicy());
   return CASS_OK;
@@ -27,6 +27,7 @@
 #include "dc_aware_policy.hpp"
 #include "dense_hash_map.hpp"
 #include "latency_aware_policy.hpp"
+#include "load_aware_policy.hpp"
 #include "speculative_execution.hpp"
 #include "string.hpp"
 #include "token_aware_policy.hpp"
@@ -45,6 +46,8 @@ public:
       , consistency_(CASS_CONSISTENCY_UNKNOWN)
       , serial_consistency_(CASS_CONSISTENCY_UNKNOWN)
       , latency_aware_routing_(false)
+      , load_aware_routing_(false)
+      , load_aware_routing_use_latency_(false)
       , token_aware_routing_(true)
       , token_aware_routing_shuffle_replicas_(true) {}
 
@@ -82,6 +85,15 @@ public:
     return latency_aware_routing_settings_;
   }
 
+  bool load_aware() const { return load_aware_routing_; }
+
+  bool load_aware_routing_use_latency() const { return load_aware_routing_use_latency_; }
+
+  void set_load_aware_routing(bool is_load_aware, bool use_latency) {
+    load_aware_routing_ = is_load_aware;
+    load_aware_routing_use_latency_ = use_latency;
+  }
+
   bool token_aware_routing() const { return token_aware_routing_; }
 
   void set_token_aware_routing(bool is_token_aware) { token_aware_routing_ = is_token_aware; }
@@ -120,7 +132,7 @@ public:
 
   void build_load_balancing_policy() {
     // The base LBP can be augmented by special wrappers (whitelist,
-    // token aware, latency aware)
+    // token aware, load aware, latency aware)
     if (base_load_balancing_policy_) {
       LoadBalancingPolicy* chain = base_load_balancing_policy_->new_instance();
 
@@ -139,6 +151,9 @@ public:
       if (token_aware_routing()) {
         chain = new TokenAwarePolicy(chain, token_aware_routing_shuffle_replicas_);
       }
+      if (load_aware()) {
+        chain = new LoadAwarePolicy(chain, load_aware_routing_use_latency_);
+      }
       if (latency_aware()) {
         chain = new LatencyAwarePolicy(chain, latency_aware_routing_settings_);
       }
@@ -160,6 +175,17 @@ public:
     speculative_execution_policy_.reset(sep);
   }
 
+  /**
+   * Replace the speculative execution policy with a new instance so that
+   * policies that keep state (e.g. latency percentiles) aren't shared between
+   * request processors.
+   */
+  void build_speculative_execution_policy() {
+    if (speculative_execution_policy_) {
+      speculative_execution_policy_.reset(speculative_execution_policy_->new_instance());
+    }
+  }
+
 private:
   cass_uint64_t request_timeout_ms_;
   CassConsistency consistency_;
@@ -168,6 +194,8 @@ private:
   DcList blacklist_dc_;
   bool latency_aware_routing_;
   LatencyAwarePolicy::Settings latency_aware_routing_settings_;
+  bool load_aware_routing_;
+  bool load_aware_routing_use_latency_;
   bool token_aware_routing_;
   bool token_aware_routing_shuffle_replicas_;
   ContactPointList whitelist_;
@@ -58,6 +58,10 @@ uint64_t get_time_monotonic_ns() {
   return time * ClockInfo::frequency();
 }
 
+uint64_t get_time_monotonic_coarse_ms() {
+  return get_time_monotonic_ns() / NANOSECONDS_PER_MILLISECOND;
+}
+
 }} // namespace datastax::internal
 
 #endif // defined(__APPLE__) && defined(__MACH__)
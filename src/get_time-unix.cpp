@@ -31,15 +31,24 @@ public:
     struct timespec tp;
     supports_monotonic_ =
         clock_getres(CLOCK_MONOTONIC, &res) == 0 && clock_gettime(CLOCK_MONOTONIC, &tp) == 0;
+#ifdef CLOCK_MONOTONIC_COARSE
+    supports_monotonic_coarse_ = clock_getres(CLOCK_MONOTONIC_COARSE, &res) == 0 &&
+                                 clock_gettime(CLOCK_MONOTONIC_COARSE, &tp) == 0;
+#else
+    supports_monotonic_coarse_ = false;
+#endif
   }
 
   static bool supports_monotonic() { return supports_monotonic_; }
+  static bool supports_monotonic_coarse() { return supports_monotonic_coarse_; }
 
 private:
   static bool supports_monotonic_;
+  static bool supports_monotonic_coarse_;
 };
 
 bool ClockInfo::supports_monotonic_;
+bool ClockInfo::supports_monotonic_coarse_;
 
 static ClockInfo __clock_info__; // Initializer
 
@@ -60,6 +69,18 @@ uint64_t get_time_monotonic_ns() {
   }
 }
 
+uint64_t get_time_monotonic_coarse_ms() {
+#ifdef CLOCK_MONOTONIC_COARSE
+  if (ClockInfo::supports_monotonic_coarse()) {
+    struct timespec tp;
+    clock_gettime(CLOCK_MONOTONIC_COARSE, &tp);
+    return static_cast<uint64_t>(tp.tv_sec) * 1000 +
+           static_cast<uint64_t>(tp.tv_nsec) / NANOSECONDS_PER_MILLISECOND;
+  }
+#endif
+  return get_time_monotonic_ns() / NANOSECONDS_PER_MILLISECOND;
+}
+
 }} // namespace datastax::internal
 
 #endif
@@ -70,6 +70,10 @@ uint64_t get_time_monotonic_ns() {
   }
 }
 
+uint64_t get_time_monotonic_coarse_ms() {
+  return get_time_monotonic_ns() / NANOSECONDS_PER_MILLISECOND;
+}
+
 }} // namespace datastax::internal
 
 #endif // defined(_WIN32)
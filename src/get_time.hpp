@@ -40,6 +40,12 @@ inline uint64_t get_time_since_epoch_ms() {
 // `get_time_since_epoch_us()` will be used.
 uint64_t get_time_monotonic_ns();
 
+// A cheaper, lower resolution (a few milliseconds on Linux) version of
+// `get_time_monotonic_ns()` in milliseconds. This is used where the clock is
+// read on every request. Platforms without a coarse clock use
+// `get_time_monotonic_ns()`.
+uint64_t get_time_monotonic_coarse_ms();
+
 }} // namespace datastax::internal
 
 #endif
@@ -60,28 +60,50 @@ bool remove_host(CopyOnWriteHostVec& hosts, const Address& address) {
 void Host::LatencyTracker::update(uint64_t latency_ns) {
   uint64_t now = uv_hrtime();
 
-  ScopedSpinlock l(SpinlockPool<LatencyTracker>::get_spinlock(this));
+  uint64_t sequence = sequence_.load(MEMORY_ORDER_RELAXED);
+  if ((sequence & 1) != 0 || !sequence_.compare_exchange_strong(sequence, sequence + 1)) {
+    return; // Another thread is updating the average
+  }
+  atomic_thread_fence(MEMORY_ORDER_RELEASE);
 
-  TimestampedAverage previous = current_;
+  int64_t previous_average = average_.load(MEMORY_ORDER_RELAXED);
+  uint64_t previous_timestamp = timestamp_.load(MEMORY_ORDER_RELAXED);
+  uint64_t previous_num_measured = num_measured_.load(MEMORY_ORDER_RELAXED);
 
-  if (previous.num_measured < threshold_to_account_) {
-    current_.average = -1;
-  } else if (previous.average < 0) {
-    current_.average = latency_ns;
+  int64_t average;
+  if (previous_num_measured < threshold_to_account_) {
+    average = -1;
+  } else if (previous_average < 0) {
+    average = latency_ns;
   } else {
-    int64_t delay = now - previous.timestamp;
+    int64_t delay = now - previous_timestamp;
     if (delay <= 0) {
+      sequence_.store(sequence, MEMORY_ORDER_RELEASE); // Unchanged
       return;
     }
 
     double scaled_delay = static_cast<double>(delay) / scale_ns_;
     double weight = log(scaled_delay + 1) / scaled_delay;
-    current_.average =
-        static_cast<int64_t>((1.0 - weight) * latency_ns + weight * previous.average);
+    average = static_cast<int64_t>((1.0 - weight) * latency_ns + weight * previous_average);
   }
 
-  current_.num_measured = previous.num_measured + 1;
-  current_.timestamp = now;
+  average_.store(average, MEMORY_ORDER_RELAXED);
+  timestamp_.store(now, MEMORY_ORDER_RELAXED);
+  num_measured_.store(previous_num_measured + 1, MEMORY_ORDER_RELAXED);
+  sequence_.store(sequence + 2, MEMORY_ORDER_RELEASE);
+}
+
+TimestampedAverage Host::LatencyTracker::get() const {
+  TimestampedAverage current;
+  uint64_t sequence;
+  do {
+    sequence = sequence_.load(MEMORY_ORDER_ACQUIRE);
+    current.average = average_.load(MEMORY_ORDER_RELAXED);
+    current.timestamp = timestamp_.load(MEMORY_ORDER_RELAXED);
+    current.num_measured = num_measured_.load(MEMORY_ORDER_RELAXED);
+    atomic_thread_fence(MEMORY_ORDER_ACQUIRE);
+  } while ((sequence & 1) != 0 || sequence != sequence_.load(MEMORY_ORDER_RELAXED));
+  return current;
 }
 
 bool VersionNumber::parse(const String& version) {
@@ -29,7 +29,6 @@
 #include "map.hpp"
 #include "ref_counted.hpp"
 #include "scoped_ptr.hpp"
-#include "spin_lock.hpp"
 #include "vector.hpp"
 
 #include <math.h>
@@ -178,23 +177,36 @@ public:
   }
 
 private:
+  /**
+   * Tracks an exponentially weighted moving average of the host's latencies.
+   * Many I/O threads update the same host so the tracker is a sequence lock
+   * that never blocks: an update is dropped if another thread is already
+   * updating the average (the average is unaffected by missing the odd
+   * sample) and reads are retried if they overlap an update.
+   */
   class LatencyTracker : public Allocated {
   public:
     LatencyTracker(uint64_t scale_ns, uint64_t threshold_to_account)
         : scale_ns_(scale_ns)
-        , threshold_to_account_(threshold_to_account) {}
+        , threshold_to_account_(threshold_to_account)
+        , sequence_(0)
+        , average_(-1)
+        , timestamp_(0)
+        , num_measured_(0) {}
 
     void update(uint64_t latency_ns);
 
-    TimestampedAverage get() const {
-      ScopedSpinlock l(SpinlockPool<LatencyTracker>::get_spinlock(this));
-      return current_;
-    }
+    TimestampedAverage get() const;
 
   private:
     uint64_t scale_ns_;
     uint64_t threshold_to_account_;
-    TimestampedAverage current_;
+
+    // Odd while an update is in progress
+    Atomic<uint64_t> sequence_;
+    Atomic<int64_t> average_;
+    Atomic<uint64_t> timestamp_;
+    Atomic<uint64_t> num_measured_;
 
   private:
     DISALLOW_COPY_AND_ASSIGN(LatencyTracker);
@@ -33,7 +33,7 @@ public:
 
   virtual void on_read(Socket* socket, ssize_t nread, const uv_buf_t* buf) {
     client_->on_read(buf->base, nread);
-    free_buffer(buf);
+    free_buffer(nread, buf);
   }
 
   virtual void on_write(Socket* socket, int status, SocketRequest* request) { delete request; }
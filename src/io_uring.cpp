@@ -0,0 +1,487 @@
+/*
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include "io_uring.hpp"
+
+#ifdef HAVE_IO_URING
+
+#include "logger.hpp"
+
+#include <algorithm>
+#include <assert.h>
+#include <errno.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+using namespace datastax::internal;
+using namespace datastax::internal::core;
+
+// Set in the user data of operations that were discarded before they were
+// submitted. Operations are at least pointer aligned so the low bit is free.
+#define DISCARDED_TAG 1
+
+// The shared read buffers (the count must be a power of two)
+#define READ_BUFFER_GROUP 0
+#define READ_BUFFER_COUNT 128
+#define READ_BUFFER_SIZE (16 * 1024)
+
+// The ring's head and tail indexes are shared with the kernel
+static inline unsigned load_acquire(const unsigned* index) {
+  return __atomic_load_n(index, __ATOMIC_ACQUIRE);
+}
+
+static inline void store_release(unsigned* index, unsigned value) {
+  __atomic_store_n(index, value, __ATOMIC_RELEASE);
+}
+
+static int sys_io_uring_setup(unsigned entries, struct io_uring_params* params) {
+  return static_cast<int>(syscall(__NR_io_uring_setup, entries, params));
+}
+
+#ifdef HAVE_IO_URING_RECV_MULTISHOT
+static int sys_io_uring_register(int fd, unsigned opcode, void* arg, unsigned nr_args) {
+  return static_cast<int>(syscall(__NR_io_uring_register, fd, opcode, arg, nr_args));
+}
+#endif
+
+static int sys_io_uring_enter(int fd, unsigned to_submit, unsigned min_complete, unsigned flags) {
+  return static_cast<int>(
+      syscall(__NR_io_uring_enter, fd, to_submit, min_complete, flags, NULL, 0));
+}
+
+template <class T>
+static void on_close_handle(uv_handle_t* handle) {
+  delete reinterpret_cast<AllocatedT<T>*>(handle);
+}
+
+IoUring::IoUring()
+    : fd_(-1)
+    , sq_ring_(NULL)
+    , sq_ring_size_(0)
+    , cq_ring_(NULL)
+    , cq_ring_size_(0)
+    , sqes_(NULL)
+    , sqes_size_(0)
+    , sq_head_(NULL)
+    , sq_tail_(NULL)
+    , sq_mask_(0)
+    , sq_entries_(0)
+    , sq_flags_(NULL)
+    , sq_array_(NULL)
+    , cq_head_(NULL)
+    , cq_tail_(NULL)
+    , cq_mask_(0)
+    , cqes_(NULL)
+    , buf_ring_(NULL)
+    , buf_ring_size_(0)
+    , buf_ring_tail_(0)
+    , read_buffers_(NULL)
+    , read_buffers_size_(0)
+    , is_recv_multishot_disabled_(false)
+    , pending_count_(0)
+    , outstanding_count_(0)
+    , multishot_count_(0)
+    , is_closing_(false)
+    , check_(NULL)
+    , idle_(NULL)
+    , poll_(NULL) {}
+
+IoUring::~IoUring() {
+  assert(check_ == NULL && idle_ == NULL && poll_ == NULL && "Handles must be closed");
+
+  if (fd_ >= 0) {
+    // Wait for the outstanding operations so that their memory is no longer
+    // used by the kernel when their callbacks release it.
+    while (pending_count_ > 0 || outstanding_count_ > 0) {
+      if (submit(1) < 0) break;
+      process_completions();
+    }
+  }
+
+  if (sqes_ != NULL) munmap(sqes_, sqes_size_);
+  if (cq_ring_ != NULL && cq_ring_ != sq_ring_) munmap(cq_ring_, cq_ring_size_);
+  if (sq_ring_ != NULL) munmap(sq_ring_, sq_ring_size_);
+  if (fd_ >= 0) close(fd_);
+  // The read buffers are unregistered when the ring is closed
+  if (read_buffers_ != NULL) munmap(read_buffers_, read_buffers_size_);
+  if (buf_ring_ != NULL) munmap(buf_ring_, buf_ring_size_);
+}
+
+int IoUring::init(uv_loop_t* loop, unsigned entries) {
+  struct io_uring_params params;
+  memset(&params, 0, sizeof(params));
+
+  fd_ = sys_io_uring_setup(entries, &params);
+  if (fd_ < 0) return -errno;
+
+  sq_ring_size_ = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+  cq_ring_size_ = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+  bool is_single_mmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+  if (is_single_mmap) {
+    sq_ring_size_ = cq_ring_size_ = std::max(sq_ring_size_, cq_ring_size_);
+  }
+
+  void* ptr = mmap(NULL, sq_ring_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd_,
+                   IORING_OFF_SQ_RING);
+  if (ptr == MAP_FAILED) return -errno;
+  sq_ring_ = ptr;
+
+  if (is_single_mmap) {
+    cq_ring_ = sq_ring_;
+  } else {
+    ptr = mmap(NULL, cq_ring_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd_,
+               IORING_OFF_CQ_RING);
+    if (ptr == MAP_FAILED) return -errno;
+    cq_ring_ = ptr;
+  }
+
+  sqes_size_ = params.sq_entries * sizeof(struct io_uring_sqe);
+  ptr = mmap(NULL, sqes_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd_,
+             IORING_OFF_SQES);
+  if (ptr == MAP_FAILED) return -errno;
+  sqes_ = static_cast<struct io_uring_sqe*>(ptr);
+
+  char* sq = static_cast<char*>(sq_ring_);
+  sq_head_ = reinterpret_cast<unsigned*>(sq + params.sq_off.head);
+  sq_tail_ = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+  sq_mask_ = *reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+  sq_entries_ = params.sq_entries;
+  sq_flags_ = reinterpret_cast<unsigned*>(sq + params.sq_off.flags);
+  sq_array_ = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+
+  char* cq = static_cast<char*>(cq_ring_);
+  cq_head_ = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+  cq_tail_ = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+  cq_mask_ = *reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+  cqes_ = reinterpret_cast<struct io_uring_cqe*>(cq + params.cq_off.cqes);
+
+  init_read_buffers();
+
+  int rc;
+  AllocatedT<uv_check_t>* check = new AllocatedT<uv_check_t>();
+  rc = uv_check_init(loop, check);
+  if (rc != 0) {
+    delete check;
+    return rc;
+  }
+  check_ = check;
+  check_->data = this;
+  uv_check_start(check_, on_check);
+  uv_unref(reinterpret_cast<uv_handle_t*>(check_));
+
+  AllocatedT<uv_idle_t>* idle = new AllocatedT<uv_idle_t>();
+  rc = uv_idle_init(loop, idle);
+  if (rc != 0) {
+    delete idle;
+    return rc;
+  }
+  idle_ = idle;
+  idle_->data = this;
+  uv_unref(reinterpret_cast<uv_handle_t*>(idle_));
+
+  AllocatedT<uv_poll_t>* poll = new AllocatedT<uv_poll_t>();
+  rc = uv_poll_init(loop, poll, fd_);
+  if (rc != 0) {
+    delete poll;
+    return rc;
+  }
+  poll_ = poll;
+  poll_->data = this;
+  rc = uv_poll_start(poll_, UV_READABLE, on_poll);
+  if (rc != 0) return rc;
+  uv_unref(reinterpret_cast<uv_handle_t*>(poll_));
+
+  return 0;
+}
+
+void IoUring::close_handles() {
+  is_closing_ = true;
+  if (pending_count_ > 0) submit(0);
+  if (check_ != NULL) {
+    uv_close(reinterpret_cast<uv_handle_t*>(check_), on_close_handle<uv_check_t>);
+    check_ = NULL;
+  }
+  if (idle_ != NULL) {
+    uv_close(reinterpret_cast<uv_handle_t*>(idle_), on_close_handle<uv_idle_t>);
+    idle_ = NULL;
+  }
+  if (poll_ != NULL) {
+    uv_close(reinterpret_cast<uv_handle_t*>(poll_), on_close_handle<uv_poll_t>);
+    poll_ = NULL;
+  }
+}
+
+int IoUring::sendmsg(int fd, const struct msghdr* msg, Operation* operation) {
+  struct io_uring_sqe* sqe = get_sqe();
+  if (sqe == NULL) return UV_ENOBUFS;
+  sqe->opcode = IORING_OP_SENDMSG;
+  sqe->fd = fd;
+  sqe->addr = reinterpret_cast<uintptr_t>(msg);
+  sqe->len = 1;
+  sqe->msg_flags = MSG_NOSIGNAL;
+  sqe->user_data = reinterpret_cast<uintptr_t>(operation);
+  push_sqe();
+  return 0;
+}
+
+#ifdef HAVE_IO_URING_RECV_MULTISHOT
+int IoUring::recv_multishot(int fd, Operation* operation) {
+  if (!has_read_buffers()) return UV_ENOTSUP;
+  struct io_uring_sqe* sqe = get_sqe();
+  if (sqe == NULL) return UV_ENOBUFS;
+  sqe->opcode = IORING_OP_RECV;
+  sqe->fd = fd;
+  sqe->ioprio = IORING_RECV_MULTISHOT;
+  sqe->flags = IOSQE_BUFFER_SELECT;
+  sqe->buf_group = READ_BUFFER_GROUP;
+  sqe->user_data = reinterpret_cast<uintptr_t>(operation);
+  push_sqe();
+  operation->is_multishot_ = true;
+  if (multishot_count_++ == 0 && poll_ != NULL) {
+    uv_ref(reinterpret_cast<uv_handle_t*>(poll_));
+  }
+  return 0;
+}
+
+char* IoUring::read_buffer(unsigned flags) const {
+  assert((flags & IORING_CQE_F_BUFFER) && "Completion doesn't have a buffer");
+  unsigned id = flags >> IORING_CQE_BUFFER_SHIFT;
+  return read_buffers_ + id * READ_BUFFER_SIZE;
+}
+
+void IoUring::recycle_read_buffer(unsigned flags) {
+  assert((flags & IORING_CQE_F_BUFFER) && "Completion doesn't have a buffer");
+  unsigned id = flags >> IORING_CQE_BUFFER_SHIFT;
+  // The ring is accessed as an array of buffers because `io_uring_buf_ring`
+  // doesn't have the kernel's layout in C++ (its flexible array is offset by
+  // an empty struct). The tail overlays the first buffer's reserved field.
+  struct io_uring_buf* bufs = static_cast<struct io_uring_buf*>(buf_ring_);
+  struct io_uring_buf* buf = &bufs[buf_ring_tail_ & (READ_BUFFER_COUNT - 1)];
+  buf->addr = reinterpret_cast<uintptr_t>(read_buffers_ + id * READ_BUFFER_SIZE);
+  buf->len = READ_BUFFER_SIZE;
+  buf->bid = static_cast<unsigned short>(id);
+  __atomic_store_n(&bufs[0].resv, ++buf_ring_tail_, __ATOMIC_RELEASE);
+}
+
+// The buffers are only used for multishot receives so the ring isn't
+// registered if the kernel headers don't have them.
+void IoUring::init_read_buffers() {
+  buf_ring_size_ = READ_BUFFER_COUNT * sizeof(struct io_uring_buf);
+  void* ptr = mmap(NULL, buf_ring_size_, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1,
+                   0);
+  if (ptr == MAP_FAILED) return;
+  buf_ring_ = ptr;
+
+  read_buffers_size_ = READ_BUFFER_COUNT * READ_BUFFER_SIZE;
+  ptr = mmap(NULL, read_buffers_size_, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1,
+             0);
+  if (ptr == MAP_FAILED) {
+    read_buffers_size_ = 0;
+    munmap(buf_ring_, buf_ring_size_);
+    buf_ring_ = NULL;
+    return;
+  }
+  read_buffers_ = static_cast<char*>(ptr);
+
+  struct io_uring_buf_reg reg;
+  memset(&reg, 0, sizeof(reg));
+  reg.ring_addr = reinterpret_cast<uintptr_t>(buf_ring_);
+  reg.ring_entries = READ_BUFFER_COUNT;
+  reg.bgid = READ_BUFFER_GROUP;
+  if (sys_io_uring_register(fd_, IORING_REGISTER_PBUF_RING, &reg, 1) < 0) {
+    LOG_DEBUG("Unable to register io_uring read buffers, socket reads will use libuv: %s",
+              uv_strerror(-errno));
+    munmap(read_buffers_, read_buffers_size_);
+    read_buffers_ = NULL;
+    read_buffers_size_ = 0;
+    munmap(buf_ring_, buf_ring_size_);
+    buf_ring_ = NULL;
+    return;
+  }
+
+  for (unsigned id = 0; id < READ_BUFFER_COUNT; ++id) {
+    recycle_read_buffer(IORING_CQE_F_BUFFER | (id << IORING_CQE_BUFFER_SHIFT));
+  }
+}
+#else
+int IoUring::recv_multishot(int fd, Operation* operation) { return UV_ENOTSUP; }
+
+char* IoUring::read_buffer(unsigned flags) const { return NULL; }
+
+void IoUring::recycle_read_buffer(unsigned flags) {}
+
+void IoUring::init_read_buffers() {}
+#endif
+
+void IoUring::disable_recv_multishot() {
+  if (!is_recv_multishot_disabled_) {
+    LOG_WARN("Multishot io_uring receives are not supported, socket reads will use libuv");
+    is_recv_multishot_disabled_ = true;
+  }
+}
+
+void IoUring::cancel(Operation* operation) {
+  if (pending_count_ > 0) {
+    submit(0);
+    if (pending_count_ > 0) discard_pending(operation);
+  }
+
+  struct io_uring_sqe* sqe = get_sqe();
+  if (sqe == NULL) return; // The operation still completes on its own
+  sqe->opcode = IORING_OP_ASYNC_CANCEL;
+  sqe->fd = -1;
+  sqe->addr = reinterpret_cast<uintptr_t>(operation);
+  sqe->user_data = 0; // The cancel's own completion is ignored
+  push_sqe();
+}
+
+struct io_uring_sqe* IoUring::get_sqe() {
+  // The loop's thread is the only producer so the tail doesn't change
+  // underneath us.
+  unsigned tail = *sq_tail_;
+  if (tail - load_acquire(sq_head_) >= sq_entries_) {
+    // The submission queue is full so the queued operations are submitted now
+    if (submit(0) < 0 || tail - load_acquire(sq_head_) >= sq_entries_) {
+      return NULL;
+    }
+  }
+
+  unsigned index = tail & sq_mask_;
+  struct io_uring_sqe* sqe = &sqes_[index];
+  memset(sqe, 0, sizeof(*sqe));
+  sq_array_[index] = index;
+  return sqe;
+}
+
+void IoUring::push_sqe() {
+  store_release(sq_tail_, *sq_tail_ + 1);
+  if (++pending_count_ == 1) {
+    if (is_closing_) {
+      submit(0);
+    } else {
+      uv_idle_start(idle_, on_idle);
+    }
+  }
+}
+
+// The kernel only reads the submission queue while it's being entered, so
+// queued entries can still be changed.
+void IoUring::discard_pending(Operation* operation) {
+  unsigned tail = *sq_tail_;
+  for (unsigned i = tail - pending_count_; i != tail; ++i) {
+    struct io_uring_sqe* sqe = &sqes_[sq_array_[i & sq_mask_]];
+    if (sqe->user_data == reinterpret_cast<uintptr_t>(operation)) {
+      memset(sqe, 0, sizeof(*sqe));
+      sqe->opcode = IORING_OP_NOP;
+      sqe->fd = -1;
+      sqe->user_data = reinterpret_cast<uintptr_t>(operation) | DISCARDED_TAG;
+    }
+  }
+}
+
+int IoUring::submit(unsigned min_complete) {
+  int rc;
+  do {
+    rc = sys_io_uring_enter(fd_, pending_count_, min_complete,
+                            min_complete > 0 ? IORING_ENTER_GETEVENTS : 0);
+  } while (rc < 0 && errno == EINTR);
+
+  if (rc < 0) {
+    rc = -errno;
+    // The queue is retried on the next iteration if the kernel is busy
+    if (rc != UV_EAGAIN && rc != UV_EBUSY) {
+      LOG_ERROR("Unable to submit io_uring operations: %s", uv_strerror(rc));
+    }
+    return rc;
+  }
+
+  pending_count_ -= rc;
+  outstanding_count_ += rc;
+  if (pending_count_ == 0 && idle_ != NULL) {
+    uv_idle_stop(idle_);
+  }
+  return rc;
+}
+
+void IoUring::process_completions() {
+  unsigned head = *cq_head_;
+  for (;;) {
+    if (head == load_acquire(cq_tail_)) {
+#ifdef IORING_SQ_CQ_OVERFLOW
+      // Completions that didn't fit in the completion queue are held by the
+      // kernel until they're flushed.
+      if (load_acquire(sq_flags_) & IORING_SQ_CQ_OVERFLOW) {
+        sys_io_uring_enter(fd_, 0, 0, IORING_ENTER_GETEVENTS);
+        if (head != load_acquire(cq_tail_)) continue;
+      }
+#endif
+      break;
+    }
+
+    struct io_uring_cqe* cqe = &cqes_[head & cq_mask_];
+    uintptr_t user_data = static_cast<uintptr_t>(cqe->user_data);
+    Operation* operation = reinterpret_cast<Operation*>(user_data & ~DISCARDED_TAG);
+    int result = (user_data & DISCARDED_TAG) ? -ECANCELED : cqe->res;
+    unsigned flags = (user_data & DISCARDED_TAG) ? 0 : cqe->flags;
+
+    // The entry is returned to the kernel before running the callback because
+    // the callback can queue more operations.
+    store_release(cq_head_, ++head);
+
+#ifdef HAVE_IO_URING_RECV_MULTISHOT
+    if (flags & IORING_CQE_F_MORE) {
+      if (operation != NULL) operation->on_complete(result, flags);
+      continue;
+    }
+#endif
+
+    // The operation is finished
+    outstanding_count_--;
+    if (operation != NULL && operation->is_multishot_) {
+      operation->is_multishot_ = false;
+      if (--multishot_count_ == 0 && poll_ != NULL) {
+        uv_unref(reinterpret_cast<uv_handle_t*>(poll_));
+      }
+    }
+
+    if (operation != NULL) {
+      operation->on_complete(result, flags);
+    }
+  }
+}
+
+void IoUring::on_check(uv_check_t* check) {
+  IoUring* io_uring = static_cast<IoUring*>(check->data);
+  if (io_uring->pending_count_ > 0) {
+    io_uring->submit(0);
+  }
+}
+
+void IoUring::on_idle(uv_idle_t* idle) {
+  // Nothing to do. The idle handle only keeps the loop from blocking before
+  // the queued operations are submitted.
+}
+
+void IoUring::on_poll(uv_poll_t* poll, int status, int events) {
+  IoUring* io_uring = static_cast<IoUring*>(poll->data);
+  io_uring->process_completions();
+}
+
+#endif
@@ -0,0 +1,251 @@
+/*
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifndef DATASTAX_INTERNAL_IO_URING_HPP
+#define DATASTAX_INTERNAL_IO_URING_HPP
+
+#include "driver_config.hpp"
+
+#ifdef HAVE_IO_URING
+
+#include "allocated.hpp"
+#include "loop_context.hpp"
+#include "macros.hpp"
+
+#include <linux/io_uring.h>
+#include <sys/socket.h>
+#include <uv.h>
+
+// Multishot receives into provided buffers need Linux 6.0+ headers
+#ifdef IORING_RECV_MULTISHOT
+#define HAVE_IO_URING_RECV_MULTISHOT
+#endif
+
+namespace datastax { namespace internal { namespace core {
+
+/**
+ * An io_uring submission and completion queue for an event loop (Linux only).
+ * Operations queued during a loop iteration are submitted together, with a
+ * single system call, in the loop's check phase, and their completions are
+ * handled when the ring's file descriptor becomes readable.
+ *
+ * If the kernel supports it (Linux 6.0+), the ring also has a set of read
+ * buffers that are shared by the loop's sockets. A multishot receive picks a
+ * free buffer for each read so a socket keeps receiving without a system call
+ * per read and without a buffer of its own.
+ *
+ * The ring is bound to its event loop's thread (see `current()`) and it's
+ * not thread-safe.
+ */
+class IoUring : public Allocated {
+public:
+  /**
+   * An operation submitted to the ring.
+   */
+  class Operation {
+  public:
+    Operation()
+        : is_multishot_(false) {}
+
+    virtual ~Operation() {}
+
+    /**
+     * A callback for handling the completion of the operation.
+     *
+     * @param result The result of the operation. It's a negated errno value
+     * if an error occurred.
+     * @param flags The completion's flags (IORING_CQE_F_*). A multishot
+     * operation has more completions if IORING_CQE_F_MORE is set.
+     */
+    virtual void on_complete(int result, unsigned flags) = 0;
+
+  private:
+    friend class IoUring;
+    bool is_multishot_; // An outstanding multishot operation keeps the loop alive
+  };
+
+  IoUring();
+  ~IoUring();
+
+  /**
+   * Create the ring and start its handles on the event loop. The handles
+   * don't keep the event loop alive.
+   *
+   * @param loop
+   * @param entries The size of the submission queue.
+   * @return 0 if successful, otherwise an error occurred.
+   */
+  int init(uv_loop_t* loop, unsigned entries);
+
+  /**
+   * Close the ring's handles. Operations queued afterwards are submitted
+   * immediately and their completions are handled when the ring is
+   * destroyed.
+   */
+  void close_handles();
+
+  /**
+   * Queue a sendmsg() operation.
+   *
+   * @param fd
+   * @param msg The message (must remain valid until the operation completes).
+   * @param operation The operation's completion callback.
+   * @return 0 if successful, otherwise an error occurred.
+   */
+  int sendmsg(int fd, const struct msghdr* msg, Operation* operation);
+
+  /**
+   * Determine if multishot receives into the ring's read buffers are
+   * supported.
+   *
+   * @return true if supported.
+   */
+  bool has_read_buffers() const { return buf_ring_ != NULL && !is_recv_multishot_disabled_; }
+
+  /**
+   * Queue a multishot recv() operation. Each read has its own completion and
+   * the data is in the read buffer selected by the kernel (see
+   * `read_buffer()`). The operation finishes when a completion doesn't have
+   * IORING_CQE_F_MORE set e.g. when it fails with -ENOBUFS because all the
+   * read buffers are in use. It's then queued again by the caller.
+   *
+   * Like a libuv stream that's reading, the event loop is kept alive until
+   * the operation finishes.
+   *
+   * @param fd
+   * @param operation The operation's completion callback.
+   * @return 0 if successful, otherwise an error occurred.
+   */
+  int recv_multishot(int fd, Operation* operation);
+
+  /**
+   * Disable multishot receives because the kernel doesn't support them
+   * (a receive failed with -EINVAL).
+   */
+  void disable_recv_multishot();
+
+  /**
+   * Get the read buffer that was selected for a completion.
+   *
+   * @param flags The completion's flags. IORING_CQE_F_BUFFER must be set.
+   * @return The read buffer.
+   */
+  char* read_buffer(unsigned flags) const;
+
+  /**
+   * Return a read buffer to the ring once its data has been handled.
+   *
+   * @param flags The completion's flags. IORING_CQE_F_BUFFER must be set.
+   */
+  void recycle_read_buffer(unsigned flags);
+
+  /**
+   * Determine if a buffer is one of the ring's read buffers.
+   *
+   * @param buf
+   * @return true if it's a read buffer.
+   */
+  bool is_read_buffer(const char* buf) const {
+    return buf >= read_buffers_ && buf < read_buffers_ + read_buffers_size_;
+  }
+
+  /**
+   * Cancel an outstanding operation. The operation's completion callback is
+   * still called, with -ECANCELED if it was canceled.
+   *
+   * Queued operations are submitted first. A queued operation only refers to
+   * its file descriptor by number, and that number could be reused once the
+   * caller closes it. After submission the kernel holds a reference to the
+   * file itself. If the queue can't be submitted, the operation is replaced
+   * with a no-op.
+   *
+   * @param operation
+   */
+  void cancel(Operation* operation);
+
+public:
+  /**
+   * Get the ring of the calling thread's event loop (see `LoopContext`).
+   *
+   * @return The ring or NULL if the thread doesn't have one.
+   */
+  static IoUring* current() {
+    LoopContext* context = LoopContext::current();
+    return context != NULL ? context->io_uring : NULL;
+  }
+
+private:
+  struct io_uring_sqe* get_sqe();
+  void push_sqe();
+  void discard_pending(Operation* operation);
+  void init_read_buffers();
+  int submit(unsigned min_complete);
+  void process_completions();
+
+  static void on_check(uv_check_t* check);
+  static void on_idle(uv_idle_t* idle);
+  static void on_poll(uv_poll_t* poll, int status, int events);
+
+private:
+  int fd_;
+  void* sq_ring_;
+  size_t sq_ring_size_;
+  void* cq_ring_;
+  size_t cq_ring_size_;
+  struct io_uring_sqe* sqes_;
+  size_t sqes_size_;
+
+  unsigned* sq_head_;
+  unsigned* sq_tail_;
+  unsigned sq_mask_;
+  unsigned sq_entries_;
+  unsigned* sq_flags_;
+  unsigned* sq_array_;
+  unsigned* cq_head_;
+  unsigned* cq_tail_;
+  unsigned cq_mask_;
+  struct io_uring_cqe* cqes_;
+
+  // The provided buffer ring (NULL if it's not supported) and its buffers
+  void* buf_ring_;
+  size_t buf_ring_size_;
+  unsigned short buf_ring_tail_;
+  char* read_buffers_;
+  size_t read_buffers_size_;
+  bool is_recv_multishot_disabled_;
+
+  unsigned pending_count_;     // Queued, but not submitted
+  unsigned outstanding_count_; // Submitted, but not completed
+  unsigned multishot_count_;   // Queued or submitted multishot operations
+  bool is_closing_;
+
+  // The check handle submits the queued operations once per iteration and the
+  // idle handle keeps the loop from blocking while there are queued operations.
+  AllocatedT<uv_check_t>* check_;
+  AllocatedT<uv_idle_t>* idle_;
+  AllocatedT<uv_poll_t>* poll_;
+
+private:
+  DISALLOW_COPY_AND_ASSIGN(IoUring);
+};
+
+}}} // namespace datastax::internal::core
+
+#endif
+
+#endif
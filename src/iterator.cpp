@@ -42,6 +42,10 @@ CassIterator* cass_iterator_from_result(const CassResult* result) {
   return CassIterator::to(new ResultIterator(result));
 }
 
+CassIterator* cass_iterator_from_result_lazy(const CassResult* result) {
+  return CassIterator::to(new ResultIterator(result, true));
+}
+
 CassIterator* cass_iterator_from_row(const CassRow* row) {
   return CassIterator::to(new RowIterator(row));
 }
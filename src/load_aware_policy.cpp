@@ -0,0 +1,95 @@
+/*
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include "load_aware_policy.hpp"
+
+using namespace datastax;
+using namespace datastax::internal;
+using namespace datastax::internal::core;
+
+void LoadAwarePolicy::init(const Host::Ptr& connected_host, const HostMap& hosts, Random* random,
+                           const String& local_dc) {
+  if (use_latency_) {
+    for (HostMap::const_iterator i = hosts.begin(), end = hosts.end(); i != end; ++i) {
+      i->second->enable_latency_tracking(latency_settings_.scale_ns,
+                                         latency_settings_.min_measured);
+    }
+  }
+  ChainedLoadBalancingPolicy::init(connected_host, hosts, random, local_dc);
+}
+
+QueryPlan* LoadAwarePolicy::new_query_plan(const String& keyspace, RequestHandler* request_handler,
+                                           const TokenMap* token_map) {
+  return new LoadAwareQueryPlan(this,
+                                child_policy_->new_query_plan(keyspace, request_handler, token_map));
+}
+
+void LoadAwarePolicy::on_host_added(const Host::Ptr& host) {
+  if (use_latency_) {
+    host->enable_latency_tracking(latency_settings_.scale_ns, latency_settings_.min_measured);
+  }
+  ChainedLoadBalancingPolicy::on_host_added(host);
+}
+
+bool LoadAwarePolicy::is_less_loaded(const Host::Ptr& first, const Host::Ptr& second) const {
+  int64_t first_load = first->inflight_request_count();
+  int64_t second_load = second->inflight_request_count();
+
+  if (use_latency_) {
+    // Latencies are only used if both hosts have enough measurements,
+    // otherwise only the in-flight requests are compared.
+    TimestampedAverage first_latency = first->get_current_average();
+    TimestampedAverage second_latency = second->get_current_average();
+    if (first_latency.average >= 0 &&
+        first_latency.num_measured >= latency_settings_.min_measured &&
+        second_latency.average >= 0 &&
+        second_latency.num_measured >= latency_settings_.min_measured) {
+      // Include the request being routed so idle hosts are still compared by
+      // their latencies.
+      return static_cast<double>(first_load + 1) * first_latency.average <
+             static_cast<double>(second_load + 1) * second_latency.average;
+    }
+  }
+
+  return first_load < second_load;
+}
+
+Host::Ptr LoadAwarePolicy::LoadAwareQueryPlan::compute_next() {
+  if (is_first_) {
+    is_first_ = false;
+    Host::Ptr first = child_plan_->compute_next();
+    if (!first) return Host::Ptr();
+    second_ = child_plan_->compute_next();
+    // Ties keep the child policy's order
+    if (second_ && policy_->is_less_loaded(second_, first) &&
+        (!is_replica(first) || is_replica(second_))) {
+      Host::Ptr temp(second_);
+      second_ = first;
+      return temp;
+    }
+    return first;
+  }
+
+  if (second_) {
+    Host::Ptr temp(second_);
+    second_.reset();
+    return temp;
+  }
+
+  return child_plan_->compute_next();
+}
@@ -0,0 +1,98 @@
+/*
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifndef DATASTAX_INTERNAL_LOAD_AWARE_POLICY_HPP
+#define DATASTAX_INTERNAL_LOAD_AWARE_POLICY_HPP
+
+#include "latency_aware_policy.hpp"
+#include "load_balancing.hpp"
+#include "macros.hpp"
+#include "scoped_ptr.hpp"
+
+namespace datastax { namespace internal { namespace core {
+
+/**
+ * Routes requests away from busy hosts using the "power of two choices". The
+ * first two hosts of the child policy's query plan (e.g. two of the replicas
+ * when token-aware routing is enabled) are compared and the one with the
+ * fewest in-flight requests is tried first. In-flight requests can also be
+ * weighted by the hosts' average latencies so that a host that is slow, but
+ * not yet backed up, is avoided. The remainder of the query plan is unchanged.
+ *
+ * Only comparing two hosts, instead of always using the least loaded host,
+ * avoids sending every request to the same host in between load updates.
+ *
+ * A replica for the request's routing key is never moved behind a host that
+ * isn't a replica. Otherwise, when there is only one live replica, the less
+ * loaded non-replica would usually be tried first, adding the coordinator hop
+ * that token-aware routing avoids. The replicas are the ones found by the
+ * child token-aware query plan, so they're not looked up a second time.
+ */
+class LoadAwarePolicy : public ChainedLoadBalancingPolicy {
+public:
+  LoadAwarePolicy(LoadBalancingPolicy* child_policy, bool use_latency)
+      : ChainedLoadBalancingPolicy(child_policy)
+      , use_latency_(use_latency) {}
+
+  virtual ~LoadAwarePolicy() {}
+
+  virtual void init(const Host::Ptr& connected_host, const HostMap& hosts, Random* random,
+                    const String& local_dc);
+
+  virtual QueryPlan* new_query_plan(const String& keyspace, RequestHandler* request_handler,
+                                    const TokenMap* token_map);
+
+  virtual LoadBalancingPolicy* new_instance() {
+    return new LoadAwarePolicy(child_policy_->new_instance(), use_latency_);
+  }
+
+  virtual void on_host_added(const Host::Ptr& host);
+
+  /**
+   * @return true if the first host is less loaded than the second host.
+   */
+  bool is_less_loaded(const Host::Ptr& first, const Host::Ptr& second) const;
+
+private:
+  class LoadAwareQueryPlan : public QueryPlan {
+  public:
+    LoadAwareQueryPlan(const LoadAwarePolicy* policy, QueryPlan* child_plan)
+        : policy_(policy)
+        , child_plan_(child_plan)
+        , is_first_(true) {}
+
+    Host::Ptr compute_next();
+    bool is_replica(const Host::Ptr& host) const { return child_plan_->is_replica(host); }
+
+  private:
+    const LoadAwarePolicy* policy_;
+    ScopedPtr<QueryPlan> child_plan_;
+    bool is_first_;
+    Host::Ptr second_;
+  };
+
+  const bool use_latency_;
+  const LatencyAwarePolicy::Settings latency_settings_;
+
+private:
+  DISALLOW_COPY_AND_ASSIGN(LoadAwarePolicy);
+};
+
+}}} // namespace datastax::internal::core
+
+#endif
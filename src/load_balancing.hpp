@@ -68,6 +68,10 @@ public:
   virtual ~QueryPlan() {}
   virtual Host::Ptr compute_next() = 0;
 
+  // Whether the host is a replica for the plan's request. Only token-aware
+  // plans know the replicas, other plans return false.
+  virtual bool is_replica(const Host::Ptr& host) const { return false; }
+
   bool compute_next(Address* address) {
     Host::Ptr host = compute_next();
     if (host) {
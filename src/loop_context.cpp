@@ -0,0 +1,49 @@
+/*
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include "loop_context.hpp"
+
+#include <assert.h>
+#include <uv.h>
+
+using namespace datastax::internal::core;
+
+#ifdef THREAD_LOCAL_
+THREAD_LOCAL_ LoopContext* LoopContext::current_ = NULL;
+
+void LoopContext::set_current(LoopContext* context) { current_ = context; }
+#else
+static uv_once_t current_key_guard = UV_ONCE_INIT;
+static uv_key_t current_key;
+
+static void init_current_key() {
+  int rc = uv_key_create(&current_key);
+  UNUSED_(rc);
+  assert(rc == 0 && "Unable to create event loop context thread key");
+}
+
+LoopContext* LoopContext::current_from_key() {
+  uv_once(&current_key_guard, init_current_key);
+  return static_cast<LoopContext*>(uv_key_get(&current_key));
+}
+
+void LoopContext::set_current(LoopContext* context) {
+  uv_once(&current_key_guard, init_current_key);
+  uv_key_set(&current_key, context);
+}
+#endif
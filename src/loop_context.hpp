@@ -0,0 +1,85 @@
+/*
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifndef DATASTAX_INTERNAL_LOOP_CONTEXT_HPP
+#define DATASTAX_INTERNAL_LOOP_CONTEXT_HPP
+
+#include "macros.hpp"
+
+#include <stddef.h>
+
+namespace datastax { namespace internal {
+
+class SlabAllocator;
+
+namespace core {
+
+class IoUring;
+class ReadBufferPool;
+class ResultMetadataCache;
+
+/**
+ * The objects owned by an event loop that are only used by the loop's thread.
+ * The loop binds its context to its thread while it runs so that code deep in
+ * the read and write paths (e.g. the allocator) can find them without passing
+ * the loop around. A single thread-local pointer is used for all of them.
+ */
+struct LoopContext {
+  LoopContext()
+      : allocator(NULL)
+      , metadata_cache(NULL)
+      , read_buffer_pool(NULL)
+      , io_uring(NULL) {}
+
+  SlabAllocator* allocator;
+  ResultMetadataCache* metadata_cache;
+  ReadBufferPool* read_buffer_pool;
+  IoUring* io_uring; // NULL if the loop doesn't use io_uring
+
+  /**
+   * Get the context bound to the calling thread.
+   *
+   * @return The context or NULL if the thread isn't running an event loop.
+   */
+  static LoopContext* current() {
+#ifdef THREAD_LOCAL_
+    return current_;
+#else
+    return current_from_key();
+#endif
+  }
+
+  /**
+   * Bind a context to the calling thread.
+   *
+   * @param context The context to bind or NULL to unbind.
+   */
+  static void set_current(LoopContext* context);
+
+private:
+#ifdef THREAD_LOCAL_
+  static THREAD_LOCAL_ LoopContext* current_;
+#else
+  static LoopContext* current_from_key();
+#endif
+};
+
+} // namespace core
+}} // namespace datastax::internal
+
+#endif
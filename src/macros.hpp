@@ -19,6 +19,8 @@
 #ifndef DATASTAX_INTERNAL_MACROS_HPP
 #define DATASTAX_INTERNAL_MACROS_HPP
 
+#include "driver_config.hpp"
+
 #include <stddef.h>
 #include <string.h>
 
@@ -30,6 +32,14 @@
 
 #define UNUSED_(X) ((void)X)
 
+// Thread-local storage for plain pointers and integers. Code that uses it must
+// fall back to thread keys (uv_key_t) when it isn't defined.
+#if defined(_MSC_VER)
+#define THREAD_LOCAL_ __declspec(thread)
+#elif defined(HAVE_GCC_THREAD)
+#define THREAD_LOCAL_ __thread
+#endif
+
 #define ZERO_PARAMS1_()
 #define ZERO_PARAMS_() ZERO_PARAMS1_()
 
@@ -38,22 +38,22 @@ void cass_alloc_set_functions(CassMallocFunction malloc_func, CassReallocFunctio
 #ifdef DEBUG_CUSTOM_ALLOCATOR
 void* operator new(size_t size) throw(std::bad_alloc) {
   assert(false && "Attempted to use global operator new");
-  return cass::Memory::malloc(size);
+  return Memory::malloc(size);
 }
 
 void* operator new[](size_t size) throw(std::bad_alloc) {
   assert(false && "Attempted to use global operator new[]");
-  return cass::Memory::malloc(size);
+  return Memory::malloc(size);
 }
 
 void operator delete(void* ptr) throw() {
   assert(false && "Attempted to use global operator delete");
-  cass::Memory::free(ptr);
+  Memory::free(ptr);
 }
 
 void operator delete[](void* ptr) throw() {
   assert(false && "Attempted to use global operator delete[]");
-  cass::Memory::free(ptr);
+  Memory::free(ptr);
 }
 #endif
 
@@ -912,6 +912,15 @@ void Metadata::clear_and_update_back(const VersionNumber& server_version) {
   updating_ = &back_;
 }
 
+void Metadata::copy_front_and_update_back(const VersionNumber& server_version) {
+  {
+    ScopedMutex l(&mutex_);
+    server_version_ = server_version;
+    back_.copy(front_);
+  }
+  updating_ = &back_;
+}
+
 void Metadata::swap_to_back_and_update_front() {
   {
     ScopedMutex l(&mutex_);
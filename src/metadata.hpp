@@ -658,6 +658,11 @@ public:
   // the front buffer for snapshots.
   void clear_and_update_back(const VersionNumber& server_version);
 
+  // This copies the front buffer to the back buffer and allows updates to
+  // the back buffer. The copy shares its keyspaces with the front buffer
+  // until they're modified, so only the updated parts are copied.
+  void copy_front_and_update_back(const VersionNumber& server_version);
+
   // This swaps the back buffer to the front and makes incremental updates
   // happen directly to the front buffer.
   void swap_to_back_and_update_front();
@@ -698,6 +703,8 @@ private:
 
     void clear() { keyspaces_->clear(); }
 
+    void copy(const InternalData& other) { keyspaces_ = other.keyspaces_; }
+
     void swap(InternalData& other) {
       CopyOnWritePtr<KeyspaceMetadata::Map> temp = other.keyspaces_;
       other.keyspaces_ = keyspaces_;
@@ -0,0 +1,276 @@
+/*
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include "metadata_cache_file.hpp"
+
+#include "buffer.hpp"
+#include "control_connector.hpp"
+#include "decoder.hpp"
+#include "hash.hpp"
+#include "logger.hpp"
+#include "macros.hpp"
+
+#include <assert.h>
+#include <stdio.h>
+#include <string.h>
+
+#define METADATA_CACHE_FILE_MAGIC 0x43444d43 // "CMDC"
+#define METADATA_CACHE_FILE_FORMAT 1
+
+using namespace datastax;
+using namespace datastax::internal;
+using namespace datastax::internal::core;
+
+namespace {
+
+struct SchemaResult {
+  const char* name;
+  ResultResponse::Ptr ControlConnectionSchema::*result;
+};
+
+const SchemaResult schema_results__[] = {
+  { "keyspaces", &ControlConnectionSchema::keyspaces },
+  { "tables", &ControlConnectionSchema::tables },
+  { "views", &ControlConnectionSchema::views },
+  { "columns", &ControlConnectionSchema::columns },
+  { "indexes", &ControlConnectionSchema::indexes },
+  { "user_types", &ControlConnectionSchema::user_types },
+  { "functions", &ControlConnectionSchema::functions },
+  { "aggregates", &ControlConnectionSchema::aggregates },
+  { "virtual_keyspaces", &ControlConnectionSchema::virtual_keyspaces },
+  { "virtual_tables", &ControlConnectionSchema::virtual_tables },
+  { "virtual_columns", &ControlConnectionSchema::virtual_columns }
+};
+
+ResultResponse::Ptr* find_schema_result(ControlConnectionSchema* schema, const StringRef& name) {
+  for (size_t i = 0; i < sizeof(schema_results__) / sizeof(schema_results__[0]); ++i) {
+    if (name == schema_results__[i].name) {
+      return &(schema->*schema_results__[i].result);
+    }
+  }
+  return NULL;
+}
+
+uint64_t checksum(const char* data, size_t size) {
+  return static_cast<uint64_t>(hash::fnv1a(data, size));
+}
+
+bool read_file(const String& path, String* contents) {
+  FILE* file = fopen(path.c_str(), "rb");
+  if (file == NULL) return false;
+
+  bool is_read = false;
+  if (fseek(file, 0, SEEK_END) == 0) {
+    long size = ftell(file);
+    if (size >= 0 && fseek(file, 0, SEEK_SET) == 0) {
+      contents->resize(static_cast<size_t>(size));
+      is_read = size == 0 || fread(&(*contents)[0], 1, contents->size(), file) == contents->size();
+    }
+  }
+
+  fclose(file);
+  return is_read;
+}
+
+bool write_file(const String& path, const char* data, size_t size) {
+  FILE* file = fopen(path.c_str(), "wb");
+  if (file == NULL) return false;
+  bool is_written = fwrite(data, 1, size, file) == size;
+  return fclose(file) == 0 && is_written;
+}
+
+} // namespace
+
+void MetadataCacheFile::read(uv_loop_t* loop, const Callback& callback) {
+  callback_ = callback;
+  inc_ref(); // For the thread pool
+  int rc = uv_queue_work(loop, &req_, on_read, on_after_read);
+  if (rc != 0) {
+    LOG_WARN("Unable to read metadata cache file %s: %s", path_.c_str(), uv_strerror(rc));
+    callback_(this);
+    dec_ref();
+  }
+}
+
+void MetadataCacheFile::on_read(uv_work_t* req) {
+  MetadataCacheFile* file = static_cast<MetadataCacheFile*>(req->data);
+  file->is_read_ = read_file(file->path_, &file->contents_);
+}
+
+void MetadataCacheFile::on_after_read(uv_work_t* req, int status) {
+  MetadataCacheFile* file = static_cast<MetadataCacheFile*>(req->data);
+  file->callback_(file);
+  file->dec_ref();
+}
+
+bool MetadataCacheFile::load(const Key& key, ControlConnectionSchema* schema) const {
+  if (!is_read_) {
+    LOG_DEBUG("Unable to read metadata cache file %s", path_.c_str());
+    return false;
+  }
+
+  const String& contents = contents_;
+
+  if (contents.size() < sizeof(int64_t)) {
+    LOG_WARN("Metadata cache file %s is truncated", path_.c_str());
+    return false;
+  }
+
+  size_t size = contents.size() - sizeof(int64_t);
+  Decoder checksum_decoder(contents.data() + size, sizeof(int64_t));
+  int64_t expected_checksum = 0;
+  if (!checksum_decoder.decode_int64(expected_checksum) ||
+      static_cast<uint64_t>(expected_checksum) != checksum(contents.data(), size)) {
+    LOG_WARN("Metadata cache file %s is invalid (checksum mismatch)", path_.c_str());
+    return false;
+  }
+
+  Decoder decoder(contents.data(), size, key.protocol_version);
+  decoder.set_type("metadata cache file");
+
+  int32_t magic = 0;
+  uint16_t format = 0;
+  if (!decoder.decode_int32(magic) || magic != METADATA_CACHE_FILE_MAGIC ||
+      !decoder.decode_uint16(format) || format != METADATA_CACHE_FILE_FORMAT) {
+    LOG_WARN("Metadata cache file %s has an unsupported format", path_.c_str());
+    return false;
+  }
+
+  int32_t protocol_version = 0, major_version = 0, minor_version = 0, patch_version = 0;
+  uint8_t use_schema = 0;
+  StringRef schema_version;
+  if (!decoder.decode_int32(protocol_version) || !decoder.decode_int32(major_version) ||
+      !decoder.decode_int32(minor_version) || !decoder.decode_int32(patch_version) ||
+      !decoder.decode_byte(use_schema) || !decoder.decode_string(&schema_version)) {
+    return false;
+  }
+
+  if (protocol_version != key.protocol_version.value() ||
+      VersionNumber(major_version, minor_version, patch_version)
+              .compare(key.server_version) != 0 ||
+      (use_schema != 0) != key.use_schema || schema_version != key.schema_version) {
+    LOG_DEBUG("Metadata cache file %s is out of date", path_.c_str());
+    return false;
+  }
+
+  uint16_t count = 0;
+  if (!decoder.decode_uint16(count)) return false;
+
+  ControlConnectionSchema temp;
+  for (uint16_t i = 0; i < count; ++i) {
+    StringRef name, encoded;
+    if (!decoder.decode_string(&name) || !decoder.decode_bytes(&encoded)) return false;
+
+    ResultResponse::Ptr* result = find_schema_result(&temp, name);
+    if (result == NULL) {
+      LOG_WARN("Metadata cache file %s contains an unknown result \"%.*s\"", path_.c_str(),
+               static_cast<int>(name.size()), name.data());
+      return false;
+    }
+
+    ResultResponse::Ptr response(new ResultResponse());
+    response->set_buffer(encoded.size());
+    memcpy(response->data(), encoded.data(), encoded.size());
+    Decoder result_decoder(response->data(), encoded.size(), key.protocol_version);
+    if (!response->decode(result_decoder)) return false;
+    *result = response;
+  }
+
+  *schema = temp;
+  return true;
+}
+
+void MetadataCacheFile::save(uv_loop_t* loop, const Key& key,
+                             const ControlConnectionSchema& schema) {
+  const size_t num_results = sizeof(schema_results__) / sizeof(schema_results__[0]);
+
+  size_t size = sizeof(int32_t) + sizeof(uint16_t) + 4 * sizeof(int32_t) + sizeof(uint8_t) +
+                sizeof(uint16_t) + key.schema_version.size() + sizeof(uint16_t);
+  uint16_t count = 0;
+  for (size_t i = 0; i < num_results; ++i) {
+    const ResultResponse::Ptr& result = schema.*schema_results__[i].result;
+    if (result) {
+      size += sizeof(uint16_t) + strlen(schema_results__[i].name) + sizeof(int32_t) +
+              result->encoded_result().size();
+      count++;
+    }
+  }
+  size += sizeof(int64_t);
+
+  Buffer buf(size);
+  size_t pos = buf.encode_int32(0, METADATA_CACHE_FILE_MAGIC);
+  pos = buf.encode_uint16(pos, METADATA_CACHE_FILE_FORMAT);
+  pos = buf.encode_int32(pos, key.protocol_version.value());
+  pos = buf.encode_int32(pos, key.server_version.major_version());
+  pos = buf.encode_int32(pos, key.server_version.minor_version());
+  pos = buf.encode_int32(pos, key.server_version.patch_version());
+  pos = buf.encode_byte(pos, key.use_schema ? 1 : 0);
+  pos = buf.encode_string(pos, key.schema_version.data(),
+                          static_cast<uint16_t>(key.schema_version.size()));
+  pos = buf.encode_uint16(pos, count);
+  for (size_t i = 0; i < num_results; ++i) {
+    const ResultResponse::Ptr& result = schema.*schema_results__[i].result;
+    if (result) {
+      StringRef encoded(result->encoded_result());
+      pos = buf.encode_string(pos, schema_results__[i].name,
+                              static_cast<uint16_t>(strlen(schema_results__[i].name)));
+      pos = buf.encode_bytes(pos, encoded.data(), static_cast<int32_t>(encoded.size()));
+    }
+  }
+  pos = buf.encode_int64(pos, static_cast<int64_t>(checksum(buf.data(), pos)));
+  assert(pos == size);
+  UNUSED_(pos);
+
+  buffer_ = buf;
+  inc_ref(); // For the thread pool
+  int rc = uv_queue_work(loop, &req_, on_write, on_after_write);
+  if (rc != 0) {
+    LOG_WARN("Unable to write metadata cache file %s: %s", path_.c_str(), uv_strerror(rc));
+    dec_ref();
+  }
+}
+
+void MetadataCacheFile::on_write(uv_work_t* req) {
+  MetadataCacheFile* file = static_cast<MetadataCacheFile*>(req->data);
+  const String& path = file->path_;
+
+  String temp_path(path + ".tmp");
+  if (!write_file(temp_path, file->buffer_.data(), file->buffer_.size())) {
+    file->error_ = "Unable to write metadata cache file " + temp_path;
+    remove(temp_path.c_str());
+    return;
+  }
+
+#if defined(_WIN32)
+  remove(path.c_str()); // Windows doesn't replace existing files
+#endif
+  if (rename(temp_path.c_str(), path.c_str()) != 0) {
+    file->error_ = "Unable to replace metadata cache file " + path;
+    remove(temp_path.c_str());
+  }
+}
+
+void MetadataCacheFile::on_after_write(uv_work_t* req, int status) {
+  MetadataCacheFile* file = static_cast<MetadataCacheFile*>(req->data);
+  if (file->error_.empty()) {
+    LOG_DEBUG("Saved schema metadata to cache file %s", file->path_.c_str());
+  } else {
+    LOG_WARN("%s", file->error_.c_str());
+  }
+  file->dec_ref();
+}
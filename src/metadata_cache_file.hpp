@@ -0,0 +1,138 @@
+/*
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifndef DATASTAX_INTERNAL_METADATA_CACHE_FILE_HPP
+#define DATASTAX_INTERNAL_METADATA_CACHE_FILE_HPP
+
+#include "buffer.hpp"
+#include "callback.hpp"
+#include "host.hpp"
+#include "protocol.hpp"
+#include "ref_counted.hpp"
+#include "string.hpp"
+#include "string_ref.hpp"
+
+#include <uv.h>
+
+namespace datastax { namespace internal { namespace core {
+
+struct ControlConnectionSchema;
+
+/**
+ * A file that caches the results of the control connection's schema queries
+ * so that they don't need to be run again when a new control connection is
+ * established (e.g. when an application is restarted).
+ *
+ * The cached results are only used when the schema version, server version,
+ * protocol version and queries used to create the cache match the connected
+ * host. The file contains the encoded results and a checksum:
+ *
+ * [int magic][uint16 format][int protocol][int major][int minor][int patch]
+ * [byte use_schema][string schema_version][uint16 n]
+ * n * ([string name][bytes result])
+ * [int64 checksum]
+ *
+ * The file is read and written using libuv's thread pool so that the event
+ * loop isn't blocked by file I/O. The results are encoded and decoded on the
+ * event loop's thread.
+ */
+class MetadataCacheFile : public RefCounted<MetadataCacheFile> {
+public:
+  typedef SharedRefPtr<MetadataCacheFile> Ptr;
+
+  typedef internal::Callback<void, MetadataCacheFile*> Callback;
+
+  /**
+   * The fields that determine if the cache file is valid for a connection.
+   */
+  struct Key {
+    Key(ProtocolVersion protocol_version, const VersionNumber& server_version, bool use_schema,
+        const StringRef& schema_version)
+        : protocol_version(protocol_version)
+        , server_version(server_version)
+        , use_schema(use_schema)
+        , schema_version(schema_version) {}
+
+    ProtocolVersion protocol_version;
+    VersionNumber server_version;
+    bool use_schema;
+    StringRef schema_version;
+  };
+
+  MetadataCacheFile(const String& path)
+      : path_(path)
+      , is_read_(false) {
+    req_.data = this;
+  }
+
+  const String& path() const { return path_; }
+
+  /**
+   * Read the cache file. The callback is run on the loop's thread once the
+   * file has been read (or failed to be read).
+   *
+   * @param loop The event loop used to run the callback.
+   * @param callback A callback that's run when the read is finished.
+   */
+  void read(uv_loop_t* loop, const Callback& callback);
+
+  /**
+   * Load the schema results from the contents of the cache file. This must be
+   * called after the file has been read.
+   *
+   * @param key The connection's versions and settings.
+   * @param schema The schema results loaded from the file.
+   * @return true if the file exists and is valid for the key, otherwise false.
+   */
+  bool load(const Key& key, ControlConnectionSchema* schema) const;
+
+  /**
+   * Replace the cache file with the specified schema results. The results are
+   * encoded immediately and the file is written in the background. It's
+   * written to a temporary file first so that a partially written file is
+   * never loaded.
+   *
+   * @param loop The event loop used to finish the write.
+   * @param key The connection's versions and settings.
+   * @param schema The schema results.
+   */
+  void save(uv_loop_t* loop, const Key& key, const ControlConnectionSchema& schema);
+
+private:
+  static void on_read(uv_work_t* req);
+  static void on_after_read(uv_work_t* req, int status);
+
+  static void on_write(uv_work_t* req);
+  static void on_after_write(uv_work_t* req, int status);
+
+private:
+  uv_work_t req_;
+  String path_;
+  String contents_;
+  bool is_read_;
+  Buffer buffer_;
+  String error_;
+  Callback callback_;
+
+private:
+  DISALLOW_COPY_AND_ASSIGN(MetadataCacheFile);
+};
+
+}}} // namespace datastax::internal::core
+
+#endif
@@ -78,6 +78,8 @@ public:
 
     void inc() { counters_[thread_state_->current_thread_id()].add(1LL); }
 
+    void inc(int64_t n) { counters_[thread_state_->current_thread_id()].add(n); }
+
     void dec() { counters_[thread_state_->current_thread_id()].sub(1LL); }
 
     int64_t sum() const {
@@ -483,7 +485,13 @@ public:
       , request_rates(&thread_state_)
       , total_connections(&thread_state_)
       , connection_timeouts(&thread_state_)
-      , request_timeouts(&thread_state_) {}
+      , request_timeouts(&thread_state_)
+      , result_metadata_cache_hits(&thread_state_)
+      , result_metadata_cache_misses(&thread_state_)
+      , reprepares(&thread_state_)
+      , coalesced_reprepares(&thread_state_)
+      , coalesced_schema_events(&thread_state_)
+      , coalesced_topology_events(&thread_state_) {}
 
   void record_request(uint64_t latency_ns) {
     // Final measurement is in microseconds
@@ -510,6 +518,15 @@ public:
   Counter connection_timeouts;
   Counter request_timeouts;
 
+  Counter result_metadata_cache_hits;
+  Counter result_metadata_cache_misses;
+
+  Counter reprepares;
+  Counter coalesced_reprepares;
+
+  Counter coalesced_schema_events;
+  Counter coalesced_topology_events;
+
   unsigned histogram_refresh_interval;
 
 private:
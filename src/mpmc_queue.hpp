@@ -127,6 +127,93 @@ public:
     return true;
   }
 
+  /**
+   * Enqueue as many of the entries as there's room for, claiming all their
+   * slots with a single update of the tail.
+   *
+   * @param data The entries to enqueue.
+   * @param count The number of entries.
+   * @return The number of entries enqueued. The entries are enqueued in order
+   * so the remaining entries start at `data + <return value>`.
+   */
+  size_t enqueue_many(const T* data, size_t count) {
+    if (count == 0) return 0;
+
+    size_t pos = tail_.load(MEMORY_ORDER_RELAXED);
+    size_t n;
+
+    for (;;) {
+      // count the consecutive empty slots starting at the tail
+      intptr_t dif = 0;
+      for (n = 0; n < count; ++n) {
+        size_t node_seq = buffer_[(pos + n) & mask_].seq.load(MEMORY_ORDER_ACQUIRE);
+        dif = (intptr_t)node_seq - (intptr_t)(pos + n);
+        if (dif != 0) break;
+      }
+
+      if (n > 0) {
+        if (tail_.compare_exchange_weak(pos, pos + n, MEMORY_ORDER_RELAXED)) {
+          break;
+        }
+      } else if (dif < 0) {
+        // the buffer is full
+        return 0;
+      } else {
+        pos = tail_.load(MEMORY_ORDER_RELAXED);
+      }
+    }
+
+    for (size_t i = 0; i < n; ++i) {
+      Node* node = &buffer_[(pos + i) & mask_];
+      node->data = data[i];
+      node->seq.store(pos + i + 1, MEMORY_ORDER_RELEASE);
+    }
+    return n;
+  }
+
+  /**
+   * Dequeue up to `max` entries, claiming all their slots with a single
+   * update of the head.
+   *
+   * @param data The dequeued entries (must have room for `max` entries).
+   * @param max The maximum number of entries to dequeue.
+   * @return The number of entries dequeued.
+   */
+  size_t dequeue_many(T* data, size_t max) {
+    if (max == 0) return 0;
+
+    size_t pos = head_.load(MEMORY_ORDER_RELAXED);
+    size_t n;
+
+    for (;;) {
+      // count the consecutive full slots starting at the head
+      intptr_t dif = 0;
+      for (n = 0; n < max; ++n) {
+        size_t node_seq = buffer_[(pos + n) & mask_].seq.load(MEMORY_ORDER_ACQUIRE);
+        dif = (intptr_t)node_seq - (intptr_t)(pos + n + 1);
+        if (dif != 0) break;
+      }
+
+      if (n > 0) {
+        if (head_.compare_exchange_weak(pos, pos + n, MEMORY_ORDER_RELAXED)) {
+          break;
+        }
+      } else if (dif < 0) {
+        // the buffer is empty
+        return 0;
+      } else {
+        pos = head_.load(MEMORY_ORDER_RELAXED);
+      }
+    }
+
+    for (size_t i = 0; i < n; ++i) {
+      Node* node = &buffer_[(pos + i) & mask_];
+      data[i] = node->data;
+      node->seq.store(pos + i + mask_ + 1, MEMORY_ORDER_RELEASE);
+    }
+    return n;
+  }
+
   bool is_empty() const {
     size_t pos = head_.load(MEMORY_ORDER_RELAXED);
     const Node* node = &buffer_[pos & mask_];
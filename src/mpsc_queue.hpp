@@ -0,0 +1,132 @@
+/*
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifndef DATASTAX_INTERNAL_MPSC_QUEUE_HPP
+#define DATASTAX_INTERNAL_MPSC_QUEUE_HPP
+
+#include "atomic.hpp"
+#include "macros.hpp"
+
+#include <stddef.h>
+
+namespace datastax { namespace internal { namespace core {
+
+/**
+ * An unbounded, intrusive multiple producer, single consumer queue based on
+ * Dmitry Vyukov's non-intrusive MPSC node-based queue[1]. Enqueuing is a
+ * single atomic exchange and never blocks or allocates; the entries are
+ * linked through the `Node` base class of `T`.
+ *
+ * A producer that has exchanged the head, but not yet linked its node, hides
+ * its own entry and the entries after it from the consumer for a moment.
+ * `dequeue()` returns false in that case. `enqueue()` only returns once the
+ * producer's node is linked, so the hidden entries always have a producer
+ * that is still inside `enqueue()`. A consumer that clears a wake-up flag
+ * before draining, and producers that check the flag after `enqueue()`
+ * returns, therefore never lose an entry: at least one of the producers
+ * behind a drain that stopped early sees the cleared flag and wakes the
+ * consumer. Wake-ups for entries that were already visible can be skipped.
+ *
+ * [1] http://www.1024cores.net/home/lock-free-algorithms/queues/intrusive-mpsc-node-based-queue
+ */
+template <class T>
+class MPSCQueue {
+public:
+  class Node {
+  public:
+    Node()
+        : next_(NULL) {}
+
+  private:
+    friend class MPSCQueue<T>;
+    Atomic<Node*> next_;
+  };
+
+  MPSCQueue()
+      : head_(&stub_)
+      , tail_(&stub_) {}
+
+  /**
+   * Add an entry. This can be called by any thread.
+   */
+  void enqueue(T* entry) { push(static_cast<Node*>(entry)); }
+
+  /**
+   * Remove the oldest entry. This must only be called by the consumer thread.
+   *
+   * @return false if the queue is empty or the next entry isn't linked yet.
+   */
+  bool dequeue(T*& entry) {
+    Node* tail = tail_;
+    Node* next = tail->next_.load(MEMORY_ORDER_ACQUIRE);
+
+    if (tail == &stub_) {
+      if (next == NULL) return false;
+      tail_ = next;
+      tail = next;
+      next = next->next_.load(MEMORY_ORDER_ACQUIRE);
+    }
+
+    if (next != NULL) {
+      tail_ = next;
+      entry = static_cast<T*>(tail);
+      return true;
+    }
+
+    // The tail is the last entry unless a producer is in the middle of
+    // linking a new entry.
+    if (tail != head_.load(MEMORY_ORDER_ACQUIRE)) return false;
+
+    // The last entry can only be removed once another node follows it
+    push(&stub_);
+    next = tail->next_.load(MEMORY_ORDER_ACQUIRE);
+    if (next != NULL) {
+      tail_ = next;
+      entry = static_cast<T*>(tail);
+      return true;
+    }
+
+    return false;
+  }
+
+  /**
+   * This must only be called by the consumer thread.
+   */
+  bool is_empty() const {
+    return tail_ == &stub_ && stub_.next_.load(MEMORY_ORDER_ACQUIRE) == NULL;
+  }
+
+private:
+  void push(Node* node) {
+    node->next_.store(NULL, MEMORY_ORDER_RELAXED);
+    Node* prev = head_.exchange(node, MEMORY_ORDER_ACQ_REL);
+    prev->next_.store(node, MEMORY_ORDER_RELEASE);
+  }
+
+private:
+  Atomic<Node*> head_; // Producers
+  Node* tail_;         // Consumer only
+  Node stub_;
+
+private:
+  DISALLOW_COPY_AND_ASSIGN(MPSCQueue);
+};
+
+}}} // namespace datastax::internal::core
+
+#endif
@@ -0,0 +1,271 @@
+/*
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include "paged_iterator.hpp"
+
+#include "request_handler.hpp"
+#include "session.hpp"
+
+using namespace datastax;
+using namespace datastax::internal;
+using namespace datastax::internal::core;
+
+extern "C" {
+
+CassPagedIterator* cass_session_execute_paged(CassSession* session, CassStatement* statement,
+                                              unsigned prefetch_pages,
+                                              size_t max_prefetch_bytes) {
+  PagedIterator::Ptr iterator(
+      new StatementPagedIterator(session, statement->from(), prefetch_pages, max_prefetch_bytes));
+  iterator->start();
+  iterator->inc_ref();
+  return CassPagedIterator::to(iterator.get());
+}
+
+cass_bool_t cass_paged_iterator_next(CassPagedIterator* iterator) {
+  return iterator->next() ? cass_true : cass_false;
+}
+
+const CassRow* cass_paged_iterator_get_row(const CassPagedIterator* iterator) {
+  return CassRow::to(iterator->row());
+}
+
+CassError cass_paged_iterator_error_code(const CassPagedIterator* iterator) {
+  return iterator->error_code();
+}
+
+void cass_paged_iterator_error_message(const CassPagedIterator* iterator, const char** message,
+                                       size_t* message_length) {
+  // The message is only set once, when the iterator fails, so the returned
+  // pointer remains valid for the lifetime of the iterator.
+  const String& error_message = iterator->error_message();
+  *message = error_message.data();
+  *message_length = error_message.length();
+}
+
+void cass_paged_iterator_free(CassPagedIterator* iterator) {
+  iterator->close();
+  iterator->dec_ref();
+}
+
+} // extern "C"
+
+// Returns a page to the iterator with the subclass's data for the request
+class PagedIterator::PageCallback : public Allocated {
+public:
+  PageCallback(PagedIterator* iterator, void* data)
+      : iterator(iterator)
+      , data(data) {}
+
+  PagedIterator::Ptr iterator;
+  void* data;
+};
+
+PagedIterator::PagedIterator(Session* session, size_t prefetch_pages, size_t max_prefetch_bytes)
+    : session_(session)
+    , prefetch_pages_(prefetch_pages)
+    , max_prefetch_bytes_(max_prefetch_bytes)
+    , prefetch_bytes_(0)
+    , pending_count_(0)
+    , is_closed_(false)
+    , error_code_(CASS_OK) {
+  uv_mutex_init(&mutex_);
+  uv_cond_init(&cond_);
+}
+
+PagedIterator::~PagedIterator() {
+  uv_mutex_destroy(&mutex_);
+  uv_cond_destroy(&cond_);
+}
+
+void PagedIterator::start() {
+  FetchVec fetches;
+  {
+    ScopedMutex l(&mutex_);
+    if (error_code_ == CASS_OK) {
+      fetch_more(true, &fetches);
+      pending_count_ += fetches.size();
+    }
+  }
+  send(fetches);
+}
+
+bool PagedIterator::next() {
+  if (current_iterator_ && current_iterator_->next()) {
+    return true;
+  }
+
+  while (true) {
+    current_iterator_.reset();
+    current_page_.reset();
+
+    FetchVec fetches;
+    {
+      ScopedMutex l(&mutex_);
+      while (pages_.empty() && pending_count_ > 0 && error_code_ == CASS_OK) {
+        uv_cond_wait(&cond_, l.get());
+      }
+
+      if (!pages_.empty()) {
+        // Pages received before a failure are still returned; the error is
+        // only reported once they've been consumed.
+        current_page_ = pages_.front();
+        pages_.pop_front();
+        prefetch_bytes_ -= current_page_->encoded_result().size();
+        // Resume prefetching now that there's room for another page
+        if (error_code_ == CASS_OK) fetch_more(false, &fetches);
+      } else {
+        if (error_code_ != CASS_OK) return false;
+        if (!has_more_pages() || is_closed_) return false;
+        // Prefetching is disabled or was paused so the next page is fetched
+        // on demand.
+        fetch_more(true, &fetches);
+        if (fetches.empty()) return false;
+      }
+      pending_count_ += fetches.size();
+    }
+
+    send(fetches);
+
+    if (current_page_) {
+      current_iterator_.reset(new ResultIterator(current_page_.get()));
+      if (current_iterator_->next()) {
+        return true;
+      }
+      // Skip empty pages
+    }
+  }
+}
+
+const Row* PagedIterator::row() const {
+  if (!current_iterator_) return NULL;
+  return current_iterator_->row();
+}
+
+CassError PagedIterator::error_code() const {
+  ScopedMutex l(&mutex_);
+  return error_code_;
+}
+
+const String& PagedIterator::error_message() const {
+  ScopedMutex l(&mutex_);
+  return error_message_;
+}
+
+void PagedIterator::close() {
+  ScopedMutex l(&mutex_);
+  is_closed_ = true;
+}
+
+bool PagedIterator::has_room() const {
+  return !is_closed_ && error_code_ == CASS_OK && pages_.size() < prefetch_pages_ &&
+         (max_prefetch_bytes_ == 0 || prefetch_bytes_ < max_prefetch_bytes_);
+}
+
+void PagedIterator::add_page(const ResultResponse::Ptr& result) {
+  if (result->kind() == CASS_RESULT_KIND_ROWS && result->row_count() > 0) {
+    pages_.push_back(result);
+    prefetch_bytes_ += result->encoded_result().size();
+  }
+}
+
+void PagedIterator::set_error(CassError code, const String& message) {
+  if (error_code_ == CASS_OK) {
+    error_code_ = code;
+    error_message_ = message;
+  }
+}
+
+void PagedIterator::on_page(CassFuture* future, void* data) {
+  PageCallback* callback = static_cast<PageCallback*>(data);
+  callback->iterator->handle_page(future->from(), callback->data);
+  delete callback;
+}
+
+void PagedIterator::handle_page(Future* future, void* data) {
+  Future::Error* error = future->error();
+
+  FetchVec fetches;
+  {
+    ScopedMutex l(&mutex_);
+    pending_count_--;
+
+    if (error) {
+      on_error(data, *error, &fetches);
+    } else {
+      on_result(data, ResultResponse::Ptr(static_cast<ResponseFuture*>(future)->response()),
+                &fetches);
+    }
+    pending_count_ += fetches.size();
+
+    uv_cond_broadcast(&cond_);
+  }
+
+  send(fetches);
+}
+
+// This must be called without holding the lock because the callback is run
+// immediately if the request fails right away.
+void PagedIterator::send(const FetchVec& fetches) {
+  for (FetchVec::const_iterator it = fetches.begin(), end = fetches.end(); it != end; ++it) {
+    Future::Ptr future(session_->execute(it->request));
+    future->set_callback(on_page, new PageCallback(this, it->data));
+  }
+}
+
+StatementPagedIterator::StatementPagedIterator(Session* session, Statement* statement,
+                                               size_t prefetch_pages, size_t max_prefetch_bytes)
+    : PagedIterator(session, prefetch_pages, max_prefetch_bytes)
+    , request_(statement)
+    , statement_(statement)
+    , has_more_pages_(true) {
+  if (statement_->result_chunk_callback()) {
+    // The rows would only be passed to the callback instead of the iterator
+    set_error(CASS_ERROR_LIB_BAD_PARAMS,
+              "Paged iterators don't support statements with a result chunk callback");
+    has_more_pages_ = false;
+    return;
+  }
+  // Only the paging state changes from page to page so the rest of the
+  // statement's request is re-used.
+  statement_->freeze();
+}
+
+void StatementPagedIterator::fetch_more(bool is_needed, FetchVec* fetches) {
+  if (has_more_pages_ && pending_count() == 0 && (is_needed || has_room())) {
+    fetches->push_back(Fetch(request_, NULL));
+  }
+}
+
+void StatementPagedIterator::on_result(void* data, const ResultResponse::Ptr& result,
+                                       FetchVec* fetches) {
+  add_page(result);
+
+  has_more_pages_ = result->has_more_pages();
+  if (has_more_pages_) {
+    // The request for the next page is only sent after this returns so it's
+    // safe to update the statement.
+    statement_->set_paging_state(result->paging_state().to_string());
+  }
+
+  fetch_more(false, fetches);
+}
+
+void StatementPagedIterator::on_error(void* data, const Future::Error& error, FetchVec* fetches) {
+  set_error(error.code, error.message);
+}
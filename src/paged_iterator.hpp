@@ -0,0 +1,185 @@
+/*
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifndef DATASTAX_INTERNAL_PAGED_ITERATOR_HPP
+#define DATASTAX_INTERNAL_PAGED_ITERATOR_HPP
+
+#include "cassandra.h"
+#include "deque.hpp"
+#include "external.hpp"
+#include "future.hpp"
+#include "ref_counted.hpp"
+#include "result_iterator.hpp"
+#include "result_response.hpp"
+#include "scoped_lock.hpp"
+#include "scoped_ptr.hpp"
+#include "statement.hpp"
+#include "string.hpp"
+#include "vector.hpp"
+
+#include <uv.h>
+
+namespace datastax { namespace internal { namespace core {
+
+class Session;
+
+/**
+ * An iterator over the rows of the pages of one or more requests. Requests
+ * for the following pages are sent as pages are received (instead of when the
+ * application finishes reading the previous page) so the round trips are
+ * overlapped with the application processing the rows. Pages are received
+ * ahead of the application until either the maximum number of pages or the
+ * maximum number of bytes are buffered.
+ *
+ * Subclasses decide which requests to send; they're called with the
+ * iterator's lock held and return the requests to send in a `FetchVec`. The
+ * requests are sent after the lock is released.
+ */
+class PagedIterator : public RefCounted<PagedIterator> {
+public:
+  typedef SharedRefPtr<PagedIterator> Ptr;
+
+  virtual ~PagedIterator();
+
+  /**
+   * Send the requests for the first pages.
+   */
+  void start();
+
+  /**
+   * Advance to the next row, waiting for the next page if necessary.
+   *
+   * @return false if there are no more rows or an error occurred.
+   */
+  bool next();
+
+  const Row* row() const;
+
+  CassError error_code() const;
+  const String& error_message() const;
+
+  /**
+   * Stop requesting pages. Outstanding requests are allowed to finish.
+   */
+  void close();
+
+protected:
+  struct Fetch {
+    Fetch(const Request::ConstPtr& request, void* data)
+        : request(request)
+        , data(data) {}
+
+    Request::ConstPtr request;
+    void* data; // Returned to `on_result()` or `on_error()`
+  };
+
+  typedef Vector<Fetch> FetchVec;
+
+  PagedIterator(Session* session, size_t prefetch_pages, size_t max_prefetch_bytes);
+
+  /**
+   * Determine the requests to send for the following pages.
+   *
+   * @param is_needed True if the application is waiting and there are no
+   * pages buffered or outstanding requests.
+   * @param fetches The requests to send.
+   */
+  virtual void fetch_more(bool is_needed, FetchVec* fetches) = 0;
+
+  /**
+   * Handle a page, adding it and determining the requests to send for the
+   * following pages.
+   */
+  virtual void on_result(void* data, const ResultResponse::Ptr& result, FetchVec* fetches) = 0;
+
+  /**
+   * Handle a failed request, either by failing the iterator or retrying.
+   */
+  virtual void on_error(void* data, const Future::Error& error, FetchVec* fetches) = 0;
+
+  /**
+   * @return true if there are pages that haven't been requested.
+   */
+  virtual bool has_more_pages() const = 0;
+
+  // The following are called with the lock held
+
+  bool has_room() const;
+  size_t pending_count() const { return pending_count_; }
+  void add_page(const ResultResponse::Ptr& result);
+  void set_error(CassError code, const String& message);
+
+private:
+  class PageCallback;
+
+  static void on_page(CassFuture* future, void* data);
+  void handle_page(Future* future, void* data);
+
+  void send(const FetchVec& fetches);
+
+private:
+  typedef Deque<ResultResponse::Ptr> PageQueue;
+
+  Session* const session_;
+  const size_t prefetch_pages_;
+  const size_t max_prefetch_bytes_;
+
+  mutable uv_mutex_t mutex_;
+  uv_cond_t cond_;
+  PageQueue pages_;
+  size_t prefetch_bytes_;
+  size_t pending_count_;
+  bool is_closed_;
+  CassError error_code_;
+  String error_message_;
+
+  // Only accessed by the application's thread
+  ResultResponse::Ptr current_page_;
+  ScopedPtr<ResultIterator> current_iterator_;
+
+private:
+  DISALLOW_COPY_AND_ASSIGN(PagedIterator);
+};
+
+/**
+ * Iterates over the pages of a single statement. Each page's request needs
+ * the previous page's paging state so only one request is outstanding at a
+ * time.
+ */
+class StatementPagedIterator : public PagedIterator {
+public:
+  StatementPagedIterator(Session* session, Statement* statement, size_t prefetch_pages,
+                         size_t max_prefetch_bytes);
+
+protected:
+  virtual void fetch_more(bool is_needed, FetchVec* fetches);
+  virtual void on_result(void* data, const ResultResponse::Ptr& result, FetchVec* fetches);
+  virtual void on_error(void* data, const Future::Error& error, FetchVec* fetches);
+  virtual bool has_more_pages() const { return has_more_pages_; }
+
+private:
+  const Request::ConstPtr request_;
+  Statement* const statement_;
+  bool has_more_pages_;
+};
+
+}}} // namespace datastax::internal::core
+
+EXTERNAL_TYPE(datastax::internal::core::PagedIterator, CassPagedIterator)
+
+#endif
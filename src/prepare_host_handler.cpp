@@ -28,29 +28,25 @@
 using namespace datastax;
 using namespace datastax::internal::core;
 
-struct CompareEntryKeyspace {
-  bool operator()(const PreparedMetadata::Entry::Ptr& lhs,
-                  const PreparedMetadata::Entry::Ptr& rhs) const {
-    return lhs->keyspace() < rhs->keyspace();
-  }
-};
-
 PrepareHostHandler::PrepareHostHandler(
     const Host::Ptr& host, const PreparedMetadata::Entry::Vec& prepared_metadata_entries,
-    const Callback& callback, ProtocolVersion protocol_version, unsigned max_requests_per_flush)
+    const Callback& callback, ProtocolVersion protocol_version, unsigned max_concurrent_prepares,
+    unsigned num_connections)
     : host_(host)
     , protocol_version_(protocol_version)
     , callback_(callback)
-    , connection_(NULL)
+    , connects_outstanding_(0)
+    , connections_open_(0)
     , prepares_outstanding_(0)
-    , max_prepares_outstanding_(CASS_MAX_STREAMS)
+    , max_prepares_outstanding_(
+          std::max(1, static_cast<int>(std::min(max_concurrent_prepares,
+                                                static_cast<unsigned>(CASS_MAX_STREAMS)))))
+    , num_connections_(std::max(1, static_cast<int>(num_connections)))
+    , is_closing_(false)
     , prepared_metadata_entries_(prepared_metadata_entries) {
-
-  // Sort by keyspace to minimize the number of times the keyspace
-  // needs to be changed.
-  std::sort(prepared_metadata_entries_.begin(), prepared_metadata_entries_.end(),
-            CompareEntryKeyspace());
-
+  // The entries are in order from most to least recently used (see
+  // `PreparedMetadata::copy()`) so that the statements in use are prepared
+  // first.
   current_entry_it_ = prepared_metadata_entries_.begin();
 }
 
@@ -62,110 +58,190 @@ void PrepareHostHandler::prepare(uv_loop_t* loop, const ConnectionSettings& sett
 
   inc_ref(); // Reference for the event loop
 
-  Connector::Ptr connector(new Connector(host_, protocol_version_,
-                                         bind_callback(&PrepareHostHandler::on_connect, this)));
+  // Don't use more connections than there are statements to prepare
+  connects_outstanding_ =
+      std::min(num_connections_, static_cast<int>(prepared_metadata_entries_.size()));
+  connections_.reserve(connects_outstanding_);
+
+  for (int i = connects_outstanding_; i > 0; --i) {
+    Connector::Ptr connector(new Connector(host_, protocol_version_,
+                                           bind_callback(&PrepareHostHandler::on_connect, this)));
 
-  connector->with_settings(settings)->with_listener(this)->connect(loop);
+    connector->with_settings(settings)->with_listener(this)->connect(loop);
+  }
 }
 
 void PrepareHostHandler::on_close(Connection* connection) {
-  callback_(this);
+  for (PrepareConnectionVec::iterator it = connections_.begin(), end = connections_.end();
+       it != end; ++it) {
+    if (it->connection == connection) {
+      it->connection = NULL;
+    }
+  }
 
-  dec_ref(); // The event loop is done with this handler
+  if (--connections_open_ == 0 && connects_outstanding_ == 0) {
+    callback_(this);
+    dec_ref(); // The event loop is done with this handler
+  }
 }
 
 void PrepareHostHandler::on_connect(Connector* connector) {
   if (connector->is_ok()) {
-    connection_ = connector->release_connection().get();
-    prepare_next();
+    connections_.push_back(PrepareConnection(connector->release_connection().get()));
+    connections_open_++;
   } else {
+    LOG_WARN("Unable to connect to host %s to prepare all queries: %s",
+             host_->address_string().c_str(), connector->error_message().c_str());
+  }
+
+  // Wait for all the connections to be established before preparing
+  if (--connects_outstanding_ > 0) {
+    return;
+  }
+
+  if (connections_open_ == 0) {
     callback_(this);
     dec_ref(); // The event loop is done with this handler
+  } else {
+    prepare_next();
   }
 }
 
 // This is the main loop for preparing statements. It's called after each
 // request successfully completes, either setting the keyspace or preparing
-// a statement. It attempts to group prepare requests into a single batch as
-// long as the keyspace is the same and the number of outstanding requests is
-// under the maximum.
+// a statement. It writes prepare requests, in order, to the least busy
+// connection using the statement's keyspace until there are no more left or
+// the maximum number of outstanding requests is reached.
 void PrepareHostHandler::prepare_next() {
-  // Finish current prepares before continuing
-  if (--prepares_outstanding_ > 0) {
-    return;
-  }
-
-  // Check to see if we're done
-  if (is_done()) {
-    close();
+  if (is_closing_) {
     return;
   }
 
-  prepares_outstanding_ = 0;
+  while (!is_done() && prepares_outstanding_ < max_prepares_outstanding_) {
+    int index = select_connection();
+    if (index < 0) {
+      break;
+    }
 
-  // Write prepare requests until there's no more left, the keyspace changes,
-  // or the maximum number of outstanding prepares is reached.
-  while (!is_done() && check_and_set_keyspace() &&
-         prepares_outstanding_ < max_prepares_outstanding_) {
-    const String& query((*current_entry_it_)->query());
-    PrepareRequest::Ptr prepare_request(new PrepareRequest(query));
+    const PreparedMetadata::Entry::Ptr& entry(*current_entry_it_);
+    PrepareRequest::Ptr prepare_request(new PrepareRequest(entry->query()));
 
     // Set the keyspace in case per request keyspaces are supported
-    prepare_request->set_keyspace(current_keyspace_);
+    prepare_request->set_keyspace(entry->keyspace());
 
-    PrepareCallback::Ptr callback(new PrepareCallback(prepare_request, Ptr(this)));
-    if (connection_->write(callback) < 0) {
+    PrepareConnection& prepare_connection(connections_[index]);
+    PrepareCallback::Ptr callback(new PrepareCallback(prepare_request, Ptr(this), index));
+    if (prepare_connection.connection->write(callback) < 0) {
       LOG_WARN("Failed to write prepare request while preparing all queries on host %s",
                host_->address_string().c_str());
       close();
       return;
     }
 
+    prepare_connection.prepares_outstanding++;
     prepares_outstanding_++;
     current_entry_it_++;
   }
 
-  connection_->flush();
-}
+  if (is_closing_) {
+    return;
+  }
+
+  // Check to see if we're done
+  if (is_done() && prepares_outstanding_ == 0) {
+    close();
+    return;
+  }
 
-bool PrepareHostHandler::check_and_set_keyspace() {
-  if (protocol_version_.supports_set_keyspace()) {
-    return true;
+  for (PrepareConnectionVec::iterator it = connections_.begin(), end = connections_.end();
+       it != end; ++it) {
+    if (it->connection) {
+      it->connection->flush();
+    }
   }
+}
 
+void PrepareHostHandler::finish_request(size_t index) {
+  connections_[index].prepares_outstanding--;
+  prepares_outstanding_--;
+  prepare_next();
+}
+
+int PrepareHostHandler::select_connection() {
   const String& keyspace((*current_entry_it_)->keyspace());
+  const bool supports_set_keyspace = protocol_version_.supports_set_keyspace();
+  const int max_prepares_per_connection =
+      (max_prepares_outstanding_ + num_connections_ - 1) / num_connections_;
+
+  while (true) {
+    int selected = -1;
+    int idle = -1;
+
+    for (size_t i = 0; i < connections_.size(); ++i) {
+      const PrepareConnection& prepare_connection(connections_[i]);
+      if (!prepare_connection.connection || prepare_connection.is_setting_keyspace ||
+          prepare_connection.prepares_outstanding >= max_prepares_per_connection) {
+        continue;
+      }
+
+      if (supports_set_keyspace || prepare_connection.current_keyspace == keyspace) {
+        if (selected < 0 ||
+            prepare_connection.prepares_outstanding < connections_[selected].prepares_outstanding) {
+          selected = static_cast<int>(i);
+        }
+      } else if (idle < 0 && prepare_connection.prepares_outstanding == 0) {
+        idle = static_cast<int>(i);
+      }
+    }
 
-  if (keyspace != current_keyspace_) {
-    PrepareCallback::Ptr callback(new SetKeyspaceCallback(keyspace, Ptr(this)));
-    if (connection_->write_and_flush(callback) < 0) {
+    if (selected >= 0 || idle < 0) {
+      return selected;
+    }
+
+    // Change the keyspace on an idle connection. The keyspace is connection
+    // state so it can only be changed when there are no outstanding requests.
+    PrepareConnection& prepare_connection(connections_[idle]);
+    SetKeyspaceCallback::Ptr callback(new SetKeyspaceCallback(keyspace, Ptr(this), idle));
+    if (prepare_connection.connection->write(callback) < 0) {
       LOG_WARN("Failed to write \"USE\" keyspace request while preparing all queries on host %s",
                host_->address_string().c_str());
       close();
-      return false;
+      return -1;
     }
-    current_keyspace_ = keyspace;
-    return false;
-  }
 
-  return true;
+    prepare_connection.is_setting_keyspace = true;
+    prepare_connection.prepares_outstanding++;
+    prepares_outstanding_++;
+  }
 }
 
 bool PrepareHostHandler::is_done() const {
   return current_entry_it_ == prepared_metadata_entries_.end();
 }
 
-void PrepareHostHandler::close() { connection_->close(); }
+void PrepareHostHandler::close() {
+  if (is_closing_) return;
+  is_closing_ = true;
+  for (PrepareConnectionVec::iterator it = connections_.begin(), end = connections_.end();
+       it != end; ++it) {
+    if (it->connection) {
+      it->connection->close();
+    }
+  }
+}
 
 PrepareHostHandler::PrepareCallback::PrepareCallback(
-    const PrepareRequest::ConstPtr& prepare_request, const PrepareHostHandler::Ptr& handler)
+    const PrepareRequest::ConstPtr& prepare_request, const PrepareHostHandler::Ptr& handler,
+    size_t index)
     : SimpleRequestCallback(prepare_request)
-    , handler_(handler) {}
+    , handler_(handler)
+    , index_(index) {}
 
 void PrepareHostHandler::PrepareCallback::on_internal_set(ResponseMessage* response) {
   LOG_DEBUG("Successfully prepared query \"%s\" on host %s while preparing all queries",
             static_cast<const PrepareRequest*>(request())->query().c_str(),
             handler_->host()->address_string().c_str());
-  handler_->prepare_next();
+  handler_->finish_request(index_);
 }
 
 void PrepareHostHandler::PrepareCallback::on_internal_error(CassError code, const String& message) {
@@ -181,14 +257,20 @@ void PrepareHostHandler::PrepareCallback::on_internal_timeout() {
 }
 
 PrepareHostHandler::SetKeyspaceCallback::SetKeyspaceCallback(const String& keyspace,
-                                                             const PrepareHostHandler::Ptr& handler)
+                                                             const PrepareHostHandler::Ptr& handler,
+                                                             size_t index)
     : SimpleRequestCallback(Request::ConstPtr(new QueryRequest("USE " + keyspace)))
-    , handler_(handler) {}
+    , keyspace_(keyspace)
+    , handler_(handler)
+    , index_(index) {}
 
 void PrepareHostHandler::SetKeyspaceCallback::on_internal_set(ResponseMessage* response) {
   LOG_TRACE("Successfully set keyspace to \"%s\" on host %s while preparing all queries",
-            handler_->current_keyspace_.c_str(), handler_->host()->address_string().c_str());
-  handler_->prepare_next();
+            keyspace_.c_str(), handler_->host()->address_string().c_str());
+  PrepareConnection& prepare_connection(handler_->connections_[index_]);
+  prepare_connection.current_keyspace = keyspace_;
+  prepare_connection.is_setting_keyspace = false;
+  handler_->finish_request(index_);
 }
 
 void PrepareHostHandler::SetKeyspaceCallback::on_internal_error(CassError code,
@@ -25,6 +25,7 @@
 #include "prepared.hpp"
 #include "ref_counted.hpp"
 #include "string.hpp"
+#include "vector.hpp"
 
 namespace datastax { namespace internal { namespace core {
 
@@ -32,6 +33,12 @@ class Connector;
 
 /**
  * A handler for pre-preparing statements on a newly available host.
+ *
+ * The statements are prepared in order from most to least recently used so
+ * that frequently used statements are available first. The requests are
+ * spread over several connections and the number of outstanding requests is
+ * limited so that a host isn't flooded with prepare requests when it becomes
+ * available.
  */
 class PrepareHostHandler
     : public RefCounted<PrepareHostHandler>
@@ -44,7 +51,7 @@ public:
   PrepareHostHandler(const Host::Ptr& host,
                      const PreparedMetadata::Entry::Vec& prepared_metadata_entries,
                      const Callback& callback, ProtocolVersion protocol_version,
-                     unsigned max_requests_per_flush);
+                     unsigned max_concurrent_prepares, unsigned num_connections = 1);
 
   const Host::Ptr host() const { return host_; }
 
@@ -56,15 +63,32 @@ private:
   void on_connect(Connector* connector);
 
 private:
+  /**
+   * The state of a connection used to prepare statements.
+   */
+  struct PrepareConnection {
+    PrepareConnection(Connection* connection)
+        : connection(connection)
+        , prepares_outstanding(0)
+        , is_setting_keyspace(false) {}
+
+    Connection* connection;
+    String current_keyspace;
+    int prepares_outstanding;
+    bool is_setting_keyspace;
+  };
+
+  typedef Vector<PrepareConnection> PrepareConnectionVec;
+
   /**
    * A callback for preparing a single statement on a host. It continues the
    * preparation process on success, otherwise it closes the temporary
-   * connection and logs a warning.
+   * connections and logs a warning.
    */
   class PrepareCallback : public SimpleRequestCallback {
   public:
     PrepareCallback(const PrepareRequest::ConstPtr& prepare_request,
-                    const PrepareHostHandler::Ptr& handler);
+                    const PrepareHostHandler::Ptr& handler, size_t index);
 
     virtual void on_internal_set(ResponseMessage* response);
 
@@ -74,17 +98,19 @@ private:
 
   private:
     PrepareHostHandler::Ptr handler_;
+    size_t index_;
   };
 
   /**
    * A callback for setting the keyspace on a connection. This is requrired
    * pre-V5/DSEv2 because the keyspace state is per connection.  It continues
    * the preparation process on success, otherwise it closes the temporary
-   * connection and logs a warning.
+   * connections and logs a warning.
    */
   class SetKeyspaceCallback : public SimpleRequestCallback {
   public:
-    SetKeyspaceCallback(const String& keyspace, const PrepareHostHandler::Ptr& handler);
+    SetKeyspaceCallback(const String& keyspace, const PrepareHostHandler::Ptr& handler,
+                        size_t index);
 
     virtual void on_internal_set(ResponseMessage* response);
 
@@ -93,15 +119,22 @@ private:
     virtual void on_internal_timeout();
 
   private:
+    String keyspace_;
     PrepareHostHandler::Ptr handler_;
+    size_t index_;
   };
 
 private:
   // This is the main method for iterating over the list of prepared statements
   void prepare_next();
 
-  // Returns true if the keyspace is current or using protocol v5/DSEv2
-  bool check_and_set_keyspace();
+  // Called when a prepare or "USE" request on a connection completes
+  void finish_request(size_t index);
+
+  // Returns the index of the connection that should be used to prepare the
+  // current entry or -1 if no connection is available. If a connection needs
+  // to change its keyspace then a "USE" request is started and -1 is returned.
+  int select_connection();
 
   bool is_done() const;
 
@@ -111,10 +144,13 @@ private:
   const Host::Ptr host_;
   const ProtocolVersion protocol_version_;
   Callback callback_;
-  Connection* connection_;
-  String current_keyspace_;
+  PrepareConnectionVec connections_;
+  int connects_outstanding_;
+  int connections_open_;
   int prepares_outstanding_;
   const int max_prepares_outstanding_;
+  const int num_connections_;
+  bool is_closing_;
   PreparedMetadata::Entry::Vec prepared_metadata_entries_;
   PreparedMetadata::Entry::Vec::const_iterator current_entry_it_;
 };
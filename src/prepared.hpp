@@ -19,9 +19,12 @@
 #ifndef DATASTAX_INTERNAL_PREPARED_HPP
 #define DATASTAX_INTERNAL_PREPARED_HPP
 
+#include "atomic.hpp"
 #include "buffer.hpp"
 #include "dense_hash_map.hpp"
 #include "external.hpp"
+#include "get_time.hpp"
+#include "list.hpp"
 #include "metadata.hpp"
 #include "prepare_request.hpp"
 #include "ref_counted.hpp"
@@ -31,6 +34,7 @@
 #include "scoped_ptr.hpp"
 #include "string.hpp"
 
+#include <algorithm>
 #include <uv.h>
 
 namespace datastax { namespace internal { namespace core {
@@ -87,42 +91,177 @@ public:
     ResultResponse::ConstPtr result_;
   };
 
-  PreparedMetadata() {
+  /**
+   * Constructor.
+   *
+   * @param max_entries The maximum number of entries. An entry that hasn't been
+   * used recently is evicted when the maximum is exceeded. If zero then the
+   * number of entries is unbounded.
+   */
+  PreparedMetadata(size_t max_entries = 0)
+      : max_entries_(max_entries)
+      , size_bytes_(0)
+      , eviction_count_(0) {
     metadata_.set_empty_key(String());
+    metadata_.set_deleted_key(String(1, '\0'));
     uv_rwlock_init(&rwlock_);
   }
 
-  ~PreparedMetadata() { uv_rwlock_destroy(&rwlock_); }
+  ~PreparedMetadata() {
+    while (Node* node = entries_.pop_front()) {
+      delete node;
+    }
+    uv_rwlock_destroy(&rwlock_);
+  }
 
+  // This is called for every execution of a bound statement so it only takes
+  // the read lock. The entry is marked as referenced for eviction and its last
+  // use time is recorded for `copy()` using the coarse clock, which is cheap
+  // enough to read on every execution. Both are only written when they change.
+  // The entries themselves are only reordered when an entry needs to be
+  // evicted.
   Entry::Ptr get(const String& prepared_id) const {
     ScopedReadLock rl(&rwlock_);
     Map::const_iterator i = metadata_.find(prepared_id);
     if (i != metadata_.end()) {
-      return i->second;
+      Node* node = i->second;
+      // Avoid writing to a cache line that's shared between threads if the
+      // entry is already marked
+      if (!node->is_referenced.load(MEMORY_ORDER_RELAXED)) {
+        node->is_referenced.store(true, MEMORY_ORDER_RELAXED);
+      }
+      uint64_t now = current_tick();
+      if (node->last_used.load(MEMORY_ORDER_RELAXED) != now) {
+        node->last_used.store(now, MEMORY_ORDER_RELAXED);
+      }
+      return node->entry;
     }
     return Entry::Ptr();
   }
 
   void set(const String& prepared_id, const PreparedMetadata::Entry::Ptr& entry) {
     ScopedWriteLock wl(&rwlock_);
-    metadata_[prepared_id] = entry;
+    Map::iterator i = metadata_.find(prepared_id);
+    Node* node;
+    if (i != metadata_.end()) {
+      node = i->second;
+      size_bytes_ -= node->size_bytes;
+      entries_.remove(node);
+    } else {
+      node = new Node(prepared_id);
+      metadata_[prepared_id] = node;
+    }
+    node->entry = entry;
+    node->size_bytes = calculate_size_bytes(prepared_id, entry);
+    node->is_referenced.store(false, MEMORY_ORDER_RELAXED);
+    node->last_used.store(current_tick(), MEMORY_ORDER_RELAXED);
+    size_bytes_ += node->size_bytes;
+    entries_.add_to_front(node);
+
+    // Second chance (CLOCK) eviction: entries referenced since they were last
+    // considered are moved back to the front instead of being evicted. The new
+    // entry is never evicted.
+    while (max_entries_ > 0 && metadata_.size() > max_entries_) {
+      Node* oldest = entries_.back();
+      entries_.remove(oldest);
+      if (oldest == node || oldest->is_referenced.load(MEMORY_ORDER_RELAXED)) {
+        oldest->is_referenced.store(false, MEMORY_ORDER_RELAXED);
+        entries_.add_to_front(oldest);
+        continue;
+      }
+      metadata_.erase(oldest->id);
+      size_bytes_ -= oldest->size_bytes;
+      eviction_count_++;
+      delete oldest;
+    }
   }
 
+  // Returns the entries ordered from most to least recently used (or set).
+  // Entries used within the same tick of the coarse clock are in no particular
+  // order.
   Entry::Vec copy() const {
-    ScopedReadLock rl(&rwlock_);
+    UsedVec used;
+    {
+      ScopedReadLock rl(&rwlock_);
+      used.reserve(metadata_.size());
+      List<Node>::Iterator<Node> it = entries_.iterator();
+      while (it.has_next()) {
+        Node* node = it.next();
+        used.push_back(Used(node->last_used.load(MEMORY_ORDER_RELAXED), node->entry));
+      }
+    }
+    std::stable_sort(used.begin(), used.end(), MostRecentlyUsed());
     Entry::Vec temp;
-    temp.reserve(metadata_.size());
-    for (Map::const_iterator it = metadata_.begin(), end = metadata_.end(); it != end; ++it) {
+    temp.reserve(used.size());
+    for (UsedVec::const_iterator it = used.begin(), end = used.end(); it != end; ++it) {
       temp.push_back(it->second);
     }
     return temp;
   }
 
+  size_t size() const {
+    ScopedReadLock rl(&rwlock_);
+    return metadata_.size();
+  }
+
+  // The approximate amount of memory used by the entries
+  size_t size_bytes() const {
+    ScopedReadLock rl(&rwlock_);
+    return size_bytes_;
+  }
+
+  uint64_t eviction_count() const {
+    ScopedReadLock rl(&rwlock_);
+    return eviction_count_;
+  }
+
 private:
-  typedef DenseHashMap<String, Entry::Ptr> Map;
+  struct Node
+      : public List<Node>::Node
+      , public Allocated {
+    Node(const String& id)
+        : id(id)
+        , size_bytes(0)
+        , is_referenced(false)
+        , last_used(0) {}
+
+    String id;
+    Entry::Ptr entry;
+    size_t size_bytes;
+    Atomic<bool> is_referenced; // Set by readers holding the read lock
+    Atomic<uint64_t> last_used; // Ditto
+  };
+
+  typedef std::pair<uint64_t, Entry::Ptr> Used;
+  typedef Vector<Used> UsedVec;
+
+  struct MostRecentlyUsed {
+    bool operator()(const Used& lhs, const Used& rhs) const { return lhs.first > rhs.first; }
+  };
 
+  static uint64_t current_tick() { return get_time_monotonic_coarse_ms(); }
+
+  static size_t calculate_size_bytes(const String& prepared_id, const Entry::Ptr& entry) {
+    size_t size = sizeof(Node) + sizeof(Entry) + prepared_id.size();
+    if (entry) {
+      size += entry->query().size() + entry->keyspace().size() +
+              entry->result_metadata_id().size();
+      if (entry->result()) size += entry->result()->encoded_result().size();
+    }
+    return size;
+  }
+
+  typedef DenseHashMap<String, Node*> Map;
+
+  const size_t max_entries_;
   mutable uv_rwlock_t rwlock_;
   Map metadata_;
+  mutable List<Node> entries_; // Newest (or most recently given a second chance) first
+  size_t size_bytes_;
+  uint64_t eviction_count_;
+
+private:
+  DISALLOW_COPY_AND_ASSIGN(PreparedMetadata);
 };
 
 }}} // namespace datastax::internal::core
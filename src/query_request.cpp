@@ -28,6 +28,10 @@ using namespace datastax::internal::core;
 
 int QueryRequest::encode(ProtocolVersion version, RequestCallback* callback,
                          BufferVec* bufs) const {
+  if (can_encode_frozen(version)) {
+    return encode_frozen(version, Buffer(), callback, bufs);
+  }
+
   int32_t result;
   int32_t length = encode_query_or_id(bufs);
   if (has_names_for_values()) {
@@ -49,15 +53,23 @@ int QueryRequest::encode(ProtocolVersion version, RequestCallback* callback,
 // <value> is a [bytes]
 int32_t QueryRequest::encode_values_with_names(ProtocolVersion version, RequestCallback* callback,
                                                BufferVec* bufs) const {
-  int32_t size = 0;
+  size_t size = 0;
   for (size_t i = 0; i < value_names_->size(); ++i) {
-    const Buffer& name_buf = (*value_names_)[i].buf;
-    bufs->push_back(name_buf);
+    const Element& element = elements()[i];
+    size += (*value_names_)[i].buf.size();
+    size += element.is_unset() ? sizeof(int32_t) : element.get_size();
+  }
 
-    Buffer value_buf(elements()[i].get_buffer());
-    bufs->push_back(value_buf);
+  // Unset values are "unset" when supported, otherwise they're null
+  int32_t unset_length = version >= CASS_PROTOCOL_VERSION_V4 ? -2 : -1;
 
-    size += name_buf.size() + value_buf.size();
+  bufs->push_back(Buffer(size));
+  Buffer& buf = bufs->back();
+  size_t pos = 0;
+  for (size_t i = 0; i < value_names_->size(); ++i) {
+    const Buffer& name_buf = (*value_names_)[i].buf;
+    pos = buf.copy(pos, name_buf.data(), name_buf.size());
+    pos = copy_element(i, unset_length, pos, &buf);
   }
   return size;
 }
@@ -0,0 +1,104 @@
+/*
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include "read_buffer_pool.hpp"
+
+#include "macros.hpp"
+#include "memory.hpp"
+
+#include <assert.h>
+
+using namespace datastax;
+using namespace datastax::internal;
+using namespace datastax::internal::core;
+
+const size_t ReadBufferPool::MIN_SIZE;
+const size_t ReadBufferPool::MAX_SIZE;
+const size_t ReadBufferPool::MAX_FREE_PER_CLASS;
+
+ReadBufferPool::ReadBufferPool() {
+  for (size_t i = 0; i < NUM_CLASSES; ++i) {
+    free_[i].reserve(MAX_FREE_PER_CLASS);
+  }
+}
+
+ReadBufferPool::~ReadBufferPool() {
+  for (size_t i = 0; i < NUM_CLASSES; ++i) {
+    for (BufferVec::iterator it = free_[i].begin(), end = free_[i].end(); it != end; ++it) {
+      Memory::free(*it);
+    }
+  }
+}
+
+uv_buf_t ReadBufferPool::alloc(size_t size) {
+  size_t buffer_size = size_class(size);
+  if (buffer_size <= MAX_SIZE) {
+    BufferVec& buffers = free_[class_index(buffer_size)];
+    if (!buffers.empty()) {
+      char* base = buffers.back();
+      buffers.pop_back();
+      return uv_buf_init(base, buffer_size);
+    }
+  }
+  return uv_buf_init(static_cast<char*>(Memory::malloc(buffer_size)), buffer_size);
+}
+
+void ReadBufferPool::free(const uv_buf_t& buf) {
+  if (buf.len >= MIN_SIZE && buf.len <= MAX_SIZE && size_class(buf.len) == buf.len) {
+    BufferVec& buffers = free_[class_index(buf.len)];
+    if (buffers.size() < MAX_FREE_PER_CLASS) {
+      buffers.push_back(buf.base);
+      return;
+    }
+  }
+  Memory::free(buf.base);
+}
+
+size_t ReadBufferPool::free_count() const {
+  size_t count = 0;
+  for (size_t i = 0; i < NUM_CLASSES; ++i) {
+    count += free_[i].size();
+  }
+  return count;
+}
+
+size_t ReadBufferPool::free_bytes() const {
+  size_t bytes = 0;
+  for (size_t i = 0; i < NUM_CLASSES; ++i) {
+    bytes += free_[i].size() * (MIN_SIZE << i);
+  }
+  return bytes;
+}
+
+size_t ReadBufferPool::size_class(size_t size) {
+  if (size > MAX_SIZE) return size;
+  size_t class_size = MIN_SIZE;
+  while (class_size < size) {
+    class_size <<= 1;
+  }
+  return class_size;
+}
+
+size_t ReadBufferPool::class_index(size_t size) {
+  size_t index = 0;
+  while ((MIN_SIZE << index) < size) {
+    index++;
+  }
+  assert(index < NUM_CLASSES);
+  return index;
+}
@@ -0,0 +1,106 @@
+/*
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifndef DATASTAX_INTERNAL_READ_BUFFER_POOL_HPP
+#define DATASTAX_INTERNAL_READ_BUFFER_POOL_HPP
+
+#include "allocated.hpp"
+#include "loop_context.hpp"
+#include "macros.hpp"
+#include "vector.hpp"
+
+#include <uv.h>
+
+namespace datastax { namespace internal { namespace core {
+
+/**
+ * A pool of socket read buffers shared by all the sockets of an event loop.
+ * Buffers are grouped into power of two size classes and a small number of
+ * free buffers are kept for each class. A read buffer is only held for the
+ * duration of a read callback so a handful of buffers are enough for all of
+ * a loop's sockets, instead of each socket caching its own.
+ *
+ * A pool is owned by each event loop and only used by the event loop's
+ * thread so it doesn't require any locking.
+ */
+class ReadBufferPool : public Allocated {
+public:
+  static const size_t MIN_SIZE = 4 * 1024;
+  static const size_t MAX_SIZE = 1024 * 1024;
+  static const size_t MAX_FREE_PER_CLASS = 4;
+
+  ReadBufferPool();
+  ~ReadBufferPool();
+
+  /**
+   * Allocate a buffer from the smallest size class that fits the requested
+   * size. Sizes larger than the largest class are allocated directly.
+   *
+   * @param size The minimum size of the buffer.
+   * @return The buffer.
+   */
+  uv_buf_t alloc(size_t size);
+
+  /**
+   * Return a buffer to the pool. The buffer is freed if it doesn't belong to
+   * a size class or its class already has enough free buffers.
+   *
+   * @param buf A buffer allocated with `alloc()`.
+   */
+  void free(const uv_buf_t& buf);
+
+  size_t free_count() const;
+  size_t free_bytes() const;
+
+public:
+  /**
+   * Get the pool of the calling thread's event loop (see `LoopContext`).
+   *
+   * @return The pool or NULL if the thread doesn't have one.
+   */
+  static ReadBufferPool* current() {
+    LoopContext* context = LoopContext::current();
+    return context != NULL ? context->read_buffer_pool : NULL;
+  }
+
+  /**
+   * Round a size up to its size class.
+   *
+   * @param size
+   * @return The class's buffer size or the size itself if it's larger than
+   * the largest class.
+   */
+  static size_t size_class(size_t size);
+
+private:
+  static size_t class_index(size_t size);
+
+private:
+  typedef Vector<char*> BufferVec;
+
+  static const size_t NUM_CLASSES = 9; // 4KB to 1MB
+
+  BufferVec free_[NUM_CLASSES];
+
+private:
+  DISALLOW_COPY_AND_ASSIGN(ReadBufferPool);
+};
+
+}}} // namespace datastax::internal::core
+
+#endif
@@ -23,6 +23,7 @@
 #include "atomic.hpp"
 #include "macros.hpp"
 #include "memory.hpp"
+#include "slab_allocator.hpp"
 
 #include <assert.h>
 #include <new>
@@ -156,12 +157,12 @@ public:
 
   char* data() { return reinterpret_cast<char*>(this) + sizeof(RefBuffer); }
 
-  void operator delete(void* ptr) { Memory::free(ptr); }
+  void operator delete(void* ptr) { SlabAllocator::free(ptr); }
 
 private:
   RefBuffer() {}
 
-  void* operator new(size_t size, size_t extra) { return Memory::malloc(size + extra); }
+  void* operator new(size_t size, size_t extra) { return SlabAllocator::malloc(size + extra); }
 
   DISALLOW_COPY_AND_ASSIGN(RefBuffer);
 };
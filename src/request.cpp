@@ -70,3 +70,18 @@ int32_t CustomPayload::encode(BufferVec* bufs) const {
   }
   return length;
 }
+
+void Request::copy_settings(const Request& other) {
+  flags_ = other.flags_;
+  settings_ = other.settings_;
+  timestamp_ = other.timestamp_;
+  record_attempted_addresses_ = other.record_attempted_addresses_;
+  result_chunk_callback_ = other.result_chunk_callback_;
+  result_chunk_data_ = other.result_chunk_data_;
+  custom_payload_ = other.custom_payload_;
+  custom_payload_extra_.copy(other.custom_payload_extra_);
+  profile_name_ = other.profile_name_;
+  if (other.host_) {
+    host_.reset(new Address(*other.host_));
+  }
+}
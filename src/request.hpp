@@ -53,6 +53,8 @@ public:
 
   inline size_t size() const { return items_.size(); }
 
+  void copy(const CustomPayload& other) { items_ = other.items_; }
+
 private:
   typedef Map<String, Buffer> ItemMap;
   ItemMap items_;
@@ -91,7 +93,9 @@ public:
       : opcode_(opcode)
       , flags_(0)
       , timestamp_(CASS_INT64_MIN)
-      , record_attempted_addresses_(false) {}
+      , record_attempted_addresses_(false)
+      , result_chunk_callback_(NULL)
+      , result_chunk_data_(NULL) {}
 
   virtual ~Request() {}
 
@@ -153,6 +157,13 @@ public:
     record_attempted_addresses_ = record_attempted_addresses;
   }
 
+  CassResultChunkCallback result_chunk_callback() const { return result_chunk_callback_; }
+  void* result_chunk_data() const { return result_chunk_data_; }
+  void set_result_chunk_callback(CassResultChunkCallback callback, void* data) {
+    result_chunk_callback_ = callback;
+    result_chunk_data_ = data;
+  }
+
   const CustomPayload::ConstPtr& custom_payload() const { return custom_payload_; }
 
   bool has_custom_payload() const { return custom_payload_ || !custom_payload_extra_.empty(); }
@@ -189,6 +200,14 @@ public:
   void set_host(const Address& host) { host_.reset(new Address(host)); }
   const Address* host() const { return host_.get(); }
 
+  /**
+   * Copy the settings (everything but the query and values) of another
+   * request.
+   *
+   * @param other The request to copy the settings from.
+   */
+  void copy_settings(const Request& other);
+
   virtual int encode(ProtocolVersion version, RequestCallback* callback, BufferVec* bufs) const = 0;
 
 private:
@@ -197,6 +216,8 @@ private:
   RequestSettings settings_;
   int64_t timestamp_;
   bool record_attempted_addresses_;
+  CassResultChunkCallback result_chunk_callback_;
+  void* result_chunk_data_;
   CustomPayload::ConstPtr custom_payload_;
   CustomPayload custom_payload_extra_;
   String profile_name_;
@@ -125,6 +125,13 @@ void RequestCallback::on_close() {
   }
 }
 
+void RequestCallback::on_result_chunk(const SharedRefPtr<ResultResponse>& chunk) {
+  const Request* req = request();
+  if (req->result_chunk_callback()) {
+    req->result_chunk_callback()(CassResult::to(chunk.get()), req->result_chunk_data());
+  }
+}
+
 void RequestCallback::set_state(RequestCallback::State next_state) {
   switch (state_) {
     case REQUEST_STATE_NEW:
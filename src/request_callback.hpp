@@ -28,6 +28,7 @@
 #include "request.hpp"
 #include "response.hpp"
 #include "scoped_ptr.hpp"
+#include "slab_allocator.hpp"
 #include "socket.hpp"
 #include "string.hpp"
 #include "timer.hpp"
@@ -123,6 +124,8 @@ private:
 class RequestCallback
     : public RefCounted<RequestCallback>
     , public SocketRequest {
+  SLAB_ALLOCATED
+
 public:
   typedef SharedRefPtr<RequestCallback> Ptr;
   typedef Vector<Ptr> Vec;
@@ -159,6 +162,10 @@ public:
   virtual void on_set(ResponseMessage* response) = 0;
   virtual void on_error(CassError code, const String& message) = 0;
 
+  // Called with the rows of a result as they're received when the request has
+  // a result chunk callback (see `ResultChunkDecoder`)
+  virtual void on_result_chunk(const SharedRefPtr<ResultResponse>& chunk);
+
 public:
   const Request* request() const { return wrapper_.request().get(); }
 
@@ -69,7 +69,22 @@ private:
 
 class PrepareCallback : public SimpleRequestCallback {
 public:
-  PrepareCallback(const String& query, const String& id, RequestExecution* request_execution);
+  typedef SharedRefPtr<PrepareCallback> Ptr;
+  typedef Vector<RequestExecution::Ptr> WaiterVec;
+
+  PrepareCallback(const String& query, const PendingPrepareKey& key,
+                  RequestExecution* request_execution, ConnectionPoolManager* manager);
+
+  /**
+   * Add a request execution that's waiting for the statement to be
+   * re-prepared. Waiters are notified of the PREPARE request's outcome the
+   * same way as the execution that started it.
+   *
+   * @param request_execution The waiting request execution.
+   */
+  void add_waiter(RequestExecution* request_execution) {
+    waiters_.push_back(RequestExecution::Ptr(request_execution));
+  }
 
 private:
   class PrepareRequest : public core::PrepareRequest {
@@ -86,37 +101,51 @@ private:
   virtual void on_internal_error(CassError code, const String& message);
   virtual void on_internal_timeout();
 
+private:
+  void remove_pending();
+  void retry_current_host();
+  void retry_next_host();
+
 private:
   RequestExecution::Ptr request_execution_;
-  String id_;
+  WaiterVec waiters_;
+  ConnectionPoolManager::Ptr manager_;
+  PendingPrepareKey key_;
 };
 
-PrepareCallback::PrepareCallback(const String& query, const String& id,
-                                 RequestExecution* request_execution)
+PrepareCallback::PrepareCallback(const String& query, const PendingPrepareKey& key,
+                                 RequestExecution* request_execution,
+                                 ConnectionPoolManager* manager)
     : SimpleRequestCallback(
           Request::ConstPtr(new PrepareRequest(query, request_execution->request()->keyspace(),
                                                request_execution->request_timeout_ms())))
     , request_execution_(request_execution)
-    , id_(id) {}
+    , manager_(manager)
+    , key_(key) {}
 
 void PrepareCallback::on_internal_set(ResponseMessage* response) {
+  remove_pending();
   switch (response->opcode()) {
     case CQL_OPCODE_RESULT: {
       ResultResponse* result = static_cast<ResultResponse*>(response->response_body().get());
       if (result->kind() == CASS_RESULT_KIND_PREPARED) {
         String result_id = result->prepared_id().to_string();
-        if (id_ != result_id) {
-          request_execution_->notify_prepared_id_mismatch(id_, result_id);
+        if (key_.id != result_id) {
+          request_execution_->notify_prepared_id_mismatch(key_.id, result_id);
+          for (WaiterVec::const_iterator it = waiters_.begin(), end = waiters_.end();
+               it != end; ++it) {
+            (*it)->notify_prepared_id_mismatch(key_.id, result_id);
+          }
         } else {
           request_execution_->notify_result_metadata_changed(request(), result);
-          request_execution_->on_retry_current_host();
+          retry_current_host();
         }
       } else {
-        request_execution_->on_retry_next_host();
+        retry_next_host();
       }
     } break;
     case CQL_OPCODE_ERROR:
-      request_execution_->on_retry_next_host();
+      retry_next_host();
       break;
     default:
       break;
@@ -124,10 +153,34 @@ void PrepareCallback::on_internal_set(ResponseMessage* response) {
 }
 
 void PrepareCallback::on_internal_error(CassError code, const String& message) {
-  request_execution_->on_retry_next_host();
+  remove_pending();
+  retry_next_host();
+}
+
+void PrepareCallback::on_internal_timeout() {
+  remove_pending();
+  retry_next_host();
+}
+
+void PrepareCallback::remove_pending() {
+  if (manager_) manager_->remove_pending_prepare(key_);
+}
+
+void PrepareCallback::retry_current_host() {
+  request_execution_->on_retry_current_host();
+  for (WaiterVec::const_iterator it = waiters_.begin(), end = waiters_.end();
+       it != end; ++it) {
+    (*it)->on_retry_current_host();
+  }
 }
 
-void PrepareCallback::on_internal_timeout() { request_execution_->on_retry_next_host(); }
+void PrepareCallback::retry_next_host() {
+  request_execution_->on_retry_next_host();
+  for (WaiterVec::const_iterator it = waiters_.begin(), end = waiters_.end();
+       it != end; ++it) {
+    (*it)->on_retry_next_host();
+  }
+}
 
 class NopRequestListener : public RequestListener {
 public:
@@ -163,6 +216,7 @@ RequestHandler::RequestHandler(const Request::ConstPtr& request, const ResponseF
     : wrapper_(request)
     , future_(future)
     , is_done_(false)
+    , has_result_chunks_(false)
     , running_executions_(0)
     , start_time_ns_(uv_hrtime())
     , listener_(&nop_request_listener__)
@@ -210,8 +264,8 @@ void RequestHandler::init(const ExecutionProfile& profile, ConnectionPoolManager
     query_plan_.reset(profile.load_balancing_policy()->new_query_plan(keyspace, this, token_map));
   }
 
-  execution_plan_.reset(
-      profile.speculative_execution_policy()->new_plan(keyspace, wrapper_.request().get()));
+  execution_plan_ =
+      profile.speculative_execution_policy()->new_plan(keyspace, wrapper_.request().get());
 }
 
 void RequestHandler::execute() {
@@ -236,13 +290,33 @@ void RequestHandler::start_request(uv_loop_t* loop, Protected) {
 Host::Ptr RequestHandler::next_host(Protected) { return query_plan_->compute_next(); }
 
 int64_t RequestHandler::next_execution(const Host::Ptr& current_host, Protected) {
-  return execution_plan_->next_execution(current_host);
+  return execution_plan_.next_execution(current_host);
+}
+
+void RequestHandler::start_speculative_execution(Protected) {
+  // Executions scheduled for requests that have already finished are skipped
+  // without being counted by the speculative execution policy.
+  if (is_done_ || !execution_plan_.start_execution()) return;
+  execute();
+}
+
+void RequestHandler::record_latency(uint64_t latency_ns, Protected) {
+  execution_plan_.record_latency(latency_ns);
 }
 
 void RequestHandler::add_attempted_address(const Address& address, Protected) {
   future_->add_attempted_address(address);
 }
 
+void RequestHandler::on_result_chunk(const ResultResponse::Ptr& chunk, Protected) {
+  // The future has already been set (e.g. the request timed out) so the
+  // application may have already freed the callback's data.
+  if (is_done_) return;
+  has_result_chunks_ = true;
+  const Request* req = request();
+  req->result_chunk_callback()(CassResult::to(chunk.get()), req->result_chunk_data());
+}
+
 void RequestHandler::notify_result_metadata_changed(const String& prepared_id, const String& query,
                                                     const String& keyspace,
                                                     const String& result_metadata_id,
@@ -280,6 +354,14 @@ void RequestHandler::set_response(const Host::Ptr& host, const Response::Ptr& re
   if (future_->set_response(host->address(), response)) {
     if (metrics_) {
       metrics_->record_request(uv_hrtime() - start_time_ns_);
+      if (response->opcode() == CQL_OPCODE_RESULT) {
+        const ResultResponse* result = static_cast<const ResultResponse*>(response.get());
+        if (result->metadata_cache_state() == ResultResponse::METADATA_CACHE_HIT) {
+          metrics_->result_metadata_cache_hits.inc();
+        } else if (result->metadata_cache_state() == ResultResponse::METADATA_CACHE_MISS) {
+          metrics_->result_metadata_cache_misses.inc();
+        }
+      }
     }
   } else {
     // This request is a speculative execution for whom we already processed
@@ -417,7 +499,9 @@ RequestExecution::RequestExecution(RequestHandler* request_handler)
     , num_retries_(0)
     , start_time_ns_(uv_hrtime()) {}
 
-void RequestExecution::on_execute_next(Timer* timer) { request_handler_->execute(); }
+void RequestExecution::on_execute_next(Timer* timer) {
+  request_handler_->start_speculative_execution(RequestHandler::Protected());
+}
 
 void RequestExecution::on_retry_current_host() { retry_current_host(); }
 
@@ -426,7 +510,19 @@ void RequestExecution::on_retry_next_host() {
   retry_next_host();
 }
 
+bool RequestExecution::fail_if_result_chunks_received() {
+  // Rows already passed to the result chunk callback can't be taken back and
+  // retrying would pass them to the callback again.
+  if (!request_handler_->has_result_chunks(RequestHandler::Protected())) return false;
+  set_error(CASS_ERROR_LIB_RESULT_INTERRUPTED,
+            "Request failed after part of its result was passed to the result chunk callback "
+            "and can't be retried");
+  return true;
+}
+
 void RequestExecution::retry_current_host() {
+  if (fail_if_result_chunks_received()) return;
+
   // Reset the request so it can be executed again
   set_state(REQUEST_STATE_NEW);
 
@@ -434,6 +530,7 @@ void RequestExecution::retry_current_host() {
 }
 
 void RequestExecution::retry_next_host() {
+  if (fail_if_result_chunks_received()) return;
   next_host();
   retry_current_host();
 }
@@ -446,10 +543,12 @@ void RequestExecution::on_write(Connection* connection) {
     request_handler_->add_attempted_address(current_host_->address(), RequestHandler::Protected());
   }
   request_handler_->start_request(connection->loop(), RequestHandler::Protected());
-  if (request()->is_idempotent()) {
+  // Streamed results can't use speculative executions because each execution
+  // would pass its rows to the result chunk callback.
+  if (request()->is_idempotent() && !request()->result_chunk_callback()) {
     int64_t timeout = request_handler_->next_execution(current_host_, RequestHandler::Protected());
     if (timeout == 0) {
-      request_handler_->execute();
+      request_handler_->start_speculative_execution(RequestHandler::Protected());
     } else if (timeout > 0) {
       schedule_timer_.start(connection->loop(), timeout,
                             bind_callback(&RequestExecution::on_execute_next, this));
@@ -466,6 +565,7 @@ void RequestExecution::on_set(ResponseMessage* response) {
 
   switch (response->opcode()) {
     case CQL_OPCODE_RESULT:
+      request_handler_->record_latency(uv_hrtime() - start_time_ns_, RequestHandler::Protected());
       on_result_response(connection, response);
       break;
     case CQL_OPCODE_ERROR:
@@ -483,6 +583,10 @@ void RequestExecution::on_error(CassError code, const String& message) {
   set_error(code, message);
 }
 
+void RequestExecution::on_result_chunk(const ResultResponse::Ptr& chunk) {
+  request_handler_->on_result_chunk(chunk, RequestHandler::Protected());
+}
+
 void RequestExecution::notify_result_metadata_changed(const Request* request,
                                                       ResultResponse* result_response) {
   // Attempt to use the per-query keyspace first (v5+/DSEv2+ only) then
@@ -668,7 +772,8 @@ void RequestExecution::on_error_unprepared(Connection* connection, ErrorResponse
             error->message().to_string().c_str());
 
   String query;
-  String id = error->prepared_id().to_string();
+  PendingPrepareKey key(current_host_->address(), error->prepared_id());
+  const String& id = key.id;
   if (request()->opcode() == CQL_OPCODE_EXECUTE) {
     const ExecuteRequest* execute = static_cast<const ExecuteRequest*>(request());
     query = execute->prepared()->query();
@@ -686,11 +791,29 @@ void RequestExecution::on_error_unprepared(Connection* connection, ErrorResponse
     return;
   }
 
-  RequestCallback::Ptr callback(new PrepareCallback(query, id, this));
+  ConnectionPoolManager* manager = request_handler_->manager(RequestHandler::Protected());
+  Metrics* metrics = request_handler_->metrics(RequestHandler::Protected());
+
+  // Wait for the statement to be re-prepared if another request is already
+  // re-preparing it on this host.
+  if (manager) {
+    RequestCallback::Ptr pending(manager->find_pending_prepare(key));
+    if (pending) {
+      static_cast<PrepareCallback*>(pending.get())->add_waiter(this);
+      if (metrics) metrics->coalesced_reprepares.inc();
+      return;
+    }
+  }
+
+  PrepareCallback::Ptr callback(new PrepareCallback(query, key, this, manager));
   if (connection->write_and_flush(callback) < 0) {
     // Try to prepare on the same host but on a different connection
     retry_current_host();
+    return;
   }
+
+  if (manager) manager->add_pending_prepare(key, callback);
+  if (metrics) metrics->reprepares.inc();
 }
 
 void RequestExecution::set_response(const Response::Ptr& response) {
@@ -159,6 +159,7 @@ class RequestHandler : public RefCounted<RequestHandler> {
 
 public:
   typedef SharedRefPtr<RequestHandler> Ptr;
+  typedef Vector<Ptr> Vec;
 
   RequestHandler(const Request::ConstPtr& request, const ResponseFuture::Ptr& future,
                  Metrics* metrics = NULL);
@@ -187,11 +188,19 @@ public:
 
   Host::Ptr next_host(Protected);
   int64_t next_execution(const Host::Ptr& current_host, Protected);
+  void start_speculative_execution(Protected);
+  void record_latency(uint64_t latency_ns, Protected);
 
   void start_request(uv_loop_t* loop, Protected);
 
   void add_attempted_address(const Address& address, Protected);
 
+  void on_result_chunk(const ResultResponse::Ptr& chunk, Protected);
+  bool has_result_chunks(Protected) const { return has_result_chunks_; }
+
+  ConnectionPoolManager* manager(Protected) const { return manager_; }
+  Metrics* metrics(Protected) const { return metrics_; }
+
   void notify_result_metadata_changed(const String& prepared_id, const String& query,
                                       const String& keyspace, const String& result_metadata_id,
                                       const ResultResponse::ConstPtr& result_response, Protected);
@@ -224,10 +233,11 @@ private:
   SharedRefPtr<ResponseFuture> future_;
 
   bool is_done_;
+  bool has_result_chunks_;
   int running_executions_;
 
   ScopedPtr<QueryPlan> query_plan_;
-  ScopedPtr<SpeculativeExecutionPlan> execution_plan_;
+  SpeculativeExecutionPlan execution_plan_;
   Timer timer_;
 
   const uint64_t start_time_ns_;
@@ -308,6 +318,7 @@ public:
 private:
   void on_execute_next(Timer* timer);
 
+  bool fail_if_result_chunks_received();
   void retry_current_host();
   void retry_next_host();
 
@@ -315,6 +326,7 @@ private:
 
   virtual void on_set(ResponseMessage* response);
   virtual void on_error(CassError code, const String& message);
+  virtual void on_result_chunk(const ResultResponse::Ptr& chunk);
 
   void on_result_response(Connection* connection, ResponseMessage* response);
   void on_error_response(Connection* connection, ResponseMessage* response);
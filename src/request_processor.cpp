@@ -137,6 +137,10 @@ public:
 
 static NopRequestProcessorListener nop_request_processor_listener__;
 
+// The number of requests dequeued at a time (the finish time is checked after
+// each batch).
+static const size_t PROCESS_REQUESTS_BATCH_SIZE = 64;
+
 RequestProcessorSettings::RequestProcessorSettings()
     : max_schema_wait_time_ms(10000)
     , prepare_on_all_hosts(true)
@@ -195,11 +199,14 @@ RequestProcessor::RequestProcessor(RequestProcessorListener* listener, EventLoop
   inc_ref(); // For the connection pool manager
   connection_pool_manager_->set_listener(this);
 
-  // Build/Assign the load balancing policies from the execution profiles
+  // Build/Assign the load balancing and speculative execution policies from
+  // the execution profiles
   default_profile_.build_load_balancing_policy();
+  default_profile_.build_speculative_execution_policy();
   load_balancing_policies_.push_back(default_profile_.load_balancing_policy());
   for (ExecutionProfile::Map::iterator it = profiles_.begin(), end = profiles_.end(); it != end;
        ++it) {
+    it->second.build_speculative_execution_policy();
     it->second.build_load_balancing_policy();
     const LoadBalancingPolicy::Ptr& load_balancing_policy = it->second.load_balancing_policy();
     if (load_balancing_policy) {
@@ -256,6 +263,28 @@ void RequestProcessor::notify_host_maybe_up(const Address& address) {
   event_loop_->add(new ProcessorNotifyMaybeHostUp(address, Ptr(this)));
 }
 
+void RequestProcessor::process_request_batch(const RequestHandler::Vec& request_handlers) {
+  if (request_handlers.empty()) return;
+
+  Vector<RequestHandler*> queued(request_handlers.size());
+  for (size_t i = 0; i < request_handlers.size(); ++i) {
+    queued[i] = request_handlers[i].get();
+    queued[i]->inc_ref(); // Queue reference
+  }
+
+  size_t count = request_queue_->enqueue_many(&queued[0], queued.size());
+  if (count > 0) {
+    request_count_.fetch_add(count);
+    maybe_signal();
+  }
+
+  for (size_t i = count; i < queued.size(); ++i) {
+    queued[i]->dec_ref();
+    queued[i]->set_error(CASS_ERROR_LIB_REQUEST_QUEUE_FULL,
+                         "The request queue has reached capacity");
+  }
+}
+
 void RequestProcessor::notify_token_map_updated(const TokenMap::Ptr& token_map) {
   event_loop_->add(new ProcessorNotifyTokenMapUpdate(token_map, Ptr(this)));
 }
@@ -265,12 +294,7 @@ void RequestProcessor::process_request(const RequestHandler::Ptr& request_handle
 
   if (request_queue_->enqueue(request_handler.get())) {
     request_count_.fetch_add(1);
-    // Only signal the request queue if it's not already processing requests.
-    bool expected = false;
-    if (!is_processing_.load(MEMORY_ORDER_RELAXED) &&
-        is_processing_.compare_exchange_strong(expected, true)) {
-      async_.send();
-    }
+    maybe_signal();
   } else {
     request_handler->dec_ref();
     request_handler->set_error(CASS_ERROR_LIB_REQUEST_QUEUE_FULL,
@@ -545,13 +569,26 @@ void RequestProcessor::maybe_close(int request_count) {
   }
 }
 
+void RequestProcessor::maybe_signal() {
+  // Only signal the request queue if it's not already processing requests.
+  bool expected = false;
+  if (!is_processing_.load(MEMORY_ORDER_RELAXED) &&
+      is_processing_.compare_exchange_strong(expected, true)) {
+    async_.send();
+  }
+}
+
 int RequestProcessor::process_requests(uint64_t processing_time) {
   uint64_t finish_time = uv_hrtime() + processing_time;
 
   int processed = 0;
-  RequestHandler* request_handler = NULL;
-  while (request_queue_->dequeue(request_handler)) {
-    if (request_handler) {
+  RequestHandler* request_handlers[PROCESS_REQUESTS_BATCH_SIZE];
+  size_t count;
+  while ((count = request_queue_->dequeue_many(request_handlers, PROCESS_REQUESTS_BATCH_SIZE)) >
+         0) {
+    for (size_t i = 0; i < count; ++i) {
+      RequestHandler* request_handler = request_handlers[i];
+      if (!request_handler) continue;
       const String& profile_name = request_handler->request()->execution_profile_name();
       const ExecutionProfile* profile(execution_profile(profile_name));
       if (profile) {
@@ -570,8 +607,7 @@ int RequestProcessor::process_requests(uint64_t processing_time) {
       request_handler->dec_ref();
     }
 
-    if ((processed & 0x3F) == 0 && // Check the finish time every 64 requests
-        uv_hrtime() >= finish_time) {
+    if (uv_hrtime() >= finish_time) { // Check the finish time after each batch
       break;
     }
   }
@@ -249,6 +249,15 @@ public:
    */
   void process_request(const RequestHandler::Ptr& request_handler);
 
+  /**
+   * Enqueue several requests to be processed. The requests are added to the
+   * queue together and the processor is signaled at most once.
+   * (thread-safe, asynchronous)
+   *
+   * @param request_handlers
+   */
+  void process_request_batch(const RequestHandler::Vec& request_handlers);
+
   /**
    * Get the number of requests the processor is handling
    *
@@ -330,6 +339,7 @@ private:
   void on_prepare(Prepare* prepare);
 
   void maybe_close(int request_count);
+  void maybe_signal();
   int process_requests(uint64_t processing_time);
 
   bool write_wait_callback(const RequestHandler::Ptr& request_handler,
@@ -23,6 +23,7 @@
 #include "event_response.hpp"
 #include "logger.hpp"
 #include "ready_response.hpp"
+#include "request_callback.hpp"
 #include "result_response.hpp"
 #include "supported_response.hpp"
 
@@ -100,6 +101,12 @@ bool ResponseMessage::allocate_body(int8_t opcode) {
   }
 }
 
+void ResponseMessage::stream_result(const RequestCallback::Ptr& callback) {
+  assert(is_result_body_pending());
+  result_chunk_decoder_.reset(
+      new ResultChunkDecoder(callback, ProtocolVersion(version_), flags_));
+}
+
 ssize_t ResponseMessage::decode(const char* input, size_t size) {
   const char* input_pos = input;
 
@@ -151,6 +158,13 @@ ssize_t ResponseMessage::decode(const char* input, size_t size) {
         return -1;
       }
 
+      // Return after the header of a result so that the result's body can
+      // be streamed (see `is_result_body_pending()`).
+      if (stream_results_ && is_result_body_pending() && stream_ >= 0 && length_ > 0) {
+        received_ = header_size_;
+        return input_pos - input;
+      }
+
       response_body_->set_buffer(length_);
       body_buffer_pos_ = response_body_->data();
     } else {
@@ -160,11 +174,39 @@ ssize_t ResponseMessage::decode(const char* input, size_t size) {
       header_buffer_pos_ += size;
       return size;
     }
+  } else if (is_result_body_pending()) {
+    response_body_->set_buffer(length_);
+    body_buffer_pos_ = response_body_->data();
   }
 
   const size_t remaining = size - (input_pos - input);
   const size_t frame_size = header_size_ + length_;
 
+  if (result_chunk_decoder_) {
+    // Only the partially received rows are buffered
+    size_t needed = received_ >= frame_size ? remaining - (received_ - frame_size) : remaining;
+    if (!result_chunk_decoder_->decode(input_pos, needed)) {
+      is_body_error_ = true;
+      return -1;
+    }
+    input_pos += needed;
+
+    if (received_ < frame_size) {
+      return size;
+    }
+
+    String body;
+    if (!result_chunk_decoder_->finish(&body)) {
+      is_body_error_ = true;
+      return -1;
+    }
+    length_ = body.size();
+    response_body_->set_buffer(length_);
+    memcpy(response_body_->data(), body.data(), length_);
+    if (!decode_body()) return -1;
+    return input_pos - input;
+  }
+
   if (received_ >= frame_size) {
     // We may have received more data then we need, only copy what we need
     size_t overage = received_ - frame_size;
@@ -174,26 +216,7 @@ ssize_t ResponseMessage::decode(const char* input, size_t size) {
     body_buffer_pos_ += needed;
     input_pos += needed;
     assert(body_buffer_pos_ == response_body_->data() + length_);
-    Decoder decoder(response_body_->data(), length_, ProtocolVersion(version_));
-
-    if (flags_ & CASS_FLAG_TRACING) {
-      if (!response_body_->decode_trace_id(decoder)) return -1;
-    }
-
-    if (flags_ & CASS_FLAG_WARNING) {
-      if (!response_body_->decode_warnings(decoder)) return -1;
-    }
-
-    if (flags_ & CASS_FLAG_CUSTOM_PAYLOAD) {
-      if (!response_body_->decode_custom_payload(decoder)) return -1;
-    }
-
-    if (!response_body_->decode(decoder)) {
-      is_body_error_ = true;
-      return -1;
-    }
-
-    is_body_ready_ = true;
+    if (!decode_body()) return -1;
   } else {
     // We haven't received all the data for the frame. We consume the entire
     // buffer.
@@ -204,3 +227,27 @@ ssize_t ResponseMessage::decode(const char* input, size_t size) {
 
   return input_pos - input;
 }
+
+bool ResponseMessage::decode_body() {
+  Decoder decoder(response_body_->data(), length_, ProtocolVersion(version_));
+
+  if (flags_ & CASS_FLAG_TRACING) {
+    if (!response_body_->decode_trace_id(decoder)) return false;
+  }
+
+  if (flags_ & CASS_FLAG_WARNING) {
+    if (!response_body_->decode_warnings(decoder)) return false;
+  }
+
+  if (flags_ & CASS_FLAG_CUSTOM_PAYLOAD) {
+    if (!response_body_->decode_custom_payload(decoder)) return false;
+  }
+
+  if (!response_body_->decode(decoder)) {
+    is_body_error_ = true;
+    return false;
+  }
+
+  is_body_ready_ = true;
+  return true;
+}
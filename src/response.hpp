@@ -25,6 +25,9 @@
 #include "hash_table.hpp"
 #include "macros.hpp"
 #include "ref_counted.hpp"
+#include "result_chunk_decoder.hpp"
+#include "scoped_ptr.hpp"
+#include "slab_allocator.hpp"
 #include "utils.hpp"
 
 #include <uv.h>
@@ -35,6 +38,8 @@
 namespace datastax { namespace internal { namespace core {
 
 class Response : public RefCounted<Response> {
+  SLAB_ALLOCATED
+
 public:
   typedef SharedRefPtr<Response> Ptr;
 
@@ -78,6 +83,8 @@ private:
 };
 
 class ResponseMessage : public Allocated {
+  SLAB_ALLOCATED
+
 public:
   ResponseMessage()
       : version_(0)
@@ -91,7 +98,8 @@ public:
       , header_buffer_pos_(header_buffer_)
       , is_body_ready_(false)
       , is_body_error_(false)
-      , body_buffer_pos_(NULL) {}
+      , body_buffer_pos_(NULL)
+      , stream_results_(false) {}
 
   uint8_t flags() const { return flags_; }
 
@@ -103,10 +111,39 @@ public:
 
   bool is_body_ready() const { return is_body_ready_; }
 
+  /**
+   * Stop after the header of a result response so that its rows can be
+   * streamed. This is only enabled while the connection has a request with a
+   * result chunk callback; otherwise the body is buffered right away.
+   *
+   * @param stream_results True if result bodies can be streamed.
+   */
+  void set_stream_results(bool stream_results) { stream_results_ = stream_results; }
+
+  /**
+   * Determines if the header of a result response has been received and the
+   * body hasn't been buffered yet. The result's rows can be decoded as they're
+   * received by calling `stream_result()` before the rest of the response is
+   * decoded.
+   */
+  bool is_result_body_pending() const {
+    return is_header_received_ && opcode_ == CQL_OPCODE_RESULT && body_buffer_pos_ == NULL &&
+           !result_chunk_decoder_;
+  }
+
+  /**
+   * Decode the result's rows as they're received and pass them to the
+   * request's result chunk callback (see `ResultChunkDecoder`).
+   *
+   * @param callback The callback of the request the result is for.
+   */
+  void stream_result(const SharedRefPtr<RequestCallback>& callback);
+
   ssize_t decode(const char* input, size_t size);
 
 private:
   bool allocate_body(int8_t opcode);
+  bool decode_body();
 
 private:
   uint8_t version_;
@@ -125,6 +162,8 @@ private:
   bool is_body_error_;
   Response::Ptr response_body_;
   char* body_buffer_pos_;
+  bool stream_results_;
+  ScopedPtr<ResultChunkDecoder> result_chunk_decoder_;
 
 private:
   DISALLOW_COPY_AND_ASSIGN(ResponseMessage);
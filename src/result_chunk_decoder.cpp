@@ -0,0 +1,276 @@
+/*
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include "result_chunk_decoder.hpp"
+
+#include "constants.hpp"
+#include "logger.hpp"
+#include "request.hpp"
+#include "request_callback.hpp"
+#include "result_response.hpp"
+#include "serialization.hpp"
+
+#include <string.h>
+
+using namespace datastax;
+using namespace datastax::internal;
+using namespace datastax::internal::core;
+
+namespace {
+
+// Scans over an encoded result without decoding it. Unlike `Decoder`, running
+// out of input isn't an error because the rest of the result might not have
+// been received yet.
+class Scanner {
+public:
+  Scanner(const char* input, size_t size)
+      : pos_(input)
+      , end_(input + size) {}
+
+  const char* pos() const { return pos_; }
+
+  bool skip(size_t size) {
+    if (static_cast<size_t>(end_ - pos_) < size) return false;
+    pos_ += size;
+    return true;
+  }
+
+  bool read_uint16(uint16_t* output) {
+    if (static_cast<size_t>(end_ - pos_) < sizeof(uint16_t)) return false;
+    pos_ = decode_uint16(pos_, *output);
+    return true;
+  }
+
+  bool read_int32(int32_t* output) {
+    if (static_cast<size_t>(end_ - pos_) < sizeof(int32_t)) return false;
+    pos_ = decode_int32(pos_, *output);
+    return true;
+  }
+
+  bool skip_string() {
+    uint16_t size = 0;
+    return read_uint16(&size) && skip(size);
+  }
+
+  bool skip_bytes() {
+    int32_t size = 0;
+    return read_int32(&size) && (size < 0 || skip(size));
+  }
+
+  bool skip_data_type() {
+    uint16_t value_type = 0;
+    if (!read_uint16(&value_type)) return false;
+
+    uint16_t n = 0;
+    switch (value_type) {
+      case CASS_VALUE_TYPE_CUSTOM:
+        return skip_string();
+
+      case CASS_VALUE_TYPE_LIST:
+      case CASS_VALUE_TYPE_SET:
+        return skip_data_type();
+
+      case CASS_VALUE_TYPE_MAP:
+        return skip_data_type() && skip_data_type();
+
+      case CASS_VALUE_TYPE_UDT:
+        if (!skip_string() || !skip_string() || !read_uint16(&n)) return false;
+        for (uint16_t i = 0; i < n; ++i) {
+          if (!skip_string() || !skip_data_type()) return false;
+        }
+        return true;
+
+      case CASS_VALUE_TYPE_TUPLE:
+        if (!read_uint16(&n)) return false;
+        for (uint16_t i = 0; i < n; ++i) {
+          if (!skip_data_type()) return false;
+        }
+        return true;
+
+      default:
+        return true;
+    }
+  }
+
+private:
+  const char* pos_;
+  const char* end_;
+};
+
+} // namespace
+
+ResultChunkDecoder::ResultChunkDecoder(const RequestCallback::Ptr& callback,
+                                       ProtocolVersion version, uint8_t flags)
+    : callback_(callback)
+    , version_(version)
+    , flags_(flags)
+    , state_(STATE_PREFIX)
+    , result_offset_(0)
+    , column_count_(0)
+    , rows_remaining_(0)
+    , rows_decoded_(0) {}
+
+ResultChunkDecoder::~ResultChunkDecoder() {}
+
+bool ResultChunkDecoder::decode(const char* input, size_t size) {
+  pending_.append(input, size);
+
+  if (state_ == STATE_PREFIX && !decode_prefix()) {
+    return true; // Wait for the rest of the result's metadata
+  }
+
+  if (state_ == STATE_ROWS) {
+    return decode_rows();
+  }
+
+  return true;
+}
+
+bool ResultChunkDecoder::finish(String* body) {
+  if (state_ == STATE_ROWS) {
+    if (rows_remaining_ != 0 || !pending_.empty()) {
+      LOG_ERROR("Rows result is missing %d row(s)", rows_remaining_);
+      return false;
+    }
+    // The rows have already been passed to the callback so the body only
+    // contains the result's metadata.
+    body->assign(prefix_);
+    encode_int32(&(*body)[body->size() - sizeof(int32_t)], 0);
+  } else {
+    body->swap(pending_);
+  }
+  return true;
+}
+
+// Determines if the result is a rows result and, if so, waits for everything
+// before the rows (the response's tracing ID, warnings and custom payload then
+// the result's metadata and row count) to be received.
+bool ResultChunkDecoder::decode_prefix() {
+  Scanner scanner(pending_.data(), pending_.size());
+
+  if (flags_ & CASS_FLAG_TRACING) {
+    if (!scanner.skip(sizeof(CassUuid))) return false;
+  }
+
+  uint16_t n = 0;
+  if (flags_ & CASS_FLAG_WARNING) {
+    if (!scanner.read_uint16(&n)) return false;
+    for (uint16_t i = 0; i < n; ++i) {
+      if (!scanner.skip_string()) return false;
+    }
+  }
+
+  if (flags_ & CASS_FLAG_CUSTOM_PAYLOAD) {
+    if (!scanner.read_uint16(&n)) return false;
+    for (uint16_t i = 0; i < n; ++i) {
+      if (!scanner.skip_string() || !scanner.skip_bytes()) return false;
+    }
+  }
+
+  size_t result_offset = scanner.pos() - pending_.data();
+
+  int32_t kind = 0;
+  if (!scanner.read_int32(&kind)) return false;
+
+  if (kind != CASS_RESULT_KIND_ROWS) {
+    state_ = STATE_BUFFERED;
+    return true;
+  }
+
+  int32_t flags = 0;
+  int32_t column_count = 0;
+  if (!scanner.read_int32(&flags) || !scanner.read_int32(&column_count)) return false;
+
+  // This follows the same order as `ResultResponse::decode_metadata()`
+  if ((flags & CASS_RESULT_FLAG_METADATA_CHANGED) && !scanner.skip_string()) return false;
+  if ((flags & CASS_RESULT_FLAG_HAS_MORE_PAGES) && !scanner.skip_bytes()) return false;
+
+  if (!(flags & CASS_RESULT_FLAG_NO_METADATA)) {
+    bool global_table_spec = flags & CASS_RESULT_FLAG_GLOBAL_TABLESPEC;
+    if (global_table_spec && (!scanner.skip_string() || !scanner.skip_string())) return false;
+    for (int32_t i = 0; i < column_count; ++i) {
+      if (!global_table_spec && (!scanner.skip_string() || !scanner.skip_string())) return false;
+      if (!scanner.skip_string() || !scanner.skip_data_type()) return false;
+    }
+  }
+
+  int32_t row_count = 0;
+  if (!scanner.read_int32(&row_count)) return false;
+
+  if (column_count < 0 || row_count < 0) {
+    // Let the response's decoder handle the invalid result
+    state_ = STATE_BUFFERED;
+    return true;
+  }
+
+  size_t prefix_size = scanner.pos() - pending_.data();
+  prefix_.assign(pending_.data(), prefix_size);
+  pending_.erase(0, prefix_size);
+  result_offset_ = result_offset;
+  column_count_ = column_count;
+  rows_remaining_ = row_count;
+  state_ = STATE_ROWS;
+  return true;
+}
+
+bool ResultChunkDecoder::decode_rows() {
+  Scanner scanner(pending_.data(), pending_.size());
+  const char* rows_end = scanner.pos();
+
+  int32_t row_count = 0;
+  while (row_count < rows_remaining_) {
+    bool is_complete = true;
+    for (int32_t i = 0; i < column_count_ && is_complete; ++i) {
+      is_complete = scanner.skip_bytes();
+    }
+    if (!is_complete) break;
+    rows_end = scanner.pos();
+    row_count++;
+  }
+
+  if (row_count == 0) {
+    return true; // Wait for a complete row
+  }
+
+  // The chunk is a rows result with the same metadata as the response and
+  // only the complete rows.
+  size_t result_size = prefix_.size() - result_offset_;
+  size_t rows_size = rows_end - pending_.data();
+  ResultResponse::Ptr chunk(new ResultResponse());
+  chunk->set_buffer(result_size + rows_size);
+  memcpy(chunk->data(), prefix_.data() + result_offset_, result_size);
+  encode_int32(chunk->data() + result_size - sizeof(int32_t), row_count);
+  memcpy(chunk->data() + result_size, pending_.data(), rows_size);
+
+  Decoder decoder(chunk->data(), result_size + rows_size, version_);
+  if (!chunk->decode(decoder)) {
+    return false;
+  }
+
+  // Execute requests that skip metadata use the prepared statement's metadata
+  if (chunk->no_metadata() && callback_->prepared_metadata_entry()) {
+    chunk->set_metadata(callback_->prepared_metadata_entry()->result()->result_metadata());
+  }
+
+  pending_.erase(0, rows_size);
+  rows_remaining_ -= row_count;
+  rows_decoded_ += row_count;
+
+  callback_->on_result_chunk(chunk);
+  return true;
+}
@@ -0,0 +1,97 @@
+/*
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifndef DATASTAX_INTERNAL_RESULT_CHUNK_DECODER_HPP
+#define DATASTAX_INTERNAL_RESULT_CHUNK_DECODER_HPP
+
+#include "allocated.hpp"
+#include "protocol.hpp"
+#include "ref_counted.hpp"
+#include "string.hpp"
+
+namespace datastax { namespace internal { namespace core {
+
+class RequestCallback;
+
+/**
+ * Decodes the body of a rows result incrementally, as it's received, instead
+ * of buffering the whole body. Each time at least one complete row has been
+ * received, the complete rows are decoded into a separate result ("chunk")
+ * and passed to the request callback's `on_result_chunk()`, which passes
+ * them to the request's result chunk callback. Only the partially
+ * received row is kept, so the memory used is bounded by the size of the
+ * largest row instead of the size of the page.
+ *
+ * After the body is complete, the response's body contains the result's
+ * metadata and paging state, but no rows. The bodies of other kinds of
+ * results are buffered and decoded normally.
+ */
+class ResultChunkDecoder : public Allocated {
+public:
+  ResultChunkDecoder(const SharedRefPtr<RequestCallback>& callback, ProtocolVersion version,
+                     uint8_t flags);
+  ~ResultChunkDecoder();
+
+  /**
+   * Decode the next part of the body.
+   *
+   * @param input The next part of the body.
+   * @param size The size of the input.
+   * @return false if the body is invalid, otherwise true.
+   */
+  bool decode(const char* input, size_t size);
+
+  /**
+   * Finish decoding the body.
+   *
+   * @param body The body (without the result's rows) to decode as the
+   * response's body.
+   * @return false if the body is invalid, otherwise true.
+   */
+  bool finish(String* body);
+
+  /**
+   * The number of rows passed to the result chunk callback.
+   */
+  int32_t rows_decoded() const { return rows_decoded_; }
+
+private:
+  enum State { STATE_PREFIX, STATE_ROWS, STATE_BUFFERED };
+
+  bool decode_prefix();
+  bool decode_rows();
+
+private:
+  SharedRefPtr<RequestCallback> callback_;
+  const ProtocolVersion version_;
+  const uint8_t flags_;
+  State state_;
+  String pending_;
+  String prefix_;
+  size_t result_offset_;
+  int32_t column_count_;
+  int32_t rows_remaining_;
+  int32_t rows_decoded_;
+
+private:
+  DISALLOW_COPY_AND_ASSIGN(ResultChunkDecoder);
+};
+
+}}} // namespace datastax::internal::core
+
+#endif
@@ -27,18 +27,20 @@ namespace datastax { namespace internal { namespace core {
 
 class ResultIterator : public Iterator {
 public:
-  ResultIterator(const ResultResponse* result)
+  ResultIterator(const ResultResponse* result, bool is_lazy = false)
       : Iterator(CASS_ITERATOR_TYPE_RESULT)
       , result_(result)
       , index_(-1)
+      , is_lazy_(is_lazy)
       , row_(result) {
     decoder_ = (const_cast<ResultResponse*>(result))->row_decoder();
     row_.values = result_->first_row().values;
   }
 
   virtual bool next() {
-    return (index_ + 1 < result_->row_count()) &&
-           (++index_ < 1 || decode_next_row(decoder_, row_.values));
+    if (index_ + 1 >= result_->row_count()) return false;
+    if (++index_ < 1) return true; // The first row is already decoded
+    return is_lazy_ ? decode_next_row_lazy(decoder_, row_) : decode_next_row(decoder_, row_.values);
   }
 
   const Row* row() const {
@@ -50,6 +52,7 @@ private:
   const ResultResponse* result_;
   Decoder decoder_;
   int32_t index_;
+  bool is_lazy_;
   Row row_;
 };
 
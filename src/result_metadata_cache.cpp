@@ -0,0 +1,86 @@
+/*
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include "result_metadata_cache.hpp"
+
+#include "hash.hpp"
+#include "macros.hpp"
+
+#include <string.h>
+
+using namespace datastax;
+using namespace datastax::internal;
+using namespace datastax::internal::core;
+
+// The hashes used as the empty and deleted keys of the entry map
+#define EMPTY_KEY 0
+#define DELETED_KEY 1
+
+uint64_t ResultMetadataCache::Key::hash() const {
+  uint64_t h = hash::fnv1a(column_specs.data(), column_specs.size());
+  h ^= (static_cast<uint64_t>(version.value()) << 48) ^
+       (static_cast<uint64_t>(column_count) << 1) ^ (global_table_spec ? 1 : 0);
+  return h > DELETED_KEY ? h : h + DELETED_KEY + 1;
+}
+
+bool ResultMetadataCache::Entry::equals(const Key& key) const {
+  return version == key.version && column_count == key.column_count &&
+         global_table_spec == key.global_table_spec &&
+         column_specs.size() == key.column_specs.size() &&
+         memcmp(column_specs.data(), key.column_specs.data(), column_specs.size()) == 0;
+}
+
+ResultMetadataCache::ResultMetadataCache()
+    : order_(MAX_ENTRIES, EMPTY_KEY)
+    , oldest_(0) {
+  entries_.set_empty_key(EMPTY_KEY);
+  entries_.set_deleted_key(DELETED_KEY);
+}
+
+ResultMetadata::Ptr ResultMetadataCache::get(const Key& key) const {
+  EntryMap::const_iterator it = entries_.find(key.hash());
+  if (it != entries_.end() && it->second.equals(key)) {
+    return it->second.metadata;
+  }
+  return ResultMetadata::Ptr();
+}
+
+void ResultMetadataCache::put(const Key& key, const RefBuffer::Ptr& buffer,
+                              const ResultMetadata::Ptr& metadata) {
+  uint64_t hash = key.hash();
+
+  EntryMap::iterator it = entries_.find(hash);
+  if (it == entries_.end()) {
+    // Evict the oldest entry to make room for the new entry
+    uint64_t oldest = order_[oldest_];
+    if (oldest != EMPTY_KEY) {
+      entries_.erase(oldest);
+    }
+    order_[oldest_] = hash;
+    oldest_ = (oldest_ + 1) % MAX_ENTRIES;
+    it = entries_.insert(EntryMap::value_type(hash, Entry())).first;
+  } // Otherwise, replace the colliding entry
+
+  Entry& entry = it->second;
+  entry.version = key.version;
+  entry.column_count = key.column_count;
+  entry.global_table_spec = key.global_table_spec;
+  entry.column_specs = key.column_specs;
+  entry.buffer = buffer;
+  entry.metadata = metadata;
+}
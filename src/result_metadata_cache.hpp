@@ -0,0 +1,129 @@
+/*
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifndef DATASTAX_INTERNAL_RESULT_METADATA_CACHE_HPP
+#define DATASTAX_INTERNAL_RESULT_METADATA_CACHE_HPP
+
+#include "allocated.hpp"
+#include "dense_hash_map.hpp"
+#include "loop_context.hpp"
+#include "macros.hpp"
+#include "protocol.hpp"
+#include "ref_counted.hpp"
+#include "result_metadata.hpp"
+#include "string_ref.hpp"
+#include "vector.hpp"
+
+namespace datastax { namespace internal { namespace core {
+
+/**
+ * A bounded cache of decoded result metadata keyed by the raw bytes of the
+ * metadata's column specifications. This allows the results of simple
+ * queries, and each page of paged queries, to share the same metadata instead
+ * of decoding identical column specifications for every response.
+ *
+ * A cache is owned by each event loop and only used by the event loop's
+ * thread so it doesn't require any locking. The metadata it returns is
+ * immutable and can be shared by any number of threads.
+ */
+class ResultMetadataCache : public Allocated {
+public:
+  static const size_t MAX_ENTRIES = 128;
+
+  /**
+   * The column specifications of a result's metadata.
+   */
+  struct Key {
+    Key(ProtocolVersion version, int32_t column_count, bool global_table_spec,
+        const StringRef& column_specs)
+        : version(version)
+        , column_count(column_count)
+        , global_table_spec(global_table_spec)
+        , column_specs(column_specs) {}
+
+    uint64_t hash() const;
+
+    ProtocolVersion version;
+    int32_t column_count;
+    bool global_table_spec;
+    StringRef column_specs;
+  };
+
+  ResultMetadataCache();
+
+  /**
+   * Get the metadata for the specified column specifications.
+   *
+   * @param key The raw column specifications.
+   * @return The cached metadata or NULL if it's not in the cache.
+   */
+  ResultMetadata::Ptr get(const Key& key) const;
+
+  /**
+   * Add metadata to the cache. The oldest entry is evicted if the cache is
+   * full.
+   *
+   * @param key The raw column specifications; these must be the bytes
+   * referenced by the metadata's column definitions.
+   * @param buffer The buffer that contains the column specifications.
+   * @param metadata The metadata decoded from the column specifications.
+   */
+  void put(const Key& key, const RefBuffer::Ptr& buffer, const ResultMetadata::Ptr& metadata);
+
+  size_t size() const { return entries_.size(); }
+
+public:
+  /**
+   * Get the cache of the calling thread's event loop (see `LoopContext`).
+   *
+   * @return The cache or NULL if the thread doesn't have one.
+   */
+  static ResultMetadataCache* current() {
+    LoopContext* context = LoopContext::current();
+    return context != NULL ? context->metadata_cache : NULL;
+  }
+
+private:
+  struct Entry {
+    Entry()
+        : column_count(0)
+        , global_table_spec(false) {}
+
+    bool equals(const Key& key) const;
+
+    ProtocolVersion version;
+    int32_t column_count;
+    bool global_table_spec;
+    StringRef column_specs; // References `buffer`
+    RefBuffer::Ptr buffer;
+    ResultMetadata::Ptr metadata;
+  };
+
+  typedef DenseHashMap<uint64_t, Entry> EntryMap;
+
+  EntryMap entries_;
+  Vector<uint64_t> order_; // A ring of the entries' hashes in insertion order
+  size_t oldest_;
+
+private:
+  DISALLOW_COPY_AND_ASSIGN(ResultMetadataCache);
+};
+
+}}} // namespace datastax::internal::core
+
+#endif
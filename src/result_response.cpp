@@ -22,6 +22,7 @@
 #include "logger.hpp"
 #include "protocol.hpp"
 #include "result_metadata.hpp"
+#include "result_metadata_cache.hpp"
 #include "result_response.hpp"
 #include "serialization.hpp"
 
@@ -189,6 +190,111 @@ private:
   SimpleDataTypeCache& cache_;
 };
 
+// Skips over a data type without decoding it
+static bool skip_data_type(Decoder& decoder) {
+  uint16_t value_type;
+  if (!decoder.decode_uint16(value_type)) return false;
+
+  StringRef temp;
+  uint16_t n;
+  switch (value_type) {
+    case CASS_VALUE_TYPE_CUSTOM:
+      return decoder.decode_string(&temp);
+
+    case CASS_VALUE_TYPE_LIST:
+    case CASS_VALUE_TYPE_SET:
+      return skip_data_type(decoder);
+
+    case CASS_VALUE_TYPE_MAP:
+      return skip_data_type(decoder) && skip_data_type(decoder);
+
+    case CASS_VALUE_TYPE_UDT:
+      if (!decoder.decode_string(&temp) || !decoder.decode_string(&temp) ||
+          !decoder.decode_uint16(n)) {
+        return false;
+      }
+      for (uint16_t i = 0; i < n; ++i) {
+        if (!decoder.decode_string(&temp) || !skip_data_type(decoder)) return false;
+      }
+      return true;
+
+    case CASS_VALUE_TYPE_TUPLE:
+      if (!decoder.decode_uint16(n)) return false;
+      for (uint16_t i = 0; i < n; ++i) {
+        if (!skip_data_type(decoder)) return false;
+      }
+      return true;
+
+    default:
+      return true;
+  }
+}
+
+static bool decode_column_specs(Decoder& decoder, int32_t column_count, bool global_table_spec,
+                                const RefBuffer::Ptr& buffer, ResultMetadata::Ptr* metadata) {
+  metadata->reset(new ResultMetadata(column_count, buffer));
+
+  SimpleDataTypeCache cache;
+
+  for (int i = 0; i < column_count; ++i) {
+    ColumnDefinition def;
+
+    def.index = i;
+
+    if (!global_table_spec) {
+      CHECK_RESULT(decoder.decode_string(&def.keyspace));
+      CHECK_RESULT(decoder.decode_string(&def.table));
+    }
+
+    CHECK_RESULT(decoder.decode_string(&def.name));
+
+    DataTypeDecoder type_decoder(decoder, cache);
+    def.data_type = DataType::ConstPtr(type_decoder.decode());
+    if (def.data_type == DataType::NIL) return false;
+
+    (*metadata)->add(def);
+  }
+  return true;
+}
+
+// Decodes the column specifications using the event loop's metadata cache.
+// The cached metadata references a copy of the column specifications, instead
+// of the response's buffer, so that cached entries don't keep the (possibly
+// large) responses alive.
+static bool decode_column_specs_cached(Decoder& decoder, int32_t column_count,
+                                       bool global_table_spec, ResultMetadataCache* cache,
+                                       ResultMetadata::Ptr* metadata, bool* is_hit) {
+  Decoder end(decoder);
+  for (int i = 0; i < column_count; ++i) {
+    StringRef temp;
+    if (!global_table_spec) {
+      CHECK_RESULT(end.decode_string(&temp));
+      CHECK_RESULT(end.decode_string(&temp));
+    }
+    CHECK_RESULT(end.decode_string(&temp));
+    CHECK_RESULT(skip_data_type(end));
+  }
+
+  StringRef column_specs(decoder.bytes_until(end));
+  ResultMetadataCache::Key key(decoder.protocol_version(), column_count, global_table_spec,
+                               column_specs);
+
+  *metadata = cache->get(key);
+  *is_hit = !!*metadata;
+
+  if (!*is_hit) {
+    RefBuffer::Ptr buffer(RefBuffer::create(column_specs.size()));
+    memcpy(buffer->data(), column_specs.data(), column_specs.size());
+    Decoder copy(buffer->data(), column_specs.size(), decoder.protocol_version());
+    CHECK_RESULT(decode_column_specs(copy, column_count, global_table_spec, buffer, metadata));
+    key.column_specs = StringRef(buffer->data(), column_specs.size());
+    cache->put(key, buffer, *metadata);
+  }
+
+  decoder = end;
+  return true;
+}
+
 void ResultResponse::set_metadata(const ResultMetadata::Ptr& metadata) {
   metadata_ = metadata;
   decode_first_row();
@@ -196,6 +302,7 @@ void ResultResponse::set_metadata(const ResultMetadata::Ptr& metadata) {
 
 bool ResultResponse::decode(Decoder& decoder) {
   protocol_version_ = decoder.protocol_version();
+  encoded_result_ = decoder.remaining_bytes();
   decoder.set_type("result");
   bool is_valid = false;
 
@@ -274,27 +381,17 @@ bool ResultResponse::decode_metadata(Decoder& decoder, ResultMetadata::Ptr* meta
       CHECK_RESULT(decoder.decode_string(&table_));
     }
 
-    metadata->reset(new ResultMetadata(column_count, this->buffer()));
-
-    SimpleDataTypeCache cache;
-
-    for (int i = 0; i < column_count; ++i) {
-      ColumnDefinition def;
-
-      def.index = i;
-
-      if (!global_table_spec) {
-        CHECK_RESULT(decoder.decode_string(&def.keyspace));
-        CHECK_RESULT(decoder.decode_string(&def.table));
-      }
-
-      CHECK_RESULT(decoder.decode_string(&def.name));
-
-      DataTypeDecoder type_decoder(decoder, cache);
-      def.data_type = DataType::ConstPtr(type_decoder.decode());
-      if (def.data_type == DataType::NIL) return false;
-
-      (*metadata)->add(def);
+    // Only the metadata of rows results is cached; prepared results are
+    // already cached with their prepared statements.
+    ResultMetadataCache* cache = has_pk_indices ? NULL : ResultMetadataCache::current();
+    if (cache) {
+      bool is_hit = false;
+      CHECK_RESULT(decode_column_specs_cached(decoder, column_count, global_table_spec, cache,
+                                              metadata, &is_hit));
+      metadata_cache_state_ = is_hit ? METADATA_CACHE_HIT : METADATA_CACHE_MISS;
+    } else {
+      CHECK_RESULT(
+          decode_column_specs(decoder, column_count, global_table_spec, this->buffer(), metadata));
     }
   }
   return true;
@@ -312,6 +409,7 @@ bool ResultResponse::decode_first_row() {
 bool ResultResponse::decode_rows(Decoder& decoder) {
   CHECK_RESULT(decode_metadata(decoder, &metadata_));
   CHECK_RESULT(decoder.decode_int32(row_count_));
+  encoded_rows_ = decoder.remaining_bytes();
   row_decoder_ = decoder;
   CHECK_RESULT(decode_first_row());
   return true;
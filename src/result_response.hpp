@@ -38,10 +38,13 @@ public:
   typedef SharedRefPtr<const ResultResponse> ConstPtr;
   typedef Vector<size_t> PKIndexVec;
 
+  enum MetadataCacheState { METADATA_NOT_CACHED, METADATA_CACHE_HIT, METADATA_CACHE_MISS };
+
   ResultResponse()
       : Response(CQL_OPCODE_RESULT)
       , kind_(CASS_RESULT_KIND_VOID)
       , has_more_pages_(false)
+      , metadata_cache_state_(METADATA_NOT_CACHED)
       , row_count_(0) {
     first_row_.set_result(this);
   }
@@ -62,6 +65,10 @@ public:
 
   const ResultMetadata::Ptr& result_metadata() const { return result_metadata_; }
 
+  // Determines if the metadata was retrieved from (or added to) the event
+  // loop's result metadata cache.
+  MetadataCacheState metadata_cache_state() const { return metadata_cache_state_; }
+
   StringRef paging_state() const { return paging_state_; }
   StringRef prepared_id() const { return prepared_id_; }
   StringRef result_metadata_id() const { return result_metadata_id_; }
@@ -84,6 +91,14 @@ public:
 
   const PKIndexVec& pk_indices() const { return pk_indices_; }
 
+  // The encoded result without the frame's tracing ID, warnings or custom
+  // payload. This can be decoded again using a new response.
+  StringRef encoded_result() const { return encoded_result_; }
+
+  // The encoded rows of a rows result, starting at the first row. This is
+  // part of the encoded result.
+  StringRef encoded_rows() const { return encoded_rows_; }
+
   virtual bool decode(Decoder& decoder);
 
 private:
@@ -106,6 +121,7 @@ private:
   bool has_more_pages_; // row data
   ResultMetadata::Ptr metadata_;
   ResultMetadata::Ptr result_metadata_;
+  MetadataCacheState metadata_cache_state_;
   StringRef paging_state_;       // row paging
   StringRef prepared_id_;        // prepared result
   StringRef result_metadata_id_; // prepared result, protocol v5/DSEv2
@@ -113,6 +129,8 @@ private:
   StringRef keyspace_;           // rows, set keyspace, and schema change
   StringRef table_;              // rows, and schema change
   StringRef new_metadata_id_;    // rows result, protocol v5/DSEv2
+  StringRef encoded_result_;
+  StringRef encoded_rows_;
   int32_t row_count_;
   Decoder row_decoder_;
   Row first_row_;
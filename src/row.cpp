@@ -19,6 +19,7 @@
 #include "row.hpp"
 
 #include "external.hpp"
+#include "logger.hpp"
 #include "result_metadata.hpp"
 #include "result_response.hpp"
 #include "serialization.hpp"
@@ -33,7 +34,7 @@ const CassValue* cass_row_get_column(const CassRow* row, size_t index) {
   if (index >= row->values.size()) {
     return NULL;
   }
-  return CassValue::to(&row->values[index]);
+  return CassValue::to(row->get_column(index));
 }
 
 const CassValue* cass_row_get_column_by_name(const CassRow* row, const char* name) {
@@ -72,14 +73,39 @@ bool decode_next_row(Decoder& decoder, OutputValueVec& output) {
   return true;
 }
 
+bool decode_next_row_lazy(Decoder& decoder, Row& row) {
+  const size_t column_count = row.values.size();
+  row.columns_.resize(column_count);
+  row.protocol_version_ = decoder.protocol_version();
+  for (size_t i = 0; i < column_count; ++i) {
+    if (!decoder.skip_value(&row.columns_[i])) return false;
+  }
+  return true;
+}
+
 }}} // namespace datastax::internal::core
 
+const Value* Row::decode_column(size_t index) const {
+  const char* position = columns_[index];
+  int32_t size = 0;
+  internal::decode_int32(position, size);
+  // The value's bounds were checked when the row was scanned
+  Decoder decoder(position, sizeof(int32_t) + (size > 0 ? size : 0), protocol_version_);
+  Value& value = const_cast<Value&>(values[index]);
+  if (!decoder.update_value(value)) {
+    LOG_ERROR("Unable to decode column %u of row", static_cast<unsigned int>(index));
+    return NULL;
+  }
+  columns_[index] = NULL;
+  return &value;
+}
+
 const Value* Row::get_by_name(const StringRef& name) const {
   IndexVec indices;
   if (result_->metadata()->get_indices(name, &indices) == 0) {
     return NULL;
   }
-  return &values[indices[0]];
+  return get_column(indices[0]);
 }
 
 bool Row::get_string_by_name(const StringRef& name, String* out) const {
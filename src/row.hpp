@@ -38,6 +38,13 @@ public:
 
   OutputValueVec values;
 
+  const Value* get_column(size_t index) const {
+    if (index < columns_.size() && columns_[index] != NULL) {
+      return decode_column(index);
+    }
+    return &values[index];
+  }
+
   const Value* get_by_name(const StringRef& name) const;
 
   bool get_string_by_name(const StringRef& name, String* out) const;
@@ -48,12 +55,24 @@ public:
 
   void set_result(ResultResponse* result) { result_ = result; }
 
+private:
+  friend bool decode_next_row_lazy(Decoder& decoder, Row& row);
+
+  const Value* decode_column(size_t index) const;
+
 private:
   const ResultResponse* result_;
+  // The positions of the lazily decoded row's columns; NULL once a column's
+  // value has been decoded.
+  mutable Vector<const char*> columns_;
+  ProtocolVersion protocol_version_;
 };
 
 bool decode_row(Decoder& decoder, const ResultResponse* result, OutputValueVec& output);
 bool decode_next_row(Decoder& decoder, OutputValueVec& output);
+// Only records the position of the next row's columns. The values are decoded
+// when they're retrieved using `Row::get_column()`.
+bool decode_next_row_lazy(Decoder& decoder, Row& row);
 
 }}} // namespace datastax::internal::core
 
@@ -41,7 +41,7 @@ public:
 
   const Value* column() const {
     assert(index_ >= 0 && static_cast<size_t>(index_) < row_->values.size());
-    return &row_->values[index_];
+    return row_->get_column(index_);
   }
 
 private:
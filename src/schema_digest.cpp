@@ -0,0 +1,327 @@
+/*
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include "schema_digest.hpp"
+
+#include "decoder.hpp"
+#include "hash.hpp"
+#include "logger.hpp"
+#include "serialization.hpp"
+#include "set.hpp"
+
+#include <string.h>
+
+using namespace datastax;
+using namespace datastax::internal;
+using namespace datastax::internal::core;
+
+namespace {
+
+enum SchemaRowsType {
+  KEYSPACE_ROWS,     // Rows that belong to a keyspace
+  TABLE_ROWS,        // Rows that belong to a table
+  VIEW_ROWS,         // Rows that belong to a materialized view (and its base table)
+  TABLE_OR_VIEW_ROWS // Rows that belong to either a table or a materialized view
+};
+
+struct SchemaResult {
+  ResultResponse::Ptr ControlConnectionSchema::*result;
+  SchemaRowsType type;
+};
+
+const SchemaResult schema_results__[] = {
+  { &ControlConnectionSchema::keyspaces, KEYSPACE_ROWS },
+  { &ControlConnectionSchema::tables, TABLE_ROWS },
+  { &ControlConnectionSchema::views, VIEW_ROWS },
+  { &ControlConnectionSchema::columns, TABLE_OR_VIEW_ROWS },
+  { &ControlConnectionSchema::indexes, TABLE_ROWS },
+  { &ControlConnectionSchema::user_types, KEYSPACE_ROWS },
+  { &ControlConnectionSchema::functions, KEYSPACE_ROWS },
+  { &ControlConnectionSchema::aggregates, KEYSPACE_ROWS },
+  { &ControlConnectionSchema::virtual_keyspaces, KEYSPACE_ROWS },
+  { &ControlConnectionSchema::virtual_tables, TABLE_ROWS },
+  { &ControlConnectionSchema::virtual_columns, TABLE_OR_VIEW_ROWS }
+};
+
+const size_t num_schema_results__ = sizeof(schema_results__) / sizeof(schema_results__[0]);
+
+struct SchemaRow {
+  StringRef keyspace_name;
+  StringRef table_name; // The (base) table name, empty for keyspace rows
+  StringRef view_name;  // Only set for view rows
+  StringRef data;       // The encoded row
+};
+
+typedef Vector<SchemaRow> SchemaRowVec;
+
+// Views by keyspace name then view name, mapped to their base table name
+typedef Map<String, Map<String, StringRef> > ViewBaseTableMap;
+
+bool find_column(const ResultResponse* result, const char* name, size_t* index) {
+  IndexVec indices;
+  if (result->metadata()->get_indices(name, &indices) == 0) {
+    LOG_ERROR("Unable to find column '%s' in schema result", name);
+    return false;
+  }
+  *index = indices[0];
+  return true;
+}
+
+// Decodes the keyspace and table names of each row without decoding the
+// values. The rows are kept encoded so they can be hashed and copied as is.
+bool decode_schema_rows(const VersionNumber& server_version, const ResultResponse* result,
+                        SchemaRowsType type, SchemaRowVec* rows) {
+  if (!result->metadata()) return false;
+
+  size_t column_count = result->column_count();
+  size_t keyspace_index = 0;
+  size_t table_index = column_count;
+  size_t view_index = column_count;
+
+  if (!find_column(result, "keyspace_name", &keyspace_index)) return false;
+
+  if (type == VIEW_ROWS) {
+    if (!find_column(result, "view_name", &view_index) ||
+        !find_column(result, "base_table_name", &table_index)) {
+      return false;
+    }
+  } else if (type != KEYSPACE_ROWS) {
+    const char* table_column_name =
+        server_version >= VersionNumber(3, 0, 0) ? "table_name" : "columnfamily_name";
+    if (!find_column(result, table_column_name, &table_index)) return false;
+  }
+
+  StringRef encoded_rows(result->encoded_rows());
+  Decoder decoder(encoded_rows.data(), encoded_rows.size(), result->protocol_version());
+  decoder.set_type("schema rows");
+
+  rows->reserve(result->row_count());
+  for (int32_t i = 0; i < result->row_count(); ++i) {
+    SchemaRow row;
+    const char* start = decoder.remaining_bytes().data();
+    for (size_t j = 0; j < column_count; ++j) {
+      StringRef value;
+      if (!decoder.decode_bytes(&value)) return false;
+      if (j == keyspace_index) {
+        row.keyspace_name = value;
+      } else if (j == table_index) {
+        row.table_name = value;
+      } else if (j == view_index) {
+        row.view_name = value;
+      }
+    }
+    row.data = StringRef(start, decoder.remaining_bytes().data() - start);
+    rows->push_back(row);
+  }
+
+  return true;
+}
+
+bool decode_schema(const VersionNumber& server_version, const ControlConnectionSchema& schema,
+                   SchemaRowVec rows[]) {
+  ViewBaseTableMap view_base_tables;
+
+  for (size_t i = 0; i < num_schema_results__; ++i) {
+    const ResultResponse::Ptr& result = schema.*schema_results__[i].result;
+    if (!result) continue;
+    if (!decode_schema_rows(server_version, result.get(), schema_results__[i].type, &rows[i])) {
+      return false;
+    }
+  }
+
+  // Map the views to their base tables so that the rows of a view are part of
+  // its base table's digest. A base table is always rebuilt with its views.
+  for (size_t i = 0; i < num_schema_results__; ++i) {
+    if (schema_results__[i].type != VIEW_ROWS) continue;
+    for (SchemaRowVec::const_iterator it = rows[i].begin(), end = rows[i].end(); it != end; ++it) {
+      view_base_tables[it->keyspace_name.to_string()][it->view_name.to_string()] = it->table_name;
+    }
+  }
+
+  if (!view_base_tables.empty()) {
+    for (size_t i = 0; i < num_schema_results__; ++i) {
+      if (schema_results__[i].type != TABLE_OR_VIEW_ROWS) continue;
+      for (SchemaRowVec::iterator it = rows[i].begin(), end = rows[i].end(); it != end; ++it) {
+        ViewBaseTableMap::const_iterator keyspace_it =
+            view_base_tables.find(it->keyspace_name.to_string());
+        if (keyspace_it == view_base_tables.end()) continue;
+        Map<String, StringRef>::const_iterator view_it =
+            keyspace_it->second.find(it->table_name.to_string());
+        if (view_it != keyspace_it->second.end()) {
+          it->table_name = view_it->second;
+        }
+      }
+    }
+  }
+
+  return true;
+}
+
+void combine_hash(uint64_t* hash, size_t result_index, const StringRef& data) {
+  // The result index is mixed in so that the same row in a different result
+  // doesn't produce the same digest.
+  uint64_t h = static_cast<uint64_t>(hash::fnv1a(data.data(), data.size())) + result_index;
+  *hash ^= h + 0x9e3779b97f4a7c15ULL + (*hash << 6) + (*hash >> 2);
+}
+
+// Builds a new result that only contains the selected rows. The header
+// (metadata and paging state) is copied from the original result.
+ResultResponse::Ptr filter_result(const ResultResponse* result, const Vector<StringRef>& rows) {
+  StringRef encoded_result(result->encoded_result());
+  StringRef encoded_rows(result->encoded_rows());
+  size_t header_size = (encoded_rows.data() - encoded_result.data()) - sizeof(int32_t);
+
+  size_t size = header_size + sizeof(int32_t);
+  for (Vector<StringRef>::const_iterator it = rows.begin(), end = rows.end(); it != end; ++it) {
+    size += it->size();
+  }
+
+  ResultResponse::Ptr response(new ResultResponse());
+  response->set_buffer(size);
+
+  char* pos = response->data();
+  memcpy(pos, encoded_result.data(), header_size);
+  pos = encode_int32(pos + header_size, static_cast<int32_t>(rows.size()));
+  for (Vector<StringRef>::const_iterator it = rows.begin(), end = rows.end(); it != end; ++it) {
+    memcpy(pos, it->data(), it->size());
+    pos += it->size();
+  }
+
+  Decoder decoder(response->data(), size, result->protocol_version());
+  if (!response->decode(decoder)) return ResultResponse::Ptr();
+  return response;
+}
+
+} // namespace
+
+bool SchemaDigest::update(const VersionNumber& server_version,
+                          const ControlConnectionSchema& schema, SchemaDelta* delta) {
+  SchemaRowVec rows[num_schema_results__];
+  if (!decode_schema(server_version, schema, rows)) {
+    LOG_WARN("Unable to compute the schema digests, the schema metadata will be fully rebuilt");
+    clear();
+    return false;
+  }
+
+  KeyspaceDigestMap keyspaces;
+  for (size_t i = 0; i < num_schema_results__; ++i) {
+    for (SchemaRowVec::const_iterator it = rows[i].begin(), end = rows[i].end(); it != end; ++it) {
+      KeyspaceDigest& keyspace = keyspaces[it->keyspace_name.to_string()];
+      if (schema_results__[i].type == KEYSPACE_ROWS) {
+        combine_hash(&keyspace.hash, i, it->data);
+      } else {
+        combine_hash(&keyspace.tables[it->table_name.to_string()], i, it->data);
+      }
+    }
+  }
+
+  bool has_delta = !keyspaces_.empty() && server_version.compare(server_version_) == 0;
+
+  if (has_delta) {
+    typedef Set<String> TableNameSet;
+    Map<String, TableNameSet> changed_tables;
+    TableNameSet changed_keyspaces;
+
+    for (KeyspaceDigestMap::const_iterator it = keyspaces_.begin(), end = keyspaces_.end();
+         it != end; ++it) {
+      if (keyspaces.find(it->first) == keyspaces.end()) {
+        delta->dropped_keyspaces.push_back(it->first);
+      }
+    }
+
+    for (KeyspaceDigestMap::const_iterator it = keyspaces.begin(), end = keyspaces.end();
+         it != end; ++it) {
+      const KeyspaceDigest& keyspace = it->second;
+      KeyspaceDigestMap::const_iterator previous = keyspaces_.find(it->first);
+
+      // A keyspace level change (e.g. a user type) can affect any of its
+      // tables so the whole keyspace is rebuilt.
+      if (previous == keyspaces_.end() || !previous->second.is_valid ||
+          previous->second.hash != keyspace.hash) {
+        if (previous != keyspaces_.end()) {
+          delta->dropped_keyspaces.push_back(it->first);
+        }
+        changed_keyspaces.insert(it->first);
+        continue;
+      }
+
+      const TableDigestMap& previous_tables = previous->second.tables;
+      for (TableDigestMap::const_iterator table_it = previous_tables.begin(),
+                                          table_end = previous_tables.end();
+           table_it != table_end; ++table_it) {
+        if (keyspace.tables.find(table_it->first) == keyspace.tables.end()) {
+          delta->dropped_tables.push_back(SchemaDelta::KeyspaceTable(it->first, table_it->first));
+        }
+      }
+
+      for (TableDigestMap::const_iterator table_it = keyspace.tables.begin(),
+                                          table_end = keyspace.tables.end();
+           table_it != table_end; ++table_it) {
+        TableDigestMap::const_iterator previous_table = previous_tables.find(table_it->first);
+        if (previous_table == previous_tables.end() || previous_table->second != table_it->second) {
+          if (previous_table != previous_tables.end()) {
+            delta->dropped_tables.push_back(
+                SchemaDelta::KeyspaceTable(it->first, table_it->first));
+          }
+          changed_tables[it->first].insert(table_it->first);
+        }
+      }
+    }
+
+    for (size_t i = 0; i < num_schema_results__; ++i) {
+      Vector<StringRef> selected;
+      for (SchemaRowVec::const_iterator it = rows[i].begin(), end = rows[i].end(); it != end;
+           ++it) {
+        String keyspace_name(it->keyspace_name.to_string());
+        if (changed_keyspaces.count(keyspace_name) > 0) {
+          selected.push_back(it->data);
+        } else if (schema_results__[i].type != KEYSPACE_ROWS) {
+          Map<String, TableNameSet>::const_iterator tables = changed_tables.find(keyspace_name);
+          if (tables != changed_tables.end() &&
+              tables->second.count(it->table_name.to_string()) > 0) {
+            selected.push_back(it->data);
+          }
+        }
+      }
+
+      if (!selected.empty()) {
+        ResultResponse::Ptr result(filter_result((schema.*schema_results__[i].result).get(),
+                                                 selected));
+        if (!result) {
+          LOG_WARN("Unable to filter the changed schema rows, the schema metadata will be fully "
+                   "rebuilt");
+          has_delta = false;
+          break;
+        }
+        delta->changed.*schema_results__[i].result = result;
+      }
+    }
+  }
+
+  server_version_ = server_version;
+  keyspaces_.swap(keyspaces);
+
+  return has_delta;
+}
+
+void SchemaDigest::invalidate_keyspace(const String& keyspace_name) {
+  if (keyspaces_.empty()) return;
+  keyspaces_[keyspace_name].is_valid = false;
+}
+
+void SchemaDigest::clear() { keyspaces_.clear(); }
@@ -0,0 +1,122 @@
+/*
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifndef DATASTAX_INTERNAL_SCHEMA_DIGEST_HPP
+#define DATASTAX_INTERNAL_SCHEMA_DIGEST_HPP
+
+#include "control_connector.hpp"
+#include "host.hpp"
+#include "map.hpp"
+#include "string.hpp"
+#include "vector.hpp"
+
+#include <stdint.h>
+#include <utility>
+
+namespace datastax { namespace internal { namespace core {
+
+/**
+ * The difference between the schema that the schema metadata was built from
+ * and a newly retrieved schema.
+ */
+struct SchemaDelta {
+  typedef std::pair<String, String> KeyspaceTable;
+  typedef Vector<KeyspaceTable> KeyspaceTableVec;
+
+  /**
+   * The keyspaces that were dropped or that need to be rebuilt.
+   */
+  StringVec dropped_keyspaces;
+
+  /**
+   * The tables (including their materialized views) that were dropped or
+   * that need to be rebuilt.
+   */
+  KeyspaceTableVec dropped_tables;
+
+  /**
+   * The rows of the keyspaces and tables that were added or changed. A result
+   * is null if none of its rows changed.
+   */
+  ControlConnectionSchema changed;
+};
+
+/**
+ * Digests of the schema rows that the schema metadata was built from. Each
+ * keyspace has a digest of its keyspace, user type, function and aggregate
+ * rows. Each table has a digest of its table, column and index rows, along
+ * with those of its materialized views.
+ *
+ * When the schema is retrieved again (e.g. after the control connection
+ * reconnects) the new rows are compared against the digests so that only the
+ * keyspaces and tables that changed need to be rebuilt. Table IDs can't be
+ * used for this because they don't change when a table is altered.
+ */
+class SchemaDigest {
+public:
+  /**
+   * Replaces the digests with the digests of a retrieved schema.
+   *
+   * @param server_version The server version of the host the schema was
+   * retrieved from.
+   * @param schema The retrieved schema.
+   * @param delta The difference from the previous digests. This is only
+   * valid if the method returns true.
+   * @return true if the delta was determined. If false then the schema
+   * metadata must be fully rebuilt (e.g. there are no previous digests or the
+   * server version changed).
+   */
+  bool update(const VersionNumber& server_version, const ControlConnectionSchema& schema,
+              SchemaDelta* delta);
+
+  /**
+   * Marks a keyspace's schema metadata as modified outside of the digests
+   * (e.g. by a schema event) so that the whole keyspace is rebuilt by the next
+   * update.
+   *
+   * @param keyspace_name The name of the modified keyspace.
+   */
+  void invalidate_keyspace(const String& keyspace_name);
+
+  void clear();
+
+  bool is_empty() const { return keyspaces_.empty(); }
+
+private:
+  typedef Map<String, uint64_t> TableDigestMap;
+
+  struct KeyspaceDigest {
+    KeyspaceDigest()
+        : hash(0)
+        , is_valid(true) {}
+
+    uint64_t hash;
+    bool is_valid;
+    TableDigestMap tables; // Keyed by the (base) table name
+  };
+
+  typedef Map<String, KeyspaceDigest> KeyspaceDigestMap;
+
+private:
+  VersionNumber server_version_;
+  KeyspaceDigestMap keyspaces_;
+};
+
+}}} // namespace datastax::internal::core
+
+#endif
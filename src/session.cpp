@@ -33,6 +33,7 @@
 #include "statement.hpp"
 
 using namespace datastax;
+using namespace datastax::internal;
 using namespace datastax::internal::core;
 
 extern "C" {
@@ -95,12 +96,34 @@ CassFuture* cass_session_execute(CassSession* session, const CassStatement* stat
   return CassFuture::to(future.get());
 }
 
+void cass_session_execute_many(CassSession* session, const CassStatement* const* statements,
+                               size_t count, CassFuture** futures) {
+  Vector<Request::ConstPtr> requests;
+  requests.reserve(count);
+  for (size_t i = 0; i < count; ++i) {
+    requests.push_back(Request::ConstPtr(statements[i]->from()));
+  }
+
+  Vector<Future::Ptr> results;
+  session->execute_many(requests, &results);
+  for (size_t i = 0; i < count; ++i) {
+    results[i]->inc_ref();
+    futures[i] = CassFuture::to(results[i].get());
+  }
+}
+
 CassFuture* cass_session_execute_batch(CassSession* session, const CassBatch* batch) {
   Future::Ptr future(session->execute(Request::ConstPtr(batch->from())));
   future->inc_ref();
   return CassFuture::to(future.get());
 }
 
+CassFuture* cass_session_execute_batch_split(CassSession* session, const CassBatch* batch) {
+  Future::Ptr future(session->execute_split(BatchRequest::ConstPtr(batch->from())));
+  future->inc_ref();
+  return CassFuture::to(future.get());
+}
+
 const CassSchemaMeta* cass_session_get_schema_meta(const CassSession* session) {
   return CassSchemaMeta::to(new Metadata::SchemaSnapshot(session->cluster()->schema_snapshot()));
 }
@@ -169,6 +192,53 @@ void cass_session_get_speculative_execution_metrics(const CassSession* session,
   metrics->percentage = internal_metrics->request_rates.speculative_request_percent();
 }
 
+void cass_session_get_result_metadata_cache_metrics(const CassSession* session,
+                                                    CassResultMetadataCacheMetrics* metrics) {
+  const Metrics* internal_metrics = session->metrics();
+
+  if (internal_metrics == NULL) {
+    LOG_WARN("Attempted to get result metadata cache metrics before connecting session object");
+    memset(metrics, 0, sizeof(CassResultMetadataCacheMetrics));
+    return;
+  }
+
+  metrics->hits = internal_metrics->result_metadata_cache_hits.sum();
+  metrics->misses = internal_metrics->result_metadata_cache_misses.sum();
+}
+
+void cass_session_get_prepared_statement_cache_metrics(const CassSession* session,
+                                                       CassPreparedStatementCacheMetrics* metrics) {
+  const Metrics* internal_metrics = session->metrics();
+  Cluster::Ptr cluster(session->cluster());
+
+  if (internal_metrics == NULL || !cluster) {
+    LOG_WARN("Attempted to get prepared statement cache metrics before connecting session object");
+    memset(metrics, 0, sizeof(CassPreparedStatementCacheMetrics));
+    return;
+  }
+
+  const PreparedMetadata& prepared_metadata = cluster->prepared_metadata();
+  metrics->entries = prepared_metadata.size();
+  metrics->size_bytes = prepared_metadata.size_bytes();
+  metrics->evictions = prepared_metadata.eviction_count();
+  metrics->reprepares = internal_metrics->reprepares.sum();
+  metrics->coalesced_reprepares = internal_metrics->coalesced_reprepares.sum();
+}
+
+void cass_session_get_control_connection_event_metrics(const CassSession* session,
+                                                       CassControlConnectionEventMetrics* metrics) {
+  const Metrics* internal_metrics = session->metrics();
+
+  if (internal_metrics == NULL) {
+    LOG_WARN("Attempted to get control connection event metrics before connecting session object");
+    memset(metrics, 0, sizeof(CassControlConnectionEventMetrics));
+    return;
+  }
+
+  metrics->coalesced_schema_events = internal_metrics->coalesced_schema_events.sum();
+  metrics->coalesced_topology_events = internal_metrics->coalesced_topology_events.sum();
+}
+
 CassUuid cass_session_get_client_id(CassSession* session) { return session->client_id(); }
 
 } // extern "C"
@@ -274,6 +344,77 @@ private:
   RequestProcessor::Vec request_processors_;
 };
 
+/**
+ * Combines the results of the batches of a split batch into a single future.
+ * The future is set when all the batches are finished, to the first batch's
+ * result if they all succeed or to the first error.
+ */
+class SplitBatchCallback : public RefCounted<SplitBatchCallback> {
+public:
+  typedef SharedRefPtr<SplitBatchCallback> Ptr;
+
+  SplitBatchCallback(const ResponseFuture::Ptr& future, size_t count)
+      : future_(future)
+      , remaining_(count)
+      , count_(count)
+      , failed_count_(0)
+      , error_code_(CASS_OK) {
+    uv_mutex_init(&mutex_);
+  }
+
+  ~SplitBatchCallback() { uv_mutex_destroy(&mutex_); }
+
+  static void on_result(CassFuture* future, void* data) {
+    SplitBatchCallback* callback = static_cast<SplitBatchCallback*>(data);
+    callback->handle_result(static_cast<ResponseFuture*>(future->from()));
+    callback->dec_ref();
+  }
+
+private:
+  void handle_result(ResponseFuture* future) {
+    Future::Error* error = future->error();
+
+    ScopedMutex l(&mutex_);
+    if (error) {
+      if (failed_count_++ == 0) {
+        error_code_ = error->code;
+        error_message_ = error->message;
+        address_ = future->address();
+        response_ = future->response();
+      }
+    } else if (!response_ && failed_count_ == 0) {
+      address_ = future->address();
+      response_ = future->response();
+    }
+
+    if (--remaining_ > 0) return;
+    l.unlock();
+
+    if (failed_count_ > 0) {
+      OStringStream ss;
+      ss << failed_count_ << " of " << count_ << " batches failed: " << error_message_;
+      if (response_) {
+        future_->set_error_with_response(address_, response_, error_code_, ss.str());
+      } else {
+        future_->set_error_with_address(address_, error_code_, ss.str());
+      }
+    } else {
+      future_->set_response(address_, response_);
+    }
+  }
+
+private:
+  uv_mutex_t mutex_;
+  ResponseFuture::Ptr future_;
+  size_t remaining_;
+  const size_t count_;
+  size_t failed_count_;
+  CassError error_code_;
+  String error_message_;
+  Address address_;
+  Response::Ptr response_;
+};
+
 }}} // namespace datastax::internal::core
 
 Session::Session()
@@ -323,7 +464,88 @@ Future::Ptr Session::prepare(const Statement* statement) {
 
 Future::Ptr Session::execute(const Request::ConstPtr& request) {
   ResponseFuture::Ptr future(new ResponseFuture());
+  execute(new_request_handler(request, future));
+  return future;
+}
+
+void Session::execute_many(const Vector<Request::ConstPtr>& requests,
+                           Vector<Future::Ptr>* futures) {
+  futures->reserve(futures->size() + requests.size());
+
+  RequestHandler::Vec request_handlers;
+  request_handlers.reserve(requests.size());
+  for (Vector<Request::ConstPtr>::const_iterator it = requests.begin(), end = requests.end();
+       it != end; ++it) {
+    ResponseFuture::Ptr future(new ResponseFuture());
+    futures->push_back(future);
+    request_handlers.push_back(new_request_handler(*it, future));
+  }
+
+  if (request_handlers.empty()) return;
+
+  if (state() != SESSION_STATE_CONNECTED) {
+    for (RequestHandler::Vec::const_iterator it = request_handlers.begin(),
+                                             end = request_handlers.end();
+         it != end; ++it) {
+      (*it)->set_error(CASS_ERROR_LIB_NO_HOSTS_AVAILABLE, "Session is not connected");
+    }
+    return;
+  }
+
+  // The requests are split into a contiguous group per request processor (at
+  // least one processor) so that each processor's queue is only updated and
+  // signaled once. The least busy processor is given the first group.
+  const size_t processor_count = request_processors_.size();
+  size_t start = std::min_element(request_processors_.begin(), request_processors_.end(),
+                                  least_busy_comp) -
+                 request_processors_.begin();
+  size_t group_count = std::min(processor_count, request_handlers.size());
+  size_t group_size = (request_handlers.size() + group_count - 1) / group_count;
+
+  for (size_t i = 0; i < request_handlers.size(); i += group_size) {
+    RequestHandler::Vec group(request_handlers.begin() + i,
+                              request_handlers.begin() +
+                                  std::min(i + group_size, request_handlers.size()));
+    request_processors_[start++ % processor_count]->process_request_batch(group);
+  }
+}
+
+Future::Ptr Session::execute_split(const BatchRequest::ConstPtr& batch) {
+  BatchRequest::Vec batches;
+  if (batch->type() == CASS_BATCH_TYPE_UNLOGGED) {
+    TokenMap::Ptr token_map(this->token_map());
+    if (token_map) {
+      batch->split(token_map.get(), connect_keyspace(), &batches);
+    }
+  }
+
+  if (batches.size() <= 1) {
+    return execute(Request::ConstPtr(batch));
+  }
+
+  ResponseFuture::Ptr future(new ResponseFuture());
+  SplitBatchCallback::Ptr callback(new SplitBatchCallback(future, batches.size()));
+  for (BatchRequest::Vec::const_iterator it = batches.begin(), end = batches.end(); it != end;
+       ++it) {
+    Future::Ptr batch_future(execute(Request::ConstPtr(*it)));
+    callback->inc_ref(); // Released in the callback
+    batch_future->set_callback(SplitBatchCallback::on_result, callback.get());
+  }
+  return future;
+}
+
+TokenMap::Ptr Session::token_map() {
+  ScopedMutex l(&mutex_);
+  return token_map_;
+}
 
+String Session::local_dc() {
+  ScopedMutex l(&mutex_);
+  return local_dc_;
+}
+
+RequestHandler::Ptr Session::new_request_handler(const Request::ConstPtr& request,
+                                                 const ResponseFuture::Ptr& future) {
   RequestHandler::Ptr request_handler(new RequestHandler(request, future, metrics()));
 
   if (request_handler->request()->opcode() == CQL_OPCODE_EXECUTE) {
@@ -331,9 +553,7 @@ Future::Ptr Session::execute(const Request::ConstPtr& request) {
     request_handler->set_prepared_metadata(cluster()->prepared(execute->prepared()->id()));
   }
 
-  execute(request_handler);
-
-  return future;
+  return request_handler;
 }
 
 void Session::execute(const RequestHandler::Ptr& request_handler) {
@@ -378,6 +598,17 @@ void Session::on_connect(const Host::Ptr& connected_host, ProtocolVersion protoc
     return;
   }
 
+  // I/O threads are bound to the configured CPUs round-robin
+  const CpuList& cpus = config().io_thread_affinity();
+  for (size_t i = 0; i < event_loop_group_->size(); ++i) {
+    EventLoop* event_loop = event_loop_group_->get(i);
+    if (!cpus.empty()) {
+      event_loop->set_cpu_affinity(cpus[i % cpus.size()]);
+    }
+    event_loop->set_spin_time(static_cast<uint64_t>(config().io_spin_time_us()) * 1000);
+    event_loop->set_use_io_uring(config().use_io_uring());
+  }
+
   rc = event_loop_group_->run();
   if (rc != 0) {
     notify_connect_failed(CASS_ERROR_LIB_UNABLE_TO_INIT, "Unable to run event loop group");
@@ -391,6 +622,12 @@ void Session::on_connect(const Host::Ptr& connected_host, ProtocolVersion protoc
         host); // If host is down it will be marked down later in the connection process
   }
 
+  {
+    ScopedMutex l(&mutex_);
+    token_map_ = token_map;
+    local_dc_ = local_dc;
+  }
+
   request_processors_.clear();
   request_processor_count_ = 0;
   is_closing_ = false;
@@ -460,6 +697,7 @@ void Session::on_host_removed(const Host::Ptr& host) {
 
 void Session::on_token_map_updated(const TokenMap::Ptr& token_map) {
   ScopedMutex l(&mutex_);
+  token_map_ = token_map;
   for (RequestProcessor::Vec::const_iterator it = request_processors_.begin(),
                                              end = request_processors_.end();
        it != end; ++it) {
@@ -20,6 +20,7 @@
 #define DATASTAX_INTERNAL_SESSION_HPP
 
 #include "allocated.hpp"
+#include "batch_request.hpp"
 #include "metrics.hpp"
 #include "mpmc_queue.hpp"
 #include "request_processor.hpp"
@@ -46,7 +47,33 @@ public:
 
   Future::Ptr execute(const Request::ConstPtr& request);
 
+  /**
+   * Execute several independent requests. The requests are added to the
+   * request processors' queues in groups so that each processor is only
+   * signaled once.
+   *
+   * @param requests
+   * @param futures A future is appended for each of the requests, in order.
+   */
+  void execute_many(const Vector<Request::ConstPtr>& requests, Vector<Future::Ptr>* futures);
+
+  /**
+   * Execute a batch, splitting an unlogged batch into a batch per replica set
+   * that are executed in parallel.
+   */
+  Future::Ptr execute_split(const BatchRequest::ConstPtr& batch);
+
+  /**
+   * The current token map. This is null if the session isn't connected or
+   * token-aware routing is disabled.
+   */
+  TokenMap::Ptr token_map();
+
+  String local_dc();
+
 private:
+  RequestHandler::Ptr new_request_handler(const Request::ConstPtr& request,
+                                          const ResponseFuture::Ptr& future);
   void execute(const RequestHandler::Ptr& request_handler);
 
   void join();
@@ -108,6 +135,8 @@ private:
   RequestProcessor::Vec request_processors_;
   size_t request_processor_count_;
   bool is_closing_;
+  TokenMap::Ptr token_map_;
+  String local_dc_;
 };
 
 }}} // namespace datastax::internal::core
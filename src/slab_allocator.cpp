@@ -0,0 +1,155 @@
+/*
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include "slab_allocator.hpp"
+
+#include "memory.hpp"
+
+#include <assert.h>
+
+using namespace datastax::internal;
+
+SlabAllocator::SlabAllocator()
+    : outstanding_(1)
+    , slabs_(NULL)
+    , slab_pos_(NULL)
+    , slab_end_(NULL)
+    , slab_count_(0) {
+  STATIC_ASSERT(sizeof(Block) <= HEADER_SIZE);
+  for (size_t i = 0; i < NUM_SIZE_CLASSES; ++i) {
+    size_classes_[i].allocator = this;
+    size_classes_[i].block_size = HEADER_SIZE + (i + 1) * SIZE_CLASS_GRANULARITY;
+  }
+}
+
+SlabAllocator::~SlabAllocator() {
+  while (slabs_ != NULL) {
+    char* next = *reinterpret_cast<char**>(slabs_);
+    Memory::free(slabs_);
+    slabs_ = next;
+  }
+}
+
+void SlabAllocator::release() {
+  // Blocks freed after this point must not use the owner's free lists.
+  assert(current() != this && "Allocator must be unbound before it's released");
+  dec_outstanding();
+}
+
+void* SlabAllocator::malloc(size_t size) {
+  // Every block is passed to the custom allocator when it's being debugged.
+#ifndef DEBUG_CUSTOM_ALLOCATOR
+  SlabAllocator* allocator = current();
+  if (allocator != NULL && size <= MAX_BLOCK_SIZE) {
+    return allocator->allocate(size);
+  }
+#endif
+  return allocate_unpooled(size);
+}
+
+void SlabAllocator::free(void* ptr) {
+  if (ptr == NULL) return;
+  Block* block = reinterpret_cast<Block*>(static_cast<char*>(ptr) - HEADER_SIZE);
+  SizeClass* size_class = block->size_class;
+  if (size_class == NULL) {
+    Memory::free(block);
+  } else {
+    size_class->allocator->deallocate(size_class, block);
+  }
+}
+
+void* SlabAllocator::allocate(size_t size) {
+  size_t index = size > 0 ? (size - 1) / SIZE_CLASS_GRANULARITY : 0;
+  SizeClass* size_class = &size_classes_[index];
+
+  Block* block = size_class->free_list;
+  if (block == NULL) {
+    // Reclaim all the blocks freed by other threads at once. Taking the whole
+    // list, instead of popping a single block, avoids the ABA problem.
+    block = size_class->remote_free_list.exchange(NULL, MEMORY_ORDER_ACQUIRE);
+    if (block == NULL) {
+      block = carve(size_class->block_size);
+      if (block == NULL) return allocate_unpooled(size); // At the slab limit
+      block->next = NULL;
+    }
+  }
+
+  size_class->free_list = block->next;
+  block->size_class = size_class;
+  outstanding_.fetch_add(1, MEMORY_ORDER_RELAXED);
+  return reinterpret_cast<char*>(block) + HEADER_SIZE;
+}
+
+void* SlabAllocator::allocate_unpooled(size_t size) {
+  Block* block = static_cast<Block*>(Memory::malloc(HEADER_SIZE + size));
+  if (block == NULL) return NULL;
+  block->size_class = NULL; // Returned using `Memory::free()`
+  return reinterpret_cast<char*>(block) + HEADER_SIZE;
+}
+
+void SlabAllocator::deallocate(SizeClass* size_class, Block* block) {
+  if (current() == this) {
+    block->next = size_class->free_list;
+    size_class->free_list = block;
+  } else {
+    Atomic<Block*>& remote_free_list = size_class->remote_free_list;
+    Block* head = remote_free_list.load(MEMORY_ORDER_RELAXED);
+    do {
+      block->next = head;
+    } while (!remote_free_list.compare_exchange_weak(head, block, MEMORY_ORDER_RELEASE));
+  }
+  dec_outstanding();
+}
+
+SlabAllocator::Block* SlabAllocator::carve(size_t block_size) {
+  if (static_cast<size_t>(slab_end_ - slab_pos_) < block_size) {
+    free_slab_remainder();
+    // Slabs are only freed with the allocator so their number is capped.
+    // Blocks past the limit are returned to the system when they're freed.
+    if (slab_count_ >= MAX_SLAB_COUNT) return NULL;
+    char* slab = static_cast<char*>(Memory::malloc(SLAB_SIZE));
+    if (slab == NULL) return NULL;
+    *reinterpret_cast<char**>(slab) = slabs_;
+    slabs_ = slab;
+    slab_pos_ = slab + HEADER_SIZE;
+    slab_end_ = slab + SLAB_SIZE;
+    ++slab_count_;
+  }
+  Block* block = reinterpret_cast<Block*>(slab_pos_);
+  slab_pos_ += block_size;
+  return block;
+}
+
+void SlabAllocator::free_slab_remainder() {
+  // The remainder of the current slab is too small for the requested block.
+  // It's given to the largest size class that it fits instead of being
+  // abandoned.
+  size_t remaining = static_cast<size_t>(slab_end_ - slab_pos_);
+  if (remaining < size_classes_[0].block_size) return;
+  SizeClass* size_class = &size_classes_[(remaining - HEADER_SIZE) / SIZE_CLASS_GRANULARITY - 1];
+  Block* block = reinterpret_cast<Block*>(slab_pos_);
+  block->next = size_class->free_list;
+  size_class->free_list = block;
+  slab_pos_ += size_class->block_size;
+}
+
+void SlabAllocator::dec_outstanding() {
+  if (outstanding_.fetch_sub(1, MEMORY_ORDER_ACQ_REL) == 1) {
+    delete this;
+  }
+}
@@ -0,0 +1,158 @@
+/*
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifndef DATASTAX_INTERNAL_SLAB_ALLOCATOR_HPP
+#define DATASTAX_INTERNAL_SLAB_ALLOCATOR_HPP
+
+#include "allocated.hpp"
+#include "atomic.hpp"
+#include "loop_context.hpp"
+#include "macros.hpp"
+
+#include <stddef.h>
+
+// Routes a class's (and its subclasses') heap allocations through the calling
+// thread's slab allocator. This must be used by the class itself because it
+// hides the operators inherited from `Allocated`.
+#define SLAB_ALLOCATED                                                                \
+public:                                                                               \
+  void* operator new(size_t size) {                                                   \
+    return datastax::internal::SlabAllocator::malloc(size);                           \
+  }                                                                                   \
+  void operator delete(void* ptr) { datastax::internal::SlabAllocator::free(ptr); }  \
+  void* operator new(size_t, void* p) { return p; }                                   \
+  void operator delete(void*, void*) {}
+
+namespace datastax { namespace internal {
+
+/**
+ * A per-thread allocator for small, short-lived objects (requests, responses
+ * and their buffers). Blocks are carved out of large slabs and recycled using
+ * per size class free lists. The allocator is bound to a single owner thread
+ * (an event loop thread); blocks freed on any other thread are returned to the
+ * owner using a lock-free list that the owner reclaims in bulk.
+ *
+ * Allocations made on threads without an allocator, and allocations larger
+ * than the largest size class, fall back to `Memory::malloc()`. So do
+ * allocations made once the allocator has `MAX_SLAB_COUNT` slabs, which
+ * bounds the memory an event loop keeps after a burst of requests.
+ */
+class SlabAllocator : public Allocated {
+public:
+  static const size_t SLAB_SIZE = 64 * 1024;
+  static const size_t SIZE_CLASS_GRANULARITY = 64;
+  static const size_t MAX_BLOCK_SIZE = 1024;
+  static const size_t NUM_SIZE_CLASSES = MAX_BLOCK_SIZE / SIZE_CLASS_GRANULARITY;
+  static const size_t HEADER_SIZE = 16; // Keeps blocks 16 byte aligned
+  static const size_t MAX_SLAB_COUNT = 16;
+
+  SlabAllocator();
+
+  /**
+   * Release the owner's reference. The allocator (and its slabs) is freed once
+   * all outstanding blocks have been returned.
+   */
+  void release();
+
+  /**
+   * Get the number of slabs allocated (owner thread only).
+   *
+   * @return The number of slabs.
+   */
+  size_t slab_count() const { return slab_count_; }
+
+  /**
+   * Get the number of blocks that haven't been freed.
+   *
+   * @return The number of outstanding blocks.
+   */
+  size_t outstanding_count() const { return outstanding_.load(MEMORY_ORDER_RELAXED) - 1; }
+
+public:
+  /**
+   * Allocate memory using the calling thread's allocator (thread-safe).
+   *
+   * @param size The number of bytes to allocate.
+   * @return A pointer to the memory or NULL if the allocation failed.
+   */
+  static void* malloc(size_t size);
+
+  /**
+   * Free memory returned by `SlabAllocator::malloc()` (thread-safe). This can
+   * be called on any thread.
+   *
+   * @param ptr A pointer returned by `SlabAllocator::malloc()`. NULL is ignored.
+   */
+  static void free(void* ptr);
+
+  /**
+   * Get the allocator of the calling thread's event loop (see `LoopContext`).
+   *
+   * @return The allocator or NULL if the thread doesn't have one.
+   */
+  static SlabAllocator* current() {
+    core::LoopContext* context = core::LoopContext::current();
+    return context != NULL ? context->allocator : NULL;
+  }
+
+private:
+  struct Block;
+
+  struct SizeClass {
+    SizeClass()
+        : allocator(NULL)
+        , block_size(0)
+        , free_list(NULL)
+        , remote_free_list(NULL) {}
+
+    SlabAllocator* allocator;
+    size_t block_size;
+    Block* free_list;                // Owner thread only
+    Atomic<Block*> remote_free_list; // Pushed by other threads
+  };
+
+  struct Block {
+    SizeClass* size_class; // NULL if allocated using `Memory::malloc()`
+    Block* next;           // Only valid while the block is free
+  };
+
+private:
+  ~SlabAllocator();
+
+  void* allocate(size_t size);
+  static void* allocate_unpooled(size_t size);
+  void deallocate(SizeClass* size_class, Block* block);
+  Block* carve(size_t block_size);
+  void free_slab_remainder();
+  void dec_outstanding();
+
+private:
+  SizeClass size_classes_[NUM_SIZE_CLASSES];
+  Atomic<size_t> outstanding_; // Outstanding blocks plus one for the owner
+  char* slabs_;                // A list of slabs linked through their first bytes
+  char* slab_pos_;
+  char* slab_end_;
+  size_t slab_count_;
+
+private:
+  DISALLOW_COPY_AND_ASSIGN(SlabAllocator);
+};
+
+}} // namespace datastax::internal
+
+#endif
@@ -16,7 +16,13 @@
 
 #include "socket.hpp"
 
+#include "io_uring.hpp"
 #include "logger.hpp"
+#include "read_buffer_pool.hpp"
+
+#ifdef HAVE_IO_URING
+#include <limits.h>
+#endif
 
 #define SSL_READ_SIZE 8192
 #define SSL_WRITE_SIZE 8192
@@ -25,6 +31,9 @@
 #define MAX_BUFFER_REUSE_NO 8
 #define BUFFER_REUSE_SIZE 64 * 1024
 
+#define READ_SIZE_DEFAULT (16 * 1024)
+#define READ_SIZE_SHRINK_COUNT 16
+
 using namespace datastax::internal;
 using namespace datastax::internal::core;
 
@@ -60,6 +69,304 @@ size_t SocketWrite::flush() {
   return total;
 }
 
+#ifdef HAVE_IO_URING
+/**
+ * A basic socket write handler that uses the event loop's io_uring. Only one
+ * write per socket is outstanding at a time so that writes can't be
+ * reordered; requests written while a write is outstanding are coalesced into
+ * the next write.
+ */
+class IoUringSocketWrite
+    : public SocketWriteBase
+    , public IoUring::Operation {
+public:
+  IoUringSocketWrite(Socket* socket, IoUring* io_uring)
+      : SocketWriteBase(socket)
+      , io_uring_(io_uring)
+      , is_outstanding_(false)
+      , iov_index_(0) {}
+
+  size_t flush();
+  virtual void cancel();
+  virtual void release();
+  virtual void on_complete(int result, unsigned flags);
+
+private:
+  int send();
+  void send_remaining_using_uv();
+
+private:
+  IoUring* io_uring_;
+  bool is_outstanding_;
+  Vector<struct iovec> iovecs_;
+  size_t iov_index_;
+  struct msghdr msg_;
+};
+
+size_t IoUringSocketWrite::flush() {
+  size_t total = 0;
+  // Requests are coalesced into this write until the socket's previous write
+  // has finished.
+  if (!is_flushed_ && !buffers_.empty() && is_first_pending_write() && !socket_->is_closing()) {
+    iovecs_.clear();
+    iovecs_.reserve(buffers_.size());
+
+    for (BufferVec::const_iterator it = buffers_.begin(), end = buffers_.end(); it != end; ++it) {
+      total += it->size();
+      struct iovec iov;
+      iov.iov_base = const_cast<char*>(it->data());
+      iov.iov_len = it->size();
+      iovecs_.push_back(iov);
+    }
+
+    is_flushed_ = true;
+    iov_index_ = 0;
+    if (send() != 0) {
+      send_remaining_using_uv();
+    }
+  }
+  return total;
+}
+
+void IoUringSocketWrite::cancel() {
+  if (is_outstanding_) {
+    io_uring_->cancel(this);
+  }
+}
+
+void IoUringSocketWrite::release() {
+  if (is_outstanding_) {
+    socket_ = NULL; // Freed when the write completes
+  } else {
+    delete this;
+  }
+}
+
+void IoUringSocketWrite::on_complete(int result, unsigned flags) {
+  is_outstanding_ = false;
+
+  if (socket_ == NULL) { // The socket closed while the write was outstanding
+    delete this;
+    return;
+  }
+
+  if (result > 0 && socket_->is_closing()) {
+    result = UV_ECANCELED;
+  } else if (result > 0) {
+    size_t written = static_cast<size_t>(result);
+    while (iov_index_ < iovecs_.size() && written >= iovecs_[iov_index_].iov_len) {
+      written -= iovecs_[iov_index_++].iov_len;
+    }
+    if (iov_index_ < iovecs_.size()) { // A partial write
+      struct iovec& iov = iovecs_[iov_index_];
+      iov.iov_base = static_cast<char*>(iov.iov_base) + written;
+      iov.iov_len -= written;
+      if (send() != 0) {
+        send_remaining_using_uv();
+      }
+      return;
+    }
+    result = 0;
+  } else if (result == 0) {
+    result = UV_EPIPE;
+  }
+
+  handle_write(&req_, result);
+}
+
+int IoUringSocketWrite::send() {
+  int fd;
+  int rc = uv_fileno(reinterpret_cast<uv_handle_t*>(tcp()), &fd);
+  if (rc != 0) return rc;
+
+  memset(&msg_, 0, sizeof(msg_));
+  msg_.msg_iov = &iovecs_[iov_index_];
+  msg_.msg_iovlen = std::min(iovecs_.size() - iov_index_, static_cast<size_t>(IOV_MAX));
+
+  rc = io_uring_->sendmsg(fd, &msg_, this);
+  if (rc == 0) is_outstanding_ = true;
+  return rc;
+}
+
+void IoUringSocketWrite::send_remaining_using_uv() {
+  UvBufVec bufs;
+  bufs.reserve(iovecs_.size() - iov_index_);
+  for (size_t i = iov_index_; i < iovecs_.size(); ++i) {
+    bufs.push_back(uv_buf_init(static_cast<char*>(iovecs_[i].iov_base), iovecs_[i].iov_len));
+  }
+  uv_stream_t* sock_stream = reinterpret_cast<uv_stream_t*>(tcp());
+  uv_write(&req_, sock_stream, bufs.data(), bufs.size(), SocketWriteBase::on_write);
+}
+#endif
+
+#ifdef HAVE_IO_URING_RECV_MULTISHOT
+namespace datastax { namespace internal { namespace core {
+
+/**
+ * A socket read that uses a multishot receive on the event loop's io_uring.
+ * The data is read into the ring's shared buffers, which are returned to the
+ * ring after the socket's handler has handled the data. The receive is queued
+ * again when the kernel stops it (e.g. when all the buffers are in use) and
+ * the socket falls back to reading using libuv if the kernel doesn't support
+ * it.
+ *
+ * Once started, the read is used for the rest of the socket's life. Data
+ * received while the socket doesn't have a handler is kept until a handler is
+ * set, and handlers that can't use the loop's buffers get a copy of the data.
+ */
+class IoUringSocketRead
+    : public Allocated
+    , public IoUring::Operation {
+public:
+  IoUringSocketRead(Socket* socket, IoUring* io_uring)
+      : socket_(socket)
+      , io_uring_(io_uring)
+      , is_outstanding_(false)
+      , has_read_(false) {}
+
+  /**
+   * Handle the data received without a handler and start receiving if the
+   * receive isn't queued. This is called when the socket's handler is set.
+   */
+  void resume();
+
+  void cancel();
+  void release();
+  virtual void on_complete(int result, unsigned flags);
+
+private:
+  int start();
+  void read(const char* data, size_t size);
+  void fail(ssize_t status);
+  void read_using_uv();
+
+private:
+  Socket* socket_;
+  IoUring* io_uring_;
+  bool is_outstanding_;
+  bool has_read_;
+  String unread_;
+};
+
+}}} // namespace datastax::internal::core
+
+void IoUringSocketRead::resume() {
+  if (!unread_.empty()) {
+    String unread;
+    unread.swap(unread_);
+    read(unread.data(), unread.size());
+  }
+  if (!is_outstanding_ && socket_->handler_ && !socket_->is_closing() && start() != 0) {
+    read_using_uv();
+  }
+}
+
+void IoUringSocketRead::cancel() {
+  if (is_outstanding_) {
+    io_uring_->cancel(this);
+  }
+}
+
+void IoUringSocketRead::release() {
+  if (is_outstanding_) {
+    socket_ = NULL; // Freed when the receive finishes
+  } else {
+    delete this;
+  }
+}
+
+void IoUringSocketRead::on_complete(int result, unsigned flags) {
+  bool is_supported = true;
+
+  if (socket_ != NULL && !socket_->is_closing()) {
+    if (result > 0) {
+      has_read_ = true;
+      read(io_uring_->read_buffer(flags), static_cast<size_t>(result));
+    } else if (result == 0) {
+      fail(UV_EOF);
+    } else if (result == -EINVAL && !has_read_) {
+      is_supported = false;
+    } else if (result != -ENOBUFS && result != -ECANCELED) {
+      fail(result);
+    }
+  }
+
+  if (flags & IORING_CQE_F_BUFFER) {
+    io_uring_->recycle_read_buffer(flags);
+  }
+
+  if (!(flags & IORING_CQE_F_MORE)) { // The receive is finished
+    is_outstanding_ = false;
+    if (socket_ == NULL) {
+      delete this;
+    } else if (!is_supported) {
+      io_uring_->disable_recv_multishot();
+      read_using_uv();
+    } else if (socket_->handler_ && !socket_->is_closing() && start() != 0) {
+      read_using_uv();
+    }
+  }
+}
+
+int IoUringSocketRead::start() {
+  int fd;
+  int rc = uv_fileno(reinterpret_cast<uv_handle_t*>(&socket_->tcp_), &fd);
+  if (rc != 0) return rc;
+
+  rc = io_uring_->recv_multishot(fd, this);
+  if (rc == 0) is_outstanding_ = true;
+  return rc;
+}
+
+void IoUringSocketRead::read(const char* data, size_t size) {
+  while (size > 0 && !socket_->is_closing()) {
+    SocketHandlerBase* handler = socket_->handler_.get();
+    if (handler == NULL) {
+      unread_.append(data, size);
+      return;
+    }
+
+    uv_buf_t buf;
+    size_t nread = size;
+    if (handler->can_use_loop_buffers() && io_uring_->is_read_buffer(data)) {
+      buf = uv_buf_init(const_cast<char*>(data), size);
+    } else {
+      handler->alloc_buffer(size, &buf);
+      nread = std::min(size, static_cast<size_t>(buf.len));
+      memcpy(buf.base, data, nread);
+    }
+    socket_->handle_read(static_cast<ssize_t>(nread), &buf);
+
+    data += nread;
+    size -= nread;
+  }
+}
+
+void IoUringSocketRead::fail(ssize_t status) {
+  if (socket_->handler_) {
+    uv_buf_t buf = uv_buf_init(NULL, 0);
+    socket_->handle_read(status, &buf);
+  } else {
+    socket_->defunct();
+  }
+}
+
+void IoUringSocketRead::read_using_uv() {
+  Socket* socket = socket_;
+  socket->io_uring_read_ = NULL;
+  delete this;
+  if (socket->handler_) {
+    uv_read_start(reinterpret_cast<uv_stream_t*>(&socket->tcp_), Socket::alloc_buffer,
+                  Socket::on_read);
+  }
+}
+#endif
+
+SocketHandler::SocketHandler()
+    : read_buffer_pool_(NULL)
+    , read_size_(READ_SIZE_DEFAULT)
+    , small_read_count_(0) {}
+
 SocketHandler::~SocketHandler() {
   while (!buffer_reuse_list_.empty()) {
     uv_buf_t buf = buffer_reuse_list_.top();
@@ -69,10 +376,23 @@ SocketHandler::~SocketHandler() {
 }
 
 SocketWriteBase* SocketHandler::new_pending_write(Socket* socket) {
+#ifdef HAVE_IO_URING
+  IoUring* io_uring = IoUring::current();
+  if (io_uring != NULL) {
+    return new IoUringSocketWrite(socket, io_uring);
+  }
+#endif
   return new SocketWrite(socket);
 }
 
 void SocketHandler::alloc_buffer(size_t suggested_size, uv_buf_t* buf) {
+  // Reads are always on the socket's loop thread so the pool is only looked
+  // up once.
+  if (read_buffer_pool_ == NULL) read_buffer_pool_ = ReadBufferPool::current();
+  if (read_buffer_pool_ != NULL) {
+    *buf = read_buffer_pool_->alloc(read_size_);
+    return;
+  }
   if (suggested_size <= BUFFER_REUSE_SIZE) {
     if (!buffer_reuse_list_.empty()) {
       *buf = buffer_reuse_list_.top();
@@ -86,7 +406,34 @@ void SocketHandler::alloc_buffer(size_t suggested_size, uv_buf_t* buf) {
   }
 }
 
-void SocketHandler::free_buffer(const uv_buf_t* buf) {
+void SocketHandler::free_buffer(ssize_t nread, const uv_buf_t* buf) {
+#ifdef HAVE_IO_URING_RECV_MULTISHOT
+  // The buffer is returned to the ring by the socket's read
+  IoUring* io_uring = IoUring::current();
+  if (io_uring != NULL && io_uring->is_read_buffer(buf->base)) return;
+#endif
+
+  if (nread > 0) {
+    if (static_cast<size_t>(nread) >= buf->len) {
+      // The buffer was filled so there's likely more data waiting (e.g. a
+      // large response). Grow the next buffer to read it in fewer calls.
+      if (read_size_ < ReadBufferPool::MAX_SIZE) read_size_ *= 2;
+      small_read_count_ = 0;
+    } else if (static_cast<size_t>(nread) <= buf->len / 4 &&
+               read_size_ > ReadBufferPool::MIN_SIZE) {
+      if (++small_read_count_ >= READ_SIZE_SHRINK_COUNT) {
+        read_size_ /= 2;
+        small_read_count_ = 0;
+      }
+    } else {
+      small_read_count_ = 0;
+    }
+  }
+
+  if (read_buffer_pool_ != NULL) {
+    read_buffer_pool_->free(*buf);
+    return;
+  }
   if (buf->len == BUFFER_REUSE_SIZE && buffer_reuse_list_.size() < MAX_BUFFER_REUSE_NO) {
     buffer_reuse_list_.push(*buf);
     return;
@@ -244,6 +591,10 @@ int32_t SocketWriteBase::write(SocketRequest* request) {
   return request_size;
 }
 
+bool SocketWriteBase::is_first_pending_write() {
+  return socket_->pending_writes_.front() == this;
+}
+
 void SocketWriteBase::on_write(uv_write_t* req, int status) {
   SocketWriteBase* pending_write = static_cast<SocketWriteBase*>(req->data);
   pending_write->handle_write(req, status);
@@ -282,6 +633,9 @@ Socket::Socket(const Address& address, size_t max_reusable_write_objects)
     , max_reusable_write_objects_(max_reusable_write_objects)
     , address_(address) {
   tcp_.data = this;
+#ifdef HAVE_IO_URING
+  io_uring_read_ = NULL;
+#endif
 }
 
 Socket::~Socket() { cleanup_free_writes(); }
@@ -291,6 +645,20 @@ void Socket::set_handler(SocketHandlerBase* handler) {
   cleanup_free_writes();
   free_writes_.clear();
   if (handler_) {
+#ifdef HAVE_IO_URING_RECV_MULTISHOT
+    if (io_uring_read_ == NULL && handler_->can_use_loop_buffers() && !is_closing()) {
+      IoUring* io_uring = IoUring::current();
+      if (io_uring != NULL && io_uring->has_read_buffers()) {
+        // The previous handler could have been reading using libuv
+        uv_read_stop(reinterpret_cast<uv_stream_t*>(&tcp_));
+        io_uring_read_ = new IoUringSocketRead(this, io_uring);
+      }
+    }
+    if (io_uring_read_ != NULL) {
+      io_uring_read_->resume();
+      return;
+    }
+#endif
     uv_read_start(reinterpret_cast<uv_stream_t*>(&tcp_), Socket::alloc_buffer, Socket::on_read);
   } else {
     uv_read_stop(reinterpret_cast<uv_stream_t*>(&tcp_));
@@ -339,6 +707,13 @@ bool Socket::is_closing() const {
 void Socket::close() {
   uv_handle_t* handle = reinterpret_cast<uv_handle_t*>(&tcp_);
   if (!uv_is_closing(handle)) {
+    SocketWriteBase::List::Iterator<SocketWriteBase> it = pending_writes_.iterator();
+    while (it.has_next()) {
+      it.next()->cancel();
+    }
+#ifdef HAVE_IO_URING_RECV_MULTISHOT
+    if (io_uring_read_ != NULL) io_uring_read_->cancel();
+#endif
     uv_close(handle, on_close);
   }
 }
@@ -379,8 +754,15 @@ void Socket::handle_close() {
   while (!pending_writes_.is_empty()) {
     SocketWriteBase* pending_write = pending_writes_.pop_front();
     pending_write->on_close();
-    delete pending_write;
+    pending_write->release();
+  }
+
+#ifdef HAVE_IO_URING_RECV_MULTISHOT
+  if (io_uring_read_ != NULL) {
+    io_uring_read_->release();
+    io_uring_read_ = NULL;
   }
+#endif
 
   if (handler_) {
     handler_->on_close();
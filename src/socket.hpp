@@ -20,6 +20,7 @@
 #include "allocated.hpp"
 #include "buffer.hpp"
 #include "constants.hpp"
+#include "driver_config.hpp"
 #include "list.hpp"
 #include "scoped_ptr.hpp"
 #include "ssl.hpp"
@@ -33,6 +34,8 @@
 
 namespace datastax { namespace internal { namespace core {
 
+class IoUringSocketRead;
+class ReadBufferPool;
 class Socket;
 class SocketWriteBase;
 
@@ -115,6 +118,15 @@ public:
    */
   virtual void alloc_buffer(size_t suggested_size, uv_buf_t* buf) = 0;
 
+  /**
+   * Determine if the handler can read from buffers that belong to the event
+   * loop instead of the buffers from `alloc_buffer()` (see `IoUring`). The
+   * loop's buffers are only valid during `on_read()`.
+   *
+   * @return true if the loop's buffers can be used.
+   */
+  virtual bool can_use_loop_buffers() const { return false; }
+
   /**
    * A callback for handling a socket read.
    *
@@ -141,23 +153,38 @@ public:
 
 /**
  * A basic socket handler that caches buffers used for reading socket data.
+ *
+ * On an event loop thread the read buffers come from the loop's shared
+ * ReadBufferPool and are sized using the socket's recent reads: the size is
+ * doubled when a read fills the buffer and halved after a run of reads that
+ * use only a small part of it. Otherwise, buffers are cached by the handler.
+ * If the loop's io_uring has read buffers then those are used instead.
  */
 class SocketHandler : public SocketHandlerBase {
 public:
+  SocketHandler();
   ~SocketHandler();
 
   virtual SocketWriteBase* new_pending_write(Socket* socket);
   virtual void alloc_buffer(size_t suggested_size, uv_buf_t* buf);
+  virtual bool can_use_loop_buffers() const { return true; }
 
   /**
    * Free or cache a read buffer.
+   * @param nread The number of bytes read into the buffer (or an error).
    * @param buf The buffer to free or cache. The buffer was created in
-   * alloc_buffer().
+   * alloc_buffer() or it's one of the loop's io_uring buffers, which are
+   * left alone.
    */
-  void free_buffer(const uv_buf_t* buf);
+  void free_buffer(ssize_t nread, const uv_buf_t* buf);
+
+  size_t read_size() const { return read_size_; }
 
 private:
   Stack<uv_buf_t> buffer_reuse_list_;
+  ReadBufferPool* read_buffer_pool_;
+  size_t read_size_;
+  unsigned small_read_count_;
 };
 
 /**
@@ -251,7 +278,20 @@ public:
    */
   virtual size_t flush() = 0;
 
+  /**
+   * Cancel the write if it's outstanding. This is called when the socket is
+   * closed.
+   */
+  virtual void cancel() {}
+
+  /**
+   * Free the write after its socket has closed.
+   */
+  virtual void release() { delete this; }
+
 protected:
+  bool is_first_pending_write();
+
   static void on_write(uv_write_t* req, int status);
   void handle_write(uv_write_t* req, int status);
 
@@ -271,6 +311,7 @@ protected:
  * @see SocketConnector
  */
 class Socket : public RefCounted<Socket> {
+  friend class IoUringSocketRead;
   friend class SocketConnector;
   friend class SocketWriteBase;
 
@@ -367,6 +408,9 @@ private:
 
   uv_tcp_t tcp_;
   ScopedPtr<SocketHandlerBase> handler_;
+#ifdef HAVE_IO_URING
+  IoUringSocketRead* io_uring_read_; // NULL if the socket reads using libuv
+#endif
 
   SocketWriteBase::List pending_writes_;
   SocketWriteVec free_writes_;
@@ -54,6 +54,8 @@ public:
     buf->len = suggested_size;
   }
 
+  virtual bool can_use_loop_buffers() const { return false; }
+
   virtual void on_read(Socket* socket, ssize_t nread, const uv_buf_t* buf) {
     if (nread > 0) {
       connector_->ssl_session_->incoming().commit(nread);
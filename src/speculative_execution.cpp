@@ -0,0 +1,93 @@
+/*
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include "speculative_execution.hpp"
+
+#include "constants.hpp"
+#include "third_party/hdr_histogram/hdr_histogram.hpp"
+
+#include <stdlib.h>
+#include <uv.h>
+
+using namespace datastax::internal::core;
+
+// Latencies are recorded in microseconds up to a minute
+#define HIGHEST_TRACKABLE_LATENCY_US (60LL * 1000LL * 1000LL)
+
+PercentileSpeculativeExecutionPolicy::PercentileSpeculativeExecutionPolicy(
+    double percentile, int max_speculative_executions, double max_speculative_ratio)
+    : percentile_(percentile)
+    , max_speculative_executions_(max_speculative_executions)
+    , max_speculative_ratio_(max_speculative_ratio)
+    , delay_ms_(-1)
+    , request_count_(0)
+    , speculative_count_(0)
+    , window_start_ns_(uv_hrtime()) {
+  hdr_init(1LL, HIGHEST_TRACKABLE_LATENCY_US, 3, &histogram_);
+}
+
+PercentileSpeculativeExecutionPolicy::~PercentileSpeculativeExecutionPolicy() {
+  free(histogram_);
+}
+
+SpeculativeExecutionPlan PercentileSpeculativeExecutionPolicy::new_plan(const String& keyspace,
+                                                                        const Request* request) {
+  request_count_++;
+  return SpeculativeExecutionPlan(this, max_speculative_executions_);
+}
+
+int64_t PercentileSpeculativeExecutionPolicy::next_execution_delay(const Host::Ptr& current_host) {
+  return delay_ms_; // -1 until a window has enough samples
+}
+
+bool PercentileSpeculativeExecutionPolicy::start_execution() {
+  if (max_speculative_ratio_ > 0.0 &&
+      speculative_count_ + 1 > max_speculative_ratio_ * request_count_) {
+    return false;
+  }
+  speculative_count_++;
+  return true;
+}
+
+void PercentileSpeculativeExecutionPolicy::record_latency(uint64_t latency_ns) {
+  int64_t latency_us = static_cast<int64_t>(latency_ns / 1000);
+  if (latency_us < 1) latency_us = 1;
+  if (latency_us > HIGHEST_TRACKABLE_LATENCY_US) latency_us = HIGHEST_TRACKABLE_LATENCY_US;
+  hdr_record_value(histogram_, latency_us);
+
+  uint64_t now = uv_hrtime();
+  if (now - window_start_ns_ >= CASS_DEFAULT_SPECULATIVE_EXECUTION_WINDOW_MS * 1000LL * 1000LL) {
+    update_delay(now);
+  }
+}
+
+void PercentileSpeculativeExecutionPolicy::update_delay(uint64_t now) {
+  // The previous delay is kept if there were too few requests in the window
+  if (histogram_->total_count >= CASS_DEFAULT_SPECULATIVE_EXECUTION_MIN_SAMPLES) {
+    int64_t latency_us = hdr_value_at_percentile(histogram_, percentile_);
+    // Round up so that a sub-millisecond latency doesn't start executions
+    // immediately.
+    int64_t delay = (latency_us + 999) / 1000;
+    delay_ms_ = delay > 0 ? delay : 1;
+  }
+
+  hdr_reset(histogram_);
+  window_start_ns_ = now;
+  request_count_ = 0;
+  speculative_count_ = 0;
+}
@@ -19,23 +19,18 @@
 #ifndef DATASTAX_INTERNAL_SPECULATIVE_EXECUTION_HPP
 #define DATASTAX_INTERNAL_SPECULATIVE_EXECUTION_HPP
 
-#include "allocated.hpp"
 #include "host.hpp"
 #include "ref_counted.hpp"
 #include "string.hpp"
 
 #include <stdint.h>
 
+struct hdr_histogram;
+
 namespace datastax { namespace internal { namespace core {
 
 class Request;
-
-class SpeculativeExecutionPlan : public Allocated {
-public:
-  virtual ~SpeculativeExecutionPlan() {}
-
-  virtual int64_t next_execution(const Host::Ptr& current_host) = 0;
-};
+class SpeculativeExecutionPlan;
 
 class SpeculativeExecutionPolicy : public RefCounted<SpeculativeExecutionPolicy> {
 public:
@@ -43,38 +38,71 @@ public:
 
   virtual ~SpeculativeExecutionPolicy() {}
 
-  virtual SpeculativeExecutionPlan* new_plan(const String& keyspace, const Request* request) = 0;
+  /**
+   * Create the plan for a request. Plans are returned by value and kept in the
+   * request handler so no allocation is required per request.
+   */
+  virtual SpeculativeExecutionPlan new_plan(const String& keyspace, const Request* request) = 0;
+
+  /**
+   * Determine the delay before the next speculative execution.
+   *
+   * @param current_host The host of the current execution.
+   * @return The delay in milliseconds or -1 to not start another execution.
+   */
+  virtual int64_t next_execution_delay(const Host::Ptr& current_host) { return -1; }
+
+  /**
+   * Called when a scheduled speculative execution is due to start.
+   *
+   * @return true to start the execution, false to skip it.
+   */
+  virtual bool start_execution() { return true; }
+
+  /**
+   * Record the latency of an execution that received a result.
+   */
+  virtual void record_latency(uint64_t latency_ns) {}
 
   virtual SpeculativeExecutionPolicy* new_instance() = 0;
 };
 
-class NoSpeculativeExecutionPlan : public SpeculativeExecutionPlan {
+class SpeculativeExecutionPlan {
 public:
-  virtual int64_t next_execution(const Host::Ptr& current_host) { return -1; }
-};
+  SpeculativeExecutionPlan()
+      : policy_(NULL)
+      , remaining_(0) {}
+
+  SpeculativeExecutionPlan(SpeculativeExecutionPolicy* policy, int max_speculative_executions)
+      : policy_(policy)
+      , remaining_(max_speculative_executions) {}
+
+  int64_t next_execution(const Host::Ptr& current_host) {
+    if (remaining_ <= 0) return -1;
+    int64_t delay = policy_->next_execution_delay(current_host);
+    if (delay >= 0) remaining_--;
+    return delay;
+  }
 
-class NoSpeculativeExecutionPolicy : public SpeculativeExecutionPolicy {
-public:
-  virtual SpeculativeExecutionPlan* new_plan(const String& keyspace, const Request* request) {
-    return new NoSpeculativeExecutionPlan();
+  bool start_execution() { return policy_ && policy_->start_execution(); }
+
+  void record_latency(uint64_t latency_ns) {
+    if (policy_) policy_->record_latency(latency_ns);
   }
 
-  virtual SpeculativeExecutionPolicy* new_instance() { return new NoSpeculativeExecutionPolicy(); }
+private:
+  // The policy is owned by the execution profile, which outlives the request
+  SpeculativeExecutionPolicy* policy_;
+  int remaining_;
 };
 
-class ConstantSpeculativeExecutionPlan : public SpeculativeExecutionPlan {
+class NoSpeculativeExecutionPolicy : public SpeculativeExecutionPolicy {
 public:
-  ConstantSpeculativeExecutionPlan(int64_t constant_delay_ms, int count)
-      : constant_delay_ms_(constant_delay_ms)
-      , count_(count) {}
-
-  virtual int64_t next_execution(const Host::Ptr& current_host) {
-    return --count_ >= 0 ? constant_delay_ms_ : -1;
+  virtual SpeculativeExecutionPlan new_plan(const String& keyspace, const Request* request) {
+    return SpeculativeExecutionPlan();
   }
 
-private:
-  const int64_t constant_delay_ms_;
-  int count_;
+  virtual SpeculativeExecutionPolicy* new_instance() { return new NoSpeculativeExecutionPolicy(); }
 };
 
 class ConstantSpeculativeExecutionPolicy : public SpeculativeExecutionPolicy {
@@ -83,8 +111,12 @@ public:
       : constant_delay_ms_(constant_delay_ms)
       , max_speculative_executions_(max_speculative_executions) {}
 
-  virtual SpeculativeExecutionPlan* new_plan(const String& keyspace, const Request* request) {
-    return new ConstantSpeculativeExecutionPlan(constant_delay_ms_, max_speculative_executions_);
+  virtual SpeculativeExecutionPlan new_plan(const String& keyspace, const Request* request) {
+    return SpeculativeExecutionPlan(this, max_speculative_executions_);
+  }
+
+  virtual int64_t next_execution_delay(const Host::Ptr& current_host) {
+    return constant_delay_ms_;
   }
 
   virtual SpeculativeExecutionPolicy* new_instance() {
@@ -95,6 +127,57 @@ public:
   const int max_speculative_executions_;
 };
 
+/**
+ * Starts speculative executions after a percentile of the recent request
+ * latencies instead of a fixed delay. The latencies of the executions that
+ * received a result are recorded in a histogram. The delay is recomputed from
+ * the histogram every window and the histogram is then cleared, so it tracks
+ * the latencies of the previous window. Speculative executions aren't started
+ * until a window has enough samples.
+ *
+ * The share of requests that start speculative executions can also be capped
+ * so that a latency spike doesn't double the load on the cluster. Only the
+ * speculative executions that actually start count against the cap, not the
+ * ones that are scheduled and then cancelled because the request finished.
+ *
+ * Each request processor uses its own instance (see
+ * `ExecutionProfile::build_speculative_execution_policy()`), so an instance is
+ * only used by a single I/O thread and isn't thread-safe.
+ */
+class PercentileSpeculativeExecutionPolicy : public SpeculativeExecutionPolicy {
+public:
+  PercentileSpeculativeExecutionPolicy(double percentile, int max_speculative_executions,
+                                       double max_speculative_ratio);
+  ~PercentileSpeculativeExecutionPolicy();
+
+  virtual SpeculativeExecutionPlan new_plan(const String& keyspace, const Request* request);
+  virtual int64_t next_execution_delay(const Host::Ptr& current_host);
+  virtual bool start_execution();
+  virtual void record_latency(uint64_t latency_ns);
+
+  virtual SpeculativeExecutionPolicy* new_instance() {
+    return new PercentileSpeculativeExecutionPolicy(percentile_, max_speculative_executions_,
+                                                    max_speculative_ratio_);
+  }
+
+  // The current delay in milliseconds or -1 if it hasn't been computed yet
+  int64_t delay_ms() const { return delay_ms_; }
+
+  const double percentile_;
+  const int max_speculative_executions_;
+  const double max_speculative_ratio_;
+
+private:
+  void update_delay(uint64_t now);
+
+private:
+  int64_t delay_ms_;
+  int64_t request_count_;
+  int64_t speculative_count_;
+  hdr_histogram* histogram_;
+  uint64_t window_start_ns_;
+};
+
 }}} // namespace datastax::internal::core
 
 #endif
@@ -26,11 +26,14 @@
 #include "protocol.hpp"
 #include "query_request.hpp"
 #include "request_callback.hpp"
+#include "scoped_lock.hpp"
 #include "scoped_ptr.hpp"
 #include "string_ref.hpp"
 #include "tuple.hpp"
 #include "user_type_value.hpp"
 
+#include <algorithm>
+#include <string.h>
 #include <uv.h>
 
 using namespace datastax;
@@ -120,6 +123,11 @@ CassError cass_statement_set_request_timeout(CassStatement* statement, cass_uint
   return CASS_OK;
 }
 
+CassError cass_statement_freeze(CassStatement* statement) {
+  statement->freeze();
+  return CASS_OK;
+}
+
 CassError cass_statement_set_is_idempotent(CassStatement* statement, cass_bool_t is_idempotent) {
   statement->set_is_idempotent(is_idempotent == cass_true);
   return CASS_OK;
@@ -150,6 +158,12 @@ CassError cass_statement_set_tracing(CassStatement* statement, cass_bool_t enabl
   return CASS_OK;
 }
 
+CassError cass_statement_set_result_chunk_callback(CassStatement* statement,
+                                                   CassResultChunkCallback callback, void* data) {
+  statement->set_result_chunk_callback(callback, data);
+  return CASS_OK;
+}
+
 CassError cass_statement_set_host(CassStatement* statement, const char* host, int port) {
   return cass_statement_set_host_n(statement, host, SAFE_STRLEN(host), port);
 }
@@ -267,6 +281,69 @@ CassError cass_statement_bind_custom_by_name_n(CassStatement* statement, const c
 
 } // extern "C"
 
+/**
+ * The encoded invariant parts of a frozen statement's request and the
+ * settings they were encoded with. They're re-encoded if the settings change.
+ */
+struct Statement::FrozenRequest : public Allocated {
+  FrozenRequest()
+      : is_encoded(false)
+      , version(0)
+      , consistency(CASS_CONSISTENCY_UNKNOWN)
+      , serial_consistency(CASS_CONSISTENCY_UNKNOWN)
+      , skip_metadata(false)
+      , has_timestamp(false)
+      , page_size(-1)
+      , element_count(0)
+      , has_paging_state(false) {
+    uv_mutex_init(&mutex);
+  }
+
+  ~FrozenRequest() { uv_mutex_destroy(&mutex); }
+
+  bool is_encoded_with(int version, CassConsistency consistency,
+                       CassConsistency serial_consistency, bool skip_metadata, bool has_timestamp,
+                       const Statement* statement, const Buffer& result_metadata_id) const {
+    return is_encoded && this->version == version && this->consistency == consistency &&
+           this->serial_consistency == serial_consistency &&
+           this->skip_metadata == skip_metadata && this->has_timestamp == has_timestamp &&
+           page_size == statement->page_size() &&
+           element_count == statement->elements().size() &&
+           has_paging_state == !statement->paging_state().empty() &&
+           this->result_metadata_id.size() == result_metadata_id.size() &&
+           memcmp(this->result_metadata_id.data(), result_metadata_id.data(),
+                  result_metadata_id.size()) == 0;
+  }
+
+  uv_mutex_t mutex;
+
+  bool is_encoded;
+  int version;
+  CassConsistency consistency;
+  CassConsistency serial_consistency;
+  bool skip_metadata;
+  bool has_timestamp;
+  int32_t page_size;
+  size_t element_count;
+  bool has_paging_state; // Only the paging state flag is encoded in <begin>
+  Buffer result_metadata_id;
+
+  Buffer begin; // <query_or_id>[<result_metadata_id>]<consistency><flags>[<n>]
+  Buffer page_size_end;          // [<result_page_size>]
+  Buffer serial_consistency_end; // [<serial_consistency>]
+};
+
+// Copies the first `size` bytes of the buffers into a single buffer.
+static Buffer concat(const BufferVec& bufs, size_t size) {
+  Buffer buf(size);
+  size_t pos = 0;
+  for (BufferVec::const_iterator it = bufs.begin(), end = bufs.end(); it != end && pos < size;
+       ++it) {
+    pos = buf.copy(pos, it->data(), std::min(it->size(), size - pos));
+  }
+  return buf;
+}
+
 Statement::Statement(const char* query, size_t query_length, size_t values_count)
     : RoutableRequest(CQL_OPCODE_QUERY)
     , AbstractData(values_count)
@@ -295,6 +372,14 @@ Statement::Statement(const Prepared* prepared)
   }
 }
 
+Statement::~Statement() {}
+
+void Statement::freeze() {
+  if (!frozen_) {
+    frozen_.reset(new FrozenRequest());
+  }
+}
+
 String Statement::query() const {
   if (opcode() == CQL_OPCODE_QUERY) {
     return String(query_or_id_.data() + sizeof(int32_t), query_or_id_.size() - sizeof(int32_t));
@@ -433,24 +518,19 @@ int32_t Statement::encode_begin(ProtocolVersion version, uint16_t element_count,
 // <value> is a [bytes]
 int32_t Statement::encode_values(ProtocolVersion version, RequestCallback* callback,
                                  BufferVec* bufs) const {
-  int32_t length = 0;
-  for (size_t i = 0; i < elements().size(); ++i) {
-    const Element& element = elements()[i];
-    if (!element.is_unset()) {
-      bufs->push_back(element.get_buffer());
-    } else {
-      if (version >= CASS_PROTOCOL_VERSION_V4) {
-        bufs->push_back(core::encode_with_length(CassUnset()));
-      } else {
+  if (elements().empty()) return 0;
+  if (version < CASS_PROTOCOL_VERSION_V4) {
+    for (size_t i = 0; i < elements().size(); ++i) {
+      if (elements()[i].is_unset()) {
         OStringStream ss;
         ss << "Query parameter at index " << i << " was not set";
         callback->on_error(CASS_ERROR_LIB_PARAMETER_UNSET, ss.str());
         return Request::REQUEST_ERROR_PARAMETER_UNSET;
       }
     }
-    length += bufs->back().size();
   }
-  return length;
+  bufs->push_back(encode_elements(-2)); // Unset values are "unset"
+  return bufs->back().size();
 }
 
 // Format: [<result_page_size>][<paging_state>][<serial_consistency>][<timestamp>]
@@ -518,6 +598,103 @@ int32_t Statement::encode_end(ProtocolVersion version, RequestCallback* callback
   return length;
 }
 
+bool Statement::can_encode_frozen(ProtocolVersion version) const {
+  // The keyspace is encoded after the timestamp and named values are encoded
+  // by the query request.
+  return frozen_ && !has_names_for_values() && !with_keyspace(version);
+}
+
+// Encodes the request as:
+// <begin>[<value_1>...<value_n>][<result_page_size>][<paging_state>]
+//   [<serial_consistency>][<timestamp>]
+// where <begin>, <result_page_size> and <serial_consistency> are the invariant
+// parts of the request, encoded by `encode_begin()` and `encode_end()`, and
+// re-used while the settings used to encode them don't change. The values, the
+// paging state and the timestamp are encoded for each execution so that the
+// pages of a result re-use the rest of the request.
+int32_t Statement::encode_frozen(ProtocolVersion version, const Buffer& result_metadata_id,
+                                 RequestCallback* callback, BufferVec* bufs) const {
+  const CassConsistency consistency = callback->consistency();
+  const CassConsistency serial_consistency = callback->serial_consistency();
+  const bool skip_metadata = callback->skip_metadata();
+  const int64_t timestamp = callback->timestamp();
+  const bool has_timestamp = timestamp != CASS_INT64_MIN;
+
+  Buffer begin, page_size_end, serial_consistency_end;
+  {
+    ScopedMutex l(&frozen_->mutex);
+    FrozenRequest& frozen = *frozen_;
+    if (!frozen.is_encoded_with(version.value(), consistency, serial_consistency, skip_metadata,
+                                has_timestamp, this, result_metadata_id)) {
+      BufferVec temp;
+      int32_t length = encode_query_or_id(&temp);
+      if (result_metadata_id.size() > 0) {
+        temp.push_back(result_metadata_id);
+        length += result_metadata_id.size();
+      }
+      length += encode_begin(version, static_cast<uint16_t>(elements().size()), callback, &temp);
+      frozen.begin = concat(temp, length);
+
+      temp.clear();
+      length = encode_end(version, callback, &temp);
+      Buffer end(concat(temp, length));
+      size_t page_size_length = page_size() >= 0 ? sizeof(int32_t) : 0;
+      size_t serial_consistency_pos =
+          page_size_length +
+          (paging_state().empty() ? 0 : sizeof(int32_t) + paging_state().size());
+      size_t serial_consistency_length = serial_consistency != 0 ? sizeof(uint16_t) : 0;
+      frozen.page_size_end = Buffer(end.data(), page_size_length);
+      frozen.serial_consistency_end =
+          Buffer(end.data() + serial_consistency_pos, serial_consistency_length);
+
+      frozen.is_encoded = true;
+      frozen.version = version.value();
+      frozen.consistency = consistency;
+      frozen.serial_consistency = serial_consistency;
+      frozen.skip_metadata = skip_metadata;
+      frozen.has_timestamp = has_timestamp;
+      frozen.page_size = page_size();
+      frozen.element_count = elements().size();
+      frozen.has_paging_state = !paging_state().empty();
+      frozen.result_metadata_id = result_metadata_id;
+    }
+    begin = frozen.begin;
+    page_size_end = frozen.page_size_end;
+    serial_consistency_end = frozen.serial_consistency_end;
+  }
+
+  int32_t length = begin.size();
+  bufs->push_back(begin);
+
+  int32_t result = encode_values(version, callback, bufs);
+  if (result < 0) return result;
+  length += result;
+
+  if (page_size_end.size() > 0) {
+    bufs->push_back(page_size_end);
+    length += page_size_end.size();
+  }
+
+  if (!paging_state().empty()) {
+    bufs->push_back(Buffer(sizeof(int32_t) + paging_state().size()));
+    bufs->back().encode_bytes(0, paging_state().data(), paging_state().size());
+    length += bufs->back().size();
+  }
+
+  if (serial_consistency_end.size() > 0) {
+    bufs->push_back(serial_consistency_end);
+    length += serial_consistency_end.size();
+  }
+
+  if (has_timestamp) {
+    bufs->push_back(Buffer(sizeof(int64_t)));
+    bufs->back().encode_int64(0, timestamp);
+    length += sizeof(int64_t);
+  }
+
+  return length;
+}
+
 bool Statement::calculate_routing_key(const Vector<size_t>& key_indices,
                                       String* routing_key) const {
   if (key_indices.empty()) return false;
@@ -528,8 +705,8 @@ bool Statement::calculate_routing_key(const Vector<size_t>& key_indices,
     if (element.is_unset() || element.is_null()) {
       return false;
     }
-    Buffer buf(element.get_buffer());
-    routing_key->assign(buf.data() + sizeof(int32_t), buf.size() - sizeof(int32_t));
+    const char* data = element_data(key_indices.front());
+    routing_key->assign(data + sizeof(int32_t), element.get_size() - sizeof(int32_t));
   } else {
     size_t length = 0;
 
@@ -547,14 +724,13 @@ bool Statement::calculate_routing_key(const Vector<size_t>& key_indices,
     routing_key->reserve(length);
 
     for (Vector<size_t>::const_iterator i = key_indices.begin(); i != key_indices.end(); ++i) {
-      const AbstractData::Element& element(elements()[*i]);
-      Buffer buf(element.get_buffer());
-      size_t size = buf.size() - sizeof(int32_t);
+      const char* data = element_data(*i);
+      size_t size = elements()[*i].get_size() - sizeof(int32_t);
 
       char size_buf[sizeof(uint16_t)];
       encode_uint16(size_buf, static_cast<uint16_t>(size));
       routing_key->append(size_buf, sizeof(uint16_t));
-      routing_key->append(buf.data() + sizeof(int32_t), size);
+      routing_key->append(data + sizeof(int32_t), size);
       routing_key->push_back(0);
     }
   }
@@ -46,7 +46,7 @@ public:
 
   Statement(const Prepared* prepared);
 
-  virtual ~Statement() {}
+  virtual ~Statement();
 
   // Used to get the original query string from a simple statement. To get the
   // query from a execute request (bound statement) cast it and get it from the
@@ -83,6 +83,10 @@ public:
 
   int32_t encode_batch(ProtocolVersion version, RequestCallback* callback, BufferVec* bufs) const;
 
+  void freeze();
+
+  bool is_frozen() const { return frozen_; }
+
 protected:
   bool with_keyspace(ProtocolVersion version) const;
 
@@ -94,12 +98,20 @@ protected:
 
   bool calculate_routing_key(const Vector<size_t>& key_indices, String* routing_key) const;
 
+  bool can_encode_frozen(ProtocolVersion version) const;
+  int32_t encode_frozen(ProtocolVersion version, const Buffer& result_metadata_id,
+                        RequestCallback* callback, BufferVec* bufs) const;
+
+private:
+  struct FrozenRequest;
+
 private:
   Buffer query_or_id_;
   int32_t flags_;
   int32_t page_size_;
   String paging_state_;
   Vector<size_t> key_indices_;
+  ScopedPtr<FrozenRequest> frozen_;
 
 private:
   DISALLOW_COPY_AND_ASSIGN(Statement);
@@ -0,0 +1,235 @@
+/*
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include "table_scan.hpp"
+
+#include "constants.hpp"
+#include "logger.hpp"
+#include "metadata.hpp"
+#include "session.hpp"
+#include "utils.hpp"
+
+using namespace datastax;
+using namespace datastax::internal;
+using namespace datastax::internal::core;
+
+extern "C" {
+
+CassPagedIterator* cass_session_scan_table(CassSession* session, const char* keyspace,
+                                           const char* table, const char* columns,
+                                           unsigned parallelism) {
+  return cass_session_scan_table_n(session, keyspace, SAFE_STRLEN(keyspace), table,
+                                   SAFE_STRLEN(table), columns, SAFE_STRLEN(columns),
+                                   parallelism);
+}
+
+CassPagedIterator* cass_session_scan_table_n(CassSession* session, const char* keyspace,
+                                             size_t keyspace_length, const char* table,
+                                             size_t table_length, const char* columns,
+                                             size_t columns_length, unsigned parallelism) {
+  SharedRefPtr<TableScanIterator> iterator(new TableScanIterator(session, parallelism));
+
+  String keyspace_name(keyspace, keyspace_length);
+  String table_name(table, table_length);
+  TokenMap::Ptr token_map(session->token_map());
+
+  if (parallelism == 0) {
+    iterator->init_error(CASS_ERROR_LIB_BAD_PARAMS, "Parallelism must be greater than zero");
+  } else if (!session->cluster()) {
+    iterator->init_error(CASS_ERROR_LIB_NO_HOSTS_AVAILABLE, "Session is not connected");
+  } else if (!token_map) {
+    iterator->init_error(CASS_ERROR_LIB_INVALID_STATE,
+                         "Token map is not available (token-aware routing must be enabled)");
+  } else {
+    Metadata::SchemaSnapshot schema(session->cluster()->schema_snapshot());
+    const KeyspaceMetadata* keyspace_meta = schema.get_keyspace(keyspace_name);
+    const TableMetadata* table_meta =
+        keyspace_meta != NULL ? keyspace_meta->get_table(table_name) : NULL;
+    if (table_meta == NULL) {
+      iterator->init_error(CASS_ERROR_LIB_BAD_PARAMS,
+                           "Unable to find table \"" + keyspace_name + "." + table_name + "\"");
+    } else {
+      iterator->init(keyspace_name, table_meta,
+                     columns_length > 0 ? String(columns, columns_length) : String("*"),
+                     token_map.get(), session->local_dc());
+    }
+  }
+
+  iterator->start();
+  iterator->inc_ref();
+  return CassPagedIterator::to(iterator.get());
+}
+
+} // extern "C"
+
+namespace {
+
+// Errors caused by the query itself aren't retried on the range's other replicas
+bool is_retryable(CassError code) {
+  switch (code) {
+    case CASS_ERROR_SERVER_SYNTAX_ERROR:
+    case CASS_ERROR_SERVER_UNAUTHORIZED:
+    case CASS_ERROR_SERVER_INVALID_QUERY:
+    case CASS_ERROR_SERVER_CONFIG_ERROR:
+      return false;
+    default:
+      return true;
+  }
+}
+
+} // namespace
+
+TableScanIterator::TableScanIterator(Session* session, size_t parallelism)
+    : PagedIterator(session, parallelism, 0)
+    , parallelism_(parallelism)
+    , next_range_(0) {}
+
+void TableScanIterator::init(const String& keyspace_name, const TableMetadata* table,
+                             const String& columns, const TokenMap* token_map,
+                             const String& local_dc) {
+  TokenRangeVec token_ranges;
+  token_map->get_token_ranges(keyspace_name, &token_ranges);
+  if (token_ranges.empty()) {
+    set_error(CASS_ERROR_LIB_INVALID_STATE,
+              "Unable to determine the token ranges of keyspace \"" + keyspace_name + "\"");
+    return;
+  }
+
+  String token("token(");
+  const ColumnMetadata::Vec& partition_key = table->partition_key();
+  for (ColumnMetadata::Vec::const_iterator it = partition_key.begin(), end = partition_key.end();
+       it != end; ++it) {
+    String name((*it)->name());
+    if (it != partition_key.begin()) token.append(", ");
+    token.append(escape_id(name));
+  }
+  token.append(")");
+
+  String keyspace_id(keyspace_name);
+  String table_id(table->name());
+  String query("SELECT " + columns + " FROM " + escape_id(keyspace_id) + "." +
+               escape_id(table_id) + " WHERE ");
+
+  ranges_.resize(token_ranges.size());
+  for (size_t i = 0; i < token_ranges.size(); ++i) {
+    const TokenRange& token_range = token_ranges[i];
+    RangeScan& range = ranges_[i];
+
+    size_t value_count = 0;
+    String range_query(query);
+    if (token_range.has_start) {
+      range_query.append(token + " > ?");
+      value_count++;
+    }
+    if (token_range.has_end) {
+      range_query.append(value_count > 0 ? " AND " : "");
+      range_query.append(token + " <= ?");
+      value_count++;
+    }
+
+    range.request.reset(new QueryRequest(range_query, value_count));
+    range.request->set_page_size(CASS_DEFAULT_SCAN_PAGE_SIZE);
+    range.request->set_is_idempotent(true);
+    size_t index = 0;
+    if (token_range.has_start) {
+      range.request->set(index++,
+                         CassBytes(reinterpret_cast<const cass_byte_t*>(token_range.start.data()),
+                                   token_range.start.size()));
+    }
+    if (token_range.has_end) {
+      range.request->set(index++,
+                         CassBytes(reinterpret_cast<const cass_byte_t*>(token_range.end.data()),
+                                   token_range.end.size()));
+    }
+
+    // Local replicas are tried first. The starting replica is rotated from
+    // range to range to spread the scan over all the local replicas.
+    HostVec local, remote;
+    const HostVec& replicas = *token_range.replicas;
+    for (HostVec::const_iterator it = replicas.begin(), end = replicas.end(); it != end; ++it) {
+      if (local_dc.empty() || (*it)->dc() == local_dc) {
+        local.push_back(*it);
+      } else {
+        remote.push_back(*it);
+      }
+    }
+    for (size_t j = 0; j < local.size(); ++j) {
+      range.replicas.push_back(local[(i + j) % local.size()]);
+    }
+    range.replicas.insert(range.replicas.end(), remote.begin(), remote.end());
+    if (!range.replicas.empty()) {
+      range.request->set_host(range.replicas.front()->address());
+    }
+  }
+
+  LOG_DEBUG("Scanning table \"%s.%s\" using %u token ranges", keyspace_name.c_str(),
+            table->name().c_str(), static_cast<unsigned>(ranges_.size()));
+}
+
+void TableScanIterator::fetch_more(bool is_needed, FetchVec* fetches) {
+  while (pending_count() + fetches->size() < parallelism_ &&
+         (has_room() || (is_needed && fetches->empty()))) {
+    RangeScan* range = NULL;
+    if (!ready_.empty()) {
+      // Finish started ranges before starting new ranges
+      range = ready_.back();
+      ready_.pop_back();
+    } else if (next_range_ < ranges_.size()) {
+      range = &ranges_[next_range_++];
+    } else {
+      break;
+    }
+    fetches->push_back(Fetch(range->request, range));
+  }
+}
+
+void TableScanIterator::on_result(void* data, const ResultResponse::Ptr& result,
+                                  FetchVec* fetches) {
+  RangeScan* range = static_cast<RangeScan*>(data);
+  add_page(result);
+
+  range->attempts = 0;
+  if (result->has_more_pages()) {
+    // The range's request isn't outstanding so it's safe to update it
+    range->request->set_paging_state(result->paging_state().to_string());
+    ready_.push_back(range);
+  }
+
+  fetch_more(false, fetches);
+}
+
+void TableScanIterator::on_error(void* data, const Future::Error& error, FetchVec* fetches) {
+  RangeScan* range = static_cast<RangeScan*>(data);
+
+  if (is_retryable(error.code) && ++range->attempts < range->replicas.size()) {
+    // Continue from the same page on the range's next replica
+    range->replica_index = (range->replica_index + 1) % range->replicas.size();
+    const Address& address = range->replicas[range->replica_index]->address();
+    LOG_DEBUG("Retrying token range query on host %s: %s", address.to_string().c_str(),
+              error.message.c_str());
+    range->request->set_host(address);
+    ready_.push_back(range);
+    fetch_more(false, fetches);
+  } else {
+    set_error(error.code, error.message);
+  }
+}
+
+bool TableScanIterator::has_more_pages() const {
+  return !ready_.empty() || next_range_ < ranges_.size();
+}
@@ -0,0 +1,88 @@
+/*
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifndef DATASTAX_INTERNAL_TABLE_SCAN_HPP
+#define DATASTAX_INTERNAL_TABLE_SCAN_HPP
+
+#include "host.hpp"
+#include "paged_iterator.hpp"
+#include "query_request.hpp"
+#include "token_map.hpp"
+#include "vector.hpp"
+
+namespace datastax { namespace internal { namespace core {
+
+class TableMetadata;
+
+/**
+ * Scans a whole table by querying each of the ring's token ranges. Each
+ * range's query is sent to one of the range's replicas (preferring the local
+ * datacenter) and up to `parallelism` ranges are queried at the same time.
+ * A range is retried on its other replicas if its query fails. The rows of
+ * all the ranges are returned by the one iterator, in no particular order.
+ */
+class TableScanIterator : public PagedIterator {
+public:
+  TableScanIterator(Session* session, size_t parallelism);
+
+  /**
+   * Create the queries for the table's token ranges. This must be called
+   * before `start()`; an error is set if the table can't be scanned.
+   *
+   * @param keyspace_name
+   * @param table The table's metadata.
+   * @param columns The selected columns or "*" for all the columns.
+   * @param token_map The current token map.
+   * @param local_dc The local datacenter or empty if unknown.
+   */
+  void init(const String& keyspace_name, const TableMetadata* table, const String& columns,
+            const TokenMap* token_map, const String& local_dc);
+
+  void init_error(CassError code, const String& message) { set_error(code, message); }
+
+protected:
+  virtual void fetch_more(bool is_needed, FetchVec* fetches);
+  virtual void on_result(void* data, const ResultResponse::Ptr& result, FetchVec* fetches);
+  virtual void on_error(void* data, const Future::Error& error, FetchVec* fetches);
+  virtual bool has_more_pages() const;
+
+private:
+  struct RangeScan {
+    RangeScan()
+        : replica_index(0)
+        , attempts(0) {}
+
+    QueryRequest::Ptr request;
+    HostVec replicas; // Ordered by preference
+    size_t replica_index;
+    size_t attempts;
+  };
+
+  typedef Vector<RangeScan> RangeScanVec;
+  typedef Vector<RangeScan*> RangeScanPtrVec;
+
+private:
+  const size_t parallelism_;
+  RangeScanVec ranges_;
+  size_t next_range_;
+  RangeScanPtrVec ready_; // Started ranges waiting to query their next page
+};
+
+}}} // namespace datastax::internal::core
+
+#endif
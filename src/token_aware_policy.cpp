@@ -107,3 +107,7 @@ Host::Ptr TokenAwarePolicy::TokenAwareQueryPlan::compute_next() {
   }
   return Host::Ptr();
 }
+
+bool TokenAwarePolicy::TokenAwareQueryPlan::is_replica(const Host::Ptr& host) const {
+  return contains(replicas_, host->address());
+}
@@ -58,6 +58,7 @@ private:
         , remaining_(replicas->size()) {}
 
     Host::Ptr compute_next();
+    bool is_replica(const Host::Ptr& host) const;
 
   private:
     LoadBalancingPolicy* child_policy_;
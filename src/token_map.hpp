@@ -23,6 +23,7 @@
 #include "ref_counted.hpp"
 #include "string.hpp"
 #include "string_ref.hpp"
+#include "vector.hpp"
 
 namespace datastax { namespace internal { namespace core {
 
@@ -30,6 +31,28 @@ class VersionNumber;
 class Value;
 class ResultResponse;
 
+/**
+ * A range of the ring, (start, end], and its replicas. The start and end
+ * tokens are encoded as the CQL value of the partitioner's token type (bigint,
+ * varint or blob) so they can be bound to a "token(...) > ? AND
+ * token(...) <= ?" query. The range that wraps around the ring is split in two
+ * ranges; one without an end and one without a start.
+ */
+struct TokenRange {
+  TokenRange()
+      : has_start(false)
+      , has_end(false)
+      , replicas(NULL) {}
+
+  bool has_start;
+  String start;
+  bool has_end;
+  String end;
+  CopyOnWriteHostVec replicas;
+};
+
+typedef Vector<TokenRange> TokenRangeVec;
+
 class TokenMap : public RefCounted<TokenMap> {
 public:
   typedef SharedRefPtr<TokenMap> Ptr;
@@ -55,6 +78,8 @@ public:
   virtual const CopyOnWriteHostVec& get_replicas(const String& keyspace_name,
                                                  const String& routing_key) const = 0;
 
+  virtual void get_token_ranges(const String& keyspace_name, TokenRangeVec* ranges) const = 0;
+
   virtual String dump(const String& keyspace_name) const = 0;
 };
 
@@ -20,6 +20,7 @@
 
 #include "md5.hpp"
 #include "murmur3.hpp"
+#include "serialization.hpp"
 
 using namespace datastax;
 using namespace datastax::internal::core;
@@ -100,6 +101,12 @@ Murmur3Partitioner::Token Murmur3Partitioner::hash(const StringRef& str) {
   return MurmurHash3_x64_128(str.data(), str.size(), 0);
 }
 
+String Murmur3Partitioner::to_bytes(const Token& token) {
+  char bytes[sizeof(int64_t)];
+  encode_int64(bytes, token);
+  return String(bytes, sizeof(bytes));
+}
+
 RandomPartitioner::Token RandomPartitioner::from_string(const StringRef& str) {
   Token token;
   parse_int128(str.data(), str.size(), &token.hi, &token.lo);
@@ -149,6 +156,16 @@ RandomPartitioner::Token RandomPartitioner::hash(const StringRef& str) {
   return token;
 }
 
+String RandomPartitioner::to_bytes(const Token& token) {
+  // Tokens are in the range [0, 2^127] so a leading zero byte keeps the varint
+  // positive.
+  char bytes[1 + 2 * sizeof(uint64_t)];
+  bytes[0] = 0;
+  encode_int64(bytes + 1, static_cast<int64_t>(token.hi));
+  encode_int64(bytes + 1 + sizeof(uint64_t), static_cast<int64_t>(token.lo));
+  return String(bytes, sizeof(bytes));
+}
+
 ByteOrderedPartitioner::Token ByteOrderedPartitioner::from_string(const StringRef& str) {
   const uint8_t* data = reinterpret_cast<const uint8_t*>(str.data());
   return Token(data, data + str.size());
@@ -158,3 +175,7 @@ ByteOrderedPartitioner::Token ByteOrderedPartitioner::hash(const StringRef& str)
   const uint8_t* data = reinterpret_cast<const uint8_t*>(str.data());
   return Token(data, data + str.size());
 }
+
+String ByteOrderedPartitioner::to_bytes(const Token& token) {
+  return String(token.begin(), token.end());
+}
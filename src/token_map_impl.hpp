@@ -115,6 +115,7 @@ struct Murmur3Partitioner {
 
   static Token from_string(const StringRef& str);
   static Token hash(const StringRef& str);
+  static String to_bytes(const Token& token);
   static StringRef name() { return "Murmur3Partitioner"; }
 };
 
@@ -135,6 +136,7 @@ struct RandomPartitioner {
 
   static Token from_string(const StringRef& str);
   static Token hash(const StringRef& str);
+  static String to_bytes(const Token& token);
   static StringRef name() { return "RandomPartitioner"; }
 };
 
@@ -144,6 +146,7 @@ public:
 
   static Token from_string(const StringRef& str);
   static Token hash(const StringRef& str);
+  static String to_bytes(const Token& token);
   static StringRef name() { return "ByteOrderedPartitioner"; }
 };
 
@@ -618,6 +621,8 @@ public:
   virtual const CopyOnWriteHostVec& get_replicas(const String& keyspace_name,
                                                  const String& routing_key) const;
 
+  virtual void get_token_ranges(const String& keyspace_name, TokenRangeVec* ranges) const;
+
   virtual String dump(const String& keyspace_name) const;
 
 public:
@@ -759,6 +764,40 @@ const CopyOnWriteHostVec& TokenMapImpl<Partitioner>::get_replicas(const String&
   return no_replicas_dummy_;
 }
 
+template <class Partitioner>
+void TokenMapImpl<Partitioner>::get_token_ranges(const String& keyspace_name,
+                                                 TokenRangeVec* ranges) const {
+  typename KeyspaceReplicaMap::const_iterator ks_it = replicas_.find(keyspace_name);
+  if (ks_it == replicas_.end() || ks_it->second.empty()) return;
+
+  const TokenReplicasVec& token_replicas = ks_it->second;
+  ranges->reserve(token_replicas.size() + 1);
+
+  // The range before the first token, (-inf, first], and the range after the
+  // last token, (last, +inf), are both owned by the first token's replicas.
+  TokenRange first;
+  first.has_end = true;
+  first.end = Partitioner::to_bytes(token_replicas.front().first);
+  first.replicas = token_replicas.front().second;
+  ranges->push_back(first);
+
+  for (size_t i = 1; i < token_replicas.size(); ++i) {
+    TokenRange range;
+    range.has_start = true;
+    range.start = Partitioner::to_bytes(token_replicas[i - 1].first);
+    range.has_end = true;
+    range.end = Partitioner::to_bytes(token_replicas[i].first);
+    range.replicas = token_replicas[i].second;
+    ranges->push_back(range);
+  }
+
+  TokenRange last;
+  last.has_start = true;
+  last.start = Partitioner::to_bytes(token_replicas.back().first);
+  last.replicas = token_replicas.front().second;
+  ranges->push_back(last);
+}
+
 template <class Partitioner>
 String TokenMapImpl<Partitioner>::dump(const String& keyspace_name) const {
   String result;
@@ -23,11 +23,14 @@
 #include <algorithm>
 #include <assert.h>
 #include <functional>
+#include <stdlib.h>
 #include <uv.h>
 
 #if (defined(WIN32) || defined(_WIN32))
 #include <windows.h>
 #else
+#include <errno.h>
+#include <pthread.h>
 #include <sched.h>
 #include <unistd.h>
 #endif
@@ -194,4 +197,66 @@ void set_thread_name(const String& thread_name) {
 #endif
 }
 
+// The number of CPUs a thread can be bound to by `set_thread_affinity()`
+static unsigned max_cpu_count() {
+#if defined(__linux__)
+  return CPU_SETSIZE;
+#elif defined(WIN32) || defined(_WIN32)
+  return sizeof(DWORD_PTR) * 8;
+#else
+  return 1024;
+#endif
+}
+
+static bool parse_cpu(const String& str, unsigned* cpu) {
+  String trimmed(str);
+  trim(trimmed);
+  if (trimmed.empty() || trimmed.size() > 5 ||
+      trimmed.find_first_not_of("0123456789") != String::npos) {
+    return false;
+  }
+  *cpu = static_cast<unsigned>(atoi(trimmed.c_str()));
+  return *cpu < max_cpu_count();
+}
+
+bool parse_cpu_list(const String& cpu_list, CpuList* cpus) {
+  Vector<String> ranges;
+  explode(cpu_list, ranges, ',');
+  if (ranges.empty()) return false;
+
+  for (Vector<String>::const_iterator it = ranges.begin(), end = ranges.end(); it != end; ++it) {
+    unsigned first, last;
+    size_t pos = it->find('-');
+    if (pos == String::npos) {
+      if (!parse_cpu(*it, &first)) return false;
+      last = first;
+    } else if (!parse_cpu(it->substr(0, pos), &first) ||
+               !parse_cpu(it->substr(pos + 1), &last) || first > last) {
+      return false;
+    }
+    for (unsigned cpu = first; cpu <= last; ++cpu) {
+      cpus->push_back(cpu);
+    }
+  }
+  return true;
+}
+
+int set_thread_affinity(unsigned cpu) {
+#if defined(__linux__)
+  if (cpu >= max_cpu_count()) return EINVAL;
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  CPU_SET(cpu, &set);
+  return pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#elif defined(WIN32) || defined(_WIN32)
+  if (cpu >= max_cpu_count()) return ERROR_INVALID_PARAMETER;
+  if (SetThreadAffinityMask(GetCurrentThread(), static_cast<DWORD_PTR>(1) << cpu) == 0) {
+    return static_cast<int>(GetLastError());
+  }
+  return 0;
+#else
+  return ENOTSUP;
+#endif
+}
+
 }} // namespace datastax::internal
@@ -36,6 +36,7 @@ namespace datastax { namespace internal {
 
 typedef Vector<String> ContactPointList;
 typedef Vector<String> DcList;
+typedef Vector<unsigned> CpuList;
 
 // copy_cast<> prevents incorrect code from being generated when two unrelated
 // types reference the same memory location and strict aliasing is enabled.
@@ -112,6 +113,26 @@ int32_t get_pid();
 
 void set_thread_name(const String& thread_name);
 
+/**
+ * Parse a list of CPUs, e.g. "0-3,8,10-11" (the format used by taskset).
+ *
+ * @param cpu_list
+ * @param cpus The CPUs, in the order they appear in the list.
+ * @return false if the list is empty or invalid, a range is reversed or a CPU
+ * is beyond the CPUs a thread can be bound to (CPU_SETSIZE on Linux).
+ */
+bool parse_cpu_list(const String& cpu_list, CpuList* cpus);
+
+/**
+ * Bind the current thread to a single CPU. This is only supported on Linux
+ * and Windows.
+ *
+ * @param cpu
+ * @return 0 if successful, otherwise an error occurred or the platform
+ * doesn't support it.
+ */
+int set_thread_affinity(unsigned cpu);
+
 template <class C>
 static void set_pointer_keys(C& container) {
   container.set_empty_key(reinterpret_cast<typename C::key_type>(0x0));
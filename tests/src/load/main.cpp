@@ -0,0 +1,952 @@
+/*
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+/*
+ * A load generator that drives a real session against an in-process
+ * mockssandra cluster. Server latencies and errors can be injected so the
+ * effect of changes to coalescing, pooling and routing can be measured
+ * without a real cluster.
+ *
+ * Reported: throughput, latency percentiles (p50/p99/p999), driver CPU time
+ * per request and driver allocations per request.
+ *
+ * With `--allocator-benchmark` only the request/response allocators are
+ * measured (no cluster is started).
+ *
+ * With `--task-queue-benchmark` only the event loop task queues are measured
+ * (no cluster is started).
+ */
+
+#include "cassandra.h"
+#include "constants.hpp"
+#include "deque.hpp"
+#include "event_loop.hpp"
+#include "memory.hpp"
+#include "mockssandra.hpp"
+#include "mpsc_queue.hpp"
+#include "scoped_lock.hpp"
+#include "slab_allocator.hpp"
+#include "third_party/hdr_histogram/hdr_histogram.hpp"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__linux__)
+#include <time.h>
+#define HAVE_THREAD_CPU_TIME
+#endif
+
+using datastax::internal::Atomic;
+using datastax::internal::Deque;
+using datastax::internal::Memory;
+using datastax::internal::ScopedMutex;
+using datastax::internal::SlabAllocator;
+using datastax::internal::Vector;
+using datastax::internal::core::EventLoop;
+using datastax::internal::core::LoopContext;
+using datastax::internal::core::MPSCQueue;
+using datastax::internal::core::Task;
+
+#define LOAD_QUERY "INSERT INTO load.test (key, value) VALUES (?, ?)"
+
+namespace {
+
+/**
+ * Load test settings (populated from the command line).
+ */
+struct Settings {
+  Settings()
+      : num_nodes(3)
+      , num_server_threads(1)
+      , num_io_threads(1)
+      , num_connections(1)
+      , rate(0)
+      , concurrency(1000)
+      , duration_secs(10)
+      , warmup_secs(2)
+      , latency_min_ms(0)
+      , latency_max_ms(0)
+      , error_rate(0.0)
+      , error_code(mockssandra::ERROR_OVERLOADED)
+      , num_values(2)
+      , value_size(64)
+      , coalesce_delay_us(CASS_DEFAULT_COALESCE_DELAY)
+      , new_request_ratio(CASS_DEFAULT_NEW_REQUEST_RATIO)
+      , allocator_benchmark_ops(0)
+      , task_queue_benchmark_ops(0) {}
+
+  unsigned num_nodes;
+  unsigned num_server_threads;
+  unsigned num_io_threads;
+  unsigned num_connections;
+  unsigned rate; // Requests per second (0 is unbounded)
+  unsigned concurrency;
+  unsigned duration_secs;
+  unsigned warmup_secs;
+  unsigned latency_min_ms;
+  unsigned latency_max_ms;
+  double error_rate; // 0.0 to 1.0
+  int32_t error_code;
+  unsigned num_values;
+  unsigned value_size;
+  unsigned coalesce_delay_us;
+  int new_request_ratio;
+  unsigned allocator_benchmark_ops; // 0 runs the load test
+  unsigned task_queue_benchmark_ops; // 0 runs the load test
+};
+
+void print_usage(const char* program) {
+  fprintf(stderr,
+          "Usage: %s [options]\n\n"
+          "  --nodes <n>              Number of mock nodes (default: 3)\n"
+          "  --server-threads <n>     Number of mock server event loop threads (default: 1)\n"
+          "  --io-threads <n>         Number of driver I/O threads (default: 1)\n"
+          "  --connections <n>        Core connections per host (default: 1)\n"
+          "  --rate <n>               Target requests per second; 0 is unbounded (default: 0)\n"
+          "  --concurrency <n>        Maximum number of in-flight requests (default: 1000)\n"
+          "  --duration <secs>        Measured duration (default: 10)\n"
+          "  --warmup <secs>          Unmeasured warmup duration (default: 2)\n"
+          "  --latency <min>[:<max>]  Injected server latency in milliseconds (default: 0)\n"
+          "  --error-rate <fraction>  Fraction of requests that fail on the server (default: 0)\n"
+          "  --error <type>           Injected error: overloaded, server (default: overloaded)\n"
+          "  --values <n>             Number of bound values per request (default: 2)\n"
+          "  --value-size <bytes>     Size of each bound value (default: 64)\n"
+          "  --coalesce-delay <us>    Driver coalesce delay (default: %d)\n"
+          "  --new-request-ratio <n>  Driver new request ratio (default: %d)\n"
+          "  --allocator-benchmark <ops>\n"
+          "                           Only benchmark the request/response allocators\n"
+          "  --task-queue-benchmark <ops>\n"
+          "                           Only benchmark the event loop task queues\n",
+          program, CASS_DEFAULT_COALESCE_DELAY, CASS_DEFAULT_NEW_REQUEST_RATIO);
+}
+
+bool parse_unsigned(const char* value, unsigned* result) {
+  char* end = NULL;
+  unsigned long temp = strtoul(value, &end, 10);
+  if (end == value || *end != '\0') return false;
+  *result = static_cast<unsigned>(temp);
+  return true;
+}
+
+bool parse_settings(int argc, char* argv[], Settings* settings) {
+  for (int i = 1; i < argc; ++i) {
+    const char* arg = argv[i];
+    if (strcmp(arg, "--help") == 0 || strcmp(arg, "-h") == 0) {
+      return false;
+    }
+    if (i + 1 >= argc) {
+      fprintf(stderr, "Missing value for '%s'\n", arg);
+      return false;
+    }
+    const char* value = argv[++i];
+    bool is_valid = true;
+    if (strcmp(arg, "--nodes") == 0) {
+      is_valid = parse_unsigned(value, &settings->num_nodes) && settings->num_nodes > 0;
+    } else if (strcmp(arg, "--server-threads") == 0) {
+      is_valid =
+          parse_unsigned(value, &settings->num_server_threads) && settings->num_server_threads > 0;
+    } else if (strcmp(arg, "--io-threads") == 0) {
+      is_valid = parse_unsigned(value, &settings->num_io_threads) && settings->num_io_threads > 0;
+    } else if (strcmp(arg, "--connections") == 0) {
+      is_valid = parse_unsigned(value, &settings->num_connections) && settings->num_connections > 0;
+    } else if (strcmp(arg, "--rate") == 0) {
+      is_valid = parse_unsigned(value, &settings->rate);
+    } else if (strcmp(arg, "--concurrency") == 0) {
+      is_valid = parse_unsigned(value, &settings->concurrency) && settings->concurrency > 0;
+    } else if (strcmp(arg, "--duration") == 0) {
+      is_valid = parse_unsigned(value, &settings->duration_secs) && settings->duration_secs > 0;
+    } else if (strcmp(arg, "--warmup") == 0) {
+      is_valid = parse_unsigned(value, &settings->warmup_secs);
+    } else if (strcmp(arg, "--latency") == 0) {
+      unsigned min = 0, max = 0;
+      is_valid = sscanf(value, "%u:%u", &min, &max) >= 1;
+      settings->latency_min_ms = min;
+      settings->latency_max_ms = max > min ? max : min;
+    } else if (strcmp(arg, "--error-rate") == 0) {
+      settings->error_rate = atof(value);
+      is_valid = settings->error_rate >= 0.0 && settings->error_rate <= 1.0;
+    } else if (strcmp(arg, "--error") == 0) {
+      if (strcmp(value, "overloaded") == 0) {
+        settings->error_code = mockssandra::ERROR_OVERLOADED;
+      } else if (strcmp(value, "server") == 0) {
+        settings->error_code = mockssandra::ERROR_SERVER_ERROR;
+      } else {
+        is_valid = false;
+      }
+    } else if (strcmp(arg, "--values") == 0) {
+      is_valid = parse_unsigned(value, &settings->num_values);
+    } else if (strcmp(arg, "--value-size") == 0) {
+      is_valid = parse_unsigned(value, &settings->value_size);
+    } else if (strcmp(arg, "--coalesce-delay") == 0) {
+      is_valid = parse_unsigned(value, &settings->coalesce_delay_us);
+    } else if (strcmp(arg, "--new-request-ratio") == 0) {
+      unsigned ratio = 0;
+      is_valid = parse_unsigned(value, &ratio) && ratio > 0 && ratio <= 100;
+      settings->new_request_ratio = static_cast<int>(ratio);
+    } else if (strcmp(arg, "--allocator-benchmark") == 0) {
+      is_valid = parse_unsigned(value, &settings->allocator_benchmark_ops);
+    } else if (strcmp(arg, "--task-queue-benchmark") == 0) {
+      is_valid = parse_unsigned(value, &settings->task_queue_benchmark_ops);
+    } else {
+      fprintf(stderr, "Unknown option '%s'\n", arg);
+      return false;
+    }
+    if (!is_valid) {
+      fprintf(stderr, "Invalid value '%s' for '%s'\n", value, arg);
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * Counts the allocations made through the driver's allocator. Allocations
+ * made on the mock server's threads are excluded so the counts reflect the
+ * driver and the application thread only.
+ */
+class AllocationCounter {
+public:
+  static void init() {
+    uv_key_create(&server_thread_key_);
+    cass_alloc_set_functions(counted_malloc, counted_realloc, counted_free);
+  }
+
+  static void mark_server_thread() { uv_key_set(&server_thread_key_, &server_thread_key_); }
+
+  static uint64_t mallocs() { return mallocs_.load(); }
+  static uint64_t frees() { return frees_.load(); }
+  static uint64_t bytes() { return bytes_.load(); }
+
+private:
+  static bool is_server_thread() { return uv_key_get(&server_thread_key_) != NULL; }
+
+  static void* counted_malloc(size_t size) {
+    if (!is_server_thread()) {
+      mallocs_.fetch_add(1, datastax::internal::MEMORY_ORDER_RELAXED);
+      bytes_.fetch_add(size, datastax::internal::MEMORY_ORDER_RELAXED);
+    }
+    return malloc(size);
+  }
+
+  static void* counted_realloc(void* ptr, size_t size) {
+    if (!is_server_thread()) {
+      mallocs_.fetch_add(1, datastax::internal::MEMORY_ORDER_RELAXED);
+      bytes_.fetch_add(size, datastax::internal::MEMORY_ORDER_RELAXED);
+      if (ptr != NULL) frees_.fetch_add(1, datastax::internal::MEMORY_ORDER_RELAXED);
+    }
+    return realloc(ptr, size);
+  }
+
+  static void counted_free(void* ptr) {
+    if (ptr != NULL && !is_server_thread()) {
+      frees_.fetch_add(1, datastax::internal::MEMORY_ORDER_RELAXED);
+    }
+    free(ptr);
+  }
+
+private:
+  static uv_key_t server_thread_key_;
+  static Atomic<uint64_t> mallocs_;
+  static Atomic<uint64_t> frees_;
+  static Atomic<uint64_t> bytes_;
+};
+
+uv_key_t AllocationCounter::server_thread_key_;
+Atomic<uint64_t> AllocationCounter::mallocs_(0);
+Atomic<uint64_t> AllocationCounter::frees_(0);
+Atomic<uint64_t> AllocationCounter::bytes_(0);
+
+/**
+ * Get the CPU time (in nanoseconds) of the calling thread or, if unsupported
+ * on the platform, the CPU time of the whole process.
+ */
+uint64_t thread_cpu_time_ns() {
+#ifdef HAVE_THREAD_CPU_TIME
+  struct timespec ts;
+  clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+  return static_cast<uint64_t>(ts.tv_sec) * 1000000000ULL + static_cast<uint64_t>(ts.tv_nsec);
+#else
+  return 0;
+#endif
+}
+
+uint64_t process_cpu_time_ns() {
+  uv_rusage_t usage;
+  if (uv_getrusage(&usage) != 0) return 0;
+  return (static_cast<uint64_t>(usage.ru_utime.tv_sec) + usage.ru_stime.tv_sec) * 1000000000ULL +
+         (static_cast<uint64_t>(usage.ru_utime.tv_usec) + usage.ru_stime.tv_usec) * 1000ULL;
+}
+
+/**
+ * A lock-free random number source that's safe to use from all the mock
+ * server threads (splitmix64 over a shared counter).
+ */
+uint64_t next_random() {
+  static Atomic<uint64_t> state(0x9E3779B97F4A7C15ULL);
+  uint64_t z = state.fetch_add(0x9E3779B97F4A7C15ULL, datastax::internal::MEMORY_ORDER_RELAXED);
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+  return z ^ (z >> 31);
+}
+
+double next_random_fraction() {
+  return static_cast<double>(next_random() >> 11) * (1.0 / 9007199254740992.0);
+}
+
+/**
+ * Delays the rest of the server's actions by a random latency in
+ * [min_ms, max_ms].
+ */
+struct InjectLatency : public mockssandra::Action {
+  InjectLatency(unsigned min_ms, unsigned max_ms)
+      : min_ms(min_ms)
+      , max_ms(max_ms) {}
+
+  virtual void on_run(mockssandra::Request* request) const {
+    uint64_t latency_ms = min_ms;
+    if (max_ms > min_ms) {
+      latency_ms += next_random() % (max_ms - min_ms + 1);
+    }
+    if (latency_ms > 0) {
+      request->wait(latency_ms, this);
+    } else {
+      run_next(request);
+    }
+  }
+
+  const unsigned min_ms;
+  const unsigned max_ms;
+};
+
+/**
+ * Fails a fraction of the requests with the provided error code.
+ */
+struct InjectError : public mockssandra::Action {
+  InjectError(double rate, int32_t code)
+      : rate(rate)
+      , code(code) {}
+
+  virtual void on_run(mockssandra::Request* request) const {
+    if (rate > 0.0 && next_random_fraction() < rate) {
+      request->error(code, "Injected error");
+    } else {
+      run_next(request);
+    }
+  }
+
+  const double rate;
+  const int32_t code;
+};
+
+class LoadRequestHandlerBuilder : public mockssandra::SimpleRequestHandlerBuilder {
+public:
+  LoadRequestHandlerBuilder(const Settings& settings) {
+    mockssandra::Action::Builder load_builder;
+    load_builder.execute(new InjectLatency(settings.latency_min_ms, settings.latency_max_ms))
+        .execute(new InjectError(settings.error_rate, settings.error_code))
+        .void_result();
+    on(mockssandra::OPCODE_QUERY)
+        .system_local()
+        .system_peers()
+        .is_query(LOAD_QUERY)
+        .then(load_builder)
+        .empty_rows_result(1);
+  }
+};
+
+/**
+ * Marks a mock server event loop thread so that its allocations are not
+ * counted and optionally records the thread's CPU time.
+ */
+class ServerThreadTask : public Task {
+public:
+  ServerThreadTask(uv_mutex_t* mutex, uv_cond_t* cond, size_t* remaining, uint64_t* cpu_time_ns)
+      : mutex_(mutex)
+      , cond_(cond)
+      , remaining_(remaining)
+      , cpu_time_ns_(cpu_time_ns) {}
+
+  virtual void run(EventLoop* event_loop) {
+    AllocationCounter::mark_server_thread();
+    ScopedMutex l(mutex_);
+    *cpu_time_ns_ += thread_cpu_time_ns();
+    if (--(*remaining_) == 0) uv_cond_signal(cond_);
+  }
+
+private:
+  uv_mutex_t* mutex_;
+  uv_cond_t* cond_;
+  size_t* remaining_;
+  uint64_t* cpu_time_ns_;
+};
+
+class LoadCluster : public mockssandra::Cluster {
+public:
+  LoadCluster(const mockssandra::RequestHandler* request_handler, size_t num_nodes,
+              size_t num_threads)
+      : factory_(request_handler, this)
+      , event_loop_group_(num_threads, "mockssandra") {
+    init(generator_, factory_, num_nodes, 0);
+  }
+
+  ~LoadCluster() { stop_all(); }
+
+  int start_all() { return Cluster::start_all(&event_loop_group_); }
+
+  /**
+   * Runs a task on every server thread and returns the total CPU time
+   * consumed by the server threads (if supported).
+   */
+  uint64_t server_threads_cpu_time_ns() {
+    uv_mutex_t mutex;
+    uv_cond_t cond;
+    uv_mutex_init(&mutex);
+    uv_cond_init(&cond);
+    size_t remaining = event_loop_group_.size();
+    uint64_t cpu_time_ns = 0;
+    for (size_t i = 0; i < event_loop_group_.size(); ++i) {
+      event_loop_group_.get(i)->add(new ServerThreadTask(&mutex, &cond, &remaining, &cpu_time_ns));
+    }
+    uv_mutex_lock(&mutex);
+    while (remaining > 0) {
+      uv_cond_wait(&cond, &mutex);
+    }
+    uv_mutex_unlock(&mutex);
+    uv_cond_destroy(&cond);
+    uv_mutex_destroy(&mutex);
+    return cpu_time_ns;
+  }
+
+private:
+  mockssandra::Ipv4AddressGenerator generator_;
+  mockssandra::ClientConnectionFactory factory_;
+  mockssandra::SimpleEventLoopGroup event_loop_group_;
+};
+
+/**
+ * Issues requests at a target rate (or as fast as the concurrency allows) and
+ * records their latencies.
+ */
+class LoadGenerator {
+public:
+  LoadGenerator(CassSession* session, const Settings& settings)
+      : session_(session)
+      , settings_(settings)
+      , value_(settings.value_size, 'x')
+      , is_recording_(false)
+      , completed_(0)
+      , errors_(0) {
+    uv_mutex_init(&mutex_);
+    uv_cond_init(&cond_);
+    uv_sem_init(&in_flight_, settings.concurrency);
+    hdr_init(1LL, 60LL * 1000LL * 1000LL, 3, &histogram_); // Microseconds up to 60 seconds
+  }
+
+  ~LoadGenerator() {
+    uv_sem_destroy(&in_flight_);
+    uv_cond_destroy(&cond_);
+    uv_mutex_destroy(&mutex_);
+    free(histogram_);
+  }
+
+  void run(uint64_t duration_ns, bool is_recording) {
+    is_recording_.store(is_recording, datastax::internal::MEMORY_ORDER_RELEASE);
+    const uint64_t interval_ns = settings_.rate > 0 ? 1000000000ULL / settings_.rate : 0;
+    const uint64_t start = uv_hrtime();
+    const uint64_t finish = start + duration_ns;
+    uint64_t scheduled = start;
+
+    for (uint64_t now = start; now < finish; now = uv_hrtime()) {
+      if (interval_ns > 0) {
+        wait_until(scheduled);
+      }
+      uv_sem_wait(&in_flight_);
+      // Latency is measured from the scheduled start to avoid hiding
+      // queuing delay (coordinated omission) when running at a fixed rate.
+      execute(interval_ns > 0 ? scheduled : uv_hrtime());
+      scheduled += interval_ns;
+    }
+
+    // Drain the in-flight requests
+    for (unsigned i = 0; i < settings_.concurrency; ++i) {
+      uv_sem_wait(&in_flight_);
+    }
+    for (unsigned i = 0; i < settings_.concurrency; ++i) {
+      uv_sem_post(&in_flight_);
+    }
+  }
+
+  void reset() {
+    ScopedMutex l(&mutex_);
+    hdr_reset(histogram_);
+    completed_ = 0;
+    errors_ = 0;
+  }
+
+  uint64_t completed() const { return completed_; }
+  uint64_t errors() const { return errors_; }
+  hdr_histogram* histogram() { return histogram_; }
+
+private:
+  struct RequestContext {
+    RequestContext(LoadGenerator* generator, uint64_t start)
+        : generator(generator)
+        , start(start) {}
+    LoadGenerator* generator;
+    uint64_t start;
+  };
+
+  void execute(uint64_t start) {
+    CassStatement* statement = cass_statement_new(LOAD_QUERY, settings_.num_values);
+    for (unsigned i = 0; i < settings_.num_values; ++i) {
+      cass_statement_bind_string_n(statement, i, value_.data(), value_.size());
+    }
+    cass_statement_set_is_idempotent(statement, cass_true);
+
+    CassFuture* future = cass_session_execute(session_, statement);
+    cass_future_set_callback(future, on_request_done, new RequestContext(this, start));
+    cass_future_free(future);
+    cass_statement_free(statement);
+  }
+
+  static void on_request_done(CassFuture* future, void* data) {
+    RequestContext* context = static_cast<RequestContext*>(data);
+    context->generator->handle_request_done(future, context->start);
+    delete context;
+  }
+
+  void handle_request_done(CassFuture* future, uint64_t start) {
+    const uint64_t latency_us = (uv_hrtime() - start) / 1000;
+    const bool is_error = cass_future_error_code(future) != CASS_OK;
+    if (is_recording_.load(datastax::internal::MEMORY_ORDER_ACQUIRE)) {
+      ScopedMutex l(&mutex_);
+      hdr_record_value(histogram_, static_cast<int64_t>(latency_us));
+      completed_++;
+      if (is_error) errors_++;
+    }
+    uv_sem_post(&in_flight_);
+  }
+
+  void wait_until(uint64_t deadline_ns) {
+    for (uint64_t now = uv_hrtime(); now < deadline_ns; now = uv_hrtime()) {
+      const uint64_t remaining_ns = deadline_ns - now;
+      if (remaining_ns > 2000000ULL) { // Sleep for anything over 2ms, otherwise spin
+        ScopedMutex l(&mutex_);
+        uv_cond_timedwait(&cond_, &mutex_, remaining_ns - 1000000ULL);
+      }
+    }
+  }
+
+private:
+  CassSession* session_;
+  const Settings settings_;
+  const String value_;
+  Atomic<bool> is_recording_; // Written by the main thread, read by the I/O threads
+  uv_mutex_t mutex_;
+  uv_cond_t cond_;
+  uv_sem_t in_flight_;
+  hdr_histogram* histogram_;
+  uint64_t completed_;
+  uint64_t errors_;
+};
+
+CassCluster* create_cluster(const Settings& settings) {
+  CassCluster* cluster = cass_cluster_new();
+  String contact_points;
+  for (unsigned i = 1; i <= settings.num_nodes; ++i) {
+    char address[32];
+    sprintf(address, "%s127.0.0.%u", i > 1 ? "," : "", i);
+    contact_points.append(address);
+  }
+  cass_cluster_set_contact_points(cluster, contact_points.c_str());
+  cass_cluster_set_num_threads_io(cluster, settings.num_io_threads);
+  cass_cluster_set_core_connections_per_host(cluster, settings.num_connections);
+  cass_cluster_set_queue_size_io(cluster, settings.concurrency * 2 > 8192
+                                              ? settings.concurrency * 2
+                                              : 8192);
+  cass_cluster_set_coalesce_delay(cluster, settings.coalesce_delay_us);
+  cass_cluster_set_new_request_ratio(cluster, settings.new_request_ratio);
+  cass_cluster_set_request_timeout(cluster, 60000);
+  cass_cluster_set_monitor_reporting_interval(cluster, 0);
+  cass_cluster_set_use_schema(cluster, cass_false); // The mock cluster has no schema
+  return cluster;
+}
+
+void print_report(LoadGenerator& generator, const Settings& settings, uint64_t elapsed_ns,
+                  uint64_t driver_cpu_ns, uint64_t loader_cpu_ns, uint64_t mallocs,
+                  uint64_t frees, uint64_t bytes) {
+  hdr_histogram* histogram = generator.histogram();
+  const uint64_t completed = generator.completed();
+  const double elapsed_secs = static_cast<double>(elapsed_ns) / 1e9;
+  const double per_request = completed > 0 ? 1.0 / static_cast<double>(completed) : 0.0;
+
+  printf("nodes=%u io_threads=%u connections=%u rate=%u concurrency=%u latency=%u:%ums "
+         "error_rate=%.4f values=%ux%uB\n",
+         settings.num_nodes, settings.num_io_threads, settings.num_connections, settings.rate,
+         settings.concurrency, settings.latency_min_ms, settings.latency_max_ms,
+         settings.error_rate, settings.num_values, settings.value_size);
+  printf("%-24s %12llu\n", "requests", static_cast<unsigned long long>(completed));
+  printf("%-24s %12llu\n", "errors", static_cast<unsigned long long>(generator.errors()));
+  printf("%-24s %12.1f\n", "throughput (req/s)", static_cast<double>(completed) / elapsed_secs);
+  printf("%-24s %12lld\n", "latency p50 (us)",
+         static_cast<long long>(hdr_value_at_percentile(histogram, 50.0)));
+  printf("%-24s %12lld\n", "latency p99 (us)",
+         static_cast<long long>(hdr_value_at_percentile(histogram, 99.0)));
+  printf("%-24s %12lld\n", "latency p999 (us)",
+         static_cast<long long>(hdr_value_at_percentile(histogram, 99.9)));
+  printf("%-24s %12lld\n", "latency max (us)", static_cast<long long>(hdr_max(histogram)));
+#ifdef HAVE_THREAD_CPU_TIME
+  printf("%-24s %12.2f\n", "driver cpu/req (us)",
+         static_cast<double>(driver_cpu_ns) / 1000.0 * per_request);
+  printf("%-24s %12.2f\n", "loader cpu/req (us)",
+         static_cast<double>(loader_cpu_ns) / 1000.0 * per_request);
+#else
+  printf("%-24s %12.2f (includes mock server)\n", "process cpu/req (us)",
+         static_cast<double>(driver_cpu_ns) / 1000.0 * per_request);
+#endif
+  printf("%-24s %12.2f\n", "allocs/req", static_cast<double>(mallocs) * per_request);
+  printf("%-24s %12.2f\n", "frees/req", static_cast<double>(frees) * per_request);
+  printf("%-24s %12.1f\n", "alloc bytes/req", static_cast<double>(bytes) * per_request);
+}
+
+/**
+ * Allocator microbenchmark: allocate/free pairs of request and response sized
+ * blocks using either the driver's allocator directly or the per-thread slab
+ * allocator. Blocks are freed either on the allocating thread or handed off to
+ * another thread (like responses freed on the application thread).
+ */
+const size_t ALLOCATOR_BATCH_SIZE = 256;
+const size_t ALLOCATOR_SIZES[] = { 48, 96, 160, 256, 480 };
+const size_t ALLOCATOR_NUM_SIZES = sizeof(ALLOCATOR_SIZES) / sizeof(ALLOCATOR_SIZES[0]);
+
+struct DriverAllocator {
+  static void* malloc(size_t size) { return Memory::malloc(size); }
+  static void free(void* ptr) { Memory::free(ptr); }
+};
+
+struct ThreadSlabAllocator {
+  static void* malloc(size_t size) { return SlabAllocator::malloc(size); }
+  static void free(void* ptr) { SlabAllocator::free(ptr); }
+};
+
+template <class A>
+void allocate_batch(void** ptrs, uint64_t offset) {
+  for (size_t i = 0; i < ALLOCATOR_BATCH_SIZE; ++i) {
+    ptrs[i] = A::malloc(ALLOCATOR_SIZES[(offset + i) % ALLOCATOR_NUM_SIZES]);
+  }
+}
+
+template <class A>
+void free_batch(void** ptrs) {
+  for (size_t i = 0; i < ALLOCATOR_BATCH_SIZE; ++i) {
+    A::free(ptrs[i]);
+  }
+}
+
+template <class A>
+void run_local_frees(uint64_t ops) {
+  void* ptrs[ALLOCATOR_BATCH_SIZE];
+  for (uint64_t n = 0; n < ops; n += ALLOCATOR_BATCH_SIZE) {
+    allocate_batch<A>(ptrs, n);
+    free_batch<A>(ptrs);
+  }
+}
+
+template <class A>
+class RemoteFreer {
+public:
+  RemoteFreer()
+      : ptrs_(NULL)
+      , is_stopped_(false) {
+    uv_sem_init(&ready_, 0);
+    uv_sem_init(&done_, 1);
+    uv_thread_create(&thread_, on_run, this);
+  }
+
+  ~RemoteFreer() {
+    uv_sem_wait(&done_);
+    is_stopped_ = true;
+    uv_sem_post(&ready_);
+    uv_thread_join(&thread_);
+    uv_sem_destroy(&ready_);
+    uv_sem_destroy(&done_);
+  }
+
+  // Waits for the previous batch to be freed then hands off the next one.
+  void free_batch(void** ptrs) {
+    uv_sem_wait(&done_);
+    ptrs_ = ptrs;
+    uv_sem_post(&ready_);
+  }
+
+private:
+  static void on_run(void* arg) {
+    RemoteFreer* freer = static_cast<RemoteFreer*>(arg);
+    while (true) {
+      uv_sem_wait(&freer->ready_);
+      if (freer->is_stopped_) break;
+      ::free_batch<A>(freer->ptrs_);
+      uv_sem_post(&freer->done_);
+    }
+  }
+
+private:
+  uv_thread_t thread_;
+  uv_sem_t ready_;
+  uv_sem_t done_;
+  void** ptrs_;
+  bool is_stopped_;
+};
+
+template <class A>
+void run_remote_frees(uint64_t ops) {
+  void* ptrs[2][ALLOCATOR_BATCH_SIZE];
+  RemoteFreer<A> freer;
+  int index = 0;
+  for (uint64_t n = 0; n < ops; n += ALLOCATOR_BATCH_SIZE, index ^= 1) {
+    allocate_batch<A>(ptrs[index], n);
+    freer.free_batch(ptrs[index]);
+  }
+}
+
+void run_allocator_case(const char* name, void (*run)(uint64_t), uint64_t ops) {
+  const uint64_t mallocs_start = AllocationCounter::mallocs();
+  const uint64_t frees_start = AllocationCounter::frees();
+  const uint64_t start = uv_hrtime();
+
+  run(ops);
+
+  const double elapsed_secs = static_cast<double>(uv_hrtime() - start) / 1e9;
+  const double per_op = 1.0 / static_cast<double>(ops);
+  printf("%-24s %12.0f ops/s %10.4f allocs/op %10.4f frees/op\n", name,
+         static_cast<double>(ops) / elapsed_secs,
+         static_cast<double>(AllocationCounter::mallocs() - mallocs_start) * per_op,
+         static_cast<double>(AllocationCounter::frees() - frees_start) * per_op);
+}
+
+void run_allocator_benchmark(uint64_t ops) {
+  // The benchmark thread acts as an event loop thread.
+  SlabAllocator* allocator = new SlabAllocator();
+  LoopContext context;
+  context.allocator = allocator;
+  LoopContext::set_current(&context);
+
+  run_allocator_case("driver (local free)", run_local_frees<DriverAllocator>, ops);
+  run_allocator_case("slab (local free)", run_local_frees<ThreadSlabAllocator>, ops);
+  run_allocator_case("driver (remote free)", run_remote_frees<DriverAllocator>, ops);
+  run_allocator_case("slab (remote free)", run_remote_frees<ThreadSlabAllocator>, ops);
+
+  LoopContext::set_current(NULL);
+  allocator->release();
+}
+
+/**
+ * Task queue microbenchmark: producer threads add tasks to a single consumer
+ * thread, like the cluster and session threads adding tasks to an event loop.
+ * The event loop's lock-free queue is compared to a mutex protected deque (the
+ * event loop's previous queue).
+ */
+class NopTask : public Task {
+public:
+  virtual void run(EventLoop* event_loop) {}
+};
+
+class MutexTaskQueue {
+public:
+  MutexTaskQueue() { uv_mutex_init(&lock_); }
+  ~MutexTaskQueue() { uv_mutex_destroy(&lock_); }
+
+  void enqueue(Task* task) {
+    ScopedMutex l(&lock_);
+    queue_.push_back(task);
+  }
+
+  bool dequeue(Task*& task) {
+    ScopedMutex l(&lock_);
+    if (queue_.empty()) return false;
+    task = queue_.front();
+    queue_.pop_front();
+    return true;
+  }
+
+private:
+  uv_mutex_t lock_;
+  Deque<Task*> queue_;
+};
+
+template <class Q>
+class TaskQueueProducer {
+public:
+  TaskQueueProducer(Q* queue, uint64_t ops, Atomic<bool>* is_started)
+      : queue_(queue)
+      , tasks_(new NopTask[ops])
+      , ops_(ops)
+      , is_started_(is_started) {}
+
+  ~TaskQueueProducer() { delete[] tasks_; }
+
+  int start() { return uv_thread_create(&thread_, on_run, this); }
+  void join() { uv_thread_join(&thread_); }
+
+private:
+  static void on_run(void* arg) {
+    TaskQueueProducer* producer = static_cast<TaskQueueProducer*>(arg);
+    while (!producer->is_started_->load()) {
+    }
+    for (uint64_t i = 0; i < producer->ops_; ++i) {
+      producer->queue_->enqueue(&producer->tasks_[i]);
+    }
+  }
+
+private:
+  uv_thread_t thread_;
+  Q* queue_;
+  NopTask* tasks_; // Preallocated so only the queue is measured
+  uint64_t ops_;
+  Atomic<bool>* is_started_;
+};
+
+template <class Q>
+void run_task_queue_case(const char* name, unsigned num_producers, uint64_t ops) {
+  Q queue;
+  Atomic<bool> is_started(false);
+  const uint64_t ops_per_producer = ops / num_producers;
+
+  Vector<TaskQueueProducer<Q>*> producers;
+  for (unsigned i = 0; i < num_producers; ++i) {
+    producers.push_back(new TaskQueueProducer<Q>(&queue, ops_per_producer, &is_started));
+    producers.back()->start();
+  }
+
+  const uint64_t total = ops_per_producer * num_producers;
+  const uint64_t start = uv_hrtime();
+  is_started.store(true);
+
+  uint64_t count = 0;
+  Task* task;
+  while (count < total) {
+    if (queue.dequeue(task)) count++;
+  }
+
+  const double elapsed_secs = static_cast<double>(uv_hrtime() - start) / 1e9;
+  for (unsigned i = 0; i < num_producers; ++i) {
+    producers[i]->join();
+    delete producers[i];
+  }
+
+  printf("%-12s %2u producer(s) %14.0f tasks/s\n", name, num_producers,
+         static_cast<double>(total) / elapsed_secs);
+}
+
+void run_task_queue_benchmark(uint64_t ops) {
+  const unsigned num_producers[] = { 1, 2, 4, 8 };
+  for (size_t i = 0; i < sizeof(num_producers) / sizeof(num_producers[0]); ++i) {
+    run_task_queue_case<MutexTaskQueue>("mutex", num_producers[i], ops);
+    run_task_queue_case<MPSCQueue<Task> >("lock-free", num_producers[i], ops);
+  }
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+  Settings settings;
+  if (!parse_settings(argc, argv, &settings)) {
+    print_usage(argv[0]);
+    return 1;
+  }
+
+  // This must happen before anything is allocated by the driver
+  AllocationCounter::init();
+  cass_log_set_level(CASS_LOG_ERROR); // Injected errors are logged as warnings
+
+  if (settings.allocator_benchmark_ops > 0) {
+    run_allocator_benchmark(settings.allocator_benchmark_ops);
+    return 0;
+  }
+
+  if (settings.task_queue_benchmark_ops > 0) {
+    run_task_queue_benchmark(settings.task_queue_benchmark_ops);
+    return 0;
+  }
+
+  LoadRequestHandlerBuilder builder(settings);
+  LoadCluster cluster(builder.build(), settings.num_nodes, settings.num_server_threads);
+  if (cluster.start_all() != 0) {
+    fprintf(stderr, "Unable to start the mock cluster\n");
+    return 1;
+  }
+  cluster.server_threads_cpu_time_ns(); // Mark the server threads
+
+  CassCluster* cass_cluster = create_cluster(settings);
+  CassSession* session = cass_session_new();
+
+  CassFuture* connect_future = cass_session_connect(session, cass_cluster);
+  CassError rc = cass_future_error_code(connect_future);
+  cass_future_free(connect_future);
+  if (rc != CASS_OK) {
+    fprintf(stderr, "Unable to connect: %s\n", cass_error_desc(rc));
+    cass_session_free(session);
+    cass_cluster_free(cass_cluster);
+    return 1;
+  }
+
+  {
+    LoadGenerator generator(session, settings);
+
+    if (settings.warmup_secs > 0) {
+      generator.run(settings.warmup_secs * 1000000000ULL, false);
+    }
+    generator.reset();
+
+    const uint64_t server_cpu_start = cluster.server_threads_cpu_time_ns();
+    const uint64_t loader_cpu_start = thread_cpu_time_ns();
+    const uint64_t process_cpu_start = process_cpu_time_ns();
+    const uint64_t mallocs_start = AllocationCounter::mallocs();
+    const uint64_t frees_start = AllocationCounter::frees();
+    const uint64_t bytes_start = AllocationCounter::bytes();
+    const uint64_t start = uv_hrtime();
+
+    generator.run(settings.duration_secs * 1000000000ULL, true);
+
+    const uint64_t elapsed = uv_hrtime() - start;
+    const uint64_t mallocs = AllocationCounter::mallocs() - mallocs_start;
+    const uint64_t frees = AllocationCounter::frees() - frees_start;
+    const uint64_t bytes = AllocationCounter::bytes() - bytes_start;
+    const uint64_t loader_cpu = thread_cpu_time_ns() - loader_cpu_start;
+    uint64_t driver_cpu = process_cpu_time_ns() - process_cpu_start;
+#ifdef HAVE_THREAD_CPU_TIME
+    // Only attribute the driver's I/O threads, not the mock server threads or
+    // the loader thread (pacing, building statements and calling execute).
+    const uint64_t server_cpu = cluster.server_threads_cpu_time_ns() - server_cpu_start;
+    driver_cpu = driver_cpu > server_cpu + loader_cpu ? driver_cpu - server_cpu - loader_cpu : 0;
+#else
+    (void)server_cpu_start;
+#endif
+
+    print_report(generator, settings, elapsed, driver_cpu, loader_cpu, mallocs, frees, bytes);
+  }
+
+  CassFuture* close_future = cass_session_close(session);
+  cass_future_wait(close_future);
+  cass_future_free(close_future);
+  cass_session_free(session);
+  cass_cluster_free(cass_cluster);
+
+  return 0;
+}
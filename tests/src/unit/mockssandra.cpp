@@ -50,6 +50,8 @@ using datastax::internal::core::UuidGen;
 #define DSE_VERSION "6.7.1"
 #define DSE_CASSANDRA_VERSION "4.0.0.671"
 
+static const CassUuid SCHEMA_VERSION = { 0x3ea7e2e0b3b511eaULL, 0x8e2f00163e0af1d2ULL };
+
 #if defined(OPENSSL_VERSION_NUMBER) && \
     !defined(LIBRESSL_VERSION_NUMBER) // Required as OPENSSL_VERSION_NUMBER for LibreSSL is defined
                                       // as 2.0.0
@@ -1619,6 +1621,7 @@ void SystemLocal::on_run(Request* request) const {
                              .column("rpc_address", Type::inet())
                              .column("partitioner", Type::text())
                              .column("tokens", Type::list(Type::text()))
+                             .column("schema_version", Type::uuid())
                              .row(Row::Builder()
                                       .text(request->client()->server()->address().to_string())
                                       .text(host.dc)
@@ -1627,6 +1630,7 @@ void SystemLocal::on_run(Request* request) const {
                                       .inet(request->client()->server()->address())
                                       .text(host.partitioner)
                                       .collection(Collection::text(host.tokens))
+                                      .uuid(SCHEMA_VERSION)
                                       .build())
                              .build();
 
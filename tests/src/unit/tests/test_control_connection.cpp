@@ -20,6 +20,7 @@
 
 #include "constants.hpp"
 #include "control_connector.hpp"
+#include "metrics.hpp"
 
 #ifdef WIN32
 #undef STATUS_TIMEOUT
@@ -210,15 +211,16 @@ public:
 
   struct EventListener : public RecordingControlConnectionListener {
   public:
-    EventListener(mockssandra::SimpleCluster* cluster)
+    EventListener(mockssandra::SimpleCluster* cluster, int expected_updates = -1)
         : remaining_(0)
+        , expected_updates_(expected_updates)
         , cluster_(cluster) {}
 
     void add_event(const mockssandra::Event::Ptr& event) { events_.push_back(event); }
 
     void trigger_events(const ControlConnection::Ptr& connection) {
       connection_ = connection;
-      remaining_ = events_.size();
+      remaining_ = expected_updates_ >= 0 ? expected_updates_ : events_.size();
       for (Vector<mockssandra::Event::Ptr>::const_iterator it = events_.begin(),
                                                            end = events_.end();
            it != end; ++it) {
@@ -263,6 +265,7 @@ public:
   private:
     Vector<mockssandra::Event::Ptr> events_;
     int remaining_;
+    int expected_updates_;
     mockssandra::SimpleCluster* cluster_;
     ControlConnection::Ptr connection_;
   };
@@ -539,6 +542,267 @@ TEST_F(ControlConnectionUnitTest, SchemaChangeEvents) {
   EXPECT_EQ("aggregate1(varchar)", event12.target_name);
 }
 
+TEST_F(ControlConnectionUnitTest, DebouncedTopologyChangeEvents) {
+  mockssandra::SimpleCluster cluster(simple(), 3);
+  ASSERT_EQ(cluster.start_all(), 0);
+
+  Address address1("127.0.0.1", PORT);
+  Address address2("127.0.0.2", PORT);
+  Address address3("127.0.0.3", PORT);
+
+  // The new nodes are added using a single peers query and the status events
+  // for the same node are coalesced into its latest status.
+  EventListener listener(&cluster, 3);
+
+  listener.add_event(TopologyChangeEvent::new_node(address2));
+  listener.add_event(TopologyChangeEvent::new_node(address3));
+  listener.add_event(TopologyChangeEvent::moved_node(address3));
+  listener.add_event(StatusChangeEvent::up(address2));
+  listener.add_event(StatusChangeEvent::down(address2));
+
+  ControlConnectionSettings settings;
+  settings.topology_event_debounce_window_ms = 100;
+
+  Metrics metrics(1, 0);
+
+  ControlConnector::Ptr connector(
+      new ControlConnector(Host::Ptr(new Host(address1)), PROTOCOL_VERSION,
+                           bind_callback(on_connection_event, &listener)));
+  connector->with_settings(settings)
+      ->with_listener(&listener)
+      ->with_metrics(&metrics)
+      ->connect(loop());
+
+  uv_run(loop(), UV_RUN_DEFAULT);
+
+  ASSERT_EQ(3u, listener.events().size());
+  EXPECT_EQ(RecordedEvent::NODE_DOWN, listener.find_event(RecordedEvent::NODE_DOWN).type);
+  EXPECT_EQ(RecordedEvent::INVALID, listener.find_event(RecordedEvent::NODE_UP).type);
+
+  int added = 0;
+  for (RecordedEventVec::const_iterator it = listener.events().begin(),
+                                        end = listener.events().end();
+       it != end; ++it) {
+    if (it->type == RecordedEvent::NODE_ADDED) {
+      EXPECT_TRUE(it->host->address() == address2 || it->host->address() == address3);
+      EXPECT_GT(it->host->tokens().size(), 0u);
+      ++added;
+    }
+  }
+  EXPECT_EQ(2, added);
+
+  // Five events were handled using a peers query and a status update
+  EXPECT_EQ(3, metrics.coalesced_topology_events.sum());
+  EXPECT_EQ(0, metrics.coalesced_schema_events.sum());
+}
+
+TEST_F(ControlConnectionUnitTest, DebouncedStatusAfterNewNode) {
+  mockssandra::SimpleCluster cluster(simple(), 2);
+  ASSERT_EQ(cluster.start_all(), 0);
+
+  Address address1("127.0.0.1", PORT);
+  Address address2("127.0.0.2", PORT);
+
+  // The status of a new node is only applied after the node has been added
+  EventListener listener(&cluster);
+
+  listener.add_event(TopologyChangeEvent::new_node(address2));
+  listener.add_event(StatusChangeEvent::down(address2));
+
+  ControlConnectionSettings settings;
+  settings.topology_event_debounce_window_ms = 100;
+
+  ControlConnector::Ptr connector(
+      new ControlConnector(Host::Ptr(new Host(address1)), PROTOCOL_VERSION,
+                           bind_callback(on_connection_event, &listener)));
+  connector->with_settings(settings)->with_listener(&listener)->connect(loop());
+
+  uv_run(loop(), UV_RUN_DEFAULT);
+
+  ASSERT_EQ(2u, listener.events().size());
+  EXPECT_EQ(RecordedEvent::NODE_ADDED, listener.events()[0].type);
+  EXPECT_EQ(address2, listener.events()[0].host->address());
+  EXPECT_EQ(RecordedEvent::NODE_DOWN, listener.events()[1].type);
+  EXPECT_EQ(address2, listener.events()[1].host->address());
+}
+
+TEST_F(ControlConnectionUnitTest, DebouncedSchemaChangeEvents) {
+  mockssandra::SimpleCluster cluster(simple());
+  ASSERT_EQ(cluster.start_all(), 0);
+
+  Address address("127.0.0.1", PORT);
+
+  // The table events are coalesced into a single refresh of all the keyspace's
+  // tables (and views) and the dropped type is no longer refreshed.
+  EventListener listener(&cluster, 4);
+
+  listener.add_event(SchemaChangeEvent::table(SchemaChangeEvent::CREATED, "keyspace1", "table1"));
+  listener.add_event(SchemaChangeEvent::table(SchemaChangeEvent::UPDATED, "keyspace1", "table2"));
+  listener.add_event(SchemaChangeEvent::table(SchemaChangeEvent::UPDATED, "keyspace1", "table1"));
+  listener.add_event(
+      SchemaChangeEvent::user_type(SchemaChangeEvent::UPDATED, "keyspace1", "type1"));
+  listener.add_event(
+      SchemaChangeEvent::user_type(SchemaChangeEvent::DROPPED, "keyspace1", "type1"));
+  listener.add_event(SchemaChangeEvent::keyspace(SchemaChangeEvent::UPDATED, "keyspace2"));
+
+  ControlConnectionSettings settings;
+  settings.schema_event_debounce_window_ms = 100;
+
+  Metrics metrics(1, 0);
+
+  ControlConnector::Ptr connector(
+      new ControlConnector(Host::Ptr(new Host(address)), PROTOCOL_VERSION,
+                           bind_callback(on_connection_event, &listener)));
+  connector->with_settings(settings)
+      ->with_listener(&listener)
+      ->with_metrics(&metrics)
+      ->connect(loop());
+
+  uv_run(loop(), UV_RUN_DEFAULT);
+
+  const RecordedEvent& event1 = listener.find_event(RecordedEvent::USER_TYPE_DROPPED);
+  EXPECT_EQ("keyspace1", event1.keyspace_name);
+  EXPECT_EQ("type1", event1.target_name);
+
+  const RecordedEvent& event2 = listener.find_event(RecordedEvent::TABLE_UPDATED);
+  EXPECT_EQ("keyspace1", event2.keyspace_name);
+  EXPECT_TRUE(event2.target_name.empty());
+  EXPECT_TRUE(event2.result);
+
+  const RecordedEvent& event3 = listener.find_event(RecordedEvent::KEYSPACE_UPDATED);
+  EXPECT_EQ("keyspace2", event3.keyspace_name);
+
+  EXPECT_EQ(RecordedEvent::INVALID, listener.find_event(RecordedEvent::USER_TYPE_UPDATED).type);
+
+  // Five events were handled using two refreshes
+  EXPECT_EQ(3, metrics.coalesced_schema_events.sum());
+  EXPECT_EQ(0, metrics.coalesced_topology_events.sum());
+}
+
+TEST_F(ControlConnectionUnitTest, MetadataCacheFile) {
+  mockssandra::SimpleCluster cluster(simple());
+  ASSERT_EQ(cluster.start_all(), 0);
+
+  const char* path = "control_connection_metadata_cache.bin";
+  remove(path);
+
+  ControlConnectionSettings settings;
+  settings.metadata_cache_file = path;
+
+  // The first connection queries the schema and creates the cache file, then
+  // the following connection uses the cached schema.
+  for (int i = 0; i < 2; ++i) {
+    bool is_connected = false;
+    ControlConnector::Ptr connector(
+        new ControlConnector(Host::Ptr(new Host(Address("127.0.0.1", PORT))), PROTOCOL_VERSION,
+                             bind_callback(on_connection_connected, &is_connected)));
+    connector->with_settings(settings)->connect(loop());
+
+    uv_run(loop(), UV_RUN_DEFAULT);
+
+    ASSERT_TRUE(is_connected);
+    EXPECT_EQ(i == 1, connector->is_schema_from_cache());
+    ASSERT_TRUE(connector->schema().keyspaces);
+    EXPECT_EQ(1, connector->schema().keyspaces->row_count());
+    ASSERT_TRUE(connector->schema().tables);
+    EXPECT_EQ(1, connector->schema().tables->row_count());
+  }
+
+  { // The cache file isn't used when the schema queries are different
+    ControlConnectionSettings token_aware_only(settings);
+    token_aware_only.use_schema = false;
+
+    bool is_connected = false;
+    ControlConnector::Ptr connector(
+        new ControlConnector(Host::Ptr(new Host(Address("127.0.0.1", PORT))), PROTOCOL_VERSION,
+                             bind_callback(on_connection_connected, &is_connected)));
+    connector->with_settings(token_aware_only)->connect(loop());
+
+    uv_run(loop(), UV_RUN_DEFAULT);
+
+    ASSERT_TRUE(is_connected);
+    EXPECT_FALSE(connector->is_schema_from_cache());
+    EXPECT_FALSE(connector->schema().tables);
+  }
+
+  { // A corrupt cache file is ignored
+    FILE* file = fopen(path, "r+b");
+    ASSERT_TRUE(file != NULL);
+    fseek(file, 32, SEEK_SET);
+    fputc('x', file);
+    fclose(file);
+
+    ControlConnectionSettings token_aware_only(settings);
+    token_aware_only.use_schema = false;
+
+    bool is_connected = false;
+    ControlConnector::Ptr connector(
+        new ControlConnector(Host::Ptr(new Host(Address("127.0.0.1", PORT))), PROTOCOL_VERSION,
+                             bind_callback(on_connection_connected, &is_connected)));
+    connector->with_settings(token_aware_only)->connect(loop());
+
+    uv_run(loop(), UV_RUN_DEFAULT);
+
+    ASSERT_TRUE(is_connected);
+    EXPECT_FALSE(connector->is_schema_from_cache());
+  }
+
+  remove(path);
+}
+
+TEST_F(ControlConnectionUnitTest, KnownSchemaVersion) {
+  mockssandra::SimpleCluster cluster(simple());
+  ASSERT_EQ(cluster.start_all(), 0);
+
+  String schema_version;
+  { // The full schema is retrieved if the schema version isn't known
+    bool is_connected = false;
+    ControlConnector::Ptr connector(
+        new ControlConnector(Host::Ptr(new Host(Address("127.0.0.1", PORT))), PROTOCOL_VERSION,
+                             bind_callback(on_connection_connected, &is_connected)));
+    connector->connect(loop());
+
+    uv_run(loop(), UV_RUN_DEFAULT);
+
+    ASSERT_TRUE(is_connected);
+    EXPECT_FALSE(connector->is_schema_unchanged());
+    EXPECT_TRUE(connector->schema().tables);
+    schema_version = connector->schema().schema_version;
+    EXPECT_EQ(16u, schema_version.size());
+  }
+
+  { // Only the keyspaces are retrieved if the schema version hasn't changed
+    bool is_connected = false;
+    ControlConnector::Ptr connector(
+        new ControlConnector(Host::Ptr(new Host(Address("127.0.0.1", PORT))), PROTOCOL_VERSION,
+                             bind_callback(on_connection_connected, &is_connected)));
+    connector->with_known_schema_version(schema_version)->connect(loop());
+
+    uv_run(loop(), UV_RUN_DEFAULT);
+
+    ASSERT_TRUE(is_connected);
+    EXPECT_TRUE(connector->is_schema_unchanged());
+    EXPECT_TRUE(connector->schema().keyspaces);
+    EXPECT_FALSE(connector->schema().tables);
+    EXPECT_FALSE(connector->schema().columns);
+    EXPECT_EQ(schema_version, connector->schema().schema_version);
+  }
+
+  { // The full schema is retrieved if the schema version is different
+    bool is_connected = false;
+    ControlConnector::Ptr connector(
+        new ControlConnector(Host::Ptr(new Host(Address("127.0.0.1", PORT))), PROTOCOL_VERSION,
+                             bind_callback(on_connection_connected, &is_connected)));
+    connector->with_known_schema_version("0123456789abcdef")->connect(loop());
+
+    uv_run(loop(), UV_RUN_DEFAULT);
+
+    ASSERT_TRUE(is_connected);
+    EXPECT_FALSE(connector->is_schema_unchanged());
+    EXPECT_TRUE(connector->schema().tables);
+  }
+}
+
 TEST_F(ControlConnectionUnitTest, EventDuringStartup) {
   Address address("127.0.0.1", PORT);
 
@@ -20,6 +20,8 @@
 
 #include "decoder.hpp"
 #include "logger.hpp"
+#include "result_response.hpp"
+#include "row.hpp"
 
 using namespace datastax;
 using namespace datastax::internal;
@@ -41,6 +43,7 @@ public:
   void SetUp() {
     failure_logged_ = false;
     warning_logged_ = false;
+    row_failure_logged_ = false;
     cass_log_set_level(CASS_LOG_WARN);
     Logger::set_callback(DecoderUnitTest::log, NULL);
   }
@@ -52,15 +55,19 @@ public:
     } else if (message->severity == CASS_LOG_WARN &&
                function.find("Decoder::") != std::string::npos) {
       warning_logged_ = true;
+    } else if (message->severity == CASS_LOG_ERROR && function.find("Row::") != std::string::npos) {
+      row_failure_logged_ = true;
     }
   }
 
   static bool warning_logged_;
   static bool failure_logged_;
+  static bool row_failure_logged_;
 };
 
 bool DecoderUnitTest::failure_logged_ = false;
 bool DecoderUnitTest::warning_logged_ = false;
+bool DecoderUnitTest::row_failure_logged_ = false;
 
 TEST_F(DecoderUnitTest, DecodeByte) {
   const signed char input[2] = { -1, 0 };
@@ -1004,3 +1011,95 @@ TEST_F(DecoderUnitTest, DecodeWarnings) {
   ASSERT_FALSE(decoder.decode_warnings(value));
   ASSERT_TRUE(failure_logged_);
 }
+
+TEST_F(DecoderUnitTest, DecodeNextRowLazy) {
+  const char input[] = { 0, 0, 0, 4, 0, 0, 0, 1,                 // Row 1: [int] 1
+                         0, 0, 0, 2, 'a', 'b',                   //        [text] "ab"
+                         -1, -1, -1, -1,                         //        null
+                         0, 0, 0, 4, 0, 0, 0, 2,                 // Row 2: [int] 2
+                         0, 0, 0, 0,                             //        [text] ""
+                         0, 0, 0, 4, 0, 0, 0, 3 };               //        [int] 3
+  TestDecoder decoder(input, sizeof(input));
+
+  DataType::ConstPtr int_type(new DataType(CASS_VALUE_TYPE_INT));
+  DataType::ConstPtr text_type(new DataType(CASS_VALUE_TYPE_TEXT));
+  Row row;
+  row.values.push_back(Value(int_type));
+  row.values.push_back(Value(text_type));
+  row.values.push_back(Value(int_type));
+
+  ASSERT_TRUE(decode_next_row_lazy(decoder, row));
+  ASSERT_EQ(20u, decoder.remaining());
+  EXPECT_EQ("ab", row.get_column(1)->decoder().as_string());
+  EXPECT_EQ(1, row.get_column(0)->as_int32());
+  EXPECT_TRUE(row.get_column(2)->is_null());
+
+  ASSERT_TRUE(decode_next_row_lazy(decoder, row));
+  ASSERT_EQ(0u, decoder.remaining());
+  EXPECT_EQ(3, row.get_column(2)->as_int32());
+  EXPECT_EQ(0, row.get_column(1)->size());
+  EXPECT_EQ(2, row.get_column(0)->as_int32());
+
+  // Truncated value
+  TestDecoder truncated(input, 10);
+  ASSERT_FALSE(decode_next_row_lazy(truncated, row));
+  ASSERT_TRUE(failure_logged_);
+}
+
+TEST_F(DecoderUnitTest, LazyResultIterator) {
+  const char input[] = { 0, 0, 0, 2,                             // Kind: rows
+                         0, 0, 0, 1,                             // Flags: global table spec
+                         0, 0, 0, 3,                             // Column count
+                         0, 2, 'k', 's', 0, 1, 't',              // Keyspace and table
+                         0, 1, 'k', 0, 0x09,                     // k int
+                         0, 1, 'v', 0, 0x0D,                     // v varchar
+                         0, 1, 'l', 0, 0x20, 0, 0x09,            // l list<int>
+                         0, 0, 0, 3,                             // Row count
+                         0, 0, 0, 4, 0, 0, 0, 1,                 // Row 1: [int] 1
+                         0, 0, 0, 2, 'a', 'b',                   //        [varchar] "ab"
+                         0, 0, 0, 12, 0, 0, 0, 1,                //        [list<int>] [7]
+                         0, 0, 0, 4, 0, 0, 0, 7,                 //
+                         -1, -1, -1, -1,                         // Row 2: null
+                         0, 0, 0, 0,                             //        [varchar] ""
+                         -1, -1, -1, -1,                         //        null
+                         0, 0, 0, 4, 0, 0, 0, 3,                 // Row 3: [int] 3
+                         0, 0, 0, 1, 'c',                        //        [varchar] "c"
+                         0, 0, 0, 2, 0, 0 };                     //        [list<int>] Truncated
+  TestDecoder decoder(input, sizeof(input), ProtocolVersion(CASS_PROTOCOL_VERSION_V4));
+  ResultResponse result;
+  ASSERT_TRUE(result.decode(decoder));
+  ASSERT_EQ(3, result.row_count());
+
+  CassIterator* iterator = cass_iterator_from_result_lazy(CassResult::to(&result));
+  const char* str;
+  size_t str_length;
+  cass_int32_t int_value;
+
+  ASSERT_TRUE(cass_iterator_next(iterator));
+  const CassRow* row = cass_iterator_get_row(iterator);
+  EXPECT_EQ(1u, cass_value_item_count(cass_row_get_column(row, 2)));
+  EXPECT_EQ(CASS_OK, cass_value_get_string(cass_row_get_column(row, 1), &str, &str_length));
+  EXPECT_EQ("ab", std::string(str, str_length));
+  EXPECT_EQ(CASS_OK, cass_value_get_int32(cass_row_get_column(row, 0), &int_value));
+  EXPECT_EQ(1, int_value);
+
+  ASSERT_TRUE(cass_iterator_next(iterator));
+  row = cass_iterator_get_row(iterator);
+  EXPECT_TRUE(cass_value_is_null(cass_row_get_column(row, 2)));
+  EXPECT_TRUE(cass_value_is_null(cass_row_get_column(row, 0)));
+  EXPECT_EQ(CASS_OK, cass_value_get_string(cass_row_get_column(row, 1), &str, &str_length));
+  EXPECT_EQ(0u, str_length);
+  EXPECT_FALSE(cass_value_is_null(cass_row_get_column(row, 1)));
+
+  ASSERT_TRUE(cass_iterator_next(iterator));
+  row = cass_iterator_get_row(iterator);
+  EXPECT_EQ(CASS_OK, cass_value_get_string(cass_row_get_column(row, 1), &str, &str_length));
+  EXPECT_EQ("c", std::string(str, str_length));
+  EXPECT_TRUE(cass_row_get_column(row, 2) == NULL);
+  EXPECT_TRUE(row_failure_logged_);
+  EXPECT_EQ(CASS_OK, cass_value_get_int32(cass_row_get_column(row, 0), &int_value));
+  EXPECT_EQ(3, int_value);
+
+  EXPECT_FALSE(cass_iterator_next(iterator));
+  cass_iterator_free(iterator);
+}
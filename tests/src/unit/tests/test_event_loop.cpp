@@ -187,3 +187,75 @@ TEST_F(EventLoopUnitTest, IoTimeElapsed) {
    * io_time_elapsed() using a uv_prepare_t on the same uv_run() iteration.
    */
 }
+
+class CountTask : public Task {
+public:
+  CountTask(Atomic<int>* count)
+      : count_(count) {}
+  virtual void run(EventLoop* event_loop) { count_->fetch_add(1); }
+
+private:
+  Atomic<int>* count_;
+};
+
+struct AddTasksArg {
+  EventLoop* event_loop;
+  Atomic<int>* count;
+  int num_tasks;
+};
+
+static void add_tasks(void* data) {
+  AddTasksArg* arg = static_cast<AddTasksArg*>(data);
+  for (int i = 0; i < arg->num_tasks; ++i) {
+    arg->event_loop->add(new CountTask(arg->count));
+  }
+}
+
+TEST_F(EventLoopUnitTest, AddTasksConcurrently) {
+  EventLoop event_loop;
+  ASSERT_EQ(0, event_loop.init("EventLoopUnitTest::AddTasksConcurrently"));
+  ASSERT_EQ(0, event_loop.run());
+
+  const int num_threads = 4;
+  const int num_tasks = 10000;
+  Atomic<int> count(0);
+  AddTasksArg arg = { &event_loop, &count, num_tasks };
+
+  uv_thread_t threads[num_threads];
+  for (int i = 0; i < num_threads; ++i) {
+    ASSERT_EQ(0, uv_thread_create(&threads[i], add_tasks, &arg));
+  }
+  for (int i = 0; i < num_threads; ++i) {
+    uv_thread_join(&threads[i]);
+  }
+
+  // All the tasks are run without closing the loop (which would wake it up)
+  for (int i = 0; i < 1000 && count.load() < num_threads * num_tasks; ++i) {
+    test::Utils::msleep(1);
+  }
+  EXPECT_EQ(num_threads * num_tasks, count.load());
+
+  event_loop.close_handles();
+  event_loop.join();
+}
+
+TEST_F(EventLoopUnitTest, SpinTime) {
+  EventLoop event_loop;
+  ASSERT_EQ(0, event_loop.init("EventLoopUnitTest::SpinTime"));
+  event_loop.set_spin_time(1000000); // 1 ms
+  ASSERT_EQ(0, event_loop.run());
+
+  // Tasks are run both while the loop is spinning and after it's blocked
+  Atomic<int> count(0);
+  for (int i = 0; i < 10; ++i) {
+    event_loop.add(new CountTask(&count));
+    if (i % 2 == 0) test::Utils::msleep(5);
+  }
+  for (int i = 0; i < 1000 && count.load() < 10; ++i) {
+    test::Utils::msleep(1);
+  }
+  EXPECT_EQ(10, count.load());
+
+  event_loop.close_handles();
+  event_loop.join();
+}
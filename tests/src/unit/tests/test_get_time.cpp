@@ -21,6 +21,7 @@
 #include "get_time.hpp"
 #include "test_utils.hpp"
 
+using datastax::internal::get_time_monotonic_coarse_ms;
 using datastax::internal::get_time_monotonic_ns;
 
 TEST(GetTimeUnitTest, Monotonic) {
@@ -40,3 +41,14 @@ TEST(GetTimeUnitTest, MonotonicDuration) {
   EXPECT_GE(elapsed, static_cast<double>(NANOSECONDS_PER_SECOND));
   EXPECT_LE(elapsed, static_cast<double>(2 * NANOSECONDS_PER_SECOND));
 }
+
+TEST(GetTimeUnitTest, MonotonicCoarse) {
+  uint64_t start = get_time_monotonic_coarse_ms();
+  uint64_t precise_start = get_time_monotonic_ns() / NANOSECONDS_PER_MILLISECOND;
+
+  test::Utils::msleep(100);
+  uint64_t elapsed = get_time_monotonic_coarse_ms() - start;
+  uint64_t precise_elapsed = get_time_monotonic_ns() / NANOSECONDS_PER_MILLISECOND - precise_start;
+  EXPECT_GE(elapsed + 20, precise_elapsed); // Within the coarse clock's resolution
+  EXPECT_LE(elapsed, precise_elapsed + 20);
+}
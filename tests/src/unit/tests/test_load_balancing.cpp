@@ -25,6 +25,7 @@
 #include "dc_aware_policy.hpp"
 #include "event_loop.hpp"
 #include "latency_aware_policy.hpp"
+#include "load_aware_policy.hpp"
 #include "murmur3.hpp"
 #include "query_request.hpp"
 #include "random.hpp"
@@ -885,6 +886,36 @@ TEST(LatencyAwareLoadBalancingUnitTest, ThreadholdToAccount) {
   EXPECT_EQ(current.average, static_cast<int64_t>(one_ms));
 }
 
+static void update_latency_thread(void* arg) {
+  Host* host = static_cast<Host*>(arg);
+  for (int i = 0; i < 10000; ++i) {
+    host->update_latency(1000000LL); // 1 ms in ns
+    TimestampedAverage current = host->get_current_average();
+    // The average of the same latency is that latency (within rounding)
+    EXPECT_TRUE(current.average == -1 || abs(current.average - 1000000LL) <= 1) << current.average;
+  }
+}
+
+TEST(LatencyAwareLoadBalancingUnitTest, ConcurrentUpdates) {
+  Host host(Address("0.0.0.0", 9042));
+  host.enable_latency_tracking(100LL, 0LL);
+
+  const int num_threads = 4;
+  uv_thread_t threads[num_threads];
+  for (int i = 0; i < num_threads; ++i) {
+    ASSERT_EQ(0, uv_thread_create(&threads[i], update_latency_thread, &host));
+  }
+  for (int i = 0; i < num_threads; ++i) {
+    uv_thread_join(&threads[i]);
+  }
+
+  // Updates that overlap another thread's update are dropped
+  TimestampedAverage current = host.get_current_average();
+  EXPECT_GT(current.num_measured, 0u);
+  EXPECT_LE(current.num_measured, static_cast<uint64_t>(num_threads * 10000));
+  EXPECT_NEAR(1000000.0, static_cast<double>(current.average), 1.0);
+}
+
 TEST(LatencyAwareLoadBalancingUnitTest, MovingAverage) {
   const uint64_t one_ms = 1000000LL; // 1 ms in ns
 
@@ -1098,3 +1129,103 @@ TEST(BlacklistLoadBalancingUnitTest, Datacenters) {
   Address next_address;
   ASSERT_FALSE(qp.get()->compute_next(&next_address));
 }
+
+TEST(LoadAwareLoadBalancingUnitTest, InflightRequests) {
+  HostMap hosts;
+  populate_hosts(3, "rack1", LOCAL_DC, &hosts);
+  LoadAwarePolicy policy(new RoundRobinPolicy(), false);
+  policy.init(SharedRefPtr<Host>(), hosts, NULL, "");
+
+  // Without any load the child policy's order is used
+  {
+    ScopedPtr<QueryPlan> qp(policy.new_query_plan("", NULL, NULL));
+    const size_t seq[] = { 1, 2, 3 };
+    verify_sequence(qp.get(), VECTOR_FROM(size_t, seq));
+  }
+
+  // The less loaded of the first two hosts is tried first
+  hosts[Address("3.0.0.0", 9042)]->increment_inflight_requests();
+  hosts[Address("3.0.0.0", 9042)]->increment_inflight_requests();
+  hosts[Address("1.0.0.0", 9042)]->increment_inflight_requests();
+  {
+    ScopedPtr<QueryPlan> qp(policy.new_query_plan("", NULL, NULL)); // Child plan: 2, 3, 1
+    const size_t seq[] = { 2, 3, 1 };
+    verify_sequence(qp.get(), VECTOR_FROM(size_t, seq));
+  }
+  {
+    ScopedPtr<QueryPlan> qp(policy.new_query_plan("", NULL, NULL)); // Child plan: 3, 1, 2
+    const size_t seq[] = { 1, 3, 2 };
+    verify_sequence(qp.get(), VECTOR_FROM(size_t, seq));
+  }
+}
+
+TEST(LoadAwareLoadBalancingUnitTest, OnlyReplicasAreSwapped) {
+  const int64_t num_hosts = 4;
+  HostMap hosts;
+  TokenMap::Ptr token_map(TokenMap::from_partitioner(Murmur3Partitioner::name()));
+
+  const uint64_t partition_size = CASS_UINT64_MAX / num_hosts;
+  Murmur3Partitioner::Token token = CASS_INT64_MIN + static_cast<int64_t>(partition_size);
+
+  for (size_t i = 1; i <= num_hosts; ++i) {
+    Host::Ptr host(create_host(addr_for_sequence(i), single_token(token),
+                               Murmur3Partitioner::name().to_string(), "rack1", LOCAL_DC));
+
+    hosts[host->address()] = host;
+    token_map->add_host(host);
+    token += partition_size;
+  }
+
+  add_keyspace_simple("rf1", 1, token_map.get());
+  add_keyspace_simple("rf2", 2, token_map.get());
+  token_map->build();
+
+  LoadAwarePolicy policy(new TokenAwarePolicy(new RoundRobinPolicy(), false), false);
+  policy.init(SharedRefPtr<Host>(), hosts, NULL, "");
+
+  QueryRequest::Ptr request(new QueryRequest("", 1));
+  const char* value = "kjdfjkldsdjkl"; // hash: 9024137376112061887
+  request->set(0, CassString(value, strlen(value)));
+  request->add_key_index(0);
+  SharedRefPtr<RequestHandler> request_handler(new RequestHandler(request, ResponseFuture::Ptr()));
+
+  // The only replica is busier than the next host, but that host isn't a replica
+  hosts[Address("4.0.0.0", 9042)]->increment_inflight_requests();
+  {
+    ScopedPtr<QueryPlan> qp(policy.new_query_plan("rf1", request_handler.get(), token_map.get()));
+    const size_t seq[] = { 4, 1, 2, 3 };
+    verify_sequence(qp.get(), VECTOR_FROM(size_t, seq));
+  }
+
+  // The less loaded of two replicas is tried first
+  {
+    ScopedPtr<QueryPlan> qp(policy.new_query_plan("rf2", request_handler.get(), token_map.get()));
+    const size_t seq[] = { 1, 4, 2, 3 };
+    verify_sequence(qp.get(), VECTOR_FROM(size_t, seq));
+  }
+}
+
+TEST(LoadAwareLoadBalancingUnitTest, Latency) {
+  HostMap hosts;
+  populate_hosts(2, "rack1", LOCAL_DC, &hosts);
+  LoadAwarePolicy policy(new RoundRobinPolicy(), true);
+  policy.init(SharedRefPtr<Host>(), hosts, NULL, "");
+
+  const Host::Ptr& host1 = hosts[Address("1.0.0.0", 9042)];
+  const Host::Ptr& host2 = hosts[Address("2.0.0.0", 9042)];
+  LatencyAwarePolicy::Settings settings;
+  for (uint64_t i = 0; i < settings.min_measured; ++i) {
+    host1->update_latency(1000);
+    host2->update_latency(10000);
+  }
+
+  // Host 1 is faster even though it has more in-flight requests
+  host1->increment_inflight_requests();
+  EXPECT_TRUE(policy.is_less_loaded(host1, host2));
+
+  // Until its in-flight requests outweigh its latency
+  for (int i = 0; i < 10; ++i) {
+    host1->increment_inflight_requests();
+  }
+  EXPECT_FALSE(policy.is_less_loaded(host1, host2));
+}
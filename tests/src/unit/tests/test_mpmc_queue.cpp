@@ -0,0 +1,53 @@
+/*
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include <gtest/gtest.h>
+
+#include "mpmc_queue.hpp"
+
+using datastax::internal::core::MPMCQueue;
+
+TEST(MPMCQueueUnitTest, EnqueueDequeueMany) {
+  MPMCQueue<int> queue(8);
+  int values[] = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10 };
+
+  // Only as many entries as there's room for are enqueued
+  EXPECT_EQ(8u, queue.enqueue_many(values, 10));
+  EXPECT_EQ(0u, queue.enqueue_many(values + 8, 2));
+  EXPECT_FALSE(queue.enqueue(11));
+
+  int dequeued[10];
+  EXPECT_EQ(3u, queue.dequeue_many(dequeued, 3));
+  EXPECT_EQ(1, dequeued[0]);
+  EXPECT_EQ(2, dequeued[1]);
+  EXPECT_EQ(3, dequeued[2]);
+
+  // Wrap around the end of the buffer
+  EXPECT_EQ(2u, queue.enqueue_many(values + 8, 2));
+
+  int value;
+  EXPECT_TRUE(queue.dequeue(value));
+  EXPECT_EQ(4, value);
+
+  EXPECT_EQ(6u, queue.dequeue_many(dequeued, 10));
+  for (int i = 0; i < 6; ++i) {
+    EXPECT_EQ(i + 5, dequeued[i]);
+  }
+  EXPECT_TRUE(queue.is_empty());
+  EXPECT_EQ(0u, queue.dequeue_many(dequeued, 10));
+}
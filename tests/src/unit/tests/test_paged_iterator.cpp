@@ -0,0 +1,320 @@
+/*
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include "loop_test.hpp"
+
+#include "paged_iterator.hpp"
+#include "query_request.hpp"
+#include "session.hpp"
+
+#include <stdlib.h>
+
+using namespace mockssandra;
+using datastax::internal::OStringStream;
+using datastax::internal::core::Config;
+using datastax::internal::core::Future;
+using datastax::internal::core::QueryRequest;
+using datastax::internal::core::Session;
+
+#define PAGED_QUERY "SELECT * FROM paged"
+#define ROWS_PER_PAGE 10
+
+class PagedIteratorUnitTest : public LoopTest {
+public:
+  /**
+   * Returns the pages of a single int column result. The paging state is the
+   * index of the next page.
+   */
+  class PagedQuery : public Action {
+  public:
+    PagedQuery(int page_count, Atomic<int>* request_count, int error_page = -1)
+        : page_count_(page_count)
+        , error_page_(error_page)
+        , request_count_(request_count) {}
+
+    void on_run(Request* request) const {
+      String query;
+      QueryParameters params;
+      if (!request->decode_query(&query, &params)) {
+        request->error(ERROR_PROTOCOL_ERROR, "Invalid query message");
+      } else if (query == PAGED_QUERY) {
+        request_count_->fetch_add(1);
+        int page = params.paging_state.empty() ? 0 : atoi(params.paging_state.c_str());
+        if (page == error_page_) {
+          request->error(ERROR_INVALID_QUERY, "Invalid page");
+        } else {
+          request->write(OPCODE_RESULT, encode_page(page, params.result_page_size));
+        }
+      } else {
+        run_next(request);
+      }
+    }
+
+  private:
+    String encode_page(int page, int32_t page_size) const {
+      String body;
+      int32_t flags = RESULT_FLAG_GLOBAL_TABLESPEC;
+      if (page + 1 < page_count_) flags |= RESULT_FLAG_HAS_MORE_PAGES;
+      encode_int32(RESULT_ROWS, &body);
+      encode_int32(flags, &body);
+      encode_int32(1, &body); // Column count
+      if (flags & RESULT_FLAG_HAS_MORE_PAGES) {
+        OStringStream ss;
+        ss << page + 1;
+        encode_int32(ss.str().size(), &body);
+        body.append(ss.str());
+      }
+      encode_string("ks", &body);
+      encode_string("paged", &body);
+      encode_string("key", &body);
+      body.push_back(0x00); // Int type
+      body.push_back(0x09);
+      encode_int32(page_size, &body); // Row count
+      for (int32_t i = 0; i < page_size; ++i) {
+        encode_int32(sizeof(int32_t), &body);
+        encode_int32(page * page_size + i, &body);
+      }
+      return body;
+    }
+
+  private:
+    int page_count_;
+    int error_page_;
+    Atomic<int>* request_count_;
+  };
+
+  static void connect(Session* session) {
+    Config config;
+    config.contact_points().push_back(Address("127.0.0.1", 9042));
+    Future::Ptr connect_future(session->connect(config));
+    ASSERT_TRUE(connect_future->wait_for(WAIT_FOR_TIME))
+        << "Timed out waiting for session to connect";
+    ASSERT_FALSE(connect_future->error()) << cass_error_desc(connect_future->error()->code) << ": "
+                                          << connect_future->error()->message;
+  }
+
+  static void close(Session* session) {
+    Future::Ptr close_future(session->close());
+    ASSERT_TRUE(close_future->wait_for(WAIT_FOR_TIME))
+        << "Timed out waiting for session to close";
+  }
+
+  static const RequestHandler* paged(int page_count, Atomic<int>* request_count,
+                                    int error_page = -1) {
+    mockssandra::SimpleRequestHandlerBuilder builder;
+    builder.on(OPCODE_QUERY)
+        .system_local()
+        .system_peers()
+        .execute(new PagedQuery(page_count, request_count, error_page))
+        .empty_rows_result(1);
+    return builder.build();
+  }
+
+  // Iterates over the remaining rows, checking they're in order, and returns
+  // the total number of rows.
+  static int iterate(CassPagedIterator* iterator, int row_count = 0) {
+    while (cass_paged_iterator_next(iterator)) {
+      const CassRow* row = cass_paged_iterator_get_row(iterator);
+      cass_int32_t key;
+      EXPECT_EQ(CASS_OK, cass_value_get_int32(cass_row_get_column(row, 0), &key));
+      EXPECT_EQ(row_count, key);
+      row_count++;
+    }
+    return row_count;
+  }
+
+  static QueryRequest::Ptr paged_query() {
+    QueryRequest::Ptr request(new QueryRequest(PAGED_QUERY));
+    request->set_page_size(ROWS_PER_PAGE);
+    return request;
+  }
+};
+
+TEST_F(PagedIteratorUnitTest, MultiplePages) {
+  Atomic<int> request_count(0);
+  mockssandra::SimpleCluster cluster(paged(5, &request_count));
+  ASSERT_EQ(cluster.start_all(), 0);
+
+  Session session;
+  connect(&session);
+
+  QueryRequest::Ptr request(paged_query());
+  CassPagedIterator* iterator =
+      cass_session_execute_paged(CassSession::to(&session), CassStatement::to(request.get()), 2, 0);
+  EXPECT_EQ(5 * ROWS_PER_PAGE, iterate(iterator));
+  EXPECT_EQ(CASS_OK, cass_paged_iterator_error_code(iterator));
+  cass_paged_iterator_free(iterator);
+
+  EXPECT_EQ(5, request_count.load());
+
+  close(&session);
+}
+
+TEST_F(PagedIteratorUnitTest, NoPrefetch) {
+  Atomic<int> request_count(0);
+  mockssandra::SimpleCluster cluster(paged(3, &request_count));
+  ASSERT_EQ(cluster.start_all(), 0);
+
+  Session session;
+  connect(&session);
+
+  QueryRequest::Ptr request(paged_query());
+  CassPagedIterator* iterator =
+      cass_session_execute_paged(CassSession::to(&session), CassStatement::to(request.get()), 0, 0);
+
+  // Only the first page is requested until its rows have been iterated over
+  ASSERT_TRUE(cass_paged_iterator_next(iterator));
+  test::Utils::msleep(100);
+  EXPECT_EQ(1, request_count.load());
+
+  const CassRow* row = cass_paged_iterator_get_row(iterator);
+  cass_int32_t key;
+  EXPECT_EQ(CASS_OK, cass_value_get_int32(cass_row_get_column(row, 0), &key));
+  EXPECT_EQ(0, key);
+  EXPECT_EQ(3 * ROWS_PER_PAGE, iterate(iterator, 1));
+  EXPECT_EQ(3, request_count.load());
+  cass_paged_iterator_free(iterator);
+
+  close(&session);
+}
+
+TEST_F(PagedIteratorUnitTest, PrefetchLimit) {
+  Atomic<int> request_count(0);
+  mockssandra::SimpleCluster cluster(paged(10, &request_count));
+  ASSERT_EQ(cluster.start_all(), 0);
+
+  Session session;
+  connect(&session);
+
+  QueryRequest::Ptr request(paged_query());
+  CassPagedIterator* iterator =
+      cass_session_execute_paged(CassSession::to(&session), CassStatement::to(request.get()), 3, 0);
+
+  // The first page is being iterated over and the next 3 pages are prefetched
+  ASSERT_TRUE(cass_paged_iterator_next(iterator));
+  for (int i = 0; i < 100 && request_count.load() < 4; ++i) {
+    test::Utils::msleep(10);
+  }
+  test::Utils::msleep(100);
+  EXPECT_EQ(4, request_count.load());
+
+  cass_paged_iterator_free(iterator);
+
+  close(&session);
+}
+
+TEST_F(PagedIteratorUnitTest, Error) {
+  Atomic<int> request_count(0);
+  mockssandra::SimpleCluster cluster(paged(5, &request_count, 2));
+  ASSERT_EQ(cluster.start_all(), 0);
+
+  Session session;
+  connect(&session);
+
+  QueryRequest::Ptr request(paged_query());
+  CassPagedIterator* iterator =
+      cass_session_execute_paged(CassSession::to(&session), CassStatement::to(request.get()), 1, 0);
+
+  // The rows of the pages before the error are returned
+  EXPECT_EQ(2 * ROWS_PER_PAGE, iterate(iterator));
+  EXPECT_EQ(CASS_ERROR_SERVER_INVALID_QUERY, cass_paged_iterator_error_code(iterator));
+
+  const char* message;
+  size_t message_length;
+  cass_paged_iterator_error_message(iterator, &message, &message_length);
+  EXPECT_EQ("Invalid page", String(message, message_length));
+
+  cass_paged_iterator_free(iterator);
+
+  close(&session);
+}
+
+static void on_chunk(const CassResult* chunk, void* data) {}
+
+TEST_F(PagedIteratorUnitTest, ResultChunkCallback) {
+  Atomic<int> request_count(0);
+  mockssandra::SimpleCluster cluster(paged(2, &request_count));
+  ASSERT_EQ(cluster.start_all(), 0);
+
+  Session session;
+  connect(&session);
+
+  // The rows of a streamed result are only passed to the chunk callback
+  QueryRequest::Ptr request(paged_query());
+  request->set_result_chunk_callback(on_chunk, NULL);
+  CassPagedIterator* iterator =
+      cass_session_execute_paged(CassSession::to(&session), CassStatement::to(request.get()), 1, 0);
+  EXPECT_EQ(0, iterate(iterator));
+  EXPECT_EQ(CASS_ERROR_LIB_BAD_PARAMS, cass_paged_iterator_error_code(iterator));
+  cass_paged_iterator_free(iterator);
+
+  EXPECT_EQ(0, request_count.load());
+
+  close(&session);
+}
+
+TEST_F(PagedIteratorUnitTest, ErrorAfterPrefetchedPage) {
+  Atomic<int> request_count(0);
+  mockssandra::SimpleCluster cluster(paged(5, &request_count, 2));
+  ASSERT_EQ(cluster.start_all(), 0);
+
+  Session session;
+  connect(&session);
+
+  QueryRequest::Ptr request(paged_query());
+  CassPagedIterator* iterator =
+      cass_session_execute_paged(CassSession::to(&session), CassStatement::to(request.get()), 2, 0);
+
+  // The second page is prefetched and the request for the third page fails
+  // while the application is still on the first page.
+  ASSERT_TRUE(cass_paged_iterator_next(iterator));
+  for (int i = 0; i < 100 && cass_paged_iterator_error_code(iterator) == CASS_OK; ++i) {
+    test::Utils::msleep(10);
+  }
+  ASSERT_EQ(CASS_ERROR_SERVER_INVALID_QUERY, cass_paged_iterator_error_code(iterator));
+  EXPECT_EQ(3, request_count.load());
+
+  // The prefetched page is still returned before the iterator stops
+  EXPECT_EQ(2 * ROWS_PER_PAGE, iterate(iterator, 1));
+  EXPECT_EQ(CASS_ERROR_SERVER_INVALID_QUERY, cass_paged_iterator_error_code(iterator));
+
+  cass_paged_iterator_free(iterator);
+
+  close(&session);
+}
+
+TEST_F(PagedIteratorUnitTest, ScanUnknownTable) {
+  mockssandra::SimpleCluster cluster(simple());
+  ASSERT_EQ(cluster.start_all(), 0);
+
+  Session session;
+  connect(&session);
+
+  CassPagedIterator* iterator =
+      cass_session_scan_table(CassSession::to(&session), "ks", "unknown", NULL, 4);
+  EXPECT_FALSE(cass_paged_iterator_next(iterator));
+  EXPECT_EQ(CASS_ERROR_LIB_BAD_PARAMS, cass_paged_iterator_error_code(iterator));
+  cass_paged_iterator_free(iterator);
+
+  iterator = cass_session_scan_table(CassSession::to(&session), "ks", "unknown", NULL, 0);
+  EXPECT_FALSE(cass_paged_iterator_next(iterator));
+  EXPECT_EQ(CASS_ERROR_LIB_BAD_PARAMS, cass_paged_iterator_error_code(iterator));
+  cass_paged_iterator_free(iterator);
+
+  close(&session);
+}
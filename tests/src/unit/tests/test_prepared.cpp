@@ -14,19 +14,26 @@
 #include "loop_test.hpp"
 
 #include "execute_request.hpp"
+#include "get_time.hpp"
 #include "md5.hpp"
 #include "prepared.hpp"
 #include "session.hpp"
 #include "set.hpp"
 #include "uuids.hpp"
+#include "vector.hpp"
 
 using namespace mockssandra;
+using datastax::internal::get_time_monotonic_coarse_ms;
+using datastax::internal::OStringStream;
 using datastax::internal::ScopedMutex;
 using datastax::internal::Set;
+using datastax::internal::Vector;
 using datastax::internal::core::Config;
 using datastax::internal::core::ExecuteRequest;
 using datastax::internal::core::Future;
+using datastax::internal::core::Metrics;
 using datastax::internal::core::Prepared;
+using datastax::internal::core::PreparedMetadata;
 using datastax::internal::core::ResponseFuture;
 using datastax::internal::core::ResultResponse;
 using datastax::internal::core::Session;
@@ -50,6 +57,7 @@ public:
       ScopedMutex l(&mutex_);
       String id = generate_id(query);
       statements_.insert(to_key(address, id));
+      order_.push_back(to_key(address, query));
       return id;
     }
 
@@ -62,6 +70,20 @@ public:
       return contains_id(address, generate_id(query));
     }
 
+    // The position of a query in the order that queries were prepared on a node
+    int prepare_index(const Address& address, const String& query) const {
+      ScopedMutex l(&mutex_);
+      String prefix(address.to_string() + "_");
+      int index = 0;
+      for (Vector<String>::const_iterator it = order_.begin(), end = order_.end(); it != end;
+           ++it) {
+        if (it->compare(0, prefix.size(), prefix) != 0) continue;
+        if (*it == to_key(address, query)) return index;
+        ++index;
+      }
+      return -1;
+    }
+
   private:
     String to_key(const Address& address, const String& id) const {
       return address.to_string() + "_" + id;
@@ -78,6 +100,7 @@ public:
   private:
     mutable uv_mutex_t mutex_;
     Set<String> statements_;
+    Vector<String> order_;
   };
 
   /**
@@ -198,6 +221,14 @@ public:
   }
 };
 
+// Entries used within the same millisecond have no defined order
+// Waits for the clock used to order prepared metadata by last use to advance
+static void wait_for_next_tick() {
+  uint64_t start = get_time_monotonic_coarse_ms();
+  while (get_time_monotonic_coarse_ms() == start) {
+  }
+}
+
 /**
  * Verify that statement is re-prepared on a node that doesn't have the prepared statement.
  */
@@ -289,3 +320,245 @@ TEST_F(PreparedUnitTest, PreparedOnUpWithCaseSensitiveKeyspace) {
 
   close(&session);
 }
+
+/**
+ * Verify that all cached statements are prepared on a host that comes up when the prepare requests
+ * are limited and spread over several connections.
+ */
+TEST_F(PreparedUnitTest, PreparedOnUpWithLimitedConcurrency) {
+  PrepareStatements statements;
+
+  mockssandra::SimpleRequestHandlerBuilder builder;
+  builder.on(OPCODE_PREPARE).execute(new PrepareQuery(&statements));
+  builder.on(OPCODE_EXECUTE).execute(new ExecuteQuery(&statements));
+
+  mockssandra::SimpleCluster cluster(builder.build(), 2); // Requires at least 2 nodes
+  ASSERT_EQ(cluster.start(1), 0);
+
+  Config config;
+  config.set_prepare_on_up_or_add_host(true);
+  config.set_prepare_on_up_or_add_host_concurrency(3);
+  config.set_core_connections_per_host(2);
+  config.contact_points().push_back(Address("127.0.0.1", 9042));
+
+  Session session;
+  connect(config, &session);
+
+  const int num_queries = 20;
+  for (int i = 0; i < num_queries; ++i) {
+    OStringStream ss;
+    ss << PREPARED_QUERY << " WHERE k = " << i;
+    ASSERT_TRUE(prepare(&session, ss.str()));
+  }
+
+  ASSERT_EQ(cluster.start(2), 0);
+  cluster.event(StatusChangeEvent::up(Address("127.0.0.2", 9042)));
+
+  bool contains_queries = false;
+  for (int i = 0; i < 600 && !contains_queries; ++i) {
+    contains_queries = true;
+    for (int j = 0; j < num_queries && contains_queries; ++j) {
+      OStringStream ss;
+      ss << PREPARED_QUERY << " WHERE k = " << j;
+      contains_queries = statements.contains_query(Address("127.0.0.2", 9042), ss.str());
+    }
+    if (!contains_queries) test::Utils::msleep(100);
+  }
+  EXPECT_TRUE(contains_queries);
+
+  close(&session);
+}
+
+/**
+ * Verify that the most recently used statement is prepared first on a host that comes up.
+ */
+TEST_F(PreparedUnitTest, PreparedOnUpMostRecentlyUsedFirst) {
+  PrepareStatements statements;
+
+  mockssandra::SimpleRequestHandlerBuilder builder;
+  builder.on(OPCODE_PREPARE).execute(new PrepareQuery(&statements));
+  builder.on(OPCODE_EXECUTE).execute(new ExecuteQuery(&statements));
+
+  mockssandra::SimpleCluster cluster(builder.build(), 2); // Requires at least 2 nodes
+  ASSERT_EQ(cluster.start(1), 0);
+
+  Config config;
+  config.set_prepare_on_up_or_add_host(true);
+  config.set_prepare_on_up_or_add_host_concurrency(1); // Prepare the statements in order
+  config.set_core_connections_per_host(1);
+  config.contact_points().push_back(Address("127.0.0.1", 9042));
+
+  Session session;
+  connect(config, &session);
+
+  const int num_queries = 3;
+  Prepared::ConstPtr first_prepared;
+  for (int i = 0; i < num_queries; ++i) {
+    OStringStream ss;
+    ss << PREPARED_QUERY << " WHERE k = " << i;
+    Prepared::ConstPtr prepared(prepare(&session, ss.str()));
+    ASSERT_TRUE(prepared);
+    if (i == 0) first_prepared = prepared;
+  }
+
+  wait_for_next_tick();
+  { // The statement that was prepared first is now the most recently used
+    Future::Ptr future =
+        session.execute(ExecuteRequest::ConstPtr(new ExecuteRequest(first_prepared.get())));
+    EXPECT_TRUE(future->wait_for(WAIT_FOR_TIME)) << "Timed out waiting to execute prepared query ";
+    EXPECT_FALSE(future->error()) << cass_error_desc(future->error()->code) << ": "
+                                  << future->error()->message;
+  }
+
+  ASSERT_EQ(cluster.start(2), 0);
+  cluster.event(StatusChangeEvent::up(Address("127.0.0.2", 9042)));
+
+  bool contains_queries = false;
+  for (int i = 0; i < 600 && !contains_queries; ++i) {
+    contains_queries = true;
+    for (int j = 0; j < num_queries && contains_queries; ++j) {
+      OStringStream ss;
+      ss << PREPARED_QUERY << " WHERE k = " << j;
+      contains_queries = statements.contains_query(Address("127.0.0.2", 9042), ss.str());
+    }
+    if (!contains_queries) test::Utils::msleep(100);
+  }
+  ASSERT_TRUE(contains_queries);
+
+  EXPECT_EQ(0, statements.prepare_index(Address("127.0.0.2", 9042), first_prepared->query()));
+
+  close(&session);
+}
+
+/**
+ * Verify that prepared metadata that hasn't been used recently is evicted when the cache is full.
+ */
+TEST(PreparedMetadataUnitTest, Eviction) {
+  PreparedMetadata metadata(2);
+
+  metadata.set("1", PreparedMetadata::Entry::Ptr(new PreparedMetadata::Entry(
+                        "SELECT 1", "", "", ResultResponse::ConstPtr())));
+  metadata.set("2", PreparedMetadata::Entry::Ptr(new PreparedMetadata::Entry(
+                        "SELECT 2", "", "", ResultResponse::ConstPtr())));
+  size_t size_bytes = metadata.size_bytes();
+  EXPECT_GT(size_bytes, 0u);
+
+  EXPECT_TRUE(metadata.get("1")); // "2" is now the only entry that hasn't been used
+
+  metadata.set("3", PreparedMetadata::Entry::Ptr(new PreparedMetadata::Entry(
+                        "SELECT 3", "", "", ResultResponse::ConstPtr())));
+  EXPECT_EQ(2u, metadata.size());
+  EXPECT_EQ(1u, metadata.eviction_count());
+  EXPECT_EQ(size_bytes, metadata.size_bytes());
+  EXPECT_TRUE(metadata.get("1"));
+  EXPECT_FALSE(metadata.get("2"));
+  EXPECT_TRUE(metadata.get("3"));
+
+  // Entries are copied from most to least recently used
+  wait_for_next_tick();
+  EXPECT_TRUE(metadata.get("3"));
+  PreparedMetadata::Entry::Vec entries(metadata.copy());
+  ASSERT_EQ(2u, entries.size());
+  EXPECT_EQ("SELECT 3", entries[0]->query());
+  EXPECT_EQ("SELECT 1", entries[1]->query());
+
+  // Replacing an existing entry doesn't evict
+  metadata.set("1", PreparedMetadata::Entry::Ptr(new PreparedMetadata::Entry(
+                        "SELECT 1", "", "", ResultResponse::ConstPtr())));
+  EXPECT_EQ(2u, metadata.size());
+  EXPECT_EQ(1u, metadata.eviction_count());
+
+  // A new entry is kept even when all the other entries have been used
+  EXPECT_TRUE(metadata.get("1"));
+  EXPECT_TRUE(metadata.get("3"));
+  metadata.set("4", PreparedMetadata::Entry::Ptr(new PreparedMetadata::Entry(
+                        "SELECT 4", "", "", ResultResponse::ConstPtr())));
+  EXPECT_EQ(2u, metadata.size());
+  EXPECT_EQ(2u, metadata.eviction_count());
+  EXPECT_TRUE(metadata.get("4"));
+}
+
+/**
+ * Verify that prepared metadata is copied from most to least recently used even when no entry has
+ * been evicted.
+ */
+TEST(PreparedMetadataUnitTest, CopyOrder) {
+  PreparedMetadata metadata(10);
+
+  metadata.set("1", PreparedMetadata::Entry::Ptr(new PreparedMetadata::Entry(
+                        "SELECT 1", "", "", ResultResponse::ConstPtr())));
+  metadata.set("2", PreparedMetadata::Entry::Ptr(new PreparedMetadata::Entry(
+                        "SELECT 2", "", "", ResultResponse::ConstPtr())));
+  metadata.set("3", PreparedMetadata::Entry::Ptr(new PreparedMetadata::Entry(
+                        "SELECT 3", "", "", ResultResponse::ConstPtr())));
+
+  wait_for_next_tick();
+  EXPECT_TRUE(metadata.get("2"));
+  wait_for_next_tick();
+  EXPECT_TRUE(metadata.get("1"));
+
+  PreparedMetadata::Entry::Vec entries(metadata.copy());
+  EXPECT_EQ(0u, metadata.eviction_count());
+  ASSERT_EQ(3u, entries.size());
+  EXPECT_EQ("SELECT 1", entries[0]->query());
+  EXPECT_EQ("SELECT 2", entries[1]->query());
+  EXPECT_EQ("SELECT 3", entries[2]->query());
+}
+
+/**
+ * Verify that concurrent requests that receive an UNPREPARED error for the same statement on the
+ * same host wait for a single re-prepare.
+ */
+TEST_F(PreparedUnitTest, CoalesceReprepares) {
+  PrepareStatements statements;
+
+  mockssandra::SimpleRequestHandlerBuilder builder;
+  builder.on(OPCODE_PREPARE).execute(new PrepareQuery(&statements));
+  builder.on(OPCODE_EXECUTE).execute(new ExecuteQuery(&statements));
+
+  mockssandra::SimpleCluster cluster(builder.build(), 2); // Requires at least 2 nodes
+  ASSERT_EQ(cluster.start_all(), 0);
+
+  Config config;
+  config.set_prepare_on_all_hosts(false); // Force re-prepare when executing on a new node
+  config.set_thread_count_io(1);
+  config.contact_points().push_back(Address("127.0.0.1", 9042));
+
+  Session session;
+  connect(config, &session);
+
+  Prepared::ConstPtr prepared = prepare(&session, PREPARED_QUERY);
+  ASSERT_TRUE(prepared);
+
+  // Execute on the node that the statement wasn't prepared on
+  Address address("127.0.0.1", 9042);
+  if (statements.contains_query(address, PREPARED_QUERY)) {
+    address = Address("127.0.0.2", 9042);
+  }
+
+  const size_t num_requests = 32;
+  Vector<Future::Ptr> futures;
+  for (size_t i = 0; i < num_requests; ++i) {
+    ExecuteRequest::Ptr request(new ExecuteRequest(prepared.get()));
+    request->set_host(address);
+    futures.push_back(session.execute(ExecuteRequest::ConstPtr(request)));
+  }
+
+  for (Vector<Future::Ptr>::const_iterator it = futures.begin(), end = futures.end(); it != end;
+       ++it) {
+    EXPECT_TRUE((*it)->wait_for(WAIT_FOR_TIME)) << "Timed out waiting to execute prepared query ";
+    EXPECT_FALSE((*it)->error()) << cass_error_desc((*it)->error()->code) << ": "
+                                 << (*it)->error()->message;
+  }
+
+  EXPECT_TRUE(statements.contains_query(address, PREPARED_QUERY));
+
+  const Metrics* metrics = session.metrics();
+  ASSERT_TRUE(metrics != NULL);
+  EXPECT_GE(metrics->reprepares.sum(), 1);
+  EXPECT_GT(metrics->coalesced_reprepares.sum(), 0);
+  EXPECT_LE(metrics->reprepares.sum() + metrics->coalesced_reprepares.sum(),
+            static_cast<int64_t>(num_requests));
+
+  close(&session);
+}
@@ -0,0 +1,147 @@
+/*
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include <gtest/gtest.h>
+
+#include "read_buffer_pool.hpp"
+#include "socket.hpp"
+
+#include <algorithm>
+
+using namespace datastax;
+using namespace datastax::internal;
+using namespace datastax::internal::core;
+
+class ReadBufferPoolUnitTest : public testing::Test {
+public:
+  class TestSocketHandler : public SocketHandler {
+  public:
+    virtual void on_read(Socket* socket, ssize_t nread, const uv_buf_t* buf) {}
+    virtual void on_write(Socket* socket, int status, SocketRequest* request) {}
+    virtual void on_close() {}
+  };
+
+  virtual void SetUp() {
+    context_.read_buffer_pool = &pool_;
+    LoopContext::set_current(&context_);
+  }
+  virtual void TearDown() { LoopContext::set_current(NULL); }
+
+  ReadBufferPool& pool() { return pool_; }
+
+  // Simulates a read of `nread` bytes and returns the size of the buffer used
+  static size_t read(SocketHandler* handler, ssize_t nread) {
+    uv_buf_t buf;
+    handler->alloc_buffer(64 * 1024, &buf);
+    size_t size = buf.len;
+    handler->free_buffer(nread < 0 ? nread : std::min(static_cast<size_t>(nread), size), &buf);
+    return size;
+  }
+
+private:
+  ReadBufferPool pool_;
+  LoopContext context_;
+};
+
+TEST_F(ReadBufferPoolUnitTest, SizeClass) {
+  EXPECT_EQ(4u * 1024, ReadBufferPool::size_class(1));
+  EXPECT_EQ(4u * 1024, ReadBufferPool::size_class(4 * 1024));
+  EXPECT_EQ(8u * 1024, ReadBufferPool::size_class(4 * 1024 + 1));
+  EXPECT_EQ(64u * 1024, ReadBufferPool::size_class(40 * 1024));
+  EXPECT_EQ(1024u * 1024, ReadBufferPool::size_class(1024 * 1024));
+  EXPECT_EQ(2u * 1024 * 1024, ReadBufferPool::size_class(2 * 1024 * 1024));
+}
+
+TEST_F(ReadBufferPoolUnitTest, Reuse) {
+  uv_buf_t buf = pool().alloc(10 * 1024);
+  EXPECT_EQ(16u * 1024, buf.len);
+  char* base = buf.base;
+  pool().free(buf);
+  EXPECT_EQ(1u, pool().free_count());
+  EXPECT_EQ(16u * 1024, pool().free_bytes());
+
+  // The free buffer is only reused for its own size class
+  uv_buf_t other = pool().alloc(4 * 1024);
+  EXPECT_NE(base, other.base);
+  pool().free(other);
+
+  buf = pool().alloc(16 * 1024);
+  EXPECT_EQ(base, buf.base);
+  pool().free(buf);
+  EXPECT_EQ(2u, pool().free_count());
+}
+
+TEST_F(ReadBufferPoolUnitTest, MaxFreePerClass) {
+  uv_buf_t bufs[ReadBufferPool::MAX_FREE_PER_CLASS + 2];
+  size_t count = sizeof(bufs) / sizeof(bufs[0]);
+  for (size_t i = 0; i < count; ++i) {
+    bufs[i] = pool().alloc(ReadBufferPool::MIN_SIZE);
+  }
+  for (size_t i = 0; i < count; ++i) {
+    pool().free(bufs[i]);
+  }
+  EXPECT_EQ(static_cast<size_t>(ReadBufferPool::MAX_FREE_PER_CLASS), pool().free_count());
+
+  // Buffers larger than the largest class aren't kept
+  uv_buf_t large = pool().alloc(ReadBufferPool::MAX_SIZE + 1);
+  EXPECT_EQ(ReadBufferPool::MAX_SIZE + 1, large.len);
+  pool().free(large);
+  EXPECT_EQ(static_cast<size_t>(ReadBufferPool::MAX_FREE_PER_CLASS), pool().free_count());
+}
+
+TEST_F(ReadBufferPoolUnitTest, SharedBySockets) {
+  TestSocketHandler handler1, handler2;
+
+  // Buffers are returned to the shared pool instead of being cached by each
+  // socket
+  read(&handler1, 100);
+  read(&handler2, 100);
+  EXPECT_EQ(1u, pool().free_count());
+}
+
+TEST_F(ReadBufferPoolUnitTest, AdaptiveReadSize) {
+  TestSocketHandler handler;
+  size_t initial_size = handler.read_size();
+
+  // Reads that fill the buffer grow the read size up to the largest class
+  EXPECT_EQ(initial_size, read(&handler, 1024 * 1024));
+  EXPECT_EQ(2 * initial_size, handler.read_size());
+  for (int i = 0; i < 16; ++i) {
+    read(&handler, 1024 * 1024);
+  }
+  EXPECT_EQ(ReadBufferPool::MAX_SIZE, handler.read_size());
+  EXPECT_EQ(ReadBufferPool::MAX_SIZE, read(&handler, 1024 * 1024));
+
+  // A few small reads don't shrink the read size
+  for (int i = 0; i < 8; ++i) {
+    read(&handler, 100);
+  }
+  read(&handler, 512 * 1024);
+  read(&handler, -1);
+  EXPECT_EQ(ReadBufferPool::MAX_SIZE, handler.read_size());
+
+  // A run of small reads shrinks it down to the smallest class
+  for (int i = 0; i < 16; ++i) {
+    read(&handler, 100);
+  }
+  EXPECT_EQ(ReadBufferPool::MAX_SIZE / 2, handler.read_size());
+  for (int i = 0; i < 1000; ++i) {
+    read(&handler, 100);
+  }
+  EXPECT_EQ(ReadBufferPool::MIN_SIZE, handler.read_size());
+}
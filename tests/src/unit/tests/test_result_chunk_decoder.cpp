@@ -0,0 +1,389 @@
+/*
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include "loop_test.hpp"
+
+#include "buffer.hpp"
+#include "constants.hpp"
+#include "query_request.hpp"
+#include "request_callback.hpp"
+#include "response.hpp"
+#include "result_response.hpp"
+#include "session.hpp"
+
+using namespace datastax;
+using namespace datastax::internal;
+using namespace datastax::internal::core;
+
+class ResultChunkDecoderUnitTest : public testing::Test {
+public:
+  class Callback : public SimpleRequestCallback {
+  public:
+    Callback(const Request::ConstPtr& request)
+        : SimpleRequestCallback(request) {}
+
+  private:
+    virtual void on_internal_set(ResponseMessage* response) {}
+    virtual void on_internal_error(CassError code, const String& message) {}
+    virtual void on_internal_timeout() {}
+  };
+
+  ResultChunkDecoderUnitTest()
+      : chunk_count_(0) {}
+
+  // Encodes a response frame with a rows result for the table "ks.t" with the
+  // columns "k int" and "v text"
+  static String encode_rows(int32_t row_count, const String& paging_state = "") {
+    BufferVec bufs;
+    bufs.push_back(Buffer(sizeof(int32_t)));
+    bufs.back().encode_int32(0, CASS_RESULT_KIND_ROWS);
+
+    int32_t flags = CASS_RESULT_FLAG_GLOBAL_TABLESPEC;
+    if (!paging_state.empty()) flags |= CASS_RESULT_FLAG_HAS_MORE_PAGES;
+    bufs.push_back(Buffer(2 * sizeof(int32_t)));
+    bufs.back().encode_int32(bufs.back().encode_int32(0, flags), 2);
+    if (!paging_state.empty()) {
+      bufs.push_back(Buffer(sizeof(int32_t) + paging_state.size()));
+      bufs.back().encode_bytes(0, paging_state.data(), paging_state.size());
+    }
+    bufs.push_back(Buffer(sizeof(uint16_t) + 2));
+    bufs.back().encode_string(0, "ks", 2);
+    bufs.push_back(Buffer(sizeof(uint16_t) + 1));
+    bufs.back().encode_string(0, "t", 1);
+    bufs.push_back(Buffer(sizeof(uint16_t) + 1 + sizeof(uint16_t)));
+    bufs.back().encode_uint16(bufs.back().encode_string(0, "k", 1), CASS_VALUE_TYPE_INT);
+    bufs.push_back(Buffer(sizeof(uint16_t) + 1 + sizeof(uint16_t)));
+    bufs.back().encode_uint16(bufs.back().encode_string(0, "v", 1), CASS_VALUE_TYPE_TEXT);
+
+    bufs.push_back(Buffer(sizeof(int32_t)));
+    bufs.back().encode_int32(0, row_count);
+    for (int32_t i = 0; i < row_count; ++i) {
+      OStringStream ss;
+      ss << "value" << i;
+      String value(ss.str());
+      Buffer row(2 * sizeof(int32_t) + sizeof(int32_t) + value.size());
+      size_t pos = row.encode_int32(0, sizeof(int32_t));
+      pos = row.encode_int32(pos, i);
+      row.encode_bytes(pos, value.data(), value.size());
+      bufs.push_back(row);
+    }
+
+    return encode_frame(bufs);
+  }
+
+  static String encode_void() {
+    BufferVec bufs;
+    bufs.push_back(Buffer(sizeof(int32_t)));
+    bufs.back().encode_int32(0, CASS_RESULT_KIND_VOID);
+    return encode_frame(bufs);
+  }
+
+  static String encode_frame(const BufferVec& bufs) {
+    String body;
+    for (BufferVec::const_iterator it = bufs.begin(), end = bufs.end(); it != end; ++it) {
+      body.append(it->data(), it->size());
+    }
+
+    Buffer header(CASS_HEADER_SIZE_V3);
+    size_t pos = header.encode_byte(0, 0x80 | CASS_PROTOCOL_VERSION_V4);
+    pos = header.encode_byte(pos, 0); // Flags
+    pos = header.encode_int16(pos, 1); // Stream
+    pos = header.encode_byte(pos, CQL_OPCODE_RESULT);
+    header.encode_int32(pos, body.size());
+
+    return String(header.data(), header.size()) + body;
+  }
+
+  // Decodes the frame in pieces of the specified size, streaming the result
+  // if the callback is set.
+  ResultResponse::Ptr decode(const String& frame, size_t piece_size,
+                             const RequestCallback::Ptr& callback = RequestCallback::Ptr()) {
+    ResponseMessage message;
+    message.set_stream_results(callback.get() != NULL);
+    size_t pos = 0;
+    while (pos < frame.size()) {
+      size_t size = std::min(piece_size, frame.size() - pos);
+      while (size > 0) {
+        ssize_t consumed = message.decode(frame.data() + pos, size);
+        EXPECT_GT(consumed, 0);
+        if (consumed <= 0) return ResultResponse::Ptr();
+        if (callback && message.is_result_body_pending()) {
+          message.stream_result(callback);
+        }
+        pos += consumed;
+        size -= consumed;
+      }
+    }
+    EXPECT_TRUE(message.is_body_ready());
+    return ResultResponse::Ptr(static_cast<ResultResponse*>(message.response_body().get()));
+  }
+
+  RequestCallback::Ptr streaming_callback() {
+    QueryRequest::Ptr request(new QueryRequest("SELECT * FROM ks.t"));
+    request->set_result_chunk_callback(on_chunk, this);
+    return RequestCallback::Ptr(new Callback(request));
+  }
+
+  static void on_chunk(const CassResult* chunk, void* data) {
+    ResultChunkDecoderUnitTest* test = static_cast<ResultChunkDecoderUnitTest*>(data);
+    test->chunk_count_++;
+
+    CassIterator* iterator = cass_iterator_from_result(chunk);
+    while (cass_iterator_next(iterator)) {
+      const CassRow* row = cass_iterator_get_row(iterator);
+      int32_t key;
+      EXPECT_EQ(CASS_OK, cass_value_get_int32(cass_row_get_column(row, 0), &key));
+      const char* value;
+      size_t value_length;
+      EXPECT_EQ(CASS_OK,
+                cass_value_get_string(cass_row_get_column(row, 1), &value, &value_length));
+      EXPECT_EQ(static_cast<int32_t>(test->keys_.size()), key);
+      test->keys_.push_back(key);
+      test->values_.push_back(String(value, value_length));
+    }
+    cass_iterator_free(iterator);
+  }
+
+protected:
+  int chunk_count_;
+  Vector<int32_t> keys_;
+  Vector<String> values_;
+};
+
+TEST_F(ResultChunkDecoderUnitTest, Rows) {
+  const int32_t row_count = 100;
+  ResultResponse::Ptr result(decode(encode_rows(row_count, "page1"), 37, streaming_callback()));
+  ASSERT_TRUE(result);
+
+  // The rows are only passed to the callback
+  EXPECT_EQ(CASS_RESULT_KIND_ROWS, result->kind());
+  EXPECT_EQ(0, result->row_count());
+  EXPECT_EQ(2, result->column_count());
+  EXPECT_TRUE(result->has_more_pages());
+  EXPECT_EQ("page1", result->paging_state().to_string());
+
+  ASSERT_EQ(static_cast<size_t>(row_count), keys_.size());
+  EXPECT_GT(chunk_count_, 1);
+  EXPECT_EQ("value0", values_.front());
+  EXPECT_EQ("value99", values_.back());
+}
+
+TEST_F(ResultChunkDecoderUnitTest, SingleRead) {
+  ResultResponse::Ptr result(decode(encode_rows(10), 64 * 1024, streaming_callback()));
+  ASSERT_TRUE(result);
+  EXPECT_EQ(0, result->row_count());
+  EXPECT_EQ(10u, keys_.size());
+  EXPECT_EQ(1, chunk_count_);
+}
+
+TEST_F(ResultChunkDecoderUnitTest, NotRows) {
+  ResultResponse::Ptr result(decode(encode_void(), 3, streaming_callback()));
+  ASSERT_TRUE(result);
+  EXPECT_EQ(CASS_RESULT_KIND_VOID, result->kind());
+  EXPECT_EQ(0, chunk_count_);
+}
+
+TEST_F(ResultChunkDecoderUnitTest, NotStreamed) {
+  // Results are buffered and decoded normally without a callback
+  ResultResponse::Ptr result(decode(encode_rows(10), 5));
+  ASSERT_TRUE(result);
+  EXPECT_EQ(10, result->row_count());
+  EXPECT_EQ(0, chunk_count_);
+}
+
+TEST_F(ResultChunkDecoderUnitTest, NotStreamedInOneDecode) {
+  // Without streaming the body is buffered right after the header
+  String frame(encode_rows(10));
+  ResponseMessage message;
+  EXPECT_EQ(static_cast<ssize_t>(frame.size()), message.decode(frame.data(), frame.size()));
+  EXPECT_FALSE(message.is_result_body_pending());
+  ASSERT_TRUE(message.is_body_ready());
+  EXPECT_EQ(10, static_cast<ResultResponse*>(message.response_body().get())->row_count());
+}
+
+#define ROWS_QUERY "SELECT * FROM ks.t"
+#define ROW_COUNT 100
+
+class ResultChunkStreamingUnitTest : public LoopTest {
+public:
+  struct Rows {
+    Rows()
+        : row_count(0)
+        , late_row_count(0)
+        , is_done(false) {}
+
+    Atomic<int> row_count;
+    Atomic<int> late_row_count; // Rows received after the future was set
+    Atomic<bool> is_done;
+    Vector<int32_t> keys; // Only accessed by the I/O thread until done
+  };
+
+  /**
+   * Writes the header and the first half of the body of a rows result, then
+   * runs the next action.
+   */
+  class PartialRows : public mockssandra::Action {
+  public:
+    PartialRows(Atomic<int>* request_count)
+        : request_count_(request_count) {}
+
+    void on_run(mockssandra::Request* request) const {
+      request_count_->fetch_add(1);
+      String body(rows_body());
+      String header;
+      header.push_back(static_cast<char>(0x80 | request->version()));
+      header.push_back(0); // Flags
+      header.push_back(static_cast<char>(request->stream() >> 8));
+      header.push_back(static_cast<char>(request->stream() & 0xFF));
+      header.push_back(mockssandra::OPCODE_RESULT);
+      mockssandra::encode_int32(body.size(), &header);
+      request->client()->write(header + body.substr(0, body.size() / 2));
+      run_next(request);
+    }
+
+  private:
+    Atomic<int>* request_count_;
+  };
+
+  /**
+   * Writes the remaining half of the body written by `PartialRows`.
+   */
+  class RemainingRows : public mockssandra::Action {
+  public:
+    void on_run(mockssandra::Request* request) const {
+      String body(rows_body());
+      request->client()->write(body.substr(body.size() / 2));
+      run_next(request);
+    }
+  };
+
+  static String rows_body() {
+    return ResultChunkDecoderUnitTest::encode_rows(ROW_COUNT).substr(CASS_HEADER_SIZE_V3);
+  }
+
+  static void connect(Session* session, unsigned request_timeout_ms) {
+    Config config;
+    config.contact_points().push_back(Address("127.0.0.1", 9042));
+    config.set_request_timeout(request_timeout_ms);
+    Future::Ptr connect_future(session->connect(config));
+    ASSERT_TRUE(connect_future->wait_for(WAIT_FOR_TIME))
+        << "Timed out waiting for session to connect";
+    ASSERT_FALSE(connect_future->error()) << cass_error_desc(connect_future->error()->code) << ": "
+                                          << connect_future->error()->message;
+  }
+
+  static void close(Session* session) {
+    Future::Ptr close_future(session->close());
+    ASSERT_TRUE(close_future->wait_for(WAIT_FOR_TIME))
+        << "Timed out waiting for session to close";
+  }
+
+  static Future::Ptr execute(Session* session, Rows* rows) {
+    QueryRequest::Ptr request(new QueryRequest(ROWS_QUERY));
+    request->set_is_idempotent(true);
+    request->set_result_chunk_callback(on_chunk, rows);
+    return session->execute(Request::ConstPtr(request));
+  }
+
+  static void on_chunk(const CassResult* chunk, void* data) {
+    Rows* rows = static_cast<Rows*>(data);
+    if (rows->is_done.load()) {
+      rows->late_row_count.fetch_add(static_cast<int>(cass_result_row_count(chunk)));
+      return;
+    }
+
+    CassIterator* iterator = cass_iterator_from_result(chunk);
+    while (cass_iterator_next(iterator)) {
+      int32_t key;
+      EXPECT_EQ(CASS_OK, cass_value_get_int32(
+                             cass_row_get_column(cass_iterator_get_row(iterator), 0), &key));
+      rows->keys.push_back(key);
+      rows->row_count.fetch_add(1);
+    }
+    cass_iterator_free(iterator);
+  }
+};
+
+TEST_F(ResultChunkStreamingUnitTest, Timeout) {
+  Atomic<int> request_count(0);
+  mockssandra::SimpleRequestHandlerBuilder builder;
+  builder.on(mockssandra::OPCODE_QUERY)
+      .system_local()
+      .system_peers()
+      .is_query(ROWS_QUERY)
+      .then(mockssandra::Action::Builder()
+                .execute(new PartialRows(&request_count))
+                .wait(500)
+                .execute(new RemainingRows()))
+      .void_result();
+  mockssandra::SimpleCluster cluster(builder.build());
+  ASSERT_EQ(cluster.start_all(), 0);
+
+  Session session;
+  connect(&session, 200);
+
+  Rows rows;
+  Future::Ptr future(execute(&session, &rows));
+  ASSERT_TRUE(future->wait_for(WAIT_FOR_TIME));
+  rows.is_done.store(true);
+  ASSERT_TRUE(future->error());
+  EXPECT_EQ(CASS_ERROR_LIB_REQUEST_TIMED_OUT, future->error()->code);
+
+  // The rest of the result is received after the timeout and it's dropped
+  test::Utils::msleep(600);
+  EXPECT_GT(rows.row_count.load(), 0);
+  EXPECT_LT(rows.row_count.load(), ROW_COUNT);
+  EXPECT_EQ(0, rows.late_row_count.load());
+  EXPECT_EQ(1, request_count.load());
+
+  close(&session);
+}
+
+TEST_F(ResultChunkStreamingUnitTest, ConnectionClosedMidResult) {
+  Atomic<int> request_count(0);
+  mockssandra::SimpleRequestHandlerBuilder builder;
+  builder.on(mockssandra::OPCODE_QUERY)
+      .system_local()
+      .system_peers()
+      .is_query(ROWS_QUERY)
+      .then(mockssandra::Action::Builder().execute(new PartialRows(&request_count)).close())
+      .void_result();
+  mockssandra::SimpleCluster cluster(builder.build(), 2);
+  ASSERT_EQ(cluster.start_all(), 0);
+
+  Session session;
+  connect(&session, CASS_DEFAULT_REQUEST_TIMEOUT_MS);
+
+  // The idempotent request isn't retried on the next host because that would
+  // pass the rows that were already received to the callback again.
+  Rows rows;
+  Future::Ptr future(execute(&session, &rows));
+  ASSERT_TRUE(future->wait_for(WAIT_FOR_TIME));
+  rows.is_done.store(true);
+  ASSERT_TRUE(future->error());
+  EXPECT_EQ(CASS_ERROR_LIB_RESULT_INTERRUPTED, future->error()->code);
+  EXPECT_EQ(1, request_count.load());
+
+  ASSERT_GT(rows.row_count.load(), 0);
+  EXPECT_LT(rows.row_count.load(), ROW_COUNT);
+  for (size_t i = 0; i < rows.keys.size(); ++i) {
+    EXPECT_EQ(static_cast<int32_t>(i), rows.keys[i]);
+  }
+
+  close(&session);
+}
@@ -0,0 +1,142 @@
+/*
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include <gtest/gtest.h>
+
+#include "buffer.hpp"
+#include "constants.hpp"
+#include "result_metadata_cache.hpp"
+#include "result_response.hpp"
+
+using namespace datastax;
+using namespace datastax::internal;
+using namespace datastax::internal::core;
+
+class ResultMetadataCacheUnitTest : public testing::Test {
+public:
+  virtual void SetUp() {
+    context_.metadata_cache = &cache_;
+    LoopContext::set_current(&context_);
+  }
+  virtual void TearDown() { LoopContext::set_current(NULL); }
+
+  ResultMetadataCache& cache() { return cache_; }
+
+  // Encodes a rows result for the table "ks.t" with the columns "<key> int"
+  // and "v list<text>"
+  static String encode_rows(const String& key, const String& paging_state = "") {
+    BufferVec bufs;
+    bufs.push_back(Buffer(sizeof(int32_t)));
+    bufs.back().encode_int32(0, CASS_RESULT_KIND_ROWS);
+
+    int32_t flags = CASS_RESULT_FLAG_GLOBAL_TABLESPEC;
+    if (!paging_state.empty()) flags |= CASS_RESULT_FLAG_HAS_MORE_PAGES;
+    bufs.push_back(Buffer(2 * sizeof(int32_t)));
+    bufs.back().encode_int32(bufs.back().encode_int32(0, flags), 2);
+    if (!paging_state.empty()) {
+      bufs.push_back(Buffer(sizeof(int32_t) + paging_state.size()));
+      bufs.back().encode_bytes(0, paging_state.data(), paging_state.size());
+    }
+    bufs.push_back(Buffer(sizeof(uint16_t) + 2));
+    bufs.back().encode_string(0, "ks", 2);
+    bufs.push_back(Buffer(sizeof(uint16_t) + 1));
+    bufs.back().encode_string(0, "t", 1);
+
+    bufs.push_back(Buffer(sizeof(uint16_t) + key.size() + sizeof(uint16_t)));
+    bufs.back().encode_uint16(bufs.back().encode_string(0, key.data(), key.size()),
+                              CASS_VALUE_TYPE_INT);
+    bufs.push_back(Buffer(sizeof(uint16_t) + 1 + 2 * sizeof(uint16_t)));
+    bufs.back().encode_uint16(
+        bufs.back().encode_uint16(bufs.back().encode_string(0, "v", 1), CASS_VALUE_TYPE_LIST),
+        CASS_VALUE_TYPE_TEXT);
+
+    // A single row with a null value for each column
+    bufs.push_back(Buffer(3 * sizeof(int32_t)));
+    bufs.back().encode_int32(bufs.back().encode_int32(bufs.back().encode_int32(0, 1), -1), -1);
+
+    String result;
+    for (BufferVec::const_iterator it = bufs.begin(), end = bufs.end(); it != end; ++it) {
+      result.append(it->data(), it->size());
+    }
+    return result;
+  }
+
+  static ResultResponse::Ptr decode(const String& body) {
+    ResultResponse::Ptr response(new ResultResponse());
+    response->set_buffer(body.size());
+    memcpy(response->data(), body.data(), body.size());
+    Decoder decoder(response->data(), body.size(), ProtocolVersion(4));
+    EXPECT_TRUE(response->decode(decoder));
+    return response;
+  }
+
+private:
+  ResultMetadataCache cache_;
+  LoopContext context_;
+};
+
+TEST_F(ResultMetadataCacheUnitTest, Pages) {
+  ResultResponse::Ptr first(decode(encode_rows("k", "page1")));
+  EXPECT_EQ(ResultResponse::METADATA_CACHE_MISS, first->metadata_cache_state());
+  ASSERT_EQ(2u, first->metadata()->column_count());
+
+  ResultResponse::Ptr second(decode(encode_rows("k", "page2")));
+  EXPECT_EQ(ResultResponse::METADATA_CACHE_HIT, second->metadata_cache_state());
+  EXPECT_EQ(first->metadata().get(), second->metadata().get());
+  EXPECT_EQ("page2", second->paging_state().to_string());
+  EXPECT_EQ("t", second->table().to_string());
+  EXPECT_EQ(1u, cache().size());
+
+  // The cached metadata doesn't reference the response's buffer
+  first.reset();
+  const ColumnDefinition& def = second->metadata()->get_column_definition(1);
+  EXPECT_EQ("v", def.name.to_string());
+  EXPECT_EQ(CASS_VALUE_TYPE_LIST, def.data_type->value_type());
+  EXPECT_EQ(1, second->row_count());
+}
+
+TEST_F(ResultMetadataCacheUnitTest, DifferentColumnSpecs) {
+  ResultResponse::Ptr first(decode(encode_rows("k1")));
+  ResultResponse::Ptr second(decode(encode_rows("k2")));
+
+  EXPECT_EQ(ResultResponse::METADATA_CACHE_MISS, second->metadata_cache_state());
+  EXPECT_NE(first->metadata().get(), second->metadata().get());
+  EXPECT_EQ("k2", second->metadata()->get_column_definition(0).name.to_string());
+  EXPECT_EQ(2u, cache().size());
+}
+
+TEST_F(ResultMetadataCacheUnitTest, Eviction) {
+  for (size_t i = 0; i <= ResultMetadataCache::MAX_ENTRIES; ++i) {
+    OStringStream ss;
+    ss << "k" << i;
+    decode(encode_rows(ss.str()));
+  }
+  EXPECT_EQ(static_cast<size_t>(ResultMetadataCache::MAX_ENTRIES), cache().size());
+
+  // The oldest entry was evicted
+  EXPECT_EQ(ResultResponse::METADATA_CACHE_MISS, decode(encode_rows("k0"))->metadata_cache_state());
+  EXPECT_EQ(ResultResponse::METADATA_CACHE_HIT, decode(encode_rows("k2"))->metadata_cache_state());
+}
+
+TEST(ResultMetadataCacheStandaloneUnitTest, NotCached) {
+  // Responses decoded outside of an event loop don't use a cache
+  ResultResponse::Ptr response(
+      ResultMetadataCacheUnitTest::decode(ResultMetadataCacheUnitTest::encode_rows("k")));
+  EXPECT_EQ(ResultResponse::METADATA_NOT_CACHED, response->metadata_cache_state());
+  EXPECT_EQ(2u, response->metadata()->column_count());
+}
@@ -0,0 +1,265 @@
+/*
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include "unit.hpp"
+
+#include "metadata.hpp"
+#include "schema_digest.hpp"
+
+#include <gtest/gtest.h>
+
+using namespace mockssandra;
+using datastax::String;
+using datastax::internal::core::ControlConnectionSchema;
+using datastax::internal::core::Decoder;
+using datastax::internal::core::KeyspaceMetadata;
+using datastax::internal::core::Metadata;
+using datastax::internal::core::ResultResponse;
+using datastax::internal::core::SchemaDelta;
+using datastax::internal::core::SchemaDigest;
+using datastax::internal::core::TableMetadata;
+using datastax::internal::core::VersionNumber;
+
+#define SERVER_VERSION VersionNumber(3, 11, 0)
+
+struct TestTable {
+  TestTable(const String& keyspace_name, const String& table_name,
+            const String& value_column_name = "v")
+      : keyspace_name(keyspace_name)
+      , table_name(table_name)
+      , value_column_name(value_column_name) {}
+
+  String keyspace_name;
+  String table_name;
+  String value_column_name;
+};
+
+typedef Vector<TestTable> TestTableVec;
+
+class SchemaDigestUnitTest : public testing::Test {
+public:
+  static ResultResponse::Ptr decode(const ResultSet& result_set) {
+    String body(result_set.encode(PROTOCOL_VERSION));
+    ResultResponse::Ptr result(new ResultResponse());
+    result->set_buffer(body.size());
+    memcpy(result->data(), body.data(), body.size());
+    Decoder decoder(result->data(), body.size(), PROTOCOL_VERSION);
+    if (!result->decode(decoder)) return ResultResponse::Ptr();
+    return result;
+  }
+
+  static ControlConnectionSchema schema(const Vector<String>& keyspace_names,
+                                        const TestTableVec& tables) {
+    ResultSet::Builder keyspaces =
+        ResultSet::Builder("system_schema", "keyspaces").column("keyspace_name", Type::text());
+    for (Vector<String>::const_iterator it = keyspace_names.begin(), end = keyspace_names.end();
+         it != end; ++it) {
+      keyspaces.row(Row::Builder().text(*it).build());
+    }
+
+    ResultSet::Builder table_rows = ResultSet::Builder("system_schema", "tables")
+                                        .column("keyspace_name", Type::text())
+                                        .column("table_name", Type::text());
+    ResultSet::Builder column_rows = ResultSet::Builder("system_schema", "columns")
+                                         .column("keyspace_name", Type::text())
+                                         .column("table_name", Type::text())
+                                         .column("column_name", Type::text())
+                                         .column("kind", Type::text())
+                                         .column("type", Type::text());
+    for (TestTableVec::const_iterator it = tables.begin(), end = tables.end(); it != end; ++it) {
+      table_rows.row(Row::Builder().text(it->keyspace_name).text(it->table_name).build());
+      column_rows.row(Row::Builder()
+                          .text(it->keyspace_name)
+                          .text(it->table_name)
+                          .text("key")
+                          .text("partition_key")
+                          .text("int")
+                          .build());
+      column_rows.row(Row::Builder()
+                          .text(it->keyspace_name)
+                          .text(it->table_name)
+                          .text(it->value_column_name)
+                          .text("regular")
+                          .text("text")
+                          .build());
+    }
+
+    ControlConnectionSchema schema;
+    schema.keyspaces = decode(keyspaces.build());
+    schema.tables = decode(table_rows.build());
+    schema.columns = decode(column_rows.build());
+    return schema;
+  }
+
+  static void update_metadata(const ControlConnectionSchema& schema, Metadata* metadata) {
+    if (schema.keyspaces) metadata->update_keyspaces(schema.keyspaces.get(), false);
+    if (schema.tables) metadata->update_tables(schema.tables.get());
+    if (schema.columns) metadata->update_columns(schema.columns.get());
+  }
+
+  // Applies a schema the same way as the cluster's schema update
+  static bool update(SchemaDigest* digest, const ControlConnectionSchema& schema,
+                     Metadata* metadata, SchemaDelta* delta) {
+    if (digest->update(SERVER_VERSION, schema, delta)) {
+      metadata->copy_front_and_update_back(SERVER_VERSION);
+      for (Vector<String>::const_iterator it = delta->dropped_keyspaces.begin(),
+                                          end = delta->dropped_keyspaces.end();
+           it != end; ++it) {
+        metadata->drop_keyspace(*it);
+      }
+      for (SchemaDelta::KeyspaceTableVec::const_iterator it = delta->dropped_tables.begin(),
+                                                         end = delta->dropped_tables.end();
+           it != end; ++it) {
+        metadata->drop_table_or_view(it->first, it->second);
+      }
+      update_metadata(delta->changed, metadata);
+      metadata->swap_to_back_and_update_front();
+      return true;
+    }
+    metadata->clear_and_update_back(SERVER_VERSION);
+    update_metadata(schema, metadata);
+    metadata->swap_to_back_and_update_front();
+    return false;
+  }
+
+  static Vector<String> keyspace_names(const char* name1, const char* name2) {
+    Vector<String> names;
+    names.push_back(name1);
+    names.push_back(name2);
+    return names;
+  }
+};
+
+TEST_F(SchemaDigestUnitTest, Delta) {
+  SchemaDigest digest;
+  Metadata metadata;
+
+  TestTableVec tables;
+  tables.push_back(TestTable("ks1", "t1"));
+  tables.push_back(TestTable("ks1", "t2"));
+  tables.push_back(TestTable("ks2", "t1"));
+
+  SchemaDelta delta;
+  EXPECT_FALSE(update(&digest, schema(keyspace_names("ks1", "ks2"), tables), &metadata, &delta));
+  EXPECT_FALSE(digest.is_empty());
+
+  Metadata::SchemaSnapshot before(metadata.schema_snapshot());
+  const KeyspaceMetadata* ks1_before = before.get_keyspace("ks1");
+  ASSERT_TRUE(ks1_before != NULL);
+  const TableMetadata* t1_before = ks1_before->get_table("t1");
+  ASSERT_TRUE(t1_before != NULL);
+
+  // Alter ks1.t2, drop ks2 and add ks3
+  tables.clear();
+  tables.push_back(TestTable("ks1", "t1"));
+  tables.push_back(TestTable("ks1", "t2", "v2"));
+  tables.push_back(TestTable("ks3", "t1"));
+
+  delta = SchemaDelta();
+  EXPECT_TRUE(update(&digest, schema(keyspace_names("ks1", "ks3"), tables), &metadata, &delta));
+
+  ASSERT_EQ(1u, delta.dropped_keyspaces.size());
+  EXPECT_EQ("ks2", delta.dropped_keyspaces[0]);
+  ASSERT_EQ(1u, delta.dropped_tables.size());
+  EXPECT_EQ("ks1", delta.dropped_tables[0].first);
+  EXPECT_EQ("t2", delta.dropped_tables[0].second);
+
+  // Only the rows of ks1.t2 and ks3 are applied
+  ASSERT_TRUE(delta.changed.keyspaces);
+  EXPECT_EQ(1, delta.changed.keyspaces->row_count());
+  ASSERT_TRUE(delta.changed.tables);
+  EXPECT_EQ(2, delta.changed.tables->row_count());
+  ASSERT_TRUE(delta.changed.columns);
+  EXPECT_EQ(4, delta.changed.columns->row_count());
+
+  Metadata::SchemaSnapshot after(metadata.schema_snapshot());
+  EXPECT_GT(after.version(), before.version());
+  EXPECT_TRUE(after.get_keyspace("ks2") == NULL);
+  ASSERT_TRUE(after.get_keyspace("ks3") != NULL);
+  EXPECT_TRUE(after.get_keyspace("ks3")->get_table("t1") != NULL);
+
+  const KeyspaceMetadata* ks1_after = after.get_keyspace("ks1");
+  ASSERT_TRUE(ks1_after != NULL);
+  ASSERT_TRUE(ks1_after->get_table("t2") != NULL);
+  EXPECT_TRUE(ks1_after->get_table("t2")->get_column("v2") != NULL);
+  EXPECT_TRUE(ks1_after->get_table("t2")->get_column("v") == NULL);
+
+  // The unchanged table is shared with the previous snapshot
+  EXPECT_EQ(t1_before, ks1_after->get_table("t1"));
+
+  // The previous snapshot isn't modified
+  EXPECT_TRUE(before.get_keyspace("ks2") != NULL);
+  EXPECT_TRUE(before.get_keyspace("ks3") == NULL);
+  EXPECT_TRUE(ks1_before->get_table("t2")->get_column("v") != NULL);
+  EXPECT_TRUE(ks1_before->get_table("t2")->get_column("v2") == NULL);
+
+  // Nothing is applied if the schema hasn't changed
+  delta = SchemaDelta();
+  EXPECT_TRUE(update(&digest, schema(keyspace_names("ks1", "ks3"), tables), &metadata, &delta));
+  EXPECT_TRUE(delta.dropped_keyspaces.empty());
+  EXPECT_TRUE(delta.dropped_tables.empty());
+  EXPECT_FALSE(delta.changed.keyspaces);
+  EXPECT_FALSE(delta.changed.tables);
+  EXPECT_FALSE(delta.changed.columns);
+}
+
+TEST_F(SchemaDigestUnitTest, InvalidateKeyspace) {
+  SchemaDigest digest;
+  Metadata metadata;
+
+  TestTableVec tables;
+  tables.push_back(TestTable("ks1", "t1"));
+  tables.push_back(TestTable("ks2", "t1"));
+
+  SchemaDelta delta;
+  EXPECT_FALSE(update(&digest, schema(keyspace_names("ks1", "ks2"), tables), &metadata, &delta));
+
+  // A keyspace modified by a schema event is rebuilt even if its rows match
+  // the digests.
+  digest.invalidate_keyspace("ks1");
+
+  delta = SchemaDelta();
+  EXPECT_TRUE(update(&digest, schema(keyspace_names("ks1", "ks2"), tables), &metadata, &delta));
+  ASSERT_EQ(1u, delta.dropped_keyspaces.size());
+  EXPECT_EQ("ks1", delta.dropped_keyspaces[0]);
+  EXPECT_TRUE(delta.dropped_tables.empty());
+  ASSERT_TRUE(delta.changed.keyspaces);
+  EXPECT_EQ(1, delta.changed.keyspaces->row_count());
+  ASSERT_TRUE(delta.changed.tables);
+  EXPECT_EQ(1, delta.changed.tables->row_count());
+
+  Metadata::SchemaSnapshot snapshot(metadata.schema_snapshot());
+  ASSERT_TRUE(snapshot.get_keyspace("ks1") != NULL);
+  EXPECT_TRUE(snapshot.get_keyspace("ks1")->get_table("t1") != NULL);
+  EXPECT_TRUE(snapshot.get_keyspace("ks2") != NULL);
+}
+
+TEST_F(SchemaDigestUnitTest, ServerVersionChanged) {
+  SchemaDigest digest;
+
+  TestTableVec tables;
+  tables.push_back(TestTable("ks1", "t1"));
+
+  SchemaDelta delta;
+  EXPECT_FALSE(digest.update(SERVER_VERSION, schema(keyspace_names("ks1", "ks2"), tables), &delta));
+  EXPECT_TRUE(digest.update(SERVER_VERSION, schema(keyspace_names("ks1", "ks2"), tables), &delta));
+
+  // The metadata needs to be fully rebuilt if the server version changes
+  EXPECT_FALSE(
+      digest.update(VersionNumber(4, 0, 0), schema(keyspace_names("ks1", "ks2"), tables), &delta));
+}
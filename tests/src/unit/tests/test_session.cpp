@@ -457,6 +457,60 @@ TEST_F(SessionUnitTest, ExecuteQueryWithThreads) {
   close(&session);
 }
 
+TEST_F(SessionUnitTest, ExecuteMany) {
+  mockssandra::SimpleCluster cluster(simple());
+  ASSERT_EQ(cluster.start_all(), 0);
+
+  Config config;
+  config.contact_points().push_back(Address("127.0.0.1", 9042));
+  config.set_thread_count_io(2);
+
+  Session session;
+  connect(config, &session);
+
+  Vector<Request::ConstPtr> requests;
+  for (int i = 0; i < 11; ++i) {
+    requests.push_back(Request::ConstPtr(new QueryRequest("blah", 0)));
+  }
+
+  Vector<Future::Ptr> futures;
+  session.execute_many(requests, &futures);
+  ASSERT_EQ(requests.size(), futures.size());
+  for (Vector<Future::Ptr>::const_iterator it = futures.begin(), end = futures.end(); it != end;
+       ++it) {
+    ASSERT_TRUE((*it)->wait_for(WAIT_FOR_TIME)) << "Timed out executing query";
+    EXPECT_FALSE((*it)->error())
+        << cass_error_desc((*it)->error()->code) << ": " << (*it)->error()->message;
+  }
+
+  close(&session);
+
+  futures.clear();
+  session.execute_many(requests, &futures);
+  ASSERT_EQ(requests.size(), futures.size());
+  EXPECT_EQ(CASS_ERROR_LIB_NO_HOSTS_AVAILABLE, futures.front()->error()->code);
+}
+
+#ifdef HAVE_IO_URING
+TEST_F(SessionUnitTest, ExecuteQueryUsingIoUring) {
+  mockssandra::SimpleCluster cluster(simple(), 3);
+  ASSERT_EQ(cluster.start_all(), 0);
+
+  Config config;
+  config.contact_points().push_back(Address("127.0.0.1", 9042));
+  config.set_thread_count_io(2);
+  config.set_use_io_uring(true);
+
+  Session session;
+  connect(config, &session);
+  for (int i = 0; i < 100; ++i) {
+    query(&session);
+  }
+  query_on_threads(&session);
+  close(&session);
+}
+#endif
+
 TEST_F(SessionUnitTest, ExecuteQueryWithThreadsUsingSsl) {
   mockssandra::SimpleCluster cluster(simple());
   SslContext::Ptr ssl_context = use_ssl(&cluster).socket_settings.ssl_context;
@@ -0,0 +1,235 @@
+/*
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include <gtest/gtest.h>
+
+#include "event_loop.hpp"
+#include "memory.hpp"
+#include "slab_allocator.hpp"
+#include "vector.hpp"
+
+#include <string.h>
+#include <uv.h>
+
+using namespace datastax::internal;
+using namespace datastax::internal::core;
+
+class SlabAllocatorUnitTest : public testing::Test {
+public:
+  SlabAllocatorUnitTest()
+      : allocator_(NULL) {}
+
+  virtual void SetUp() {
+    allocator_ = new SlabAllocator();
+    context_.allocator = allocator_;
+    LoopContext::set_current(&context_);
+  }
+
+  virtual void TearDown() {
+    LoopContext::set_current(NULL);
+    allocator_->release();
+  }
+
+  SlabAllocator* allocator() { return allocator_; }
+
+private:
+  SlabAllocator* allocator_;
+  LoopContext context_;
+};
+
+static void free_on_thread(void* arg) { SlabAllocator::free(arg); }
+
+// Counts the allocations made using `Memory` that haven't been freed
+static int live_allocation_count = 0;
+
+static void* counting_malloc(size_t size) {
+  ++live_allocation_count;
+  return malloc(size);
+}
+
+static void* counting_realloc(void* ptr, size_t size) {
+  if (ptr == NULL) ++live_allocation_count;
+  return realloc(ptr, size);
+}
+
+static void counting_free(void* ptr) {
+  if (ptr != NULL) --live_allocation_count;
+  free(ptr);
+}
+
+class CheckAllocator : public Task {
+public:
+  CheckAllocator(bool* has_allocator)
+      : has_allocator_(has_allocator) {}
+
+  virtual void run(EventLoop* event_loop) { *has_allocator_ = SlabAllocator::current() != NULL; }
+
+private:
+  bool* has_allocator_;
+};
+
+TEST(SlabAllocatorStandaloneUnitTest, Fallback) {
+  ASSERT_TRUE(SlabAllocator::current() == NULL);
+
+  char* ptr = static_cast<char*>(SlabAllocator::malloc(100));
+  ASSERT_TRUE(ptr != NULL);
+  memset(ptr, 'a', 100);
+  SlabAllocator::free(ptr);
+
+  SlabAllocator::free(NULL); // Ignored
+}
+
+TEST_F(SlabAllocatorUnitTest, Reuse) {
+  void* ptr1 = SlabAllocator::malloc(100);
+  ASSERT_TRUE(ptr1 != NULL);
+  EXPECT_EQ(1u, allocator()->outstanding_count());
+  EXPECT_EQ(1u, allocator()->slab_count());
+
+  SlabAllocator::free(ptr1);
+  EXPECT_EQ(0u, allocator()->outstanding_count());
+
+  void* ptr2 = SlabAllocator::malloc(128); // Same size class
+  EXPECT_EQ(ptr1, ptr2);
+  SlabAllocator::free(ptr2);
+}
+
+TEST_F(SlabAllocatorUnitTest, SizeClasses) {
+  void* small = SlabAllocator::malloc(SlabAllocator::SIZE_CLASS_GRANULARITY);
+  SlabAllocator::free(small);
+
+  void* larger = SlabAllocator::malloc(SlabAllocator::SIZE_CLASS_GRANULARITY + 1);
+  EXPECT_NE(small, larger);
+  EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(larger) % SlabAllocator::HEADER_SIZE);
+  SlabAllocator::free(larger);
+
+  // Too large for the allocator
+  void* large = SlabAllocator::malloc(SlabAllocator::MAX_BLOCK_SIZE + 1);
+  EXPECT_EQ(0u, allocator()->outstanding_count());
+  SlabAllocator::free(large);
+}
+
+TEST_F(SlabAllocatorUnitTest, ManySlabs) {
+  const size_t count = 2 * SlabAllocator::SLAB_SIZE / SlabAllocator::MAX_BLOCK_SIZE;
+
+  Vector<void*> ptrs;
+  for (size_t i = 0; i < count; ++i) {
+    ptrs.push_back(SlabAllocator::malloc(SlabAllocator::MAX_BLOCK_SIZE));
+    memset(ptrs.back(), 'a', SlabAllocator::MAX_BLOCK_SIZE);
+  }
+  EXPECT_GE(allocator()->slab_count(), 2u);
+  EXPECT_EQ(count, allocator()->outstanding_count());
+
+  for (size_t i = 0; i < count; ++i) {
+    SlabAllocator::free(ptrs[i]);
+  }
+  EXPECT_EQ(0u, allocator()->outstanding_count());
+}
+
+TEST_F(SlabAllocatorUnitTest, BurstIsReturned) {
+  const size_t max_slab_count = SlabAllocator::MAX_SLAB_COUNT;
+  const size_t count = 4 * max_slab_count * SlabAllocator::SLAB_SIZE / SlabAllocator::MAX_BLOCK_SIZE;
+
+  Vector<void*> ptrs;
+  ptrs.reserve(count);
+
+  live_allocation_count = 0;
+  Memory::set_functions(counting_malloc, counting_realloc, counting_free);
+
+  for (size_t i = 0; i < count; ++i) {
+    ptrs.push_back(SlabAllocator::malloc(SlabAllocator::MAX_BLOCK_SIZE));
+    memset(ptrs.back(), 'a', SlabAllocator::MAX_BLOCK_SIZE);
+  }
+  EXPECT_EQ(max_slab_count, allocator()->slab_count());
+  EXPECT_GT(live_allocation_count, static_cast<int>(max_slab_count));
+
+  for (size_t i = 0; i < count; ++i) {
+    SlabAllocator::free(ptrs[i]);
+  }
+  EXPECT_EQ(0u, allocator()->outstanding_count());
+
+  // Only the slabs are kept after the burst
+  EXPECT_EQ(static_cast<int>(max_slab_count), live_allocation_count);
+
+  Memory::set_functions(NULL, NULL, NULL);
+}
+
+TEST_F(SlabAllocatorUnitTest, SlabRemainder) {
+  // Blocks for 256 bytes don't fill a slab exactly
+  const size_t block_size = SlabAllocator::HEADER_SIZE + 256;
+  const size_t count = (SlabAllocator::SLAB_SIZE - SlabAllocator::HEADER_SIZE) / block_size;
+  const size_t remaining = (SlabAllocator::SLAB_SIZE - SlabAllocator::HEADER_SIZE) % block_size;
+  ASSERT_GE(remaining, SlabAllocator::HEADER_SIZE + SlabAllocator::SIZE_CLASS_GRANULARITY);
+
+  Vector<void*> ptrs;
+  for (size_t i = 0; i <= count; ++i) {
+    ptrs.push_back(SlabAllocator::malloc(256));
+  }
+  EXPECT_EQ(2u, allocator()->slab_count());
+
+  // The largest block that fits is allocated from the remainder of the first
+  // slab
+  char* remainder = static_cast<char*>(ptrs.front()) + count * block_size;
+  void* ptr = SlabAllocator::malloc(remaining - SlabAllocator::HEADER_SIZE -
+                                    (remaining - SlabAllocator::HEADER_SIZE) %
+                                        SlabAllocator::SIZE_CLASS_GRANULARITY);
+  EXPECT_EQ(remainder, ptr);
+  SlabAllocator::free(ptr);
+
+  for (size_t i = 0; i < ptrs.size(); ++i) {
+    SlabAllocator::free(ptrs[i]);
+  }
+}
+
+TEST_F(SlabAllocatorUnitTest, RemoteFree) {
+  void* ptr1 = SlabAllocator::malloc(100);
+
+  uv_thread_t thread;
+  ASSERT_EQ(0, uv_thread_create(&thread, free_on_thread, ptr1));
+  ASSERT_EQ(0, uv_thread_join(&thread));
+  EXPECT_EQ(0u, allocator()->outstanding_count());
+
+  // The block is reclaimed from the remote free list
+  void* ptr2 = SlabAllocator::malloc(100);
+  EXPECT_EQ(ptr1, ptr2);
+  SlabAllocator::free(ptr2);
+}
+
+TEST(SlabAllocatorStandaloneUnitTest, ReleaseWithOutstanding) {
+  SlabAllocator* allocator = new SlabAllocator();
+  LoopContext context;
+  context.allocator = allocator;
+  LoopContext::set_current(&context);
+  void* ptr = SlabAllocator::malloc(100);
+  LoopContext::set_current(NULL);
+
+  allocator->release();
+  SlabAllocator::free(ptr); // Frees the allocator
+}
+
+TEST(SlabAllocatorStandaloneUnitTest, EventLoop) {
+  bool has_allocator = false;
+
+  EventLoop event_loop;
+  ASSERT_EQ(0, event_loop.init("SlabAllocatorUnitTest::EventLoop"));
+  ASSERT_EQ(0, event_loop.run());
+  event_loop.add(new CheckAllocator(&has_allocator));
+  event_loop.close_handles();
+  event_loop.join();
+
+  EXPECT_TRUE(has_allocator);
+}
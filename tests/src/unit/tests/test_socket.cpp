@@ -19,9 +19,16 @@
 #include "loop_test.hpp"
 #
 #include "connector.hpp"
+#include "io_uring.hpp"
 #include "socket_connector.hpp"
 #include "ssl.hpp"
 
+#ifdef HAVE_IO_URING
+#include <errno.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
 #define DNS_HOSTNAME "cpp-driver.hostname."
 #define DNS_IP_ADDRESS "127.254.254.254"
 
@@ -86,7 +93,7 @@ public:
     if (nread > 0) {
       result_->append(buf->base, nread);
     }
-    free_buffer(buf);
+    free_buffer(nread, buf);
     if (result_->find("Closed") != std::string::npos) {
       socket->close();
     }
@@ -100,6 +107,26 @@ private:
   String* result_;
 };
 
+#ifdef HAVE_IO_URING
+// Counts the reads that used the loop's io_uring buffers
+class IoUringTestSocketHandler : public TestSocketHandler {
+public:
+  IoUringTestSocketHandler(String* result, int* read_buffer_count)
+      : TestSocketHandler(result)
+      , read_buffer_count_(read_buffer_count) {}
+
+  virtual void on_read(Socket* socket, ssize_t nread, const uv_buf_t* buf) {
+    if (nread > 0 && IoUring::current()->is_read_buffer(buf->base)) {
+      ++(*read_buffer_count_);
+    }
+    TestSocketHandler::on_read(socket, nread, buf);
+  }
+
+private:
+  int* read_buffer_count_;
+};
+#endif
+
 class SslTestSocketHandler : public SslSocketHandler {
 public:
   SslTestSocketHandler(SslSession* ssl_session, String* result)
@@ -177,6 +204,67 @@ public:
     }
   }
 
+  static void on_socket_connected_many_writes(SocketConnector* connector, String* result) {
+    Socket::Ptr socket = connector->release_socket();
+    ASSERT_EQ(SocketConnector::SOCKET_OK, connector->error_code())
+        << "Failed to connect: " << connector->error_message();
+    socket->set_handler(new TestSocketHandler(result));
+    for (int i = 0; i < 100; ++i) {
+      OStringStream ss;
+      ss << i << " ";
+      String data(ss.str());
+      socket->write(new BufferSocketRequest(Buffer(data.data(), data.size())));
+      socket->flush();
+    }
+    socket->write_and_flush(new BufferSocketRequest(Buffer("Closed", sizeof("Closed") - 1)));
+  }
+
+#ifdef HAVE_IO_URING
+  struct ReusedFd {
+    ReusedFd()
+        : closed_fd(-1) {
+      pair[0] = pair[1] = -1;
+    }
+
+    String result;
+    int closed_fd;
+    int pair[2];
+  };
+
+  struct LargeRead {
+    LargeRead()
+        : read_buffer_count(0) {}
+
+    String data;
+    String result;
+    int read_buffer_count;
+  };
+
+  static void on_socket_connected_large_read(SocketConnector* connector, LargeRead* large) {
+    Socket::Ptr socket = connector->release_socket();
+    ASSERT_EQ(SocketConnector::SOCKET_OK, connector->error_code())
+        << "Failed to connect: " << connector->error_message();
+    socket->set_handler(new IoUringTestSocketHandler(&large->result, &large->read_buffer_count));
+    socket->write(new BufferSocketRequest(Buffer(large->data.data(), large->data.size())));
+    socket->write_and_flush(new BufferSocketRequest(Buffer("Closed", sizeof("Closed") - 1)));
+  }
+
+  // Flush a write and close the socket before the loop submits the write.
+  // The socket's file descriptor number is then reused by a socket pair.
+  static void on_socket_connected_close_after_flush(SocketConnector* connector,
+                                                    ReusedFd* reused) {
+    Socket::Ptr socket = connector->release_socket();
+    ASSERT_EQ(SocketConnector::SOCKET_OK, connector->error_code())
+        << "Failed to connect: " << connector->error_message();
+    socket->set_handler(new TestSocketHandler(&reused->result));
+    ASSERT_EQ(0, uv_fileno(reinterpret_cast<uv_handle_t*>(socket->handle()), &reused->closed_fd));
+    const char* data = "Not for the socket pair";
+    socket->write_and_flush(new BufferSocketRequest(Buffer(data, strlen(data))));
+    socket->close();
+    ASSERT_EQ(0, socketpair(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK, 0, reused->pair));
+  }
+#endif
+
   static void on_socket_refused(SocketConnector* connector, bool* is_refused) {
     if (connector->error_code() == SocketConnector::SOCKET_ERROR_CONNECT) {
       *is_refused = true;
@@ -251,6 +339,96 @@ TEST_F(SocketUnitTest, Simple) {
   EXPECT_EQ(result, "The socket is successfully connected and wrote data - Closed");
 }
 
+#ifdef HAVE_IO_URING
+TEST_F(SocketUnitTest, IoUring) {
+  listen();
+
+  IoUring io_uring;
+  ASSERT_EQ(0, io_uring.init(loop(), 16));
+  LoopContext context;
+  context.io_uring = &io_uring;
+  LoopContext::set_current(&context);
+
+  String result;
+  SocketConnector::Ptr connector(new SocketConnector(
+      Address("127.0.0.1", 8888), bind_callback(on_socket_connected_many_writes, &result)));
+  connector->connect(loop());
+  uv_run(loop(), UV_RUN_DEFAULT);
+
+  OStringStream expected;
+  for (int i = 0; i < 100; ++i) {
+    expected << i << " ";
+  }
+  expected << "Closed";
+  EXPECT_EQ(expected.str(), result);
+
+  LoopContext::set_current(NULL);
+  io_uring.close_handles();
+  uv_run(loop(), UV_RUN_DEFAULT);
+}
+
+TEST_F(SocketUnitTest, IoUringRead) {
+  listen();
+
+  IoUring io_uring;
+  ASSERT_EQ(0, io_uring.init(loop(), 16));
+  LoopContext context;
+  context.io_uring = &io_uring;
+  LoopContext::set_current(&context);
+
+  // Larger than several of the ring's read buffers
+  LargeRead large;
+  large.data.assign(1024 * 1024, 'a');
+  SocketConnector::Ptr connector(new SocketConnector(
+      Address("127.0.0.1", 8888), bind_callback(on_socket_connected_large_read, &large)));
+  connector->connect(loop());
+  uv_run(loop(), UV_RUN_DEFAULT);
+
+  EXPECT_EQ(large.data + "Closed", large.result);
+  if (io_uring.has_read_buffers()) { // Multishot receives require Linux 6.0+
+    EXPECT_GT(large.read_buffer_count, 1);
+  } else {
+    EXPECT_EQ(0, large.read_buffer_count);
+  }
+
+  LoopContext::set_current(NULL);
+  io_uring.close_handles();
+  uv_run(loop(), UV_RUN_DEFAULT);
+}
+
+TEST_F(SocketUnitTest, IoUringCloseAfterFlush) {
+  listen();
+
+  IoUring io_uring;
+  ASSERT_EQ(0, io_uring.init(loop(), 16));
+  LoopContext context;
+  context.io_uring = &io_uring;
+  LoopContext::set_current(&context);
+
+  ReusedFd reused;
+  SocketConnector::Ptr connector(
+      new SocketConnector(Address("127.0.0.1", 8888),
+                          bind_callback(on_socket_connected_close_after_flush, &reused)));
+  connector->connect(loop());
+  uv_run(loop(), UV_RUN_DEFAULT);
+
+  LoopContext::set_current(NULL);
+  io_uring.close_handles();
+  uv_run(loop(), UV_RUN_DEFAULT);
+
+  ASSERT_GE(reused.pair[0], 0);
+  EXPECT_EQ(reused.closed_fd, reused.pair[0]); // Otherwise the test is inconclusive
+
+  // The write must not have been sent using the reused file descriptor
+  char buf[64];
+  EXPECT_EQ(-1, read(reused.pair[1], buf, sizeof(buf)));
+  EXPECT_EQ(EAGAIN, errno);
+
+  ::close(reused.pair[0]);
+  ::close(reused.pair[1]);
+}
+#endif
+
 TEST_F(SocketUnitTest, SimpleDns) {
   if (!verify_dns()) return;
 
@@ -0,0 +1,111 @@
+/*
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include <gtest/gtest.h>
+
+#include "constants.hpp"
+#include "speculative_execution.hpp"
+#include "test_utils.hpp"
+
+using namespace datastax::internal;
+using namespace datastax::internal::core;
+
+#define ONE_MS_IN_NS (1000LL * 1000LL)
+
+// Record the latencies of a full window. The window's latencies are
+// 1..`count` milliseconds.
+static void record_window(SpeculativeExecutionPolicy* policy, int count) {
+  for (int i = 1; i <= count; ++i) {
+    policy->record_latency(i * ONE_MS_IN_NS);
+  }
+  test::Utils::msleep(CASS_DEFAULT_SPECULATIVE_EXECUTION_WINDOW_MS + 50);
+  policy->record_latency(ONE_MS_IN_NS); // Ends the window
+}
+
+TEST(SpeculativeExecutionUnitTest, Constant) {
+  SpeculativeExecutionPolicy::Ptr policy(new ConstantSpeculativeExecutionPolicy(50, 2));
+  SpeculativeExecutionPlan plan(policy->new_plan("", NULL));
+  EXPECT_EQ(50, plan.next_execution(Host::Ptr()));
+  EXPECT_EQ(50, plan.next_execution(Host::Ptr()));
+  EXPECT_EQ(-1, plan.next_execution(Host::Ptr()));
+
+  SpeculativeExecutionPolicy::Ptr none(new NoSpeculativeExecutionPolicy());
+  plan = none->new_plan("", NULL);
+  EXPECT_EQ(-1, plan.next_execution(Host::Ptr()));
+}
+
+TEST(SpeculativeExecutionUnitTest, Percentile) {
+  SharedRefPtr<PercentileSpeculativeExecutionPolicy> policy(
+      new PercentileSpeculativeExecutionPolicy(90.0, 1, 0.0));
+
+  // No executions are started until there are enough samples
+  SpeculativeExecutionPlan plan(policy->new_plan("", NULL));
+  EXPECT_EQ(-1, plan.next_execution(Host::Ptr()));
+
+  record_window(policy.get(), CASS_DEFAULT_SPECULATIVE_EXECUTION_MIN_SAMPLES / 2);
+  EXPECT_EQ(-1, policy->delay_ms());
+
+  record_window(policy.get(), CASS_DEFAULT_SPECULATIVE_EXECUTION_MIN_SAMPLES);
+  // The 90th percentile is rounded up to the histogram's precision
+  EXPECT_NEAR(CASS_DEFAULT_SPECULATIVE_EXECUTION_MIN_SAMPLES * 9 / 10, policy->delay_ms(), 2);
+
+  plan = policy->new_plan("", NULL);
+  EXPECT_EQ(policy->delay_ms(), plan.next_execution(Host::Ptr()));
+  EXPECT_EQ(-1, plan.next_execution(Host::Ptr())); // Max speculative executions
+}
+
+TEST(SpeculativeExecutionUnitTest, PercentileRatio) {
+  SharedRefPtr<PercentileSpeculativeExecutionPolicy> policy(
+      new PercentileSpeculativeExecutionPolicy(50.0, 1, 0.1));
+  record_window(policy.get(), CASS_DEFAULT_SPECULATIVE_EXECUTION_MIN_SAMPLES);
+  ASSERT_GT(policy->delay_ms(), 0);
+
+  // Only one in ten requests starts a speculative execution
+  int count = 0;
+  for (int i = 0; i < 100; ++i) {
+    SpeculativeExecutionPlan plan(policy->new_plan("", NULL));
+    if (plan.next_execution(Host::Ptr()) >= 0 && plan.start_execution()) count++;
+  }
+  EXPECT_EQ(10, count);
+}
+
+TEST(SpeculativeExecutionUnitTest, PercentileRatioCanceled) {
+  SharedRefPtr<PercentileSpeculativeExecutionPolicy> policy(
+      new PercentileSpeculativeExecutionPolicy(50.0, 1, 0.1));
+  record_window(policy.get(), CASS_DEFAULT_SPECULATIVE_EXECUTION_MIN_SAMPLES);
+  ASSERT_GT(policy->delay_ms(), 0);
+
+  // Every request schedules a speculative execution, but most of them finish
+  // before it starts. Only the executions that start count against the ratio.
+  int scheduled = 0;
+  int started = 0;
+  for (int i = 0; i < 100; ++i) {
+    SpeculativeExecutionPlan plan(policy->new_plan("", NULL));
+    if (plan.next_execution(Host::Ptr()) >= 0) scheduled++;
+    if (i % 20 == 19 && plan.start_execution()) started++;
+  }
+  EXPECT_EQ(100, scheduled);
+  EXPECT_EQ(5, started);
+
+  // The unused budget is still available to later requests
+  for (int i = 0; i < 100; ++i) {
+    SpeculativeExecutionPlan plan(policy->new_plan("", NULL));
+    if (plan.next_execution(Host::Ptr()) >= 0 && plan.start_execution()) started++;
+  }
+  EXPECT_EQ(20, started);
+}
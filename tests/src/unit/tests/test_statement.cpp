@@ -22,7 +22,9 @@
 #include "constants.hpp"
 #include "control_connection.hpp"
 #include "query_request.hpp"
+#include "request_callback.hpp"
 #include "session.hpp"
+#include "test_token_map_utils.hpp"
 
 using namespace datastax::internal::core;
 
@@ -168,3 +170,226 @@ TEST_F(StatementUnitTest, ErrorParametersUnset) {
   ASSERT_TRUE(future->error());
   EXPECT_EQ(future->error()->code, CASS_ERROR_LIB_PARAMETER_UNSET);
 }
+
+static Buffer encode_values(const Statement::Ptr& request) {
+  const AbstractData& data = *request;
+  return data.encode();
+}
+
+static int32_t value_length_at(const Buffer& buf, size_t pos) {
+  int32_t length;
+  datastax::internal::decode_int32(buf.data() + pos, length);
+  return length;
+}
+
+TEST(StatementBindUnitTest, EncodeValues) {
+  Statement::Ptr request(new QueryRequest("INSERT INTO t (k, v, s) VALUES (?, ?, ?)", 3));
+
+  String text(1024, 'a');
+  SharedRefPtr<Collection> collection(new Collection(CASS_COLLECTION_TYPE_SET, 2));
+  ASSERT_EQ(CASS_OK, collection->append(CassString("x", 1)));
+  ASSERT_EQ(CASS_OK, collection->append(CassString("y", 1)));
+
+  ASSERT_EQ(CASS_OK, request->set(0, CassString(text.data(), text.size())));
+  ASSERT_EQ(CASS_OK, request->set(1, static_cast<cass_int32_t>(42)));
+  ASSERT_EQ(CASS_OK, request->set(2, collection.get()));
+
+  Buffer buf(encode_values(request));
+  ASSERT_EQ(sizeof(int32_t) + text.size() + sizeof(int32_t) + sizeof(int32_t) +
+                collection->get_size_with_length(),
+            buf.size());
+
+  size_t pos = 0;
+  EXPECT_EQ(static_cast<int32_t>(text.size()), value_length_at(buf, pos));
+  EXPECT_EQ(text, String(buf.data() + pos + sizeof(int32_t), text.size()));
+  pos += sizeof(int32_t) + text.size();
+  EXPECT_EQ(static_cast<int32_t>(sizeof(int32_t)), value_length_at(buf, pos));
+  EXPECT_EQ(42, value_length_at(buf, pos + sizeof(int32_t)));
+  pos += 2 * sizeof(int32_t);
+  Buffer encoded_collection(collection->encode_with_length());
+  EXPECT_EQ(0, memcmp(buf.data() + pos, encoded_collection.data(), encoded_collection.size()));
+}
+
+TEST(StatementBindUnitTest, RebindValues) {
+  Statement::Ptr request(new QueryRequest("INSERT INTO t (k, v) VALUES (?, ?)", 2));
+
+  String text(100, 'a');
+  ASSERT_EQ(CASS_OK, request->set(0, CassString(text.data(), text.size())));
+  ASSERT_EQ(CASS_OK, request->set(1, static_cast<cass_int32_t>(1)));
+  Buffer first(encode_values(request));
+
+  // The encoded values of the previous request must not be modified
+  ASSERT_EQ(CASS_OK, request->set(1, static_cast<cass_int32_t>(2)));
+  ASSERT_EQ(CASS_OK, request->set(0, CassString("b", 1)));
+  Buffer second(encode_values(request));
+
+  ASSERT_EQ(2 * sizeof(int32_t) + text.size() + sizeof(int32_t), first.size());
+  EXPECT_EQ(text, String(first.data() + sizeof(int32_t), text.size()));
+  EXPECT_EQ(1, value_length_at(first, 2 * sizeof(int32_t) + text.size()));
+
+  ASSERT_EQ(sizeof(int32_t) + 1 + 2 * sizeof(int32_t), second.size());
+  EXPECT_EQ(1, value_length_at(second, 0));
+  EXPECT_EQ('b', second.data()[sizeof(int32_t)]);
+  EXPECT_EQ(2, value_length_at(second, 2 * sizeof(int32_t) + 1));
+}
+
+TEST(StatementBindUnitTest, UnsetValues) {
+  Statement::Ptr request(new QueryRequest("INSERT INTO t (k, v) VALUES (?, ?)", 2));
+
+  ASSERT_EQ(CASS_OK, request->set(1, static_cast<cass_int32_t>(1)));
+  Buffer buf(encode_values(request));
+
+  ASSERT_EQ(3 * sizeof(int32_t), buf.size());
+  EXPECT_EQ(-1, value_length_at(buf, 0)); // Unset values are encoded as null
+  EXPECT_EQ(static_cast<int32_t>(sizeof(int32_t)), value_length_at(buf, sizeof(int32_t)));
+}
+
+class EncodeRequestCallback : public SimpleRequestCallback {
+public:
+  EncodeRequestCallback(const Request::ConstPtr& request)
+      : SimpleRequestCallback(request) {}
+
+  String encode(ProtocolVersion version) {
+    BufferVec bufs;
+    int32_t length = request()->encode(version, this, &bufs);
+    if (length < 0) return String();
+    String encoded;
+    for (BufferVec::const_iterator it = bufs.begin(), end = bufs.end(); it != end; ++it) {
+      encoded.append(it->data(), it->size());
+    }
+    EXPECT_EQ(static_cast<size_t>(length), encoded.size());
+    return encoded;
+  }
+
+private:
+  virtual void on_internal_set(ResponseMessage* response) {}
+  virtual void on_internal_error(CassError code, const String& message) {}
+  virtual void on_internal_timeout() {}
+};
+
+TEST(StatementBindUnitTest, FrozenEncode) {
+  const char* query = "INSERT INTO t (k, v) VALUES (?, ?)";
+  Statement::Ptr request(new QueryRequest(query, 2));
+  Statement::Ptr frozen(new QueryRequest(query, 2));
+  frozen->freeze();
+  ASSERT_TRUE(frozen->is_frozen());
+
+  SharedRefPtr<EncodeRequestCallback> callback(new EncodeRequestCallback(request));
+  SharedRefPtr<EncodeRequestCallback> frozen_callback(new EncodeRequestCallback(frozen));
+
+  for (int i = 0; i < 3; ++i) { // Re-use the encoded parts
+    ASSERT_EQ(CASS_OK, request->set(0, CassString("a", 1)));
+    ASSERT_EQ(CASS_OK, request->set(1, static_cast<cass_int32_t>(i)));
+    ASSERT_EQ(CASS_OK, frozen->set(0, CassString("a", 1)));
+    ASSERT_EQ(CASS_OK, frozen->set(1, static_cast<cass_int32_t>(i)));
+    EXPECT_EQ(callback->encode(ProtocolVersion(4)), frozen_callback->encode(ProtocolVersion(4)));
+  }
+
+  // Changing settings re-encodes the invariant parts
+  request->set_page_size(100);
+  request->set_timestamp(1234);
+  request->set_serial_consistency(CASS_CONSISTENCY_LOCAL_SERIAL);
+  frozen->set_page_size(100);
+  frozen->set_timestamp(1234);
+  frozen->set_serial_consistency(CASS_CONSISTENCY_LOCAL_SERIAL);
+  EXPECT_EQ(callback->encode(ProtocolVersion(4)), frozen_callback->encode(ProtocolVersion(4)));
+
+  request->set_timestamp(5678);
+  frozen->set_timestamp(5678);
+  EXPECT_EQ(callback->encode(ProtocolVersion(4)), frozen_callback->encode(ProtocolVersion(4)));
+  EXPECT_EQ(callback->encode(ProtocolVersion(3)), frozen_callback->encode(ProtocolVersion(3)));
+}
+
+TEST(StatementBindUnitTest, FrozenEncodePages) {
+  // Long enough for the beginning of the request to be in a shared buffer
+  const char* query = "SELECT * FROM t WHERE k = ?";
+  Statement::Ptr request(new QueryRequest(query, 1));
+  Statement::Ptr frozen(new QueryRequest(query, 1));
+  frozen->freeze();
+  request->set_page_size(100);
+  frozen->set_page_size(100);
+  request->set_serial_consistency(CASS_CONSISTENCY_LOCAL_SERIAL);
+  frozen->set_serial_consistency(CASS_CONSISTENCY_LOCAL_SERIAL);
+  ASSERT_EQ(CASS_OK, request->set(0, static_cast<cass_int32_t>(1)));
+  ASSERT_EQ(CASS_OK, frozen->set(0, static_cast<cass_int32_t>(1)));
+
+  SharedRefPtr<EncodeRequestCallback> callback(new EncodeRequestCallback(request));
+  SharedRefPtr<EncodeRequestCallback> frozen_callback(new EncodeRequestCallback(frozen));
+  EXPECT_EQ(callback->encode(ProtocolVersion(4)), frozen_callback->encode(ProtocolVersion(4)));
+
+  // Only the paging state is encoded for each of the following pages; the
+  // beginning of the request is encoded once with the paging state flag.
+  const char* begin = NULL;
+  for (int i = 0; i < 3; ++i) {
+    OStringStream ss;
+    ss << "page" << i;
+    request->set_paging_state(ss.str());
+    frozen->set_paging_state(ss.str());
+    EXPECT_EQ(callback->encode(ProtocolVersion(4)), frozen_callback->encode(ProtocolVersion(4)));
+
+    BufferVec bufs;
+    ASSERT_GT(frozen_callback->request()->encode(ProtocolVersion(4), frozen_callback.get(), &bufs),
+              0);
+    if (begin != NULL) {
+      EXPECT_EQ(begin, bufs.front().data());
+    }
+    begin = bufs.front().data();
+  }
+}
+
+TEST(BatchRequestUnitTest, Split) {
+  TokenMap::Ptr token_map(TokenMap::from_partitioner(Murmur3Partitioner::name()));
+  token_map->add_host(create_host("1.0.0.1", single_token(CASS_INT64_MIN / 2)));
+  token_map->add_host(create_host("1.0.0.2", single_token(0)));
+  token_map->add_host(create_host("1.0.0.3", single_token(CASS_INT64_MAX / 2)));
+  add_keyspace_simple("ks", 1, token_map.get());
+  token_map->build();
+
+  BatchRequest::Ptr batch(new BatchRequest(CASS_BATCH_TYPE_UNLOGGED));
+  batch->set_consistency(CASS_CONSISTENCY_QUORUM);
+  batch->set_timestamp(1234);
+  const int num_statements = 32;
+  for (int i = 0; i < num_statements; ++i) {
+    QueryRequest::Ptr statement(new QueryRequest("INSERT INTO t (k) VALUES (?)", 1));
+    statement->set(0, static_cast<cass_int32_t>(i));
+    statement->add_key_index(0);
+    batch->add_statement(statement.get());
+  }
+  // Statements without a routing key are grouped together
+  batch->add_statement(new QueryRequest("INSERT INTO t (k) VALUES (0)"));
+
+  BatchRequest::Vec batches;
+  batch->split(token_map.get(), "ks", &batches);
+  ASSERT_EQ(4u, batches.size());
+
+  size_t count = 0;
+  for (BatchRequest::Vec::const_iterator it = batches.begin(), end = batches.end(); it != end;
+       ++it) {
+    const BatchRequest::Ptr& split(*it);
+    EXPECT_EQ(CASS_BATCH_TYPE_UNLOGGED, split->type());
+    EXPECT_EQ(CASS_CONSISTENCY_QUORUM, split->consistency());
+    EXPECT_EQ(1234, split->timestamp());
+    ASSERT_FALSE(split->statements().empty());
+    count += split->statements().size();
+
+    // All the statements of a batch have the same replicas
+    String routing_key;
+    if (!split->statements().front()->get_routing_key(&routing_key)) {
+      EXPECT_EQ(1u, split->statements().size());
+      continue;
+    }
+    Address replica = token_map->get_replicas("ks", routing_key)->front()->address();
+    for (BatchRequest::StatementVec::const_iterator statement_it = split->statements().begin(),
+                                                    statement_end = split->statements().end();
+         statement_it != statement_end; ++statement_it) {
+      ASSERT_TRUE((*statement_it)->get_routing_key(&routing_key));
+      EXPECT_EQ(replica, token_map->get_replicas("ks", routing_key)->front()->address());
+    }
+  }
+  EXPECT_EQ(static_cast<size_t>(num_statements + 1), count);
+
+  // Without a token map the batch isn't split
+  batches.clear();
+  batch->split(NULL, "ks", &batches);
+  EXPECT_EQ(1u, batches.size());
+}
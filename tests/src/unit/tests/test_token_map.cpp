@@ -494,3 +494,48 @@ TEST(TokenMapUnitTest, UniqueReplicas) {
   test_murmur3.build();
   test_murmur3.verify();
 }
+
+TEST(TokenMapUnitTest, TokenRanges) {
+  TestTokenMap<Murmur3Partitioner> test_murmur3;
+
+  Host::Ptr host1(create_host("1.0.0.1", single_token(CASS_INT64_MIN / 2)));
+  Host::Ptr host2(create_host("1.0.0.2", single_token(0)));
+  Host::Ptr host3(create_host("1.0.0.3", single_token(CASS_INT64_MAX / 2)));
+  test_murmur3.add_host(host1);
+  test_murmur3.add_host(host2);
+  test_murmur3.add_host(host3);
+  test_murmur3.build("ks", 2);
+
+  TokenRangeVec ranges;
+  test_murmur3.token_map->get_token_ranges("ks", &ranges);
+  ASSERT_EQ(4u, ranges.size());
+
+  // The range that wraps around the ring is split in two ranges that are both
+  // owned by the first token's replicas.
+  EXPECT_FALSE(ranges[0].has_start);
+  EXPECT_TRUE(ranges[0].has_end);
+  EXPECT_EQ(Murmur3Partitioner::to_bytes(CASS_INT64_MIN / 2), ranges[0].end);
+  EXPECT_TRUE(ranges[3].has_start);
+  EXPECT_FALSE(ranges[3].has_end);
+  EXPECT_EQ(Murmur3Partitioner::to_bytes(CASS_INT64_MAX / 2), ranges[3].start);
+
+  ASSERT_EQ(2u, ranges[0].replicas->size());
+  EXPECT_EQ(host1->address(), (*ranges[0].replicas)[0]->address());
+  EXPECT_EQ(host2->address(), (*ranges[0].replicas)[1]->address());
+  EXPECT_EQ(host1->address(), (*ranges[3].replicas)[0]->address());
+
+  // (min / 2, 0] and (0, max / 2]
+  EXPECT_EQ(Murmur3Partitioner::to_bytes(CASS_INT64_MIN / 2), ranges[1].start);
+  EXPECT_EQ(Murmur3Partitioner::to_bytes(0), ranges[1].end);
+  EXPECT_EQ(host2->address(), (*ranges[1].replicas)[0]->address());
+  EXPECT_EQ(Murmur3Partitioner::to_bytes(0), ranges[2].start);
+  EXPECT_EQ(Murmur3Partitioner::to_bytes(CASS_INT64_MAX / 2), ranges[2].end);
+  EXPECT_EQ(host3->address(), (*ranges[2].replicas)[0]->address());
+
+  // The tokens are encoded as bigint values
+  EXPECT_EQ(String("\x00\x00\x00\x00\x00\x00\x00\x00", 8), Murmur3Partitioner::to_bytes(0));
+
+  ranges.clear();
+  test_murmur3.token_map->get_token_ranges("invalid", &ranges);
+  EXPECT_TRUE(ranges.empty());
+}
@@ -23,10 +23,16 @@
 
 #include <ctype.h>
 #include <stdio.h>
+#if defined(__linux__)
+#include <sched.h>
+#endif
 
 using datastax::String;
+using datastax::internal::CpuList;
 using datastax::internal::escape_id;
 using datastax::internal::num_leading_zeros;
+using datastax::internal::OStringStream;
+using datastax::internal::parse_cpu_list;
 
 TEST(UtilsUnitTest, EscapeId) {
   String s;
@@ -85,3 +91,40 @@ TEST(UtilsUnitTest, Trim) {
   s = "  a bc ";
   EXPECT_EQ(trim(s), String("a bc"));
 }
+
+TEST(UtilsUnitTest, ParseCpuList) {
+  CpuList cpus;
+  EXPECT_TRUE(parse_cpu_list("0-3, 8,10-11", &cpus));
+  ASSERT_EQ(7u, cpus.size());
+  unsigned expected[] = { 0, 1, 2, 3, 8, 10, 11 };
+  for (size_t i = 0; i < cpus.size(); ++i) {
+    EXPECT_EQ(expected[i], cpus[i]);
+  }
+
+  cpus.clear();
+  EXPECT_TRUE(parse_cpu_list("5", &cpus));
+  ASSERT_EQ(1u, cpus.size());
+  EXPECT_EQ(5u, cpus[0]);
+
+  EXPECT_FALSE(parse_cpu_list("", &cpus));
+  EXPECT_FALSE(parse_cpu_list("a", &cpus));
+  EXPECT_FALSE(parse_cpu_list("-1", &cpus));
+  EXPECT_FALSE(parse_cpu_list("3-1", &cpus));
+  EXPECT_FALSE(parse_cpu_list("1-2-3", &cpus));
+  EXPECT_FALSE(parse_cpu_list("1,,x", &cpus));
+
+  // Reversed ranges and CPUs a thread can't be bound to
+  EXPECT_FALSE(parse_cpu_list("2-1", &cpus));
+  EXPECT_FALSE(parse_cpu_list("0,5-4", &cpus));
+  EXPECT_FALSE(parse_cpu_list("0-99999", &cpus));
+  EXPECT_FALSE(parse_cpu_list("99999", &cpus));
+#if defined(__linux__)
+  cpus.clear();
+  OStringStream ss;
+  ss << CPU_SETSIZE - 1;
+  EXPECT_TRUE(parse_cpu_list(ss.str(), &cpus));
+  ss.str("");
+  ss << "0-" << CPU_SETSIZE;
+  EXPECT_FALSE(parse_cpu_list(ss.str(), &cpus));
+#endif
+}